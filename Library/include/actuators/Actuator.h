@@ -69,12 +69,28 @@ namespace sf
 
         //! A method returning the name of the actuator.
         std::string getName() const;
+        
+        //! A method returning the name of the actuator as a persistent string, used to label profiling zones.
+        const char* getZoneName() const;
+        
+        //! A method saving the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
     
     protected:
         DisplayMode dm;
 
     private:
         std::string name;
+        const char* zoneName;
     };
 }
 
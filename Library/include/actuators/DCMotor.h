@@ -95,6 +95,18 @@ namespace sf
         //! A method returning the ratio of the motor gearbox.
         Scalar getGearRatio() const;
         
+        //! A method saving the internal state of the motor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the motor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         Scalar V;
         Scalar I;
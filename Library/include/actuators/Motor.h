@@ -64,6 +64,18 @@ namespace sf
         //! A method returning the type of the actuator.
         ActuatorType getType() const;
         
+        //! A method saving the internal state of the motor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the motor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
     protected:
         Scalar torque;
     };
@@ -83,6 +83,18 @@ namespace sf
         //! A method returning the type of the actuator.
         ActuatorType getType() const;
         
+        //! A method saving the internal state of the propeller.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the propeller.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         //Params
         Scalar D;
@@ -66,6 +66,18 @@ namespace sf
         //! A method returning the type of the actuator.
         ActuatorType getType() const;
         
+        //! A method saving the internal state of the push actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the push actuator.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         Scalar setpoint;
         bool underwater;
@@ -96,8 +96,22 @@ namespace sf
         //! A method returning the type of the comm.
         virtual CommType getType() const;
         
+        //! A method saving the internal state of the modem, including messages propagating in water.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the modem, including messages propagating in water.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
     protected:
         virtual void ProcessMessages();
+        virtual void WriteFrame(SimulationState& state, const CommDataFrame* frame);
+        virtual CommDataFrame* ReadFrame(SimulationState& state);
         
         static AcousticModem* getNode(uint64_t deviceId);
         
@@ -28,7 +28,9 @@
 
 #include <SDL2/SDL_mutex.h>
 #include <deque>
+#include <functional>
 #include "StonefishCommon.h"
+#include "utils/RandomStream.h"
 
 namespace sf
 {
@@ -36,6 +38,7 @@ namespace sf
     enum class CommType {RADIO, ACOUSTIC, USBL, VLC};
     
     struct Renderable;
+    class SimulationState;
     class Entity;
     class StaticEntity;
     class MovingEntity;
@@ -110,6 +113,15 @@ namespace sf
          */
         void Update(Scalar dt);
         
+        //! A method used to set a callback function called when a message is sent or received.
+        /*!
+         \param callback a function to be called with the comm, the data frame and a flag indicating reception
+         */
+        void InstallEventHandler(std::function<void(Comm*, const CommDataFrame*, bool)> callback);
+        
+        //! A method informing if an event handler is installed.
+        bool hasEventHandler() const;
+        
         //! A method used to mark data as old.
         void MarkDataOld();
         
@@ -134,6 +146,9 @@ namespace sf
         //! A method returning the comm name.
         std::string getName();
         
+        //! A method returning the name of the comm as a persistent string, used to label profiling zones.
+        const char* getZoneName() const;
+        
         //! A method performing an internal update of the comm state.
         /*!
          \param dt the time step of the simulation [s]
@@ -143,25 +158,53 @@ namespace sf
         //! A method returning the type of the comm.
         virtual CommType getType() const = 0;
         
+        //! A method saving the internal state of the comm, including buffered messages.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the comm, including buffered messages.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
+        //! A method to reseed the noise generator of the comm.
+        /*!
+         The stream is derived from the seed and the name of the comm, so it does not depend on other comms.
+         \param seed the seed value
+         */
+        void setRandomSeed(uint64_t seed);
+        
     protected:
         //! A method used for data reception.
         void MessageReceived(CommDataFrame* message);
+        //! A method used to queue a data frame for transmission.
+        void Transmit(CommDataFrame* message);
         //! A method to proccess received messages.
         virtual void ProcessMessages() = 0;
+        //! A method used to write a data frame to the state buffer.
+        virtual void WriteFrame(SimulationState& state, const CommDataFrame* frame);
+        //! A method used to read a data frame from the state buffer.
+        virtual CommDataFrame* ReadFrame(SimulationState& state);
     
         bool newDataAvailable;
         std::deque<CommDataFrame*> txBuffer;
         std::deque<CommDataFrame*> rxBuffer;
         uint64_t txSeq;
+        RandomStream randomGenerator;
         
     private:
         std::string name;
+        const char* zoneName;
         uint64_t id;
         int64_t cId;
         SDL_mutex* updateMutex;
         Entity* attach;
         Transform o2c;
         bool renderable;
+        std::function<void(Comm*, const CommDataFrame*, bool)> eventCallback;
     };
 }
 
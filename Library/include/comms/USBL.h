@@ -76,6 +76,19 @@ namespace sf
 
         //! A method returning the type of the comm.
         CommType getType() const;
+        
+        //! A method saving the internal state of the USBL.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the USBL.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
        
     protected:
         virtual void ProcessMessages() = 0;
@@ -85,9 +98,6 @@ namespace sf
         Scalar pingTime;
         std::map<uint64_t, BeaconInfo> beacons;
         bool noise;
-        
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
     };
 }
     
@@ -27,8 +27,14 @@
 #define __Stonefish_Console__
 
 #include <SDL2/SDL_thread.h>
+#include <atomic>
 #include "StonefishCommon.h"
 
+#define CONSOLE_QUEUE_SIZE      1024 //Number of messages waiting for output (power of 2)
+#define CONSOLE_MESSAGE_LENGTH  1024 //Maximum length of a message (including terminator)
+#define CONSOLE_HISTORY_LENGTH  5000 //Number of lines kept for display
+#define CONSOLE_RATE_SLOTS      64   //Number of message formats tracked by the rate limiter
+
 namespace sf
 {
     //! An enum defining types of messages.
@@ -42,6 +48,12 @@ namespace sf
     };
     
     //! A class implementing a text console.
+    /*!
+     Messages are formatted on the calling thread and pushed to a bounded lock-free queue,
+     which is drained by a background thread writing to the standard output and to a ring of console lines.
+     Messages which do not fit in the queue are dropped (and counted). Optionally, messages sharing the same format string can be rate limited.
+     Critical messages are always printed synchronously.
+     */
     class Console
     {
     public:
@@ -68,6 +80,9 @@ namespace sf
          */
         void AppendMessage(const ConsoleMessage& msg);
         
+        //! A method that blocks until all queued messages are written out.
+        void Flush();
+        
         //! A method that clears the console.
         void Clear();
 
@@ -77,17 +92,81 @@ namespace sf
          \return success
          */
         bool SaveToFile(std::string filename);
+        
+        //! A method to set the maximum number of messages with the same format string printed per second.
+        /*!
+         Rate limiting is disabled by default. When enabled, distinct messages produced from the same format string
+         count towards the same limit, which is meant for repetitive diagnostics printed in loops.
+         \param maxPerSecond the message limit (0 disables rate limiting)
+         */
+        void setRateLimit(unsigned int maxPerSecond);
     
         //! A method that returns a pointer to the console data mutex.
         SDL_mutex* getLinesMutex();
         
-        //! A method that returns a copy of the console lines.
+        //! A method that returns a copy of the console lines (after flushing the queue).
         std::vector<ConsoleMessage> getLines();
         
+        //! A method returning the number of messages dropped because the queue was full.
+        uint64_t getDroppedCount() const;
+        
+        //! A method returning the number of messages suppressed by the rate limiter.
+        uint64_t getSuppressedCount() const;
+        
     protected:
+        //! A method returning the number of stored console lines (call with the lines mutex locked).
+        size_t getLinesCount() const;
+        
+        //! A method returning a stored console line (call with the lines mutex locked).
+        /*!
+         \param id the index of the line (0 is the oldest)
+         \return a reference to the console line
+         */
+        const ConsoleMessage& getLine(size_t id) const;
+        
         bool stdoutEnabled;
-        std::vector<ConsoleMessage> lines;
         SDL_mutex* linesMutex;
+        
+    private:
+        struct QueueCell
+        {
+            std::atomic<uint64_t> sequence;
+            MessageType type;
+            char text[CONSOLE_MESSAGE_LENGTH];
+        };
+        
+        struct RateSlot
+        {
+            std::atomic<uint64_t> hash;
+            std::atomic<int64_t> windowStart;
+            std::atomic<uint32_t> count;
+            std::atomic<uint32_t> suppressed;
+        };
+        
+        bool Enqueue(MessageType t, const char* text);
+        bool RateLimit(MessageType t, const std::string& format);
+        void PushLine(MessageType t, const char* text);
+        void Output(MessageType t, const char* text);
+        void Drain();
+        void SweepRateSlots();
+        static int RunWriter(void* data);
+        
+        QueueCell* queue;
+        std::atomic<uint64_t> enqueuePos;
+        std::atomic<uint64_t> dequeuePos;
+        std::atomic<uint64_t> dropped;
+        std::atomic<uint64_t> suppressedTotal;
+        uint64_t droppedReported;
+        RateSlot rateSlots[CONSOLE_RATE_SLOTS];
+        std::atomic<uint32_t> rateLimit;
+        std::vector<ConsoleMessage> lines; //Ring of console lines
+        size_t linesStart;
+        size_t linesCount;
+        SDL_Thread* writerThread;
+        SDL_mutex* writerMutex;
+        SDL_cond* writerCond;
+        SDL_cond* flushCond;
+        std::atomic<bool> writerRunning;
     };
 }
 
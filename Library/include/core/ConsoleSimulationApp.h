@@ -32,6 +32,7 @@
 namespace sf
 {
     class Console;
+    class RemoteControlServer;
     
     //! A class that defines a console application interface.
     class ConsoleSimulationApp : public SimulationApp
@@ -51,15 +52,38 @@ namespace sf
         //! A method informing if the application is graphical.
         bool hasGraphics();
         
+        //! A method enabling the remote control server listening on the loopback interface (has to be called before Run).
+        /*!
+         Running the application with autostart disabled allows for stepping the simulation in lockstep with the client.
+         \param port the TCP port
+         */
+        void EnableRemoteControl(uint16_t port);
+        
+        //! A method enabling the remote control server listening on a Unix domain socket (has to be called before Run).
+        /*!
+         \param socketPath the path of the socket file
+         */
+        void EnableRemoteControl(const std::string& socketPath);
+        
+        //! A method returning a pointer to the remote control server (nullptr if not enabled).
+        RemoteControlServer* getRemoteControlServer();
+        
+        //! A method printing the performance statistics of the CPU ray-traced sensors and the profiler summary (if enabled).
+        void PrintStatistics();
+        
     protected:
         void Init();
         void LoopInternal();
+        void CleanUp();
         void StartSimulation();
         void ResumeSimulation();
         void StopSimulation();
         
     private:
         SDL_Thread* simulationThread;
+        RemoteControlServer* remoteServer;
+        uint16_t remotePort;
+        std::string remoteSocketPath;
         static int RunSimulation(void* data);
     };
     
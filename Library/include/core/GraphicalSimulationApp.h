@@ -180,6 +180,12 @@ namespace sf
         
         virtual void InitializeGUI();
         
+        IMGUI* gui;
+        OpenGLPipeline* glPipeline;
+        RenderSettings rSettings;
+        HelperSettings hSettings;
+        bool loading;
+        
     private:
         void InitializeSDL();
         void RenderLoop();
@@ -195,9 +201,6 @@ namespace sf
         uint8_t* joystickHats;
         SDL_Event mouseWasDown;
         
-        IMGUI* gui;
-        OpenGLPipeline* glPipeline;
-        
         MovingEntity* trackballCenter;
         std::pair<Entity*, int> selectedEntity;
         bool displayHUD;
@@ -205,14 +208,11 @@ namespace sf
         bool displayConsole;
         bool displayPerformance;
         std::string shaderPath;
-        bool loading;
         double drawingTime;
         double maxDrawingTime;
         int maxCounter;
         int windowW;
         int windowH;
-        RenderSettings rSettings;
-        HelperSettings hSettings;
         GLuint timeQuery[2];
         GLint timeQueryPingpong;
         bool limitFramerate;
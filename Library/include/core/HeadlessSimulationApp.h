@@ -0,0 +1,80 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  HeadlessSimulationApp.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_HeadlessSimulationApp__
+#define __Stonefish_HeadlessSimulationApp__
+
+#include "core/GraphicalSimulationApp.h"
+
+namespace sf
+{
+    //! A class that implements a graphical application without a window, rendering only the vision sensors.
+    /*!
+     The OpenGL context is created through EGL without any surface (e.g. Mesa surfaceless platform with llvmpipe),
+     so it works on machines without a display or a GPU. Display composition, GUI and trackball are not rendered.
+     Requires the library to be built with EGL support (HEADLESS_RENDERING).
+     */
+    class HeadlessSimulationApp : public GraphicalSimulationApp
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param name a name for the application
+         \param dataDirPath a path to the directory containing simulation data
+         \param s a structure containing the rendering settings
+         \param sim a pointer to the simulation manager
+         */
+        HeadlessSimulationApp(std::string name, std::string dataDirPath, RenderSettings s, SimulationManager* sim);
+        
+        //! A destructor.
+        virtual ~HeadlessSimulationApp();
+        
+        //! A method returning the number of sensor frames rendered since the start of the simulation.
+        uint64_t getSensorFrameCount() const;
+        
+        //! A method returning the average sensor rendering throughput.
+        /*!
+         \return number of sensor frames rendered per second of rendering time
+         */
+        double getSensorFrameRate() const;
+        
+    protected:
+        void Init();
+        void LoopInternal();
+        void CleanUp();
+        void StartSimulation();
+        
+    private:
+        void InitializeEGL();
+        void PrintStatistics();
+        
+        void* eglDisplay;
+        void* eglContext;
+        uint64_t sensorFrames;
+        uint64_t renderTime;
+    };
+}
+
+#endif
@@ -27,6 +27,8 @@
 #define __Stonefish_NameManager__
 
 #include "StonefishCommon.h"
+#include <unordered_set>
+#include <unordered_map>
 
 namespace sf
 {
@@ -56,8 +58,16 @@ namespace sf
         //! A method used to clear the pool of names.
         void ClearNames();
         
+        //! A method informing if a name is already in the pool.
+        /*!
+         \param name a name to check
+         \return is the name used
+         */
+        bool isNameUsed(const std::string& name) const;
+        
     private:
-        std::vector<std::string> names;
+        std::unordered_set<std::string> names;
+        std::unordered_map<std::string, unsigned int> suffixes; //Numeric suffixes 1..n known to be used for each proposed name
     };
 }
     
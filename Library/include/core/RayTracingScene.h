@@ -0,0 +1,139 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracingScene.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracingScene__
+#define __Stonefish_RayTracingScene__
+
+#include "StonefishCommon.h"
+#include "utils/BVH.h"
+#include <map>
+
+namespace sf
+{
+    class SimulationManager;
+    class SolidEntity;
+    struct Material;
+    
+    //! A structure holding the result of tracing a single ray.
+    struct RayHit
+    {
+        GLfloat distance; //Distance to the hit point (maximum distance if nothing was hit) [m]
+        glm::vec3 normal; //Unit surface normal at the hit point, in the world frame
+        GLint instance; //Index of the hit instance (-1 if nothing was hit)
+    };
+    
+    //! A structure representing a mesh instance in the ray tracing scene.
+    struct RayTracingInstance
+    {
+        const BVH* bvh;
+        glm::mat3 R; //Orientation of the mesh frame in the world frame
+        glm::vec3 p; //Position of the mesh frame in the world frame
+        glm::vec3 aabbMin; //Bounding box in the world frame
+        glm::vec3 aabbMax;
+        GLfloat restitution; //Reflectivity of the material
+    };
+    
+    //! A structure holding ray tracing performance statistics.
+    struct RayTracingStatistics
+    {
+        uint64_t rays; //Number of rays traced
+        uint64_t traceTime; //Total time spent tracing [us]
+        size_t instances; //Number of mesh instances in the scene
+        size_t triangles; //Number of triangles in the scene
+    };
+    
+    //! A class representing the simulated world for CPU ray tracing, built from the physics meshes.
+    /*!
+     Each physics mesh gets its own bounding volume hierarchy, built once and cached until the mesh is destroyed.
+     Instances only store the current pose of the meshes, so updating the scene is cheap.
+     */
+    class RayTracingScene
+    {
+    public:
+        //! A constructor.
+        RayTracingScene();
+        
+        //! A destructor.
+        ~RayTracingScene();
+        
+        //! A method updating the poses of all instances (at most once per simulation time).
+        /*!
+         \param sm a pointer to the simulation manager
+         */
+        void Update(SimulationManager* sm);
+        
+        //! A method removing all instances and cached hierarchies.
+        void Clear();
+        
+        //! A method removing the cached hierarchy of a mesh (called when the mesh is destroyed, as its address may be reused).
+        /*!
+         \param mesh a pointer to the mesh
+         */
+        void Evict(const Mesh* mesh);
+        
+        //! A method tracing a packet of rays defined in the world frame.
+        /*!
+         \param packet a reference to the ray packet
+         */
+        void Trace(RayPacket& packet) const;
+        
+        //! A method tracing a batch of rays sharing the same origin (in parallel).
+        /*!
+         \param origin the origin of the rays in the world frame [m]
+         \param directions a pointer to an array of unit ray directions in the world frame
+         \param count the number of rays
+         \param maxDistance the maximum distance of a hit [m]
+         \param hits a pointer to an array that will store the results
+         */
+        void TraceRays(const glm::vec3& origin, const glm::vec3* directions, size_t count, GLfloat maxDistance, RayHit* hits) const;
+        
+        //! A method returning an instance of the scene.
+        /*!
+         \param index the index of the instance
+         \return a reference to the instance
+         */
+        const RayTracingInstance& getInstance(size_t index) const;
+        
+        //! A method returning the number of instances.
+        size_t getNumOfInstances() const;
+        
+        //! A method returning the performance statistics of the ray tracer.
+        RayTracingStatistics getStatistics() const;
+        
+    private:
+        void AddSolid(SolidEntity* solid);
+        void AddInstance(const Mesh* mesh, const Transform& T, const Material& mat);
+        
+        std::map<const Mesh*, BVH*> bvhCache;
+        std::vector<RayTracingInstance> instances;
+        Scalar lastUpdate;
+        bool valid;
+        size_t nTriangles;
+        mutable uint64_t nRays;
+        mutable uint64_t traceTime;
+    };
+}
+
+#endif
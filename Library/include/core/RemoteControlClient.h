@@ -0,0 +1,186 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RemoteControlClient.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RemoteControlClient__
+#define __Stonefish_RemoteControlClient__
+
+#include "StonefishCommon.h"
+#include "core/RemoteControlServer.h"
+#include "core/SimulationState.h"
+
+namespace sf
+{
+    //! A structure holding an actuator setpoint sent to the remote control server.
+    struct RemoteSetpoint
+    {
+        uint16_t index;
+        uint8_t channel;
+        double value;
+    };
+    
+    //! A structure holding a sensor sample received from the remote control server.
+    struct RemoteSensorData
+    {
+        uint16_t index;
+        double timestamp;
+        std::vector<double> values;
+    };
+    
+    //! A structure holding the state of a body received from the remote control server.
+    struct RemoteBodyData
+    {
+        uint16_t index;
+        double position[3];
+        double orientation[4]; //Quaternion (x,y,z,w)
+        double linearVelocity[3];
+        double angularVelocity[3];
+    };
+    
+    //! A structure describing an object of the remote simulation.
+    struct RemoteObjectInfo
+    {
+        std::string name;
+        uint8_t type;
+        uint16_t channels;
+    };
+    
+    //! A structure holding the result of a remote command.
+    struct RemoteResult
+    {
+        RemoteCommand command;
+        RemoteStatus status;
+        double time;
+        bool running;
+        uint16_t count;
+        std::vector<RemoteSensorData> sensors;
+        std::vector<RemoteBodyData> bodies;
+        std::vector<RemoteObjectInfo> actuatorsInfo;
+        std::vector<RemoteObjectInfo> sensorsInfo;
+        std::vector<RemoteObjectInfo> entitiesInfo;
+        
+        RemoteResult() : command(RemoteCommand::INFO), status(RemoteStatus::OK), time(0.0), running(false), count(0) {}
+    };
+    
+    //! A class implementing a client of the remote control server.
+    /*!
+     Commands are collected in a batch and sent in a single request when the batch is executed.
+     */
+    class RemoteControlClient
+    {
+    public:
+        //! A constructor.
+        RemoteControlClient();
+        
+        //! A destructor.
+        ~RemoteControlClient();
+        
+        //! A method connecting to a server listening on the loopback interface.
+        /*!
+         \param port the TCP port
+         \return success
+         */
+        bool Connect(uint16_t port);
+        
+        //! A method connecting to a server listening on a Unix domain socket.
+        /*!
+         \param socketPath the path of the socket file
+         \return success
+         */
+        bool Connect(const std::string& socketPath);
+        
+        //! A method closing the connection.
+        void Disconnect();
+        
+        //! A method adding a request for the description of the scenario to the batch.
+        void Info();
+        
+        //! A method adding a simulation step request to the batch.
+        /*!
+         \param steps the number of steps to compute
+         */
+        void Step(uint32_t steps = 1);
+        
+        //! A method adding a pause request to the batch.
+        void Pause();
+        
+        //! A method adding a resume request to the batch.
+        void Resume();
+        
+        //! A method adding a soft reset request to the batch.
+        /*!
+         \param seed a seed for the noise generators
+         */
+        void Reset(uint32_t seed);
+        
+        //! A method adding actuator setpoints to the batch.
+        /*!
+         \param setpoints a list of setpoints
+         */
+        void SetActuators(const std::vector<RemoteSetpoint>& setpoints);
+        
+        //! A method adding a request for sensor samples to the batch.
+        /*!
+         \param indices a list of sensor indices (empty means all scalar sensors)
+         */
+        void GetSensors(const std::vector<uint16_t>& indices = std::vector<uint16_t>());
+        
+        //! A method adding a request for body states to the batch.
+        /*!
+         \param indices a list of entity indices (empty means all moving bodies)
+         */
+        void GetBodies(const std::vector<uint16_t>& indices = std::vector<uint16_t>());
+        
+        //! A method adding a request for the simulation time to the batch.
+        void GetTime();
+        
+        //! A method adding a request to quit the application to the batch.
+        void Quit();
+        
+        //! A method sending the batch to the server and receiving the results (the batch is cleared).
+        /*!
+         \param results a reference to a list of results, one per executed command
+         \return success of the communication
+         */
+        bool Execute(std::vector<RemoteResult>& results);
+        
+        //! A method informing if the client is connected.
+        bool isConnected() const;
+        
+        //! A method returning the number of commands in the batch.
+        unsigned int getBatchSize() const;
+        
+    private:
+        void AddCommand(RemoteCommand cmd);
+        void AddIndices(RemoteCommand cmd, const std::vector<uint16_t>& indices);
+        bool ParseResult(SimulationState& response, RemoteResult& result);
+        
+        int clientSocket;
+        unsigned int batchSize;
+        SimulationState batch;
+        SimulationState response;
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RemoteControlServer.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RemoteControlServer__
+#define __Stonefish_RemoteControlServer__
+
+#include <atomic>
+#include <SDL2/SDL_thread.h>
+#include "StonefishCommon.h"
+
+#define REMOTE_CONTROL_MAGIC     0x43524653 //"SFRC" in little-endian byte order
+#define REMOTE_CONTROL_MAX_FRAME (16*1024*1024) //Maximum payload size [B]
+
+namespace sf
+{
+    class SimulationState;
+    class SimulationApp;
+    class SimulationManager;
+    
+    //! An enum defining the commands of the remote control protocol.
+    enum class RemoteCommand : uint8_t {INFO = 0, STEP, PAUSE, RESUME, RESET, SET_ACTUATORS, GET_SENSORS, GET_BODIES, GET_TIME, QUIT};
+    
+    //! An enum defining the result of a remote command.
+    enum class RemoteStatus : uint8_t {OK = 0, INVALID_ARGUMENT, WRONG_STATE, MALFORMED, UNKNOWN_COMMAND};
+    
+    //! A class implementing a server allowing to control a simulation through a local socket.
+    /*!
+     The server accepts one client at a time. Every request is a frame composed of a header (uint32 magic, uint32 payload size)
+     and a payload containing any number of commands, which are executed in order. The response is a frame with the same header,
+     containing a uint8 command code, a uint8 status and the command output (only if the status is OK) for each executed command.
+     A malformed or unknown command ends the processing of the request. All values are stored in the native (little-endian) byte order, 
+     real numbers are sent as doubles and strings as a uint64 length followed by the characters.
+     
+     Commands (arguments -> output):
+     - INFO () -> actuators (uint16 count, {uint8 type, string name}), sensors (uint16 count, {uint8 type, uint16 channels, string name}),
+       entities (uint16 count, {uint8 type, string name})
+     - STEP (uint32 steps) -> double time; computes steps immediately, requires the simulation to be paused and the initial conditions
+       to be solved (WRONG_STATE otherwise)
+     - PAUSE () -> ()
+     - RESUME () -> ()
+     - RESET (uint32 seed) -> (); soft reset with a seed for the noise generators
+     - SET_ACTUATORS (uint16 count, {uint16 index, uint8 channel, double value}) -> uint16 count
+     - GET_SENSORS (uint16 count, {uint16 index}) -> uint16 count, {uint16 index, uint16 channels, double timestamp, double values[channels]}
+     - GET_BODIES (uint16 count, {uint16 index}) -> uint16 count, {uint16 index, double position[3], double orientation[4] (xyzw), 
+       double linearVelocity[3], double angularVelocity[3]}
+     - GET_TIME () -> double time, uint8 running
+     - QUIT () -> ()
+     
+     A count of 0 in GET_SENSORS and GET_BODIES selects all scalar sensors and all moving bodies, respectively. 
+     The actuator channel 0 is the main setpoint (thruster, propeller and rudder setpoint, motor intensity, VBS flow rate, push force, 
+     servo position, suction cup pump). Servos also accept channel 1 (velocity), 2 (maximum torque) and 3 (control mode).
+     A complete control cycle (set actuators, step, get sensors and bodies) fits in a single request.
+     */
+    class RemoteControlServer
+    {
+    public:
+        //! A constructor of a server listening on the loopback interface.
+        /*!
+         \param port the TCP port
+         */
+        RemoteControlServer(uint16_t port);
+        
+        //! A constructor of a server listening on a Unix domain socket.
+        /*!
+         \param socketPath the path of the socket file
+         */
+        RemoteControlServer(const std::string& socketPath);
+        
+        //! A destructor.
+        ~RemoteControlServer();
+        
+        //! A method executing all commands of a request.
+        /*!
+         \param request a reference to the request payload
+         \param response a reference to the buffer to which the response payload is appended
+         \return the number of executed commands
+         */
+        unsigned int ProcessRequest(SimulationState& request, SimulationState& response);
+        
+        //! A method informing if the server is listening.
+        bool isRunning() const;
+        
+        //! A method returning the number of requests served.
+        uint64_t getRequestsCount() const;
+        
+    private:
+        void Start();
+        void Serve(int client);
+        RemoteStatus ExecuteCommand(RemoteCommand cmd, SimulationState& request, SimulationState& response);
+        RemoteStatus Info(SimulationState& response);
+        RemoteStatus Step(SimulationState& request, SimulationState& response);
+        RemoteStatus SetActuators(SimulationState& request, SimulationState& response);
+        RemoteStatus GetSensors(SimulationState& request, SimulationState& response);
+        RemoteStatus GetBodies(SimulationState& request, SimulationState& response);
+        static int RunServer(void* data);
+        
+        SimulationApp* app;
+        SimulationManager* sim;
+        SimulationState* output; //Output of the command being executed
+        std::string socketPath;
+        int listenSocket;
+        SDL_Thread* thread;
+        std::atomic<bool> stop;
+        std::atomic<uint64_t> requests;
+    };
+}
+
+#endif
@@ -31,6 +31,9 @@
 #include "tinyxml2.h"
 #include <map>
 
+#define SCENARIO_COMPILED_MAGIC "SFSCNC\0\0"
+#define SCENARIO_COMPILED_VERSION 1
+
 using namespace tinyxml2;
 
 namespace sf
@@ -60,10 +63,34 @@ namespace sf
         
         //! A method used to parse a scenario description file.
         /*!
-         \param filename path to the scenario description file
+         \param filename path to the scenario description file or to a compiled scenario
          \return success
          */
         virtual bool Parse(std::string filename);
+        
+        //! A method used to parse a scenario description file and save it as a compiled scenario.
+        /*!
+         \param filename path to the scenario description file
+         \param compiledFilename path to the compiled scenario file
+         \return success
+         */
+        bool ParseAndCompile(std::string filename, std::string compiledFilename);
+        
+        //! A method saving the last parsed scenario as a compiled scenario.
+        /*!
+         A compiled scenario contains the fully pre-processed description (includes resolved, arguments replaced, math evaluated) 
+         and all processed meshes cached during parsing. It is loaded by the Parse method without any XML pre-processing and geometry processing.
+         \param filename path to the compiled scenario file
+         \return success
+         */
+        bool SaveCompiled(std::string filename);
+        
+        //! A method checking if a file contains a compiled scenario.
+        /*!
+         \param filename path to the file
+         \return is the file a compiled scenario
+         */
+        static bool IsCompiled(const std::string& filename);
 
         //! A method saving the log to a text file.
         /*!
@@ -81,6 +108,20 @@ namespace sf
     protected:
         Console log;
 
+        //! A method used to load the xml description file, resolve includes and pre-process it.
+        /*!
+         \param filename path to the scenario description file
+         \return success
+         */
+        virtual bool LoadFile(const std::string& filename);
+
+        //! A method used to load a compiled scenario.
+        /*!
+         \param filename path to the compiled scenario file
+         \return success
+         */
+        virtual bool LoadCompiled(const std::string& filename);
+
         //! A method used to pre-process the xml description file after loading.
         /*!
          \param root a pointer to a root node
@@ -277,6 +318,7 @@ namespace sf
         bool isGraphicalSim();
 
     private:
+        bool ParseScenario(const std::string& filename, bool compiled);
         bool CopyNode(XMLNode* destParent, const XMLNode* src);
         bool ParseVector(const char* components, Vector3& v);
         bool ParseTransform(XMLElement* element, Transform& T);
@@ -60,6 +60,15 @@ namespace sf
          */
         void Run(bool autostart = true);
         
+        //! A method pausing the simulation (does nothing if the simulation is not running).
+        void Pause();
+        
+        //! A method resuming the simulation (does nothing if the simulation is running).
+        void Resume();
+        
+        //! A method stopping the simulation and requesting the application to finish.
+        void Exit();
+        
         //! A method informing if the application is graphical.
         virtual bool hasGraphics() = 0;
         
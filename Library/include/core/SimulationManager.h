@@ -31,6 +31,8 @@
 #include "entities/forcefields/Atmosphere.h"
 #include "entities/SolidEntity.h"
 #include "utils/PerformanceMonitor.h"
+#include <unordered_map>
+#include <atomic>
 
 namespace sf
 {
@@ -49,8 +51,12 @@ namespace sf
     class Sensor;
     class Comm;
     class Contact;
+    class SimulationState;
     class OpenGLTrackball;
     class OpenGLDebugDrawer;
+    class RayTracingScene;
+    class TelemetryRecorder;
+    class SharedMemoryBridge;
     
     //! An enum designating the type of solver used for physics computation
     typedef enum {SOLVER_SI, SOLVER_DANTZIG, SOLVER_PGS, SOLVER_LEMKE, SOLVER_NNCG} SolverType;
@@ -65,6 +71,28 @@ namespace sf
         Entity* B;
     };
     
+    //! A structure holding simulation metrics, updated by the simulation thread and readable from any thread without locking.
+    struct SimulationMetrics
+    {
+        std::atomic<uint64_t> steps; //Number of physics steps
+        std::atomic<double> simulationTime; //[s]
+        std::atomic<double> cpuUsage; //[%]
+        std::atomic<double> physicsTime; //Last physics computation [us]
+        std::atomic<double> physicsTimeAverage; //[us]
+        std::atomic<double> hydrodynamicsTime; //Last hydrodynamics computation [us]
+        std::atomic<double> hydrodynamicsTimeAverage; //[us]
+        std::atomic<uint64_t> mlcpFallbacks;
+        std::atomic<uint32_t> entities;
+        std::atomic<uint32_t> sensors;
+        std::atomic<uint32_t> actuators;
+        std::atomic<uint32_t> comms;
+        std::atomic<uint32_t> contactManifolds;
+        
+        SimulationMetrics() : steps(0), simulationTime(0.0), cpuUsage(0.0), physicsTime(0.0), physicsTimeAverage(0.0),
+                              hydrodynamicsTime(0.0), hydrodynamicsTimeAverage(0.0), mlcpFallbacks(0), 
+                              entities(0), sensors(0), actuators(0), comms(0), contactManifolds(0) {}
+    };
+    
     //! An abstract class managing the simulation world, the solver settings and implementing custom physics callbacks.
     class SimulationManager
     {
@@ -119,9 +147,57 @@ namespace sf
         //! A method which restarts the simulation.
         void RestartScenario();
         
+        //! A method saving the dynamic state of the simulation to a buffer (thread safe).
+        /*!
+         The state includes poses and velocities of all bodies and multibodies, internal states of actuators,
+         sensor histories and noise generators, trajectory playback times and messages propagating between comms.
+         \param state a reference to the state buffer (cleared before writing)
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the dynamic state of the simulation from a buffer (thread safe).
+        /*!
+         The state has to be saved in the same scenario, without adding or removing any objects.
+         \param state a reference to the state buffer
+         \return success
+         */
+        bool RestoreState(SimulationState& state);
+        
+        //! A method performing a soft reset of the scenario, without rebuilding it.
+        /*!
+         All bodies are moved back to their initial state captured when the simulation was started, 
+         contact caches are cleared, actuators and sensors are reset and noise generators are reseeded randomly.
+         \return success
+         */
+        bool ResetScenario();
+        
+        //! A method performing a soft reset of the scenario, without rebuilding it.
+        /*!
+         \param seed a seed for the noise generators
+         \return success
+         */
+        bool ResetScenario(uint32_t seed);
+        
+        //! A method to seed the noise generators of all sensors and comms (thread safe).
+        /*!
+         Every sensor and comm derives its own random stream from the seed and its name, 
+         so the noise is reproducible and does not depend on the update order or on other objects in the scenario.
+         The seed is also used for the objects created later.
+         \param seed the seed value
+         */
+        void setRandomSeed(uint64_t seed);
+        
         //! A method computing the next simulation step.
         void AdvanceSimulation();
         
+        //! A method computing a number of simulation steps immediately, without following the simulation clock.
+        /*!
+         Used to run the simulation in lockstep with an external controller. Does nothing before the initial conditions are solved.
+         \param steps the number of steps to compute
+         \return true if the steps were computed, false if the initial conditions are not solved
+         */
+        bool StepSimulation(unsigned int steps = 1);
+        
         //! A method updating the drawing queue (thread safe)
         void UpdateDrawingQueue();
         
@@ -326,6 +402,13 @@ namespace sf
          */
         Robot* getRobot(const std::string& name);
         
+        //! A method returning the index of a robot, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the robot
+         \return an index of the robot or -1 if not found
+         */
+        int getRobotIndex(const std::string& name) const;
+        
         //! A method returning an entity by index.
         /*!
          \param index an id of the entity
@@ -333,6 +416,9 @@ namespace sf
          */
         Entity* getEntity(unsigned int index);
         
+        //! A method returning the number of entities.
+        size_t getNumOfEntities() const;
+        
         //! A method returning an entity by name.
         /*!
          \param name a name of the entity
@@ -340,6 +426,13 @@ namespace sf
          */
         Entity* getEntity(const std::string& name);
         
+        //! A method returning the index of an entity, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the entity
+         \return an index of the entity or -1 if not found
+         */
+        int getEntityIndex(const std::string& name) const;
+        
         //! A method returning a joint by index.
         /*!
          \param index an id of the joint
@@ -354,6 +447,14 @@ namespace sf
          */
         Joint* getJoint(const std::string& name);
         
+        //! A method returning the index of a joint, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the joint
+         \return an index of the joint or -1 if not found
+         Indices of joints added after a removed joint are shifted down by one.
+         */
+        int getJointIndex(const std::string& name) const;
+        
         //! A method returning a contact by index.
         /*!
          \param index an id of the contact
@@ -368,6 +469,13 @@ namespace sf
          */
         Contact* getContact(const std::string& name);
         
+        //! A method returning the index of a contact, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the contact
+         \return an index of the contact or -1 if not found
+         */
+        int getContactIndex(const std::string& name) const;
+        
         //! A method returning a contavt by entity pair.
         /*!
          \param entA a pointer to the first entity
@@ -383,6 +491,9 @@ namespace sf
          */
         Actuator* getActuator(unsigned int index);
         
+        //! A method returning the number of actuators.
+        size_t getNumOfActuators() const;
+        
         //! A method returning an actuator by name.
         /*!
          \param name a name of the actuator
@@ -390,6 +501,13 @@ namespace sf
          */
         Actuator* getActuator(const std::string& name);
         
+        //! A method returning the index of an actuator, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the actuator
+         \return an index of the actuator or -1 if not found
+         */
+        int getActuatorIndex(const std::string& name) const;
+        
         //! A method returning a sensor by index.
         /*!
          \param index an id of the sensor
@@ -397,6 +515,9 @@ namespace sf
          */
         Sensor* getSensor(unsigned int index);
         
+        //! A method returning the number of sensors.
+        size_t getNumOfSensors() const;
+        
         //! A method returning a sensor by name.
         /*!
          \param name a name of the sensor
@@ -404,6 +525,13 @@ namespace sf
          */
         Sensor* getSensor(const std::string& name);
         
+        //! A method returning the index of a sensor, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the sensor
+         \return an index of the sensor or -1 if not found
+         */
+        int getSensorIndex(const std::string& name) const;
+        
         //! A method returning a communication device by index.
         /*!
          \param index an id of the communication device
@@ -418,6 +546,13 @@ namespace sf
          */
         Comm* getComm(const std::string& name);
         
+        //! A method returning the index of a communication device, to be resolved once and used with the index-based getter.
+        /*!
+         \param name a name of the communication device
+         \return an index of the communication device or -1 if not found
+         */
+        int getCommIndex(const std::string& name) const;
+        
         //! A method returning a pointer to the NED object.
         NED* getNED();
         
@@ -442,11 +577,35 @@ namespace sf
         //! A method returning a pointer to the material manager.
         MaterialManager* getMaterialManager();
         
+        //! A method returning a pointer to the CPU ray tracing scene (created on first use).
+        RayTracingScene* getRayTracingScene();
+        
         //! A method returning a pointer to the name manager.
         NameManager* getNameManager();
         
+        //! A method to set the telemetry recorder sampling the simulation after every step.
+        /*!
+         \param recorder a pointer to the recorder (nullptr to detach)
+         */
+        void setTelemetryRecorder(TelemetryRecorder* recorder);
+        
+        //! A method returning a pointer to the telemetry recorder (nullptr if not set).
+        TelemetryRecorder* getTelemetryRecorder();
+        
+        //! A method to set the shared memory bridge exchanging data with co-located controllers at every step.
+        /*!
+         \param bridge a pointer to the bridge (nullptr to detach)
+         */
+        void setSharedMemoryBridge(SharedMemoryBridge* bridge);
+        
+        //! A method returning a pointer to the shared memory bridge (nullptr if not set).
+        SharedMemoryBridge* getSharedMemoryBridge();
+        
         //! A method returning a reference to the performance monitor.
         PerformanceMonitor& getPerformanceMonitor();
+        
+        //! A method returning a reference to the simulation metrics (safe to read from any thread).
+        const SimulationMetrics& getMetrics() const;
 
         //! A method returning a pointer to the trackball view.
         OpenGLTrackball* getTrackball();
@@ -454,6 +613,9 @@ namespace sf
         //! A method informing if the simulation is freshly started.
         bool isSimulationFresh() const;
         
+        //! A method returning the mutex guarding the simulation settings and the lists of objects (thread safeness).
+        SDL_mutex* getSimSettingsMutex();
+        
         //! A method informing if the ocean is enabled in the simulation.
         bool isOceanEnabled() const;
         
@@ -502,6 +664,15 @@ namespace sf
                                const std::string& albedoTexturePath = "", const std::string& normalTexturePath = "");
         
     protected:
+        //! A structure implementing a hash of an unordered entity pair.
+        struct EntityPairHash
+        {
+            size_t operator()(const std::pair<const Entity*, const Entity*>& p) const
+            {
+                return std::hash<const Entity*>()(p.first) ^ (std::hash<const Entity*>()(p.second) << 1);
+            }
+        };
+        
         static void SolveICTickCallback(btDynamicsWorld* world, Scalar timeStep);
         static void SimulationTickCallback(btDynamicsWorld* world, Scalar timeStep);
         static void SimulationPostTickCallback(btDynamicsWorld* world, Scalar timeStep);
@@ -523,12 +694,16 @@ namespace sf
         void RenderBulletDebug();
         void InitializeSolver();
         void InitializeScenario();
+        void ClearContactCaches();
+        bool SoftReset(uint32_t seed);
+        void ComputeStep(uint64_t deltaTime);
         
         // State
         Scalar simulationTime;
         uint64_t currentTime;
         uint64_t ssus;
         bool simulationFresh;
+        SimulationState* initialState;
 
         // Performance
         PerformanceMonitor perfMon;
@@ -570,8 +745,20 @@ namespace sf
         std::vector<Actuator*> actuators;
         std::vector<Comm*> comms;
         std::vector<Contact*> contacts;
+        std::unordered_map<std::string, size_t> robotIds;
+        std::unordered_map<std::string, size_t> entityIds;
+        std::unordered_map<std::string, size_t> jointIds;
+        std::unordered_map<std::string, size_t> sensorIds;
+        std::unordered_map<std::string, size_t> actuatorIds;
+        std::unordered_map<std::string, size_t> commIds;
+        std::unordered_map<std::string, size_t> contactIds;
+        std::unordered_map<std::pair<const Entity*, const Entity*>, Contact*, EntityPairHash> contactPairs;
         std::vector<Collision> collisions;
         NED* ned;
+        RayTracingScene* rtScene;
+        TelemetryRecorder* telemetry;
+        SharedMemoryBridge* shmBridge;
+        SimulationMetrics metrics;
         Ocean* ocean;
         Atmosphere* atmosphere;
         Scalar g;
@@ -0,0 +1,137 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SimulationState.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SimulationState__
+#define __Stonefish_SimulationState__
+
+#include "StonefishCommon.h"
+#include <type_traits>
+#include <cstring>
+
+namespace sf
+{
+    //! A class implementing a compact binary buffer storing the dynamic state of the simulation.
+    class SimulationState
+    {
+    public:
+        //! A constructor.
+        SimulationState();
+        
+        //! A method clearing the buffer without releasing memory.
+        void Clear();
+        
+        //! A method moving the read position to the beginning of the buffer.
+        void Rewind();
+        
+        //! A method writing a trivially copyable value to the buffer.
+        /*!
+         \param value a reference to the value
+         */
+        template<typename T> void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly!");
+            WriteBytes(&value, sizeof(T));
+        }
+        
+        //! A method reading a trivially copyable value from the buffer.
+        /*!
+         \param value a reference to the output value
+         */
+        template<typename T> void Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly!");
+            ReadBytes(&value, sizeof(T));
+        }
+        
+        //! A method writing a vector to the buffer.
+        /*!
+         \param v a reference to the vector
+         */
+        void Write(const Vector3& v);
+        
+        //! A method reading a vector from the buffer.
+        /*!
+         \param v a reference to the output vector
+         */
+        void Read(Vector3& v);
+        
+        //! A method writing a transform to the buffer (bit-exact).
+        /*!
+         \param T a reference to the transform
+         */
+        void Write(const Transform& T);
+        
+        //! A method reading a transform from the buffer.
+        /*!
+         \param T a reference to the output transform
+         */
+        void Read(Transform& T);
+        
+        //! A method writing a string to the buffer.
+        /*!
+         \param str a reference to the string
+         */
+        void WriteString(const std::string& str);
+        
+        //! A method reading a string from the buffer.
+        /*!
+         \param str a reference to the output string
+         */
+        void ReadString(std::string& str);
+        
+        //! A method writing raw data to the buffer.
+        /*!
+         \param src a pointer to the data
+         \param size the size of the data in bytes
+         */
+        void WriteBytes(const void* src, size_t size);
+        
+        //! A method reading raw data from the buffer.
+        /*!
+         \param dst a pointer to the destination memory
+         \param size the size of the data in bytes
+         */
+        void ReadBytes(void* dst, size_t size);
+        
+        //! A method returning the size of the stored state in bytes.
+        size_t getSize() const;
+        
+        //! A method returning a pointer to the stored data.
+        const uint8_t* getData() const;
+        
+        //! A method returning the number of bytes left to read.
+        size_t getRemainingSize() const;
+        
+        //! A method informing if the state was read without overruns.
+        bool isValid() const;
+        
+    private:
+        std::vector<uint8_t> data;
+        size_t readPos;
+        bool valid;
+    };
+}
+
+#endif
@@ -185,6 +185,18 @@ namespace sf
          \param max a point located at the maximum coordinate corner
          */
         void getAABB(Vector3& min, Vector3& max);
+        
+        //! A method saving the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
       
     private:
         void BuildRigidBody(btCollisionShape* shape, bool collides);
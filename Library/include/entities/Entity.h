@@ -52,6 +52,7 @@ namespace sf
     
     struct Renderable;
     class SimulationManager;
+    class SimulationState;
     
     //! An abstract class representing a simulation entity.
     class Entity
@@ -78,6 +79,9 @@ namespace sf
         //! A method returning the name of the entity.
         std::string getName() const;
         
+        //! A method returning the name of the entity as a persistent string, used to label profiling zones.
+        const char* getZoneName() const;
+        
         //! A method returning the type of the entity.
         virtual EntityType getType() const = 0;
         
@@ -97,9 +101,22 @@ namespace sf
          */
         virtual void getAABB(Vector3& min, Vector3& max) = 0;
         
+        //! A method saving the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the dynamic state of the entity.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
     private:
         bool renderable;
         std::string name;
+        const char* zoneName;
     };
 }
 
@@ -381,6 +381,18 @@ namespace sf
         //! A method returning the type of the entity.
         EntityType getType() const;
         
+        //! A method saving the dynamic state of the multibody.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the dynamic state of the multibody.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         btMultiBody* multiBody;
         std::vector<FeatherstoneLink> links;
@@ -390,6 +390,18 @@ namespace sf
         //! A method returning the index of the physical object used in rendering.
         int getPhysicalObject() const;
         
+        //! A method saving the dynamic state of the body.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the dynamic state of the body.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
     protected:
         BodyFluidPosition CheckBodyFluidPosition(Ocean* ocn);
         void ComputeFluidDynamicsApprox(GeometryApproxType t);
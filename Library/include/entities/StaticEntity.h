@@ -86,6 +86,9 @@ namespace sf
         //! A method returning the material of the entity.
         Material getMaterial() const;
         
+        //! A method returning a pointer to the physics mesh.
+        const Mesh* getPhysicsMesh() const;
+        
         //! A method returning the rigid body associated with the entity.
         btRigidBody* getRigidBody();
         
@@ -31,6 +31,8 @@
 
 namespace sf
 {
+    class SimulationState;
+    
     //! An enum representing available trajectory playback modes.
     enum class PlaybackMode {ONETIME, REPEAT, BOOMERANG};
 
@@ -76,6 +78,18 @@ namespace sf
 
         //! A method returning the current playback iteration.
         unsigned int getPlaybackIteration() const;
+        
+        //! A method saving the playback state.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the playback state.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
 
         static void calculateVelocityShortestPath(const Transform &transform0, const Transform &transform1, Scalar timeStep, Vector3 &linVel, Vector3 &angVel);
     
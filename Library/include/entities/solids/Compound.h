@@ -103,6 +103,9 @@ namespace sf
 
         //! A method returning a pointer to one part of the compound body.
         const CompoundPart getPart(size_t partId) const;
+        
+        //! A method returning the number of parts of the compound body.
+        size_t getNumOfParts() const;
 
         //! A method that returns the type of solid.
         SolidType getSolidType();
@@ -77,6 +77,7 @@ namespace sf
     {
         std::string shadingAlgorithm;
         GLSLShader* shaders[6];
+        GLSLShader* shadersInstanced[6];
 
         MaterialShader()
         {
@@ -87,7 +88,10 @@ namespace sf
         {
             shadingAlgorithm = obj.shadingAlgorithm;
             for(size_t i=0; i<6; ++i)
+            {
                 shaders[i] = obj.shaders[i];
+                shadersInstanced[i] = obj.shadersInstanced[i];
+            }
         }
     };
 
@@ -222,6 +226,22 @@ namespace sf
          \param M the model matrix
          */
         void DrawObject(int objectId, int lookId, const glm::mat4& M);
+        
+        //! A method to draw multiple copies of an object with a single instanced draw call.
+        /*!
+         \param objectId the id of the graphical object
+         \param lookId the id of the graphical material
+         \param M a pointer to an array of model matrices
+         \param count the number of instances
+         */
+        void DrawObjectInstanced(int objectId, int lookId, const glm::mat4* M, GLsizei count);
+        
+        //! A method to draw all solid objects from a drawing queue, grouping copies of the same object into instanced draw calls.
+        /*!
+         \param queue a drawing queue sorted by look and object
+         \param useLooks a flag determining if the looks of the objects should be used
+         */
+        void DrawObjects(const std::vector<Renderable>& queue, bool useLooks = true);
 
         //! A method to draw the light source.
         /*!
@@ -318,6 +338,9 @@ namespace sf
          \param id the id of the object
          */
         const Object& getObject(size_t id);
+        
+        //! A method returning the number of objects.
+        size_t getObjectsCount();
 
         //! A method returning a reference to the look structure.
         /*!
@@ -378,6 +401,39 @@ namespace sf
          */
         static Mesh* LoadMesh(const std::string& filename, GLfloat scale, bool smooth);
         
+        //! A static method to enable caching of processed meshes loaded from files.
+        /*!
+         The cache is only searched when caching is enabled. Cached meshes are kept until ClearMeshCache is called
+         or the simulation manager is destroyed.
+         \param enabled a flag indicating if the meshes loaded with LoadMesh should be stored in the cache
+         */
+        static void setMeshCaching(bool enabled);
+        
+        //! A static method informing if the caching of processed meshes is enabled.
+        static bool isMeshCaching();
+        
+        //! A static method to add a processed mesh to the cache (takes ownership of the mesh).
+        /*!
+         \param key a key identifying the mesh (see MeshCacheKey)
+         \param mesh a pointer to the processed mesh
+         */
+        static void AddMeshToCache(const std::string& key, Mesh* mesh);
+        
+        //! A static method to delete all cached meshes.
+        static void ClearMeshCache();
+        
+        //! A static method returning the cache of processed meshes.
+        static const std::map<std::string, Mesh*>& getMeshCache();
+        
+        //! A static method generating a key used to identify a mesh in the cache.
+        /*!
+         \param filename the path to the mesh file
+         \param scale the scale applied to the mesh
+         \param smooth a flag indicating if the normals were smoothed
+         \return the key
+         */
+        static std::string MeshCacheKey(const std::string& filename, GLfloat scale, bool smooth);
+        
         //! A static method to build a graphical plane object.
         /*!
          \param halfExtents the size of the plane [m]
@@ -522,6 +578,7 @@ namespace sf
         int currentLookId;
         bool currentTexturable;
         int currentShaderMode;
+        bool currentInstanced;
         
         glm::vec3 eyePos;
         glm::vec3 viewDir;
@@ -540,6 +597,10 @@ namespace sf
         GLuint lightsUBO;
         LightsUBO lightsUBOData;
         GLuint viewUBO;
+        GLuint instancesSSBO;
+        GLsizeiptr instancesSSBOSize;
+        std::vector<glm::mat4> instanceData;
+        std::vector<glm::mat4> instanceMatrices;
         
         //Shaders
         std::map<std::string, GLSLShader*> basicShaders;
@@ -548,6 +609,12 @@ namespace sf
         
         //Methods
         void UseStandardLook(const glm::mat4& M);
+        GLSLShader* SetupLook(int lookId, bool texturable, bool instanced);
+        void UploadInstances(const glm::mat4* M, GLsizei count);
+        
+        //Processed mesh cache
+        static std::map<std::string, Mesh*> meshCache;
+        static bool meshCaching;
     };
 }
 
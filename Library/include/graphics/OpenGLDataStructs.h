@@ -42,6 +42,7 @@
 #define MIN_INTENSITY_THRESHOLD 1.0f //Minimum light intensity to be considered [cd]
 #define STD_NEAR_PLANE_DISTANCE 0.02f //Standard near plane distance of the cameras
 #define STD_FAR_PLANE_DISTANCE 100000.f //Standard far plane distance of the cameras
+#define INSTANCING_MIN_COUNT 2 //Minimum number of copies of an object drawn with a single instanced call
 
 //Standard texture unit bindings (OpenGL 3.x >=48; OpenGL 4.x >=80)
 #define TEX_BASE                ((GLint)0)
@@ -81,6 +82,7 @@
 #define SSBO_PARTICLE_VEL       ((GLuint)8)
 #define SSBO_QTREE_INDIRECT     ((GLuint)9)
 #define SSBO_QTREE_SIZE         ((GLuint)10)
+#define SSBO_INSTANCES          ((GLuint)11)
 
 //Light params
 #define MAX_POINT_LIGHTS        ((GLint)32)
@@ -320,6 +322,8 @@ namespace sf
         GLuint vboIndex;
         GLsizei faceCount;
         bool texturable;
+        glm::vec3 aabbMin; //Bounding box in the object frame
+        glm::vec3 aabbMax;
     };
     
     //! An enum representing the type of look of an object.
@@ -493,7 +497,8 @@ namespace sf
 
 		static bool SortByMaterial(const Renderable& r1, const Renderable& r2) 
 		{
-			return r1.lookId < r2.lookId;
+			//Copies of the same object with the same look end up adjacent (instancing)
+			return r1.lookId < r2.lookId || (r1.lookId == r2.lookId && r1.objectId < r2.objectId);
 		}
     };
     
@@ -33,6 +33,7 @@ namespace sf
 {
     class GLSLShader;
     class Camera;
+    class OpenGLReadbackRing;
     class SolidEntity;
     
     //! A class representing a depth camera.
@@ -139,6 +140,7 @@ namespace sf
     protected:
         void LinearizeDepth();
         void Depth2LinearRanges();
+        void ProcessReadback(bool wait);
         
         Camera* camera;
         unsigned int idx;
@@ -151,7 +153,6 @@ namespace sf
         glm::vec3 tempUp;
         glm::mat4 projection;
         bool _needsUpdate;
-        bool newData;
         glm::vec2 range;
         GLfloat noiseDepth;
         std::default_random_engine randGen;
@@ -160,7 +161,7 @@ namespace sf
         GLuint renderDepthTex;
         GLuint linearDepthTex;
         GLuint linearDepthFBO;
-        GLuint linearDepthPBO;
+        OpenGLReadbackRing* readback;
         static GLSLShader** depthCameraOutputShader;
         static GLSLShader* depthVisualizeShader;
     };
@@ -78,6 +78,14 @@ namespace sf
         //! A method that updates sonar world transform.
         void UpdateTransform();
         
+        //! A method checking if a bounding box can be visible in the view (used for culling).
+        /*!
+         \param aabbMin the minimum corner of the axis-aligned bounding box in the world frame
+         \param aabbMax the maximum corner of the axis-aligned bounding box in the world frame
+         \return false if the box is surely not visible
+         */
+        bool isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const;
+        
         //! A method to set the noise properties of the sonar.
         /*!
          \param signalStdDev the standard deviation of the echo intensity
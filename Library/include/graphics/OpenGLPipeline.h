@@ -36,6 +36,27 @@ namespace sf
     class SimulationManager;
     class OpenGLContent;
     class OpenGLCamera;
+    class OpenGLView;
+    
+    //! An enum defining how views are scheduled for rendering.
+    enum class ViewScheduling {ROUND_ROBIN, SENSOR_RATE};
+    
+    //! A structure holding rendering statistics of a view.
+    struct ViewStatistics
+    {
+        unsigned int renderCount; //Number of renders
+        unsigned int missedCount; //Number of update requests which could not be served before the next one
+        GLfloat lastTime; //GPU time of the last render [ms]
+        GLfloat avgTime; //Average GPU time [ms]
+        GLfloat maxTime; //Maximum GPU time [ms]
+        
+        ViewStatistics()
+        {
+            renderCount = 0;
+            missedCount = 0;
+            lastTime = avgTime = maxTime = 0.f;
+        }
+    };
 
     //! A class implementing the OpenGL rendering pipeline.
     class OpenGLPipeline
@@ -74,9 +95,32 @@ namespace sf
 		 \param r a vector of renderable objects
 		 */
         void AddToSelectedDrawingQueue(const std::vector<Renderable>& r);
+        
+        //! A method handing the built drawing queues over to the rendering thread (has to be called with the drawing queue mutex locked).
+        /*!
+         \param t the simulation time corresponding to the drawing queues [s]
+         */
+        void SubmitDrawingQueue(Scalar t);
 		
         //! A method that draws all normal objects.
         void DrawObjects();
+        
+        //! A method that draws the normal objects which passed the last culling.
+        void DrawVisibleObjects();
+        
+        //! A method to cull the drawing queue against a view.
+        /*!
+         \param view a pointer to the view
+         \return a reference to the list of solid objects potentially visible in the view
+         */
+        std::vector<Renderable>& CullObjects(const OpenGLView* view);
+        
+        //! A method to cull the drawing queue against a frustum.
+        /*!
+         \param VP the view-projection matrix defining the frustum
+         \return a reference to the list of solid objects intersecting the frustum
+         */
+        std::vector<Renderable>& CullObjects(const glm::mat4& VP);
 		
 		//! A method that draws all lights.
 		void DrawLights();
@@ -90,7 +134,7 @@ namespace sf
         //! A method that clears the drawing queue for selected objects.
         void PurgeSelectedDrawingQueue();
 
-        //! A method that informs if the drawing queue is empty.
+        //! A method that informs if the last submitted drawing queue was taken by the rendering thread.
         bool isDrawingQueueEmpty();
         
         //! A method to get mutex of the drawing queue for thread safeness.
@@ -108,22 +152,81 @@ namespace sf
         //! A method returning a pointer to the OpenGL content manager.
         OpenGLContent* getContent();
         
+        //! A method to restrict rendering to sensor views (no trackball, no display composition).
+        /*!
+         \param enabled a flag specifying if only sensor views should be rendered
+         */
+        void setSensorViewsOnly(bool enabled);
+        
+        //! A method informing if rendering is restricted to sensor views.
+        bool isSensorViewsOnly() const;
+        
+        //! A method returning the number of views updated during the last call to Render.
+        unsigned int getUpdatedViewsCount() const;
+        
+        //! A method to set the view scheduling policy.
+        /*!
+         ROUND_ROBIN renders continuous views and one other pending view per frame.
+         SENSOR_RATE renders every view whose sensor requested an update, real-time views first.
+         \param s the scheduling policy
+         */
+        void setViewScheduling(ViewScheduling s);
+        
+        //! A method returning the view scheduling policy.
+        ViewScheduling getViewScheduling() const;
+        
+        //! A method returning the rendering statistics of a view.
+        /*!
+         \param id the index of the view
+         \return a structure with view statistics
+         */
+        ViewStatistics getViewStatistics(size_t id);
+        
+        //! A method returning the simulation time of the frame being rendered [s].
+        Scalar getFrameTimeStamp() const;
+        
     private:
         void PerformDrawingQueueCopy(SimulationManager* sim);
+        void ComputeBoundingBoxes();
+        unsigned int ScheduleViews(std::vector<unsigned int>& viewsNoUpdate);
+        void BeginViewTiming(unsigned int id);
+        void EndViewTiming(unsigned int id);
+        void CollectViewTiming(unsigned int id, unsigned int set, bool wait);
+        std::vector<Renderable>& CullObjects(const OpenGLView* view, const glm::vec4* frustum);
         void DrawHelpers();
         
         RenderSettings rSettings;
         HelperSettings hSettings;
-        std::vector<Renderable> drawingQueue;
-        std::vector<Renderable> drawingQueueCopy;
+        std::vector<Renderable> drawingQueue; //Back buffer filled by the simulation without locking (slots kept between frames)
+        std::vector<Renderable> drawingQueuePending; //Submitted buffer waiting for the rendering thread (guarded by the mutex)
+        std::vector<Renderable> drawingQueueCopy; //Front buffer used for rendering
         std::vector<Renderable> selectedDrawingQueue;
+        std::vector<Renderable> selectedDrawingQueuePending;
         std::vector<Renderable> selectedDrawingQueueCopy;
+        size_t drawingQueueSize; //Number of used slots in the back buffer
+        size_t selectedDrawingQueueSize;
+        size_t drawingQueuePendingSize; //Number of used slots in the submitted buffer (0 after it was taken)
+        size_t selectedDrawingQueuePendingSize;
+        std::vector<glm::vec3> drawingQueueAABBs; //World bounding boxes (min, max) of the drawing queue copy
+        std::vector<char> visibleFlags;
+        std::vector<Renderable> visibleQueue;
+        std::vector<Renderable> visibleSpareSlots;
+        bool cullingCacheValid;
+        glm::mat4 cullingCacheVP;
+        ViewScheduling scheduling;
+        std::vector<ViewStatistics> viewStats;
+        std::vector<GLuint> viewQueries; //Timestamp queries (2 sets of begin/end per view)
+        std::vector<char> viewQueriesPending;
         SDL_mutex* drawingQueueMutex;
         std::deque<unsigned int> viewsQueue;
         GLuint screenFBO;
         GLuint screenTex;
         OpenGLContent* content;
         Scalar lastSimTime;
+        bool sensorViewsOnly;
+        unsigned int updatedViews;
+        Scalar drawingQueueTimeStamp;
+        Scalar frameTimeStamp;
     };
 }
 
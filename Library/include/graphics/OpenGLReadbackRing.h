@@ -0,0 +1,103 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLReadbackRing.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_OpenGLReadbackRing__
+#define __Stonefish_OpenGLReadbackRing__
+
+#include "StonefishCommon.h"
+#include "graphics/OpenGLDataStructs.h"
+
+//! Default number of pixel buffers used for asynchronous readback of a sensor image.
+#define READBACK_RING_DEPTH 3
+
+namespace sf
+{
+    //! A class implementing a ring of pixel buffer objects used for asynchronous readback of rendered data.
+    /*!
+     Each readback is followed by a fence. Buffers are mapped only after their fence is signaled,
+     so the CPU never stalls waiting for the GPU, unless all buffers of the ring are occupied.
+     Every frame carries the simulation time it was rendered for.
+     */
+    class OpenGLReadbackRing
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param size the size of a single frame [B]
+         \param depth the number of buffers in the ring
+         */
+        OpenGLReadbackRing(GLsizeiptr size, unsigned int depth = READBACK_RING_DEPTH);
+        
+        //! A destructor.
+        ~OpenGLReadbackRing();
+        
+        //! A method that binds the next free buffer as the pixel pack buffer.
+        /*!
+         \return false if the ring is full and the oldest frame has to be consumed first
+         */
+        bool BeginReadback();
+        
+        //! A method that inserts a fence after the readback commands and unbinds the buffer.
+        /*!
+         \param timeStamp the simulation time of the rendered frame [s]
+         */
+        void EndReadback(Scalar timeStamp);
+        
+        //! A method that maps the oldest frame, if its readback was completed.
+        /*!
+         \param data a reference to a pointer that will be set to the mapped data
+         \param timeStamp a reference to a variable that will store the simulation time of the frame [s]
+         \param wait a flag indicating if the method should block until the oldest frame is ready
+         \return true if a frame was mapped and has to be released with Unmap()
+         */
+        bool Map(void*& data, Scalar& timeStamp, bool wait = false);
+        
+        //! A method that unmaps the frame mapped with Map() and releases its buffer.
+        void Unmap();
+        
+        //! A method informing if all buffers are occupied by frames waiting to be consumed.
+        bool isFull() const;
+        
+        //! A method returning the number of frames waiting to be consumed.
+        unsigned int getPendingCount() const;
+        
+    private:
+        struct Slot
+        {
+            GLuint pbo;
+            GLsync fence;
+            Scalar timeStamp;
+        };
+        
+        std::vector<Slot> slots;
+        GLsizeiptr frameSize;
+        unsigned int head;
+        unsigned int tail;
+        unsigned int pending;
+        bool mapped;
+    };
+}
+
+#endif
@@ -31,6 +31,7 @@
 namespace sf
 {
     class ColorCamera;
+    class OpenGLReadbackRing;
  
     //! A class implementing a real camera in OpenGL.
     class OpenGLRealCamera : public OpenGLCamera
@@ -105,10 +106,13 @@ namespace sf
         bool needsUpdate();
         
     private:
+        void ReadbackTexture();
+        void ProcessReadback(bool wait);
+        
         ColorCamera* camera;
         GLuint cameraFBO;
         GLuint cameraColorTex[2];
-        GLuint cameraPBO;
+        OpenGLReadbackRing* readback;
         
         glm::mat4 cameraTransform;
         glm::vec3 eye;
@@ -118,7 +122,6 @@ namespace sf
         glm::vec3 tempDir;
         glm::vec3 tempUp;
         bool _needsUpdate;
-        bool newData;
     };
 }
 
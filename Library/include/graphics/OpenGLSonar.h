@@ -32,6 +32,8 @@
 namespace sf
 {
     class GLSLShader;
+    class Camera;
+    class OpenGLReadbackRing;
     
     //! An abstract class representing a sonar view.
     class OpenGLSonar : public OpenGLView
@@ -60,6 +62,14 @@ namespace sf
          */
         virtual void DrawLDR(GLuint destinationFBO, bool updated) = 0;
         
+        //! A method checking if a bounding box can be visible in the view (used for culling).
+        /*!
+         \param aabbMin the minimum corner of the axis-aligned bounding box in the world frame
+         \param aabbMax the maximum corner of the axis-aligned bounding box in the world frame
+         \return false if the box is surely not visible
+         */
+        virtual bool isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const;
+        
         //! A method returning the eye position.
         glm::vec3 GetEyePosition() const;
         
@@ -114,6 +124,10 @@ namespace sf
         static void Destroy();
         
     protected:
+        void InitReadback(GLsizeiptr outputSize);
+        void ReadbackOutput(Camera* sensor, GLuint outputTexture);
+        void ProcessReadback(Camera* sensor, bool wait);
+        
         //Sonar specific
         glm::mat4 sonarTransform;
         glm::vec3 eye;
@@ -130,15 +144,14 @@ namespace sf
         ColorMap cMap;
         bool settingsUpdated;
         bool _needsUpdate;
-        bool newData;
         
         //OpenGL
         GLuint inputRangeIntensityTex;
         GLuint inputDepthRBO;
-        GLuint outputPBO;
+        OpenGLReadbackRing* outputReadback;
         GLuint displayTex;
         GLuint displayFBO;
-        GLuint displayPBO;
+        OpenGLReadbackRing* displayReadback;
         GLuint displayVAO;
         GLuint displayVBO;
         
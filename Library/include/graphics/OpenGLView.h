@@ -119,6 +119,17 @@ namespace sf
 
         //! A method saying if the view works in continuous update mode.
         bool isContinuous();
+        
+        //! A method returning the number of update requests overwritten before the view was rendered.
+        unsigned int getMissedUpdatesCount() const;
+        
+        //! A method checking if a bounding box can be visible in the view (used for culling).
+        /*!
+         \param aabbMin the minimum corner of the axis-aligned bounding box in the world frame
+         \param aabbMax the maximum corner of the axis-aligned bounding box in the world frame
+         \return false if the box is surely not visible
+         */
+        virtual bool isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const;
 
         //! A method extracting frustium planes from the view-projection matrix.
         /*!
@@ -127,6 +138,15 @@ namespace sf
          */
         static void ExtractFrustumFromVP(glm::vec4 frustum[6], const glm::mat4& VP);
         
+        //! A method checking if an axis-aligned bounding box intersects a frustum.
+        /*!
+         \param frustum a pointer to the 6 frustum planes
+         \param aabbMin the minimum corner of the bounding box
+         \param aabbMax the maximum corner of the bounding box
+         \return false if the box is completely outside of the frustum
+         */
+        static bool AABBInFrustum(const glm::vec4 frustum[6], const glm::vec3& aabbMin, const glm::vec3& aabbMax);
+        
     protected:
         GLint originX;
         GLint originY;
@@ -135,6 +155,7 @@ namespace sf
         GLuint renderFBO;
         bool enabled;
         bool continuous;
+        unsigned int missedUpdates;
         ViewUBO viewUBOData;
     };
 }
@@ -29,6 +29,9 @@
 #include <deque>
 #include "StonefishCommon.h"
 
+//! Maximum number of contact points stored when the history length is not specified.
+#define CONTACT_MAX_HISTORY_LENGTH 100000
+
 namespace sf
 {
     //! An enum specifying the style of contact rendering.
@@ -75,7 +78,7 @@ namespace sf
          \param uniqueName a name for the contact
          \param entityA a pointer to the first entity
          \param entityB a pointer to the second entity
-         \param historyLength defines: 0 -> unlimited history, >0 -> history with a specified length
+         \param historyLength defines: 0 -> full history (bounded by CONTACT_MAX_HISTORY_LENGTH), >0 -> history with a specified length
          */
         Contact(std::string uniqueName, Entity* entityA, Entity* entityB, unsigned int historyLength = 1);
         
@@ -138,7 +141,7 @@ namespace sf
         Entity* A;
         Entity* B;
         std::deque<ContactPoint> points;
-        std::deque<ContactPoint>::iterator pointsLastBeg;
+        size_t pointsLastAdded;
         unsigned int historyLen;
         int16_t displayMask;
         bool newDataAvailable;
@@ -0,0 +1,135 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  FramePool.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_FramePool__
+#define __Stonefish_FramePool__
+
+#include <atomic>
+#include <SDL2/SDL_mutex.h>
+#include "StonefishCommon.h"
+
+#define FRAME_POOL_CAPACITY 4
+
+namespace sf
+{
+    class FramePool;
+    
+    //! A class representing a reference-counted frame buffer belonging to a frame pool.
+    class SensorFrame
+    {
+    public:
+        //! A method used to take an additional reference to the frame.
+        void Retain();
+        
+        //! A method used to drop a reference to the frame (thread-safe, returns the frame to the pool when the last reference is dropped).
+        void Release();
+        
+        //! A method returning a pointer to the frame data.
+        void* getData();
+        
+        //! A method returning the size of the frame data [B].
+        size_t getSize() const;
+        
+        //! A method returning the simulation time for which the frame was rendered [s].
+        Scalar getTimeStamp() const;
+        
+        //! A method returning the id of the output which produced the frame.
+        unsigned int getIndex() const;
+        
+    private:
+        friend class FramePool;
+        
+        SensorFrame(FramePool* owner, size_t dataSize);
+        ~SensorFrame();
+        
+        FramePool* pool;
+        uint8_t* data;
+        size_t size;
+        Scalar timeStamp;
+        unsigned int index;
+        std::atomic<unsigned int> refCount;
+    };
+    
+    //! A class implementing a pool of preallocated, reference-counted frame buffers.
+    /*!
+     Frames are filled on the rendering thread and can be released by the consumers from any thread.
+     The pool is destroyed when its owner calls Destroy() and all frames have been released.
+     */
+    class FramePool
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param frameSize the size of a single frame [B]
+         \param capacity the number of preallocated frames
+         */
+        FramePool(size_t frameSize, unsigned int capacity = FRAME_POOL_CAPACITY);
+        
+        //! A method used to take a free frame from the pool.
+        /*!
+         \return a pointer to the frame holding a single reference or nullptr if all frames are in use
+         */
+        SensorFrame* Acquire();
+        
+        //! A method used to take a free frame from the pool and fill it with data.
+        /*!
+         \param src a pointer to the source data (frame size bytes are copied)
+         \param timeStamp the simulation time for which the data was rendered [s]
+         \param index the id of the output which produced the data
+         \return a pointer to the frame holding a single reference or nullptr if all frames are in use
+         */
+        SensorFrame* Fill(const void* src, Scalar timeStamp, unsigned int index = 0);
+        
+        //! A method used by the owner to release the pool (it is deleted after all frames are returned).
+        void Destroy();
+        
+        //! A method returning the size of a single frame [B].
+        size_t getFrameSize() const;
+        
+        //! A method returning the number of preallocated frames.
+        unsigned int getCapacity() const;
+        
+        //! A method returning the number of frames available for acquisition.
+        unsigned int getFreeCount();
+        
+        //! A method returning the number of frames that could not be acquired because the pool was exhausted.
+        uint64_t getDroppedCount() const;
+        
+    private:
+        friend class SensorFrame;
+        
+        ~FramePool();
+        void Return(SensorFrame* frame);
+        
+        SDL_mutex* mutex;
+        std::vector<SensorFrame*> frames;
+        std::vector<SensorFrame*> freeFrames;
+        size_t frameSize;
+        uint64_t dropped;
+        bool destroyed;
+    };
+}
+
+#endif
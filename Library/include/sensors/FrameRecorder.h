@@ -0,0 +1,180 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  FrameRecorder.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_FrameRecorder__
+#define __Stonefish_FrameRecorder__
+
+#include <deque>
+#include <cstdio>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+#include "sensors/FramePool.h"
+
+namespace sf
+{
+    //! An enum defining the encoding of recorded frames.
+    enum class RecordingFormat {PNG, JPEG, RAW};
+    
+    //! An enum defining how recorded frames are stored.
+    enum class RecordingContainer {FILES, INDEXED};
+    
+    //! A structure holding the statistics of a frame recorder.
+    struct RecorderStatistics
+    {
+        uint64_t received; //Frames handed over by the sensors
+        uint64_t written; //Frames encoded and written to disk
+        uint64_t droppedQueue; //Frames rejected because the encoding queue was full
+        uint64_t droppedPool; //Frames lost because the frame pools of the sensors were exhausted
+        uint64_t failed; //Frames which could not be encoded or written
+        uint64_t bytesWritten; //Total size of the written data [B]
+        unsigned int queueLength; //Number of frames waiting for encoding
+        unsigned int queuePeak; //Maximum number of frames waiting for encoding
+        double encodeTime; //Total time spent on encoding and writing [s]
+        
+        RecorderStatistics()
+        {
+            received = written = droppedQueue = droppedPool = failed = bytesWritten = 0;
+            queueLength = queuePeak = 0;
+            encodeTime = 0.0;
+        }
+    };
+    
+    class VisionSensor;
+    
+    //! A class implementing a background recorder of vision sensor outputs.
+    /*!
+     The recorder installs itself as the frame handler of the added sensors. Pooled frames are queued on the rendering thread
+     and encoded/written by a pool of worker threads, so recording never blocks rendering. Memory is bounded by the capacity of
+     the frame pools and of the encoding queue; frames arriving when either is exhausted are dropped and counted.
+     Color images and sonar displays are stored as 3-channel images, sonar outputs as 1-channel images.
+     Floating point data (depth cameras, multibeams) is always stored raw.
+     With the FILES container every frame is written to "<sensor>_<output>_<sequence>.<ext>" in the output directory,
+     and an "index.csv" file lists the frames with their simulation time stamps. With the INDEXED container all frames
+     are written to a single file followed by an index table (see WriteIndex for the layout).
+     Detach has to be called before the recorded sensors are destroyed (e.g. before the scenario is torn down),
+     because the queued frames belong to the frame pools of the sensors.
+     */
+    class FrameRecorder
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param path a path to the output directory (FILES) or output file (INDEXED)
+         \param format the encoding of the recorded frames
+         \param container the storage type
+         \param numOfWorkers the number of encoding threads
+         \param queueCapacity the maximum number of frames waiting for encoding
+         */
+        FrameRecorder(const std::string& path, RecordingFormat format = RecordingFormat::PNG, RecordingContainer container = RecordingContainer::FILES,
+                      unsigned int numOfWorkers = 2, unsigned int queueCapacity = 16);
+        
+        //! A destructor (writes all queued frames, does not access the sensors).
+        ~FrameRecorder();
+        
+        //! A method used to start recording the outputs of a vision sensor.
+        /*!
+         \param sensor a pointer to the vision sensor
+         \param poolCapacity the number of preallocated frames per sensor output
+         */
+        void AddSensor(VisionSensor* sensor, unsigned int poolCapacity = FRAME_POOL_CAPACITY);
+        
+        //! A method that stops recording, uninstalls the frame handlers and waits until all queued frames are written.
+        void Detach();
+        
+        //! A method that waits until all queued frames are written.
+        void Flush();
+        
+        //! A method to set the quality of JPEG encoding.
+        /*!
+         \param q the quality (1-100)
+         */
+        void setJPEGQuality(int q);
+        
+        //! A method returning the recorder statistics.
+        RecorderStatistics getStatistics();
+        
+        //! A method informing if the recorder output was opened successfully.
+        bool isOpen() const;
+        
+    private:
+        struct Stream
+        {
+            VisionSensor* sensor;
+            unsigned int index;
+            std::string name;
+            uint64_t sequence;
+        };
+        
+        struct Job
+        {
+            SensorFrame* frame;
+            const Stream* source; //Elements of a deque do not move and the stream name/index never change
+            unsigned int stream;
+            uint64_t sequence;
+            unsigned int width;
+            unsigned int height;
+            unsigned int channels;
+            unsigned int bytesPerChannel;
+        };
+        
+        struct IndexEntry
+        {
+            unsigned int stream;
+            uint64_t sequence;
+            Scalar timeStamp;
+            uint64_t offset;
+        };
+        
+        void Submit(VisionSensor* sensor, SensorFrame* frame);
+        unsigned int getStream(VisionSensor* sensor, unsigned int index);
+        bool getFrameLayout(VisionSensor* sensor, SensorFrame* frame, Job& job) const;
+        bool Encode(const Job& job, std::vector<uint8_t>& buffer) const;
+        bool Write(const Job& job, const void* data, size_t size);
+        void WriteIndex();
+        static int RunWorker(void* data);
+        
+        std::string path;
+        RecordingFormat format;
+        RecordingContainer container;
+        int jpegQuality;
+        std::vector<VisionSensor*> sensors;
+        std::deque<Stream> streams; //Deque keeps references valid while streams are added
+        std::deque<Job> queue;
+        unsigned int queueCapacity;
+        unsigned int busyWorkers;
+        bool stop;
+        std::vector<SDL_Thread*> workers;
+        SDL_mutex* queueMutex;
+        SDL_cond* jobAvailable;
+        SDL_cond* jobsDone;
+        SDL_mutex* fileMutex;
+        FILE* file; //Container (INDEXED) or index.csv (FILES)
+        std::vector<IndexEntry> index;
+        uint64_t fileOffset;
+        RecorderStatistics stats;
+    };
+}
+
+#endif
@@ -76,6 +76,8 @@ namespace sf
         uint64_t getId() const;
         
     private:
+        friend class ScalarSensor;
+        
         Scalar timestamp;
         unsigned short nDim;
         Scalar* data;
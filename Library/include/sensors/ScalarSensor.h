@@ -27,6 +27,7 @@
 #define __Stonefish_ScalarSensor__
 
 #include <deque>
+#include <functional>
 #include "sensors/Sensor.h"
 
 namespace sf
@@ -56,7 +57,6 @@ namespace sf
         std::string name;
         QuantityType type;
         Scalar stdDev;
-        std::normal_distribution<Scalar> noise;
         Scalar rangeMin;
         Scalar rangeMax;
         
@@ -74,10 +74,7 @@ namespace sf
         void setStdDev(Scalar sd)
         {
             if(sd > Scalar(0))
-            {
                 stdDev = sd;
-                noise = std::normal_distribution<Scalar>(Scalar(0), stdDev);
-            }
         }
     };
     
@@ -129,6 +126,15 @@ namespace sf
          */
         void SaveMeasurementsToOctaveFile(const std::string& path, bool includeTime = true, bool separateChannels = false);
         
+        //! A method used to set a callback function called when a new sample is added.
+        /*!
+         \param callback a function to be called with the sensor and the new sample (after noise and limits)
+         */
+        void InstallNewDataHandler(std::function<void(ScalarSensor*, const Sample&)> callback);
+        
+        //! A method informing if a new data handler is installed.
+        bool hasNewDataHandler() const;
+        
         //! A method returning the number of channels of the sensor.
         unsigned short getNumOfChannels() const;
         
@@ -166,6 +172,18 @@ namespace sf
         //! A method returning the sensor measurement frame.
         virtual Transform getSensorFrame() const = 0;
         
+        //! A method saving the internal state of the sensor, including the history of measurements.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the sensor, including the history of measurements.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
     protected:
         void AddSampleToHistory(const Sample& s);
         std::deque<Sample*> history;
@@ -174,6 +192,8 @@ namespace sf
         
     private:
         int historyLen;
+        std::vector<Scalar> noiseBuffer;
+        std::function<void(ScalarSensor*, const Sample&)> newDataCallback;
     };
 }
     
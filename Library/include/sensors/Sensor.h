@@ -26,9 +26,9 @@
 #ifndef __Stonefish_Sensor__
 #define __Stonefish_Sensor__
 
-#include <random>
 #include <SDL2/SDL_mutex.h>
 #include "StonefishCommon.h"
+#include "utils/RandomStream.h"
 
 namespace sf
 {
@@ -36,6 +36,7 @@ namespace sf
     enum class SensorType {JOINT, LINK, VISION, OTHER};
     
     struct Renderable;
+    class SimulationState;
     
     //! An abstract class representing a sensor.
     class Sensor
@@ -77,6 +78,9 @@ namespace sf
 
         //! A method returning the sensor's name.
         std::string getName() const;
+        
+        //! A method returning the name of the sensor as a persistent string, used to label profiling zones.
+        const char* getZoneName() const;
 
         //! A method returning the sampling rate of the sensor.
         Scalar getUpdateFrequency() const;
@@ -108,15 +112,33 @@ namespace sf
         //! A method returning the sensor measurement frame.
         virtual Transform getSensorFrame() const = 0;
         
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        virtual void RestoreState(SimulationState& state);
+        
+        //! A method to reseed the noise generator of the sensor.
+        /*!
+         The stream is derived from the seed and the name of the sensor, so it does not depend on other sensors.
+         \param seed the seed value
+         */
+        void setRandomSeed(uint64_t seed);
+        
     protected:
         Scalar freq;
         SDL_mutex* updateMutex;
-        
-        static std::random_device randomDevice;
-        static std::mt19937 randomGenerator;
+        RandomStream randomGenerator;
         
     private:
         std::string name;
+        const char* zoneName;
         Scalar eleapsedTime;
         bool newDataAvailable;
         bool renderable;
@@ -26,7 +26,9 @@
 #ifndef __Stonefish_VisionSensor__
 #define __Stonefish_VisionSensor__
 
+#include <functional>
 #include "sensors/Sensor.h"
+#include "sensors/FramePool.h"
 
 namespace sf
 {
@@ -95,12 +97,52 @@ namespace sf
         //! A method returning the type of the vision sensor.
         virtual VisionSensorType getVisionSensorType() const = 0;
         
+        //! A method used to set the simulation time of the data being delivered.
+        /*!
+         \param t the simulation time for which the data was rendered [s]
+         */
+        void setFrameTimeStamp(Scalar t);
+        
+        //! A method returning the simulation time for which the last delivered data was rendered [s].
+        Scalar getFrameTimeStamp() const;
+        
+        //! A method used to set a callback function receiving pooled frames.
+        /*!
+         The callback is called on the rendering thread and receives a frame holding a single reference.
+         The consumer has to call SensorFrame::Release() when done with the data, possibly from another thread.
+         When all frames of the pool are in use new data is dropped, so consumers never block rendering.
+         \param callback a function to be called
+         \param poolCapacity the number of preallocated frames per sensor output
+         */
+        void InstallFrameHandler(std::function<void(VisionSensor*, SensorFrame*)> callback, unsigned int poolCapacity = FRAME_POOL_CAPACITY);
+        
+        //! A method returning the frame pool of a sensor output.
+        /*!
+         \param index the id of the sensor output
+         \return a pointer to the frame pool or nullptr if no frames were delivered yet
+         */
+        FramePool* getFramePool(unsigned int index = 0);
+        
     protected:
         virtual void InitGraphics() = 0;
         
+        //! A method used to initialise a CPU backend when graphics is not available.
+        /*!
+         \return true if the sensor supports simulation without graphics
+         */
+        virtual bool InitRayTracing();
+        
+        void DeliverFrame(const void* data, size_t size, unsigned int index = 0);
+        
     private:
+        void InitBackend();
+        
         Entity* attach;
         Transform o2s;
+        Scalar frameTimeStamp;
+        std::vector<FramePool*> framePools;
+        unsigned int framePoolCapacity;
+        std::function<void(VisionSensor*, SensorFrame*)> newFrameCallback;
     };
 }
 
@@ -26,6 +26,7 @@
 #ifndef __Stonefish_GPS__
 #define __Stonefish_GPS__
 
+#include <random>
 #include "sensors/scalar/LinkSensor.h"
 
 namespace sf
@@ -60,6 +61,18 @@ namespace sf
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType() const;
         
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         //Custom noise generation specific to GPS
         Scalar nedStdDev;
@@ -26,6 +26,7 @@
 #ifndef __Stonefish_INS__
 #define __Stonefish_INS__
 
+#include <random>
 #include "sensors/scalar/LinkSensor.h"
 #include "sensors/scalar/GPS.h"
 #include "sensors/scalar/Pressure.h"
@@ -98,6 +99,18 @@ namespace sf
         //! A method returning the type of the scalar sensor.
         ScalarSensorType getScalarSensorType() const;
 
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
         private:
             Scalar latitude, longitude, altitude;
             Vector3 ned;
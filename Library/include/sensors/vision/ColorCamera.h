@@ -80,6 +80,9 @@ namespace sf
          */
         void InstallNewDataHandler(std::function<void(ColorCamera*)> callback);
         
+        //! A method informing if a new data handler is installed.
+        bool hasNewDataHandler() const;
+        
         //! A method used to set the exposure compensation factor.
         /*!
          \param comp the exposure compensation value [EV]
@@ -33,6 +33,7 @@
 namespace sf
 {
     class OpenGLDepthCamera;
+    class RayTracedDepthCamera;
     
     //! A class representing a depth camera.
     class DepthCamera : public Camera
@@ -80,6 +81,9 @@ namespace sf
          */
         void InstallNewDataHandler(std::function<void(DepthCamera*)> callback);
         
+        //! A method informing if a new data handler is installed.
+        bool hasNewDataHandler() const;
+        
         //! A method used to set the noise characteristics of the sensor.
         /*!
          \param depthStdDev standard deviation of the depth measurement at 1m distance
@@ -101,8 +105,10 @@ namespace sf
         
     private:
         void InitGraphics();
+        bool InitRayTracing();
         
         OpenGLDepthCamera* glCamera;
+        RayTracedDepthCamera* rtCamera;
         GLfloat* imageData;
         glm::vec2 depthRange;
         GLfloat noiseStdDev;
@@ -33,6 +33,7 @@
 namespace sf
 {
     class OpenGLFLS;
+    class RayTracedFLS;
     
     //! A class representing a forward looking sonar.
     class FLS : public Camera
@@ -141,8 +142,10 @@ namespace sf
         
     private:
         void InitGraphics();
+        bool InitRayTracing();
         
         OpenGLFLS* glFLS;
+        RayTracedFLS* rtFLS;
         GLubyte* sonarData;
         GLubyte* displayData;
         glm::vec2 range;
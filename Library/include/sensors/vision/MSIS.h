@@ -33,6 +33,7 @@
 namespace sf
 {
     class OpenGLMSIS;
+    class RayTracedMSIS;
     
     //! A class representing a mechanical scanning imaging sonar.
     class MSIS : public Camera
@@ -161,10 +162,24 @@ namespace sf
         //! A method returning the type of the vision sensor.
         VisionSensorType getVisionSensorType() const;
         
+        //! A method saving the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void SaveState(SimulationState& state);
+        
+        //! A method restoring the internal state of the sensor.
+        /*!
+         \param state a reference to the state buffer
+         */
+        void RestoreState(SimulationState& state);
+        
     private:
         void InitGraphics();
+        bool InitRayTracing();
         
         OpenGLMSIS* glMSIS;
+        RayTracedMSIS* rtMSIS;
         GLubyte* sonarData;
         GLubyte* displayData;
         int currentStep;
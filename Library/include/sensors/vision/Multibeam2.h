@@ -35,6 +35,7 @@
 namespace sf
 {
     class OpenGLDepthCamera;
+    class RayTracedDepthCamera;
     
     //! A structure holding information about a single OpenGL camera.
     struct CamData
@@ -128,8 +129,12 @@ namespace sf
         
     private:
         void InitGraphics();
+        bool InitRayTracing();
+        void SetupCameraLayout();
+        void RangeDataReady();
         
         std::vector<CamData> cameras;
+        RayTracedDepthCamera* rtCamera;
         GLfloat* imageData;
         GLfloat* rangeData;
         Scalar fovV;
@@ -0,0 +1,103 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedDepthCamera.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracedDepthCamera__
+#define __Stonefish_RayTracedDepthCamera__
+
+#include "StonefishCommon.h"
+#include "core/RayTracingScene.h"
+#include "utils/RandomStream.h"
+
+namespace sf
+{
+    //! A class implementing a CPU ray-cast depth camera.
+    /*!
+     The image can be composed of a number of pinhole views rotated around the up axis of the sensor,
+     the same way as the OpenGL depth cameras of the multibeam sensor.
+     */
+    class RayTracedDepthCamera
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param width the horizontal resolution of the whole image [pix]
+         \param height the vertical resolution of the whole image [pix]
+         \param depthRange the minimum and maximum depth [m]
+         \param rng the random number stream of the owning sensor
+         */
+        RayTracedDepthCamera(unsigned int width, unsigned int height, glm::vec2 depthRange, RandomStream& rng);
+        
+        //! A method adding a pinhole view covering a range of image columns.
+        /*!
+         \param offsetX the first image column covered by the view
+         \param viewWidth the number of columns covered by the view
+         \param horizontalFOVDeg the horizontal field of view of the view [deg]
+         \param verticalFOVDeg the vertical field of view of the view [deg]
+         \param yaw the rotation of the view around the up axis of the sensor (positive to the left) [rad]
+         */
+        void AddView(unsigned int offsetX, unsigned int viewWidth, GLfloat horizontalFOVDeg, GLfloat verticalFOVDeg, GLfloat yaw);
+        
+        //! A method setting the noise characteristics of the depth measurement.
+        /*!
+         \param depthStdDev the standard deviation of the depth measurement at 1m distance
+         */
+        void setNoise(GLfloat depthStdDev);
+        
+        //! A method computing a linear depth image (0 outside of the depth range).
+        /*!
+         \param scene a pointer to the ray tracing scene
+         \param sensorFrame the transformation of the sensor in the world frame
+         */
+        void ComputeDepth(const RayTracingScene* scene, const Transform& sensorFrame);
+        
+        //! A method computing an image of ranges along the pixel rays (clamped to the depth range).
+        /*!
+         \param scene a pointer to the ray tracing scene
+         \param sensorFrame the transformation of the sensor in the world frame
+         */
+        void ComputeRanges(const RayTracingScene* scene, const Transform& sensorFrame);
+        
+        //! A method returning a pointer to the output image.
+        GLfloat* getOutputDataPointer();
+        
+    private:
+        void TracePixels(const RayTracingScene* scene, const Transform& sensorFrame);
+        
+        unsigned int resX;
+        unsigned int resY;
+        glm::vec2 range;
+        GLfloat noiseStdDev;
+        GLfloat minDepthFactor;
+        std::vector<glm::vec3> localDirs; //Pixel ray directions in the sensor frame
+        std::vector<GLfloat> depthFactor; //Cosine of the angle between the ray and the view axis
+        std::vector<glm::vec3> worldDirs;
+        std::vector<RayHit> hits;
+        std::vector<GLfloat> output;
+        RandomStream& randGen;
+        std::vector<Scalar> noise;
+    };
+}
+
+#endif
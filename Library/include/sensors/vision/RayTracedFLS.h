@@ -0,0 +1,71 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedFLS.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracedFLS__
+#define __Stonefish_RayTracedFLS__
+
+#include "sensors/vision/RayTracedSonar.h"
+
+namespace sf
+{
+    //! A class implementing a CPU ray-traced forward-looking sonar.
+    class RayTracedFLS : public RayTracedSonar
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param numOfBeams a number of acoustic beams
+         \param numOfBins a range resolution of the sonar image
+         \param horizontalFOVDeg the horizontal field of view [deg]
+         \param verticalFOVDeg the vertical beam width [deg]
+         \param displayWidth the width of the visualisation image [pix]
+         \param cm the color map used to display sonar data
+         \param rng the random number stream of the owning sensor
+         */
+        RayTracedFLS(unsigned int numOfBeams, unsigned int numOfBins, GLfloat horizontalFOVDeg, GLfloat verticalFOVDeg,
+                     unsigned int displayWidth, ColorMap cm, RandomStream& rng);
+        
+        //! A method computing a new sonar image.
+        /*!
+         \param scene a pointer to the ray tracing scene
+         \param sensorFrame the transformation of the sensor in the world frame
+         \param range the minimum and maximum range of the sonar [m]
+         \param gain the gain of the sonar
+         */
+        void ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain);
+        
+    private:
+        void UpdateDisplay(GLfloat rangeMin);
+        
+        GLuint nBeams;
+        GLuint nBins;
+        GLuint nBeamSamples;
+        GLfloat fovH;
+        std::vector<glm::vec2> binHistogram;
+        std::vector<GLfloat> image;
+    };
+}
+
+#endif
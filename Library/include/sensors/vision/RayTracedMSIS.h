@@ -0,0 +1,73 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedMSIS.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracedMSIS__
+#define __Stonefish_RayTracedMSIS__
+
+#include "sensors/vision/RayTracedSonar.h"
+
+namespace sf
+{
+    //! A class implementing a CPU ray-traced mechanical scanning imaging sonar.
+    class RayTracedMSIS : public RayTracedSonar
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param numOfSteps the number of rotation steps in a full circle
+         \param numOfBins the number of range bins
+         \param horizontalBeamWidthDeg the width of the beam along the scanning direction [deg]
+         \param verticalBeamWidthDeg the width of the beam perpendicular to the scanning direction [deg]
+         \param cm the color map used to display sonar data
+         \param rng the random number stream of the owning sensor
+         */
+        RayTracedMSIS(unsigned int numOfSteps, unsigned int numOfBins, GLfloat horizontalBeamWidthDeg, GLfloat verticalBeamWidthDeg, ColorMap cm, RandomStream& rng);
+        
+        //! A method computing a new beam of the sonar image.
+        /*!
+         \param scene a pointer to the ray tracing scene
+         \param sensorFrame the transformation of the sensor in the world frame
+         \param range the minimum and maximum range of the sonar [m]
+         \param gain the gain of the sonar
+         \param rotationStep the current rotation step of the transducer
+         \param rotationLimits the rotation limits of the transducer [deg]
+         */
+        void ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain,
+                           GLint rotationStep, glm::vec2 rotationLimits);
+        
+    private:
+        void UpdateDisplay(GLfloat rangeMin);
+        
+        GLuint nSteps;
+        GLuint nBins;
+        glm::uvec2 nBeamSamples; //Horizontal, vertical
+        glm::vec2 fov;
+        glm::vec3 settings; //Range min, range max, gain
+        glm::vec2 limits;
+        std::vector<glm::vec2> binHistogram;
+    };
+}
+
+#endif
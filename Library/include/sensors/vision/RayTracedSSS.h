@@ -0,0 +1,68 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedSSS.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracedSSS__
+#define __Stonefish_RayTracedSSS__
+
+#include "sensors/vision/RayTracedSonar.h"
+
+namespace sf
+{
+    //! A class implementing a CPU ray-traced side-scan sonar.
+    class RayTracedSSS : public RayTracedSonar
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param numOfBins the number of bins of both transducers (even)
+         \param numOfLines the number of lines of the waterfall image
+         \param verticalBeamWidthDeg the beam width across track [deg]
+         \param horizontalBeamWidthDeg the beam width along track [deg]
+         \param verticalTiltDeg the tilt of the transducers below horizontal [deg]
+         \param cm the color map used to display sonar data
+         \param rng the random number stream of the owning sensor
+         */
+        RayTracedSSS(unsigned int numOfBins, unsigned int numOfLines, GLfloat verticalBeamWidthDeg, GLfloat horizontalBeamWidthDeg,
+                     GLfloat verticalTiltDeg, ColorMap cm, RandomStream& rng);
+        
+        //! A method computing a new line and shifting the waterfall image.
+        /*!
+         \param scene a pointer to the ray tracing scene
+         \param sensorFrame the transformation of the sensor in the world frame
+         \param range the minimum and maximum range of the sonar [m]
+         \param gain the gain of the sonar
+         */
+        void ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain);
+        
+    private:
+        GLuint nHalfBins;
+        glm::uvec2 nBeamSamples; //Across track, along track
+        GLfloat tilt;
+        GLfloat fovV;
+        std::vector<glm::vec2> lineHistogram;
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedSonar.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RayTracedSonar__
+#define __Stonefish_RayTracedSonar__
+
+#include "StonefishCommon.h"
+#include "utils/RandomStream.h"
+#include "graphics/OpenGLDataStructs.h"
+#include "core/RayTracingScene.h"
+
+namespace sf
+{
+    //! An abstract class implementing common functions of CPU ray-traced sonars.
+    /*!
+     Ray-traced sonars reproduce the output of their OpenGL counterparts without a graphics context,
+     by casting rays against the physics meshes of the scene. They are used when the simulation runs in console mode.
+     */
+    class RayTracedSonar
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param outputWidth the width of the sonar data image [pix]
+         \param outputHeight the height of the sonar data image [pix]
+         \param displayWidth the width of the visualisation image [pix]
+         \param displayHeight the height of the visualisation image [pix]
+         \param cm the color map used to display sonar data
+         \param rng the random number stream of the owning sensor
+         */
+        RayTracedSonar(unsigned int outputWidth, unsigned int outputHeight, unsigned int displayWidth, unsigned int displayHeight, ColorMap cm, RandomStream& rng);
+        
+        //! A destructor.
+        virtual ~RayTracedSonar();
+        
+        //! A method setting the noise characteristics of the sonar.
+        /*!
+         \param signalStdDev the standard deviation of the multiplicative and additive noise
+         */
+        void setNoise(glm::vec2 signalStdDev);
+        
+        //! A method returning a pointer to the sonar data (8-bit intensity).
+        GLubyte* getOutputDataPointer();
+        
+        //! A method returning a pointer to the visualisation image (RGB).
+        GLubyte* getDisplayDataPointer();
+        
+        //! A static method mapping a sonar intensity to a color, the same way as the display shader.
+        /*!
+         \param value the normalised intensity
+         \param cm the color map
+         \param rgb a pointer to the output pixel (3 bytes)
+         */
+        static void MapColor(GLfloat value, ColorMap cm, GLubyte* rgb);
+        
+    protected:
+        GLfloat Gaussian(GLfloat mean, GLfloat stdDev);
+        GLfloat SampleOutput(GLfloat u, GLfloat v) const;
+        void TraceBeams(const RayTracingScene* scene, const Transform& sensorFrame, GLfloat maxRange);
+        
+        std::vector<glm::vec3> localDirs; //Ray directions in the sensor frame
+        std::vector<glm::vec3> worldDirs;
+        std::vector<RayHit> hits;
+        std::vector<GLfloat> echo; //Echo intensity of each ray
+        std::vector<GLubyte> output;
+        std::vector<GLubyte> display;
+        unsigned int outW;
+        unsigned int outH;
+        unsigned int dispW;
+        unsigned int dispH;
+        glm::vec2 noise;
+        ColorMap cMap;
+        
+    private:
+        RandomStream& randGen;
+        std::vector<Scalar> noiseBuffer; //Batch of normally distributed numbers, discarded at the start of every frame
+        size_t noiseIndex;
+    };
+}
+
+#endif
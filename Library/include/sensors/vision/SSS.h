@@ -33,6 +33,7 @@
 namespace sf
 {
     class OpenGLSSS;
+    class RayTracedSSS;
     
     //! A class representing a side-scan sonar.
     class SSS : public Camera
@@ -143,8 +144,10 @@ namespace sf
         
     private:
         void InitGraphics();
+        bool InitRayTracing();
         
         OpenGLSSS* glSSS;
+        RayTracedSSS* rtSSS;
         GLubyte* sonarData;
         GLubyte* displayData;
         glm::vec2 range;
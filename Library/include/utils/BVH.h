@@ -0,0 +1,126 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BVH.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_BVH__
+#define __Stonefish_BVH__
+
+#include "graphics/OpenGLDataStructs.h"
+
+#define RAY_PACKET_SIZE 8
+#define BVH_MAX_LEAF_SIZE 4
+#define BVH_MAX_DEPTH 48
+#define BVH_SAH_BINS 12
+
+namespace sf
+{
+    //! A structure representing a packet of rays traced together (structure of arrays).
+    struct RayPacket
+    {
+        GLfloat ox[RAY_PACKET_SIZE]; //Ray origins
+        GLfloat oy[RAY_PACKET_SIZE];
+        GLfloat oz[RAY_PACKET_SIZE];
+        GLfloat dx[RAY_PACKET_SIZE]; //Unit ray directions
+        GLfloat dy[RAY_PACKET_SIZE];
+        GLfloat dz[RAY_PACKET_SIZE];
+        GLfloat t[RAY_PACKET_SIZE]; //Maximum distance on input, distance to the closest hit on output (0 for unused rays)
+        GLfloat nx[RAY_PACKET_SIZE]; //Normal at the closest hit
+        GLfloat ny[RAY_PACKET_SIZE];
+        GLfloat nz[RAY_PACKET_SIZE];
+        GLint hit[RAY_PACKET_SIZE]; //Identifier of the hit object (-1 if nothing hit)
+    };
+    
+    //! A structure representing a node of the bounding volume hierarchy.
+    struct BVHNode
+    {
+        glm::vec3 aabbMin;
+        GLuint first; //First triangle (leaf) or first child (inner node)
+        glm::vec3 aabbMax;
+        GLuint count; //Number of triangles (0 for inner nodes)
+        GLuint axis; //Split axis
+    };
+    
+    //! A class implementing a bounding volume hierarchy of triangles, traversed with packets of rays.
+    class BVH
+    {
+    public:
+        //! A constructor building the hierarchy (binned SAH).
+        /*!
+         \param mesh a pointer to the triangle mesh
+         */
+        BVH(const Mesh* mesh);
+        
+        //! A method intersecting a packet of rays with the triangles.
+        /*!
+         The packet has to be expressed in the frame of the mesh. For each ray hitting a triangle
+         closer than its current distance, the distance, normal and hit identifier are overwritten.
+         \param packet a reference to the ray packet
+         \param id the identifier stored for the rays that hit
+         \return true if any of the rays hit a triangle
+         */
+        bool Intersect(RayPacket& packet, GLint id) const;
+        
+        //! A static method checking if any ray of the packet hits an axis-aligned box.
+        /*!
+         \param packet a reference to the ray packet
+         \param aabbMin the minimum corner of the box
+         \param aabbMax the maximum corner of the box
+         \return true if any of the rays hits the box closer than its current distance
+         */
+        static bool IntersectAABB(const RayPacket& packet, const glm::vec3& aabbMin, const glm::vec3& aabbMax);
+        
+        //! A method returning the bounding box of the hierarchy.
+        /*!
+         \param min a reference to a vector that will store the minimum corner
+         \param max a reference to a vector that will store the maximum corner
+         */
+        void getAABB(glm::vec3& min, glm::vec3& max) const;
+        
+        //! A method returning the number of triangles.
+        size_t getNumOfTriangles() const;
+        
+        //! A method returning the number of nodes.
+        size_t getNumOfNodes() const;
+        
+    private:
+        struct Triangle
+        {
+            glm::vec3 v0;
+            glm::vec3 e1;
+            glm::vec3 e2;
+            glm::vec3 n[3];
+        };
+        
+        static bool IntersectTriangle(RayPacket& packet, const Triangle& tri, GLint id);
+        void UpdateBounds(GLuint nodeId);
+        void Subdivide(GLuint nodeId, unsigned int depth);
+        
+        std::vector<BVHNode> nodes;
+        std::vector<Triangle> triangles;
+        std::vector<GLuint> triIds;
+        std::vector<glm::vec3> centroids;
+    };
+}
+
+#endif
@@ -65,6 +65,29 @@ namespace sf
      */
     Mesh* LoadOBJ(const std::string& path, GLfloat scale);
     
+    //! A function returning the number of bytes between the current position and the end of an open file.
+    /*!
+     \param file a pointer to the open file
+     \return the number of bytes left to read
+     */
+    uint64_t FileBytesLeft(FILE* file);
+    
+    //! A function to write a processed mesh to an open binary file.
+    /*!
+     \param file a pointer to the open file
+     \param mesh a pointer to the mesh structure
+     \return success
+     */
+    bool WriteMeshBinary(FILE* file, const Mesh* mesh);
+    
+    //! A function to read a processed mesh from an open binary file.
+    /*!
+     The number of vertices and faces is validated against the size of the file before allocating memory.
+     \param file a pointer to the open file
+     \return a pointer to an allocated mesh structure or nullptr if reading failed
+     */
+    Mesh* ReadMeshBinary(FILE* file);
+    
     //! A function to compute all physical properties of a mesh.
     /*!
      \param mesh a pointer to the mesh structure
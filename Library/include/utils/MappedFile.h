@@ -0,0 +1,68 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MappedFile.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_MappedFile__
+#define __Stonefish_MappedFile__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A class implementing a read-only memory mapping of a file.
+    /*!
+     On platforms without POSIX memory mapping the file is read into memory.
+     */
+    class MappedFile
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param path a path to the file
+         */
+        MappedFile(const std::string& path);
+        
+        //! A destructor.
+        ~MappedFile();
+        
+        //! A method returning a pointer to the file contents (nullptr if the file could not be mapped).
+        const char* getData() const;
+        
+        //! A method returning the size of the file [B].
+        size_t getSize() const;
+        
+        //! A method informing if the file was mapped successfully.
+        bool isOpen() const;
+        
+    private:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        const char* data;
+        size_t size;
+        std::vector<char> buffer; //Used when memory mapping is not available
+    };
+}
+
+#endif
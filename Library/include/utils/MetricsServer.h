@@ -0,0 +1,89 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MetricsServer.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_MetricsServer__
+#define __Stonefish_MetricsServer__
+
+#include <atomic>
+#include <SDL2/SDL_thread.h>
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    struct SimulationMetrics;
+    
+    //! A class implementing a background server publishing simulation metrics as a plain-text Prometheus page.
+    /*!
+     The server listens on a local TCP port or a Unix domain socket and answers every HTTP request with the current metrics.
+     All values are read from the lock-free counters of the simulation manager, so serving requests never blocks the simulation.
+     */
+    class MetricsServer
+    {
+    public:
+        //! A constructor of a server listening on the loopback interface.
+        /*!
+         \param port the TCP port
+         */
+        MetricsServer(uint16_t port);
+        
+        //! A constructor of a server listening on a Unix domain socket.
+        /*!
+         \param socketPath the path of the socket file
+         */
+        MetricsServer(const std::string& socketPath);
+        
+        //! A destructor.
+        ~MetricsServer();
+        
+        //! A method generating the metrics page.
+        /*!
+         Only counters and instantaneous values are exported, so that concurrent scrapers do not affect each other.
+         Rates (e.g. steps per second or the real-time factor) have to be computed by the monitoring system.
+         \return the page in the Prometheus text format
+         */
+        std::string GeneratePage();
+        
+        //! A method informing if the server is listening.
+        bool isRunning() const;
+        
+        //! A method returning the number of requests served.
+        uint64_t getRequestsCount() const;
+        
+    private:
+        void Start();
+        void Serve(int client);
+        static int RunServer(void* data);
+        static uint64_t getResidentMemory();
+        
+        const SimulationMetrics* metrics;
+        std::string socketPath;
+        int listenSocket;
+        SDL_Thread* thread;
+        std::atomic<bool> stop;
+        std::atomic<uint64_t> requests;
+    };
+}
+
+#endif
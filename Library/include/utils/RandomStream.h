@@ -0,0 +1,114 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RandomStream.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_RandomStream__
+#define __Stonefish_RandomStream__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A class implementing a counter-based random number generator (Philox4x32-10).
+    /*!
+     Each stream is defined by a 64-bit key and produces the output as a function of the key and a counter,
+     so streams derived from different keys are independent and the state is just a few integers.
+     The class fulfills the requirements of a uniform random bit generator and can be used with the standard distributions.
+     */
+    class RandomStream
+    {
+    public:
+        typedef uint32_t result_type;
+        
+        //! A constructor of a stream with the key derived from the global seed.
+        RandomStream();
+        
+        //! A constructor.
+        /*!
+         \param key the key of the stream
+         */
+        RandomStream(uint64_t key);
+        
+        //! A method to reset the stream using a key derived from a seed and a name.
+        /*!
+         \param seed the seed value
+         \param name the name of the owner of the stream
+         */
+        void Seed(uint64_t seed, const std::string& name);
+        
+        //! A method to reset the stream using a key.
+        /*!
+         \param key the key of the stream
+         */
+        void Seed(uint64_t key);
+        
+        //! An operator generating the next random number.
+        result_type operator()();
+        
+        //! A method filling an array with normally distributed random numbers.
+        /*!
+         The numbers are generated in batches using the Box-Muller transform, in loops suitable for vectorization.
+         Whole blocks of the stream are used, so the remaining numbers of the block being consumed by the operator are discarded.
+         \param out a pointer to the output array
+         \param n the number of values to generate
+         \param mean the mean of the distribution
+         \param stdDev the standard deviation of the distribution
+         */
+        void FillNormal(Scalar* out, size_t n, Scalar mean = Scalar(0), Scalar stdDev = Scalar(1));
+        
+        //! A method returning the key of the stream.
+        uint64_t getKey() const;
+        
+        //! A method returning the number of random numbers consumed since the last reset (including the ones discarded by FillNormal).
+        uint64_t getPosition() const;
+        
+        //! A method returning the minimum value generated.
+        static constexpr result_type min() { return 0; }
+        
+        //! A method returning the maximum value generated.
+        static constexpr result_type max() { return UINT32_MAX; }
+        
+        //! A static method to set the global seed used to derive the keys of the streams.
+        /*!
+         \param seed the seed value
+         */
+        static void setGlobalSeed(uint64_t seed);
+        
+        //! A static method returning the global seed.
+        static uint64_t getGlobalSeed();
+        
+    private:
+        void Generate();
+        void GenerateBlocks(uint64_t first, size_t nBlocks, uint32_t* out) const;
+        
+        uint32_t key[2];
+        uint64_t counter;
+        uint32_t block[4];
+        uint32_t index;
+        
+        static uint64_t globalSeed;
+    };
+}
+
+#endif
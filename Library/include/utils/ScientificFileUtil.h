@@ -129,6 +129,177 @@ namespace sf
         std::vector<ScientificDataItem*> items;
     };
     
+    //! An enum defining the storage types of Octave binary data.
+    enum class OctaveStorageType : uint8_t {UINT8 = 0, UINT16 = 1, UINT32 = 2, INT8 = 3, INT16 = 4, INT32 = 5, FLOAT = 6, DOUBLE = 7, UINT64 = 8, INT64 = 9};
+    
+    //! A class representing a read-only strided view of matrix data stored in a file buffer.
+    /*!
+     Elements are converted to Scalar on access, so the view works for all storage types and both byte orders without copying.
+     */
+    class ScientificDataView
+    {
+    public:
+        //! A constructor of an empty view.
+        ScientificDataView();
+        
+        //! A constructor.
+        /*!
+         \param data a pointer to the first element
+         \param rows the number of rows
+         \param cols the number of columns
+         \param rowStride the distance between consecutive rows [elements]
+         \param colStride the distance between consecutive columns [elements]
+         \param type the storage type of the elements
+         \param swapBytes a flag indicating that the byte order of the elements differs from the host
+         */
+        ScientificDataView(const char* data, unsigned int rows, unsigned int cols, int64_t rowStride, int64_t colStride, 
+                           OctaveStorageType type, bool swapBytes);
+        
+        //! An operator returning a single element.
+        /*!
+         \param row the index of the row
+         \param col the index of the column
+         \return the value of the element
+         */
+        Scalar operator()(unsigned int row, unsigned int col) const;
+        
+        //! An operator returning an element of a vector view (in column-major order for matrices).
+        /*!
+         \param i the index of the element
+         \return the value of the element
+         */
+        Scalar operator[](size_t i) const;
+        
+        //! A method returning a view of a single row.
+        ScientificDataView row(unsigned int r) const;
+        
+        //! A method returning a view of a single column.
+        ScientificDataView col(unsigned int c) const;
+        
+        //! A method returning a view of a block of the matrix.
+        /*!
+         \param r the first row of the block
+         \param c the first column of the block
+         \param nRows the number of rows of the block
+         \param nCols the number of columns of the block
+         \return the view of the block
+         */
+        ScientificDataView block(unsigned int r, unsigned int c, unsigned int nRows, unsigned int nCols) const;
+        
+        //! A method returning a transposed view.
+        ScientificDataView transposed() const;
+        
+        //! A method returning a pointer to the elements if they are contiguous, aligned doubles in host byte order (column-major).
+        const double* getDoubleData() const;
+        
+        //! A method copying the view to a matrix.
+        btMatrixXu toMatrix() const;
+        
+        //! A method copying the view to a vector (in column-major order for matrices).
+        btVectorXu toVector() const;
+        
+        //! A method returning the number of rows.
+        unsigned int rows() const;
+        
+        //! A method returning the number of columns.
+        unsigned int cols() const;
+        
+        //! A method returning the number of elements.
+        size_t size() const;
+        
+        //! A method returning the storage type of the elements.
+        OctaveStorageType getStorageType() const;
+        
+        //! A method returning the size of an element stored with a specified type [B].
+        static size_t getElementSize(OctaveStorageType type);
+        
+    private:
+        const char* data;
+        unsigned int nRows;
+        unsigned int nCols;
+        int64_t rowStride;
+        int64_t colStride;
+        OctaveStorageType type;
+        bool swap;
+    };
+    
+    class MappedFile;
+    
+    //! A class implementing a zero-copy reader of Octave binary files.
+    /*!
+     The file is memory-mapped and the data items are exposed as views into the mapping, which stay valid for the lifetime of the reader.
+     Both little and big-endian files are supported, with any integer or floating point storage type.
+     */
+    class MappedScientificData
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param path the path to the Octave binary file
+         */
+        MappedScientificData(const std::string& path);
+        
+        //! A destructor.
+        ~MappedScientificData();
+        
+        //! A method returning a view of a data item.
+        /*!
+         \param name the name of the item
+         \return the view of the item (empty if not found)
+         */
+        ScientificDataView getView(const std::string& name) const;
+        
+        //! A method returning the value of a scalar item (or the first element of a matrix).
+        /*!
+         \param name the name of the item
+         \return the value
+         */
+        Scalar getScalar(const std::string& name) const;
+        
+        //! A method returning the type of a data item.
+        /*!
+         \param name the name of the item
+         \param type a reference to the output type
+         \return true if the item was found
+         */
+        bool getItemType(const std::string& name, ScientificDataType& type) const;
+        
+        //! A method returning the name of a data item.
+        /*!
+         \param index the id of the data item on the list
+         \return the name of the item
+         */
+        std::string getItemName(unsigned int index) const;
+        
+        //! A method returning the total number of items.
+        unsigned int getItemsCount() const;
+        
+        //! A method copying all items to a data structure.
+        ScientificData* Load() const;
+        
+        //! A method informing if the file was opened and parsed successfully.
+        bool isOpen() const;
+        
+        //! A method informing if the file is stored in big-endian byte order.
+        bool isBigEndian() const;
+        
+    private:
+        struct Item
+        {
+            std::string name;
+            ScientificDataType type;
+            ScientificDataView view;
+        };
+        
+        bool Parse();
+        
+        std::string path;
+        MappedFile* file;
+        std::vector<Item> items;
+        bool bigEndian;
+        bool valid;
+    };
+    
     //! A function to load data from an Octave file.
     /*!
      \param path the path to the file
@@ -0,0 +1,253 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryBridge.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SharedMemoryBridge__
+#define __Stonefish_SharedMemoryBridge__
+
+#include <atomic>
+#include "StonefishCommon.h"
+
+#define SHM_BRIDGE_MAGIC    "SFSHM001"
+#define SHM_BRIDGE_VERSION  1
+#define SHM_BRIDGE_ALIGN    64 //Alignment of all blocks (cache line) [B]
+#define SHM_BRIDGE_NAME_LENGTH 48
+
+namespace sf
+{
+    //! An enum defining the kinds of shared memory channels.
+    enum class SharedMemoryKind : uint8_t {OUTPUT = 0, IMAGE = 1, INPUT = 2};
+    
+    //! An enum defining the pixel formats of image channels.
+    enum class SharedMemoryFormat : uint8_t {DOUBLE = 0, RGB8 = 1, FLOAT32 = 2};
+    
+    /*
+     Layout of the shared memory segment (native byte order, all blocks aligned to 64 bytes):
+     
+     SharedMemoryHeader
+     numChannels x SharedMemoryChannel
+     data blocks: for each channel slotCount x {SharedMemorySlot, payload of slotSize bytes}
+     
+     OUTPUT channels are rings of sensor samples (numValues doubles), IMAGE channels are rings of camera frames
+     (width x height pixels, row-major, RGB8 or FLOAT32) and INPUT channels hold a single slot of numValues doubles 
+     written by the controller (actuator setpoints, see SharedMemoryBridge::AddActuator).
+     
+     Every slot is protected by a sequence counter (seqlock). The writer of the n-th sample of a channel (n starting from 0)
+     uses the slot n % slotCount, sets its sequence to 2n+1, writes the payload, sets the sequence to 2n+2 and then the 
+     write count of the channel to n+1. A reader takes the write count, reads the slot in place and accepts the data
+     if the sequence was 2n+2 before and after reading. Inputs use the same protocol with a single slot.
+     
+     After publishing, the simulation increments the notify counter of the header, which is a futex word on Linux.
+     Readers may wait on it (incrementing the waiters counter while waiting), so that the wake-up call is skipped when nobody waits.
+     */
+    
+    //! A structure representing the header of the shared memory segment.
+    struct alignas(SHM_BRIDGE_ALIGN) SharedMemoryHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t numChannels;
+        uint64_t size; //Total size of the segment [B]
+        std::atomic<uint32_t> notify; //Incremented after publishing new data
+        std::atomic<uint32_t> waiters; //Number of readers waiting for notification
+        std::atomic<uint64_t> steps; //Number of completed simulation steps
+        std::atomic<uint64_t> time; //Simulation time of the last step (bits of a double) 
+        uint32_t writerPid;
+        uint32_t reserved;
+    };
+    
+    //! A structure representing the descriptor of a shared memory channel.
+    struct alignas(SHM_BRIDGE_ALIGN) SharedMemoryChannel
+    {
+        char name[SHM_BRIDGE_NAME_LENGTH]; //Null terminated
+        uint8_t kind; //SharedMemoryKind
+        uint8_t format; //SharedMemoryFormat
+        uint16_t numValues; //Number of doubles (OUTPUT and INPUT) or bytes per pixel (IMAGE)
+        uint32_t slotCount;
+        uint32_t width; //Image width [pix] (number of values otherwise)
+        uint32_t height; //Image height [pix] (1 otherwise)
+        uint64_t slotSize; //Size of the slot payload [B]
+        uint64_t offset; //Offset of the first slot from the beginning of the segment [B]
+        std::atomic<uint64_t> writeCount; //Number of published samples
+        uint64_t reserved[2];
+    };
+    
+    //! A structure representing the header of a slot.
+    struct alignas(SHM_BRIDGE_ALIGN) SharedMemorySlot
+    {
+        std::atomic<uint64_t> seq;
+        double time; //Simulation time of the sample [s]
+        uint64_t size; //Size of the valid payload [B]
+    };
+    
+    class Actuator;
+    class ScalarSensor;
+    class Sample;
+    class Camera;
+    
+    //! A class implementing a shared memory bridge between the simulation and controllers running in other processes on the same host.
+    /*!
+     Sensor samples and camera frames are written to POSIX shared memory rings when they are produced and actuator setpoints
+     are read from the shared memory before every simulation step, so that a co-located controller can read and write data in place,
+     without serialization or sockets. Channels have to be added and the segment created with Open before the simulation is started
+     (nothing is exchanged until then). The bridge attaches itself to the simulation manager of the running application.
+     Detach has to be called before the bridged objects are destroyed (e.g. before the scenario is torn down).
+     Use SharedMemoryClient in the controller process.
+     */
+    class SharedMemoryBridge
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param name the name of the shared memory segment (e.g. "/stonefish")
+         \param slotCount the number of slots in every output ring
+         */
+        SharedMemoryBridge(const std::string& name, unsigned int slotCount = 4);
+        
+        //! A destructor (removes the shared memory segment).
+        ~SharedMemoryBridge();
+        
+        //! A method uninstalling the data handlers of the bridged sensors and detaching the bridge from the simulation manager.
+        void Detach();
+        
+        //! A method to publish the samples of a scalar sensor.
+        /*!
+         \param sensor a pointer to the sensor (must not have a new data handler installed)
+         \return the id of the created channel or -1 if failed
+         */
+        int AddSensor(ScalarSensor* sensor);
+        
+        //! A method to publish the frames of a color or depth camera.
+        /*!
+         \param camera a pointer to the camera (must not have a new data handler installed)
+         \return the id of the created channel or -1 if failed
+         */
+        int AddCamera(Camera* camera);
+        
+        //! A method to receive the setpoints of an actuator.
+        /*!
+         The input holds the values of the actuator channels defined as in RemoteControlServer 
+         (main setpoint, and servo velocity, maximum torque and control mode). NaN values are ignored.
+         \param actuator a pointer to the actuator
+         \return the id of the created channel or -1 if failed
+         */
+        int AddActuator(Actuator* actuator);
+        
+        //! A method to add a custom output channel.
+        /*!
+         \param name the name of the channel
+         \param numValues the number of values of a sample
+         \return the id of the created channel or -1 if failed
+         */
+        int AddOutput(const std::string& name, unsigned int numValues);
+        
+        //! A method to add a custom input channel.
+        /*!
+         \param name the name of the channel
+         \param numValues the number of values
+         \return the id of the created channel or -1 if failed
+         */
+        int AddInput(const std::string& name, unsigned int numValues);
+        
+        //! A method to add all scalar sensors, color and depth cameras and supported actuators of the simulation.
+        void AddAll();
+        
+        //! A method creating the shared memory segment, to be called before the simulation is started (no channels can be added afterwards).
+        /*!
+         \return success
+         */
+        bool Open();
+        
+        //! A method publishing a sample of an output channel.
+        /*!
+         \param channel the id of the channel
+         \param time the simulation time of the sample [s]
+         \param values a pointer to the values
+         */
+        void Publish(int channel, Scalar time, const double* values);
+        
+        //! A method reading the values of an input channel.
+        /*!
+         \param channel the id of the channel
+         \param values a pointer to the output buffer
+         \return true if new values were written by the controller since the last call
+         */
+        bool Receive(int channel, double* values);
+        
+        //! A method waking up the readers waiting for new data.
+        void Notify();
+        
+        //! A method called by the simulation manager before every step to apply the actuator setpoints (only if the segment is open).
+        void StepStarted();
+        
+        //! A method called by the simulation manager after every step to notify the readers.
+        /*!
+         \param time the simulation time [s]
+         */
+        void StepCompleted(Scalar time);
+        
+        //! A method returning the name of the shared memory segment.
+        std::string getName() const;
+        
+        //! A method informing if the shared memory segment was created.
+        bool isOpen() const;
+        
+        //! A method returning the size of the shared memory segment [B].
+        size_t getSize() const;
+        
+    private:
+        struct Source
+        {
+            std::string name;
+            SharedMemoryKind kind;
+            SharedMemoryFormat format;
+            unsigned int numValues;
+            unsigned int slotCount;
+            unsigned int width;
+            unsigned int height;
+            uint64_t slotSize;
+            void* object;
+            uint64_t lastRead; //Write count of the input when last applied
+        };
+        
+        int AddChannel(const std::string& name, SharedMemoryKind kind, SharedMemoryFormat format, unsigned int numValues, 
+                       unsigned int width, unsigned int height, unsigned int slots, void* object);
+        uint8_t* BeginWrite(int channel, Scalar time, size_t size);
+        void EndWrite(int channel);
+        void PublishSample(int channel, const Sample& s);
+        void PublishFrame(int channel, Camera* camera);
+        
+        std::string name;
+        unsigned int slotCount;
+        std::vector<Source> sources;
+        int fd;
+        uint8_t* segment;
+        size_t size;
+        SharedMemoryHeader* header;
+        SharedMemoryChannel* channels;
+        std::atomic<bool> opened; //Cameras publish from the rendering thread
+    };
+}
+
+#endif
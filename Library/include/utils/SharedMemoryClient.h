@@ -0,0 +1,144 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryClient.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SharedMemoryClient__
+#define __Stonefish_SharedMemoryClient__
+
+#include "utils/SharedMemoryBridge.h"
+
+namespace sf
+{
+    //! A class implementing the controller side of the shared memory bridge.
+    /*!
+     The client maps the segment created by SharedMemoryBridge. Outputs can be read in place (BeginRead/EndRead) 
+     or copied (Read), inputs are written with WriteInput. A single client process should write each input.
+     */
+    class SharedMemoryClient
+    {
+    public:
+        //! A constructor.
+        SharedMemoryClient();
+        
+        //! A destructor.
+        ~SharedMemoryClient();
+        
+        //! A method mapping a shared memory segment created by the simulation.
+        /*!
+         \param name the name of the shared memory segment
+         \return success
+         */
+        bool Open(const std::string& name);
+        
+        //! A method unmapping the shared memory segment.
+        void Close();
+        
+        //! A method returning the index of a channel.
+        /*!
+         \param name the name of the channel
+         \return the index of the channel or -1 if not found
+         */
+        int getChannelIndex(const std::string& name) const;
+        
+        //! A method returning the descriptor of a channel.
+        /*!
+         \param channel the index of the channel
+         \return a pointer to the descriptor or nullptr if the channel does not exist
+         */
+        const SharedMemoryChannel* getChannel(int channel) const;
+        
+        //! A method returning the number of channels.
+        unsigned int getNumOfChannels() const;
+        
+        //! A method returning a pointer to the latest sample of an output channel, without copying.
+        /*!
+         \param channel the index of the channel
+         \param seq a reference to the sequence number which has to be passed to EndRead
+         \param time an optional pointer to the output simulation time of the sample [s]
+         \return a pointer to the payload or nullptr if no sample was published
+         */
+        const uint8_t* BeginRead(int channel, uint64_t& seq, double* time = nullptr) const;
+        
+        //! A method checking if the sample read in place was not overwritten during reading.
+        /*!
+         \param channel the index of the channel
+         \param seq the sequence number returned by BeginRead
+         \return true if the data read is consistent
+         */
+        bool EndRead(int channel, uint64_t seq) const;
+        
+        //! A method copying the latest sample of an output channel.
+        /*!
+         \param channel the index of the channel
+         \param dst a pointer to the output buffer (at least slotSize bytes)
+         \param time an optional pointer to the output simulation time of the sample [s]
+         \return true if a consistent sample was copied
+         */
+        bool Read(int channel, void* dst, double* time = nullptr) const;
+        
+        //! A method writing the values of an input channel.
+        /*!
+         \param channel the index of the channel
+         \param values a pointer to the values (numValues doubles)
+         \return success
+         */
+        bool WriteInput(int channel, const double* values);
+        
+        //! A method waiting for a notification from the simulation.
+        /*!
+         \param lastNotify the value of the notification counter seen last time
+         \param timeout the maximum waiting time [ms]
+         \return true if new data was published since the last notification
+         */
+        bool Wait(uint32_t lastNotify, int timeout);
+        
+        //! A method returning the current value of the notification counter.
+        uint32_t getNotifyCounter() const;
+        
+        //! A method returning the number of samples published in a channel.
+        /*!
+         \param channel the index of the channel
+         */
+        uint64_t getWriteCount(int channel) const;
+        
+        //! A method returning the number of simulation steps completed.
+        uint64_t getSteps() const;
+        
+        //! A method returning the simulation time of the last step [s].
+        double getSimulationTime() const;
+        
+        //! A method informing if the segment is mapped.
+        bool isOpen() const;
+        
+    private:
+        SharedMemorySlot* getSlot(int channel, uint64_t index) const;
+        
+        uint8_t* segment;
+        size_t size;
+        SharedMemoryHeader* header;
+        SharedMemoryChannel* channels;
+    };
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SocketUtil.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_SocketUtil__
+#define __Stonefish_SocketUtil__
+
+#include "StonefishCommon.h"
+
+namespace sf
+{
+    //! A function informing if local sockets are supported on the current platform.
+    bool SocketsSupported();
+    
+    //! A function opening a TCP socket listening on the loopback interface.
+    /*!
+     \param port the TCP port
+     \return the socket descriptor or -1 if failed
+     */
+    int OpenServerSocket(uint16_t port);
+    
+    //! A function opening a Unix domain socket listening for connections (an existing socket file is replaced).
+    /*!
+     \param path the path of the socket file
+     \return the socket descriptor or -1 if failed
+     */
+    int OpenServerSocket(const std::string& path);
+    
+    //! A function connecting to a TCP socket on the loopback interface.
+    /*!
+     \param port the TCP port
+     \return the socket descriptor or -1 if failed
+     */
+    int ConnectSocket(uint16_t port);
+    
+    //! A function connecting to a Unix domain socket.
+    /*!
+     \param path the path of the socket file
+     \return the socket descriptor or -1 if failed
+     */
+    int ConnectSocket(const std::string& path);
+    
+    //! A function waiting for a connection to a server socket.
+    /*!
+     \param serverSocket the listening socket
+     \param timeout the maximum waiting time [ms]
+     \return the socket descriptor of the connection or -1 if no connection was made
+     */
+    int AcceptConnection(int serverSocket, int timeout);
+    
+    //! A function waiting until data can be read from a socket.
+    /*!
+     \param socket the socket descriptor
+     \param timeout the maximum waiting time [ms]
+     \return true if data is available or the connection was closed
+     */
+    bool WaitForData(int socket, int timeout);
+    
+    //! A function setting the timeouts of the blocking send and receive operations.
+    /*!
+     \param socket the socket descriptor
+     \param timeout the timeout [ms] (0 means no timeout)
+     */
+    void SetSocketTimeout(int socket, int timeout);
+    
+    //! A function sending a block of data (without raising signals if the connection is closed).
+    /*!
+     \param socket the socket descriptor
+     \param data a pointer to the data
+     \param size the size of the data [B]
+     \return true if all data was sent
+     */
+    bool SendAll(int socket, const void* data, size_t size);
+    
+    //! A function receiving a block of data.
+    /*!
+     \param socket the socket descriptor
+     \param data a pointer to the buffer
+     \param size the size of the data [B]
+     \return true if all data was received
+     */
+    bool ReceiveAll(int socket, void* data, size_t size);
+    
+    //! A function receiving available data (at most the size of the buffer).
+    /*!
+     \param socket the socket descriptor
+     \param data a pointer to the buffer
+     \param size the size of the buffer [B]
+     \return the number of bytes received (0 if the connection was closed, negative on error)
+     */
+    int64_t ReceiveSome(int socket, void* data, size_t size);
+    
+    //! A function closing a socket.
+    /*!
+     \param socket the socket descriptor
+     */
+    void CloseSocket(int socket);
+}
+
+#endif
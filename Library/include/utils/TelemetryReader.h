@@ -0,0 +1,143 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TelemetryReader.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_TelemetryReader__
+#define __Stonefish_TelemetryReader__
+
+#include <functional>
+#include "utils/TelemetryRecorder.h"
+#include "utils/MappedFile.h"
+
+namespace sf
+{
+    //! A structure representing a single telemetry record (pointing into the mapped file).
+    struct TelemetryRecord
+    {
+        uint16_t channel;
+        TelemetryKind kind;
+        uint8_t flags;
+        double time;
+        const double* values; //Values of SENSOR, BODY and ACTUATOR records
+        unsigned int numValues;
+        const TelemetryCommEvent* comm; //Event of COMM records
+        const char* data; //Message data of COMM records (comm->dataLength bytes)
+    };
+    
+    //! A class implementing a reader of telemetry logs written by TelemetryRecorder.
+    /*!
+     The log is memory-mapped and records are returned in place, without copying. Seeking uses the chunk index stored at the end
+     of the file; if it is missing (recording interrupted) the index is rebuilt by scanning the chunks, skipping an incomplete last chunk.
+     */
+    class TelemetryReader
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param path a path to the telemetry log
+         */
+        TelemetryReader(const std::string& path);
+        
+        //! A destructor.
+        ~TelemetryReader();
+        
+        //! A method iterating over the records of a channel in a time range.
+        /*!
+         \param channel the id of the channel (-1 for all channels)
+         \param startTime the start of the time range [s]
+         \param endTime the end of the time range [s]
+         \param callback a function called for every record (returning false stops the iteration)
+         \return the number of visited records
+         */
+        size_t ForEachRecord(int channel, double startTime, double endTime, std::function<bool(const TelemetryRecord&)> callback) const;
+        
+        //! A method returning the records of a channel in a time range.
+        /*!
+         \param channel the id of the channel (-1 for all channels)
+         \param startTime the start of the time range [s]
+         \param endTime the end of the time range [s]
+         \return a list of records
+         */
+        std::vector<TelemetryRecord> getRecords(int channel, double startTime = -BT_LARGE_FLOAT, double endTime = BT_LARGE_FLOAT) const;
+        
+        //! A method finding the first record of a channel at or after a specified time.
+        /*!
+         \param channel the id of the channel
+         \param time the simulation time [s]
+         \param record a reference to the output record
+         \return true if the record was found
+         */
+        bool FindRecord(int channel, double time, TelemetryRecord& record) const;
+        
+        //! A method converting channels to an Octave file (one matrix per channel, with the time in the first column).
+        /*!
+         SENSOR matrices have the same layout as the ones written by ScalarSensor::SaveMeasurementsToOctaveFile.
+         COMM matrices contain the time, the direction (1 for received), sequence, source, destination, frame time and data length.
+         \param path a path to the output file
+         \param channels names of the channels to convert (all if empty)
+         \return success
+         */
+        bool ExportToOctaveFile(const std::string& path, const std::vector<std::string>& channels = std::vector<std::string>()) const;
+        
+        //! A method returning the id of a channel.
+        /*!
+         \param name the name of the channel
+         \return the id of the channel or -1 if not found
+         */
+        int getChannelId(const std::string& name) const;
+        
+        //! A method returning the channel descriptions.
+        const std::vector<TelemetryChannel>& getChannels() const;
+        
+        //! A method returning the time range covered by the log.
+        /*!
+         \param start a reference to the output start time [s]
+         \param end a reference to the output end time [s]
+         */
+        void getTimeRange(double& start, double& end) const;
+        
+        //! A method returning the number of chunks in the log.
+        size_t getNumOfChunks() const;
+        
+        //! A method informing if the index had to be rebuilt.
+        bool isRecovered() const;
+        
+        //! A method informing if the log was opened successfully.
+        bool isOpen() const;
+        
+    private:
+        bool ParseSchema();
+        void LoadIndex();
+        
+        MappedFile* file;
+        const char* data;
+        size_t size;
+        uint64_t chunksOffset;
+        std::vector<TelemetryChannel> channels;
+        std::vector<TelemetryIndexEntry> index;
+        bool recovered;
+    };
+}
+
+#endif
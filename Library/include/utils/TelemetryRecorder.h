@@ -0,0 +1,288 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TelemetryRecorder.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_TelemetryRecorder__
+#define __Stonefish_TelemetryRecorder__
+
+#include <cstdio>
+#include <deque>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+#include "StonefishCommon.h"
+
+#define TELEMETRY_FILE_MAGIC    "SFTLM001"
+#define TELEMETRY_CHUNK_MAGIC   "CHNK"
+#define TELEMETRY_INDEX_MAGIC   "SFTLMIDX"
+#define TELEMETRY_VERSION       1
+
+namespace sf
+{
+    //! An enum defining the kinds of telemetry channels.
+    enum class TelemetryKind : uint8_t {SENSOR = 0, BODY = 1, ACTUATOR = 2, COMM = 3};
+    
+    //! A structure describing a telemetry channel.
+    struct TelemetryChannel
+    {
+        uint16_t id;
+        TelemetryKind kind;
+        std::string name;
+        std::vector<std::string> valueNames; //Names of the values stored in each record (empty for comm channels)
+    };
+    
+    /*
+     On-disk layout of a telemetry log (native byte order, all blocks 8-byte aligned so that records can be read in place):
+     
+     TelemetryFileHeader
+     schema: for each channel {uint16 id, uint8 kind, uint8 0, uint16 numValues, uint16 nameLength, name,
+                               numValues x {uint16 length, value name}}, zero padded to 8 bytes
+     chunks: TelemetryChunkHeader followed by numRecords x {TelemetryRecordHeader, payload}
+     index:  numChunks x TelemetryIndexEntry
+     TelemetryFileFooter
+     
+     Payloads: SENSOR, BODY and ACTUATOR records store numValues doubles. BODY values are the position [m] and orientation
+     quaternion (x,y,z,w) of the body origin, the linear velocity [m/s] and the angular velocity [rad/s], all in the world frame.
+     COMM records store TelemetryCommEvent followed by the message data (flag bit 0 set for received messages).
+     If the footer is missing (e.g. after a crash) the index can be rebuilt by scanning the chunks.
+     */
+    
+    //! A structure representing the header of a telemetry file.
+    struct TelemetryFileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t numChannels;
+        uint64_t schemaSize;
+        uint64_t reserved;
+    };
+    
+    //! A structure representing the header of a chunk of records.
+    struct TelemetryChunkHeader
+    {
+        char magic[4];
+        uint32_t numRecords;
+        uint64_t size; //Size of the records following the header [B]
+        double startTime;
+        double endTime;
+        uint64_t channelMask; //Bit of every channel with records in the chunk (see TelemetryChannelBit)
+    };
+    
+    //! A function returning the bit of a channel in the channel mask of a chunk (channels above 62 share the last bit).
+    inline uint64_t TelemetryChannelBit(unsigned int channel) { return (uint64_t)1 << (channel < 63 ? channel : 63); }
+    
+    //! A structure representing the header of a single record.
+    struct TelemetryRecordHeader
+    {
+        uint16_t channel;
+        uint8_t kind;
+        uint8_t flags;
+        uint32_t size; //Size of the payload (multiple of 8) [B]
+        double time;
+    };
+    
+    //! A structure representing the fixed part of a comm event payload.
+    struct TelemetryCommEvent
+    {
+        uint64_t seq;
+        uint64_t source;
+        uint64_t destination;
+        double frameTime;
+        uint32_t dataLength;
+        uint32_t reserved;
+    };
+    
+    //! A structure representing an entry of the chunk index.
+    struct TelemetryIndexEntry
+    {
+        uint64_t offset; //Offset of the chunk header in the file [B]
+        uint64_t size; //Size of the chunk including the header [B]
+        double startTime;
+        double endTime;
+        uint64_t channelMask;
+        uint32_t numRecords;
+        uint32_t reserved;
+    };
+    
+    //! A structure representing the footer of a telemetry file.
+    struct TelemetryFileFooter
+    {
+        uint64_t indexOffset;
+        uint64_t numChunks;
+        char magic[8];
+    };
+    
+    //! A structure holding the statistics of a telemetry recorder.
+    struct TelemetryStatistics
+    {
+        uint64_t records; //Records captured
+        uint64_t droppedRecords; //Records lost because the write queue was full
+        uint64_t chunks; //Chunks written to disk
+        uint64_t bytesWritten; //Total size of the written data [B]
+        unsigned int queuePeak; //Maximum number of chunks waiting for writing
+        
+        TelemetryStatistics()
+        {
+            records = droppedRecords = chunks = bytesWritten = 0;
+            queuePeak = 0;
+        }
+    };
+    
+    class Entity;
+    class Actuator;
+    class ScalarSensor;
+    class Sample;
+    class Comm;
+    struct CommDataFrame;
+    
+    //! A class implementing a streaming binary recorder of sensor samples, body states, actuator setpoints and comm events.
+    /*!
+     Records are appended to a fixed-size chunk buffer on the simulation thread and complete chunks are written to disk
+     by a background thread, so memory use is bounded by the chunk size and the queue capacity, independently of the duration
+     of the simulation. Records captured while all chunk buffers are waiting for writing are dropped and counted. Sensor samples and comm events are recorded
+     when they are produced (through the handlers installed by the recorder), body and actuator states after every simulation step
+     (or at the state rate). Channels have to be added before the first record is captured. The recorder attaches itself to
+     the simulation manager of the running application. Detach has to be called before the recorded objects are destroyed.
+     Use TelemetryReader to read the logs.
+     */
+    class TelemetryRecorder
+    {
+    public:
+        //! A constructor.
+        /*!
+         \param path a path to the output file
+         \param chunkSize the size of a chunk of records [B]
+         \param queueCapacity the maximum number of allocated chunks (being filled, waiting for writing or written)
+         \param chunkDuration the maximum simulation time span of a chunk [s]
+         */
+        TelemetryRecorder(const std::string& path, size_t chunkSize = 1 << 20, unsigned int queueCapacity = 8, Scalar chunkDuration = Scalar(10));
+        
+        //! A destructor (writes all captured records, the index and the footer).
+        ~TelemetryRecorder();
+        
+        //! A method uninstalling the handlers of the recorded sensors and comms and detaching the recorder from the simulation manager.
+        void Detach();
+        
+        //! A method to record the samples of a scalar sensor.
+        /*!
+         \param sensor a pointer to the sensor (without a data handler)
+         \return the id of the created channel or -1 if failed
+         */
+        int AddSensor(ScalarSensor* sensor);
+        
+        //! A method to record the state of a moving body or the base of a multibody.
+        /*!
+         \param entity a pointer to a solid, animated or Featherstone entity
+         \return the id of the created channel or -1 if failed
+         */
+        int AddBody(Entity* entity);
+        
+        //! A method to record the state of a thruster, propeller, rudder or servo.
+        /*!
+         \param actuator a pointer to the actuator
+         \return the id of the created channel or -1 if failed
+         */
+        int AddActuator(Actuator* actuator);
+        
+        //! A method to record the messages sent and received by a comm device.
+        /*!
+         \param comm a pointer to the comm (without an event handler)
+         \return the id of the created channel or -1 if failed
+         */
+        int AddComm(Comm* comm);
+        
+        //! A method to add all scalar sensors, moving bodies, supported actuators and comms of the simulation (skipping sensors and comms with handlers).
+        void AddAll();
+        
+        //! A method called by the simulation manager after every step to capture body and actuator states.
+        /*!
+         \param time the simulation time [s]
+         */
+        void StepCompleted(Scalar time);
+        
+        //! A method that hands the current chunk over to the writer and waits until all chunks are written.
+        void Flush();
+        
+        //! A method to set the rate at which body and actuator states are recorded.
+        /*!
+         \param hz the recording rate [Hz] (0 means every simulation step)
+         */
+        void setStateRate(Scalar hz);
+        
+        //! A method returning the channel descriptions.
+        std::vector<TelemetryChannel> getChannels() const;
+        
+        //! A method returning the recorder statistics.
+        TelemetryStatistics getStatistics();
+        
+        //! A method informing if the output file was opened successfully.
+        bool isOpen() const;
+        
+    private:
+        struct Source
+        {
+            TelemetryChannel channel;
+            void* object;
+        };
+        
+        struct Chunk
+        {
+            std::vector<char> data;
+            TelemetryChunkHeader header;
+        };
+        
+        int AddChannel(TelemetryKind kind, const std::string& name, const std::vector<std::string>& valueNames, void* object);
+        void WriteSchema();
+        char* BeginRecord(uint16_t channel, TelemetryKind kind, uint8_t flags, size_t payloadSize, Scalar time);
+        void SubmitChunk();
+        void RecordSample(uint16_t channel, const Sample& s);
+        void RecordCommEvent(uint16_t channel, const CommDataFrame* frame, bool received);
+        static int RunWriter(void* data);
+        
+        std::string path;
+        FILE* file;
+        size_t chunkSize;
+        unsigned int queueCapacity;
+        Scalar chunkDuration;
+        Scalar stateInterval;
+        Scalar lastStateTime;
+        bool started;
+        std::vector<Source> sources;
+        Chunk* current;
+        std::deque<Chunk*> queue;
+        std::vector<Chunk*> freeChunks;
+        unsigned int allocatedChunks;
+        unsigned int busy;
+        bool stop;
+        SDL_Thread* writer;
+        SDL_mutex* captureMutex;
+        SDL_mutex* queueMutex;
+        SDL_cond* chunkAvailable;
+        SDL_cond* chunksDone;
+        std::vector<TelemetryIndexEntry> index;
+        uint64_t fileOffset;
+        TelemetryStatistics stats;
+    };
+}
+
+#endif
@@ -0,0 +1,163 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ZoneProfiler.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish_ZoneProfiler__
+#define __Stonefish_ZoneProfiler__
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+//! A macro opening a profiling zone lasting until the end of the scope (name has to be a string literal).
+#define PROFILE_ZONE(name) sf::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+//! A macro opening a profiling zone with a detail string (e.g. entity name, has to be persistent, see ZoneProfiler::Intern).
+#define PROFILE_ZONE_DETAIL(name, detail) sf::ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name, detail)
+
+namespace sf
+{
+    //! A structure representing a completed profiling zone.
+    struct ProfileEvent
+    {
+        const char* name;
+        const char* detail;
+        int64_t start; //[ns]
+        int64_t duration; //[ns]
+        int64_t self; //Duration excluding nested zones [ns]
+        uint32_t depth;
+    };
+    
+    //! A structure holding aggregated timing of a profiling zone.
+    struct ProfileSummary
+    {
+        std::string name;
+        std::string detail;
+        uint64_t calls;
+        double total; //[ms]
+        double self; //[ms]
+        double max; //[us]
+    };
+    
+    //! A static class implementing a hierarchical scoped-zone profiler.
+    /*!
+     Every thread records completed zones into its own ring buffer, written without locks. When the profiler is disabled
+     opening a zone costs a single relaxed atomic load. When enabled, the internal profiling zones of Bullet
+     (broadphase, narrowphase, solver...) are recorded as well. Ring buffers keep the most recent events,
+     which can be exported to the Chrome trace format (chrome://tracing, Perfetto) or aggregated into a summary table.
+     Export while zones are being recorded may include events being overwritten, so it is best done with the simulation stopped.
+     */
+    class ZoneProfiler
+    {
+    public:
+        //! A method to enable or disable profiling at runtime.
+        /*!
+         \param en a flag specifying if zones should be recorded
+         */
+        static void setEnabled(bool en);
+        
+        //! A method informing if profiling is enabled.
+        static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+        
+        //! A method to set the number of events kept per thread (applies to threads that did not record yet and after Clear).
+        /*!
+         \param n the number of events (rounded up to a power of two)
+         */
+        static void setBufferCapacity(size_t n);
+        
+        //! A method to set the name of the calling thread, used in the exported trace.
+        /*!
+         \param name the name of the thread
+         */
+        static void setThreadName(const std::string& name);
+        
+        //! A method opening a zone on the calling thread.
+        /*!
+         \param name the name of the zone (has to outlive the profiler data)
+         \param detail an optional detail string (has to outlive the profiler data)
+         */
+        static void Begin(const char* name, const char* detail = nullptr);
+        
+        //! A method closing the last opened zone on the calling thread.
+        static void End();
+        
+        //! A method returning a persistent copy of a string, to be used as a zone detail.
+        /*!
+         \param str the string to intern
+         \return a pointer to a null-terminated string valid until the end of the program
+         */
+        static const char* Intern(const std::string& str);
+        
+        //! A method to discard all recorded events.
+        static void Clear();
+        
+        //! A method to export recorded events in the Chrome trace format.
+        /*!
+         \param path a path to the output JSON file
+         \return success
+         */
+        static bool ExportChromeTrace(const std::string& path);
+        
+        //! A method returning the recorded events aggregated by zone name and detail, sorted by total time.
+        static std::vector<ProfileSummary> getSummary();
+        
+        //! A method returning the summary formatted as a text table.
+        static std::string getSummaryTable();
+        
+    private:
+        ZoneProfiler() {}
+        static void BulletEnter(const char* name);
+        static void BulletLeave();
+        
+        static std::atomic<bool> enabled;
+    };
+    
+    //! A class representing a scoped profiling zone.
+    class ProfileZone
+    {
+    public:
+        //! A constructor opening the zone.
+        /*!
+         \param name the name of the zone
+         \param detail an optional detail string
+         */
+        ProfileZone(const char* name, const char* detail = nullptr) : active(ZoneProfiler::isEnabled())
+        {
+            if(active) ZoneProfiler::Begin(name, detail);
+        }
+        
+        //! A destructor closing the zone.
+        ~ProfileZone()
+        {
+            if(active) ZoneProfiler::End();
+        }
+        
+    private:
+        bool active;
+    };
+}
+
+#endif
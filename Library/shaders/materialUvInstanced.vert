@@ -0,0 +1,62 @@
+/*    
+    Copyright (c) 2026 agent. All rights reserved.
+
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#version 430
+
+layout(location = 0) in vec3 vt;
+layout(location = 1) in vec3 n;
+layout(location = 2) in vec2 uv;
+layout(location = 3) in vec3 t;
+
+struct Instance
+{
+    mat4 M;
+    mat4 N;
+};
+
+layout(std430, binding = 11) readonly buffer Instances
+{
+    Instance instances[];
+};
+
+out vec3 normal;
+out mat3 TBN;
+out vec2 texCoord;
+out vec4 fragPos;
+out vec3 eyeSpaceNormal;
+out float logz;
+
+uniform mat4 VP;
+uniform mat3 V;
+uniform float FC;
+
+void main()
+{
+    mat3 N = mat3(instances[gl_InstanceID].N);
+	normal = normalize(N * n);
+    vec3 tangent = normalize(N * t);
+    vec3 bitangent = cross(normal, tangent);
+    TBN = mat3(tangent, bitangent, normal);
+	eyeSpaceNormal = normalize(V * normal);
+	texCoord = uv;
+	fragPos = instances[gl_InstanceID].M * vec4(vt, 1.0);
+	gl_Position = VP * fragPos; 
+    gl_Position.z = log2(max(1e-6, 1.0 + gl_Position.w)) * 2.0 * FC - 1.0;
+    logz = 1.0 + gl_Position.w;
+}
@@ -0,0 +1,40 @@
+/*    
+    Copyright (c) 2026 agent. All rights reserved.
+
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#version 430
+
+layout(location = 0) in vec3 vertex;
+
+struct Instance
+{
+    mat4 M;
+    mat4 N;
+};
+
+layout(std430, binding = 11) readonly buffer Instances
+{
+    Instance instances[];
+};
+
+uniform mat4 VP;
+
+void main()
+{
+	gl_Position = VP * instances[gl_InstanceID].M * vec4(vertex, 1.0);
+}
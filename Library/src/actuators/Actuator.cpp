@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/ZoneProfiler.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -35,6 +36,7 @@ namespace sf
 Actuator::Actuator(std::string uniqueName)
 {
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
+    zoneName = ZoneProfiler::Intern(name);
     dm = DisplayMode::GRAPHICAL;
 }
 
@@ -54,10 +56,23 @@ std::string Actuator::getName() const
     return name;
 }
 
+const char* Actuator::getZoneName() const
+{
+    return zoneName;
+}
+
 std::vector<Renderable> Actuator::Render()
 {
     std::vector<Renderable> items(0);
     return items;
 }
 
+void Actuator::SaveState(SimulationState& state)
+{
+}
+
+void Actuator::RestoreState(SimulationState& state)
+{
+}
+
 }
@@ -25,6 +25,8 @@
 
 #include "actuators/DCMotor.h"
 
+#include "core/SimulationState.h"
+
 namespace sf
 {
 
@@ -131,4 +133,20 @@ void DCMotor::SetupGearbox(bool enable, Scalar ratio, Scalar efficiency)
     gearEff = efficiency > 0.0 ? (efficiency <= 1.0 ? efficiency : 1.0) : 1.0;
 }
 
+void DCMotor::SaveState(SimulationState& state)
+{
+    Motor::SaveState(state);
+    state.Write(V);
+    state.Write(I);
+    state.Write(lastVoverL);
+}
+
+void DCMotor::RestoreState(SimulationState& state)
+{
+    Motor::RestoreState(state);
+    state.Read(V);
+    state.Read(I);
+    state.Read(lastVoverL);
+}
+
 }
\ No newline at end of file
@@ -25,6 +25,8 @@
 
 #include "actuators/Motor.h"
 
+#include "core/SimulationState.h"
+
 #include "joints/RevoluteJoint.h"
 #include "entities/FeatherstoneEntity.h"
 
@@ -101,4 +103,14 @@ void Motor::Update(Scalar dt)
         fe->DriveJoint(jId, torque);
 }
 
+void Motor::SaveState(SimulationState& state)
+{
+    state.Write(torque);
+}
+
+void Motor::RestoreState(SimulationState& state)
+{
+    state.Read(torque);
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
@@ -172,4 +173,25 @@ std::vector<Renderable> Propeller::Render()
     return items;
 }
     
+
+void Propeller::SaveState(SimulationState& state)
+{
+    state.Write(theta);
+    state.Write(omega);
+    state.Write(thrust);
+    state.Write(torque);
+    state.Write(setpoint);
+    state.Write(iError);
+}
+
+void Propeller::RestoreState(SimulationState& state)
+{
+    state.Read(theta);
+    state.Read(omega);
+    state.Read(thrust);
+    state.Read(torque);
+    state.Read(setpoint);
+    state.Read(iError);
+}
+
 }
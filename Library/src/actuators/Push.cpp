@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 
 namespace sf
 {
@@ -107,4 +108,15 @@ std::vector<Renderable> Push::Render()
     return items;
 }
     
+
+void Push::SaveState(SimulationState& state)
+{
+    state.Write(setpoint);
+}
+
+void Push::RestoreState(SimulationState& state)
+{
+    state.Read(setpoint);
+}
+
 }
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLContent.h"
 #include "entities/SolidEntity.h"
@@ -194,4 +195,17 @@ std::vector<Renderable> Rudder::Render()
     return items;
 }
     
+
+void Rudder::SaveState(SimulationState& state)
+{
+    state.Write(theta);
+    state.Write(setpoint);
+}
+
+void Rudder::RestoreState(SimulationState& state)
+{
+    state.Read(theta);
+    state.Read(setpoint);
+}
+
 }
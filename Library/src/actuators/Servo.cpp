@@ -26,6 +26,7 @@
 #include "actuators/Servo.h"
 
 #include "core/SimulationApp.h"
+#include "core/SimulationState.h"
 #include "entities/FeatherstoneEntity.h"
 #include "joints/Joint.h"
 #include "joints/RevoluteJoint.h"
@@ -255,4 +256,18 @@ void Servo::Update(Scalar dt)
     }
 }
 
+void Servo::SaveState(SimulationState& state)
+{
+    state.Write(mode);
+    state.Write(pSetpoint);
+    state.Write(vSetpoint);
+}
+
+void Servo::RestoreState(SimulationState& state)
+{
+    state.Read(mode);
+    state.Read(pSetpoint);
+    state.Read(vSetpoint);
+}
+
 }
@@ -26,6 +26,7 @@
 #include "actuators/SuctionCup.h"
 
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "joints/SpringJoint.h"
 
 namespace sf
@@ -115,4 +116,15 @@ void SuctionCup::Engage(SimulationManager* sm)
     }
 }
     
+
+void SuctionCup::SaveState(SimulationState& state)
+{
+    state.Write(pump);
+}
+
+void SuctionCup::RestoreState(SimulationState& state)
+{
+    state.Read(pump);
+}
+
 }
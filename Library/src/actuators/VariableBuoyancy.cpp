@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include <algorithm>
 
 namespace sf 
@@ -163,4 +164,21 @@ std::vector<Renderable> VariableBuoyancy::Render()
 }
     
     
+
+void VariableBuoyancy::SaveState(SimulationState& state)
+{
+    state.Write(V);
+    state.Write(CG);
+    state.Write(flowRate);
+    state.Write(force);
+}
+
+void VariableBuoyancy::RestoreState(SimulationState& state)
+{
+    state.Read(V);
+    state.Read(CG);
+    state.Read(flowRate);
+    state.Read(force);
+}
+
 }
@@ -28,6 +28,7 @@
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 
 namespace sf
@@ -182,7 +183,7 @@ void AcousticModem::SendMessage(std::string data)
                 msg->data = data;
                 msg->txPosition = getDeviceFrame().getOrigin();
                 msg->travelled = Scalar(0);
-                txBuffer.push_back(msg);
+                Transmit(msg);
             }
     }
     else
@@ -198,7 +199,7 @@ void AcousticModem::SendMessage(std::string data)
         msg->data = data;
         msg->txPosition = getDeviceFrame().getOrigin();
         msg->travelled = Scalar(0);
-        txBuffer.push_back(msg);
+        Transmit(msg);
     }
 }
 
@@ -215,7 +216,7 @@ void AcousticModem::ProcessMessages()
             msg->source = getDeviceId();
             msg->data = "ACK";
             msg->txPosition = getDeviceFrame().getOrigin();
-            txBuffer.push_back(msg);
+            Transmit(msg);
         }
         else
         {
@@ -265,6 +266,59 @@ void AcousticModem::InternalUpdate(Scalar dt)
     }
 }
 
+void AcousticModem::SaveState(SimulationState& state)
+{
+    Comm::SaveState(state);
+    uint64_t n = propagating.size();
+    state.Write(n);
+    std::map<AcousticDataFrame*, Vector3>::iterator mIt;
+    for(mIt = propagating.begin(); mIt != propagating.end(); ++mIt)
+    {
+        WriteFrame(state, mIt->first);
+        state.Write(mIt->second);
+    }
+}
+
+void AcousticModem::RestoreState(SimulationState& state)
+{
+    Comm::RestoreState(state);
+    std::map<AcousticDataFrame*, Vector3>::iterator mIt;
+    for(mIt = propagating.begin(); mIt != propagating.end(); ++mIt)
+        delete mIt->first;
+    propagating.clear();
+    
+    uint64_t n;
+    state.Read(n);
+    for(uint64_t i=0; i<n; ++i)
+    {
+        AcousticDataFrame* msg = (AcousticDataFrame*)ReadFrame(state);
+        Vector3 pos;
+        state.Read(pos);
+        propagating[msg] = pos;
+    }
+}
+
+void AcousticModem::WriteFrame(SimulationState& state, const CommDataFrame* frame)
+{
+    Comm::WriteFrame(state, frame);
+    const AcousticDataFrame* msg = (const AcousticDataFrame*)frame;
+    state.Write(msg->txPosition);
+    state.Write(msg->travelled);
+}
+
+CommDataFrame* AcousticModem::ReadFrame(SimulationState& state)
+{
+    AcousticDataFrame* msg = new AcousticDataFrame();
+    state.Read(msg->timeStamp);
+    state.Read(msg->seq);
+    state.Read(msg->source);
+    state.Read(msg->destination);
+    state.ReadString(msg->data);
+    state.Read(msg->txPosition);
+    state.Read(msg->travelled);
+    return msg;
+}
+
 void AcousticModem::UpdatePosition(Vector3 pos, bool absolute, std::string referenceFrame)
 {
     position = pos;
@@ -27,6 +27,8 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/ZoneProfiler.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "entities/MovingEntity.h"
 #include "entities/StaticEntity.h"
@@ -37,6 +39,7 @@ namespace sf
 Comm::Comm(std::string uniqueName, uint64_t deviceId)
 {
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
+    zoneName = ZoneProfiler::Intern(name);
     id = deviceId;
     cId = -1;
     renderable = false;
@@ -45,6 +48,8 @@ Comm::Comm(std::string uniqueName, uint64_t deviceId)
     attach = nullptr;
     o2c = I4();
     txSeq = 0;
+    eventCallback = NULL;
+    randomGenerator.Seed(RandomStream::getGlobalSeed(), name);
 }
 
 Comm::~Comm()
@@ -71,6 +76,11 @@ std::string Comm::getName()
     return name;
 }
 
+const char* Comm::getZoneName() const
+{
+    return zoneName;
+}
+
 uint64_t Comm::getDeviceId()
 {
     return id;
@@ -116,12 +126,73 @@ void Comm::SendMessage(std::string data)
         msg->destination = cId;
         msg->timeStamp = SimulationApp::getApp()->getSimulationManager()->getSimulationTime();
         msg->data = data;
-        txBuffer.push_back(msg);
+        Transmit(msg);
     }
     else
         return;
 }
 
+void Comm::SaveState(SimulationState& state)
+{
+    state.Write(newDataAvailable);
+    state.Write(txSeq);
+    state.Write(randomGenerator);
+    uint64_t nTx = txBuffer.size();
+    state.Write(nTx);
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        WriteFrame(state, txBuffer[i]);
+    uint64_t nRx = rxBuffer.size();
+    state.Write(nRx);
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        WriteFrame(state, rxBuffer[i]);
+}
+
+void Comm::RestoreState(SimulationState& state)
+{
+    for(size_t i=0; i<txBuffer.size(); ++i)
+        delete txBuffer[i];
+    txBuffer.clear();
+    for(size_t i=0; i<rxBuffer.size(); ++i)
+        delete rxBuffer[i];
+    rxBuffer.clear();
+    
+    state.Read(newDataAvailable);
+    state.Read(txSeq);
+    state.Read(randomGenerator);
+    uint64_t n;
+    state.Read(n);
+    for(uint64_t i=0; i<n; ++i)
+        txBuffer.push_back(ReadFrame(state));
+    state.Read(n);
+    for(uint64_t i=0; i<n; ++i)
+        rxBuffer.push_back(ReadFrame(state));
+}
+
+void Comm::setRandomSeed(uint64_t seed)
+{
+    randomGenerator.Seed(seed, name);
+}
+
+void Comm::WriteFrame(SimulationState& state, const CommDataFrame* frame)
+{
+    state.Write(frame->timeStamp);
+    state.Write(frame->seq);
+    state.Write(frame->source);
+    state.Write(frame->destination);
+    state.WriteString(frame->data);
+}
+
+CommDataFrame* Comm::ReadFrame(SimulationState& state)
+{
+    CommDataFrame* frame = new CommDataFrame();
+    state.Read(frame->timeStamp);
+    state.Read(frame->seq);
+    state.Read(frame->source);
+    state.Read(frame->destination);
+    state.ReadString(frame->data);
+    return frame;
+}
+
 CommDataFrame* Comm::ReadMessage()
 {
     CommDataFrame* msg = nullptr;
@@ -136,6 +207,25 @@ CommDataFrame* Comm::ReadMessage()
 void Comm::MessageReceived(CommDataFrame* message)
 {
     rxBuffer.push_back(message);
+    if(eventCallback != NULL)
+        eventCallback(this, message, true);
+}
+
+void Comm::Transmit(CommDataFrame* message)
+{
+    txBuffer.push_back(message);
+    if(eventCallback != NULL)
+        eventCallback(this, message, false);
+}
+
+void Comm::InstallEventHandler(std::function<void(Comm*, const CommDataFrame*, bool)> callback)
+{
+    eventCallback = callback;
+}
+
+bool Comm::hasEventHandler() const
+{
+    return eventCallback != nullptr;
 }
 
 void Comm::AttachToWorld(const Transform& origin)
@@ -25,12 +25,11 @@
 
 #include "comms/USBL.h"
 
+#include "core/SimulationState.h"
+
 namespace sf
 {
     
-std::random_device USBL::randomDevice;
-std::mt19937 USBL::randomGenerator(randomDevice());
-    
 USBL::USBL(std::string uniqueName, uint64_t deviceId, Scalar minVerticalFOVDeg, Scalar maxVerticalFOVDeg, Scalar operatingRange)
            : AcousticModem(uniqueName, deviceId, minVerticalFOVDeg, maxVerticalFOVDeg, operatingRange)
 {
@@ -48,6 +47,57 @@ CommType USBL::getType() const
     return CommType::USBL;
 }
 
+void USBL::SaveState(SimulationState& state)
+{
+    AcousticModem::SaveState(state);
+    state.Write(pingTime);
+    uint64_t n = beacons.size();
+    state.Write(n);
+    for(std::map<uint64_t, BeaconInfo>::iterator it = beacons.begin(); it != beacons.end(); ++it)
+    {
+        const BeaconInfo& b = it->second;
+        state.Write(it->first);
+        state.Write(b.localOri.x());
+        state.Write(b.localOri.y());
+        state.Write(b.localOri.z());
+        state.Write(b.localOri.w());
+        state.Write(b.localDepth);
+        state.Write(b.t);
+        state.Write(b.relPos);
+        state.Write(b.elevation);
+        state.Write(b.azimuth);
+        state.Write(b.range);
+    }
+}
+
+void USBL::RestoreState(SimulationState& state)
+{
+    AcousticModem::RestoreState(state);
+    state.Read(pingTime);
+    beacons.clear();
+    uint64_t n;
+    state.Read(n);
+    for(uint64_t i=0; i<n; ++i)
+    {
+        uint64_t beaconId;
+        Scalar qx, qy, qz, qw;
+        BeaconInfo b;
+        state.Read(beaconId);
+        state.Read(qx);
+        state.Read(qy);
+        state.Read(qz);
+        state.Read(qw);
+        b.localOri = Quaternion(qx, qy, qz, qw);
+        state.Read(b.localDepth);
+        state.Read(b.t);
+        state.Read(b.relPos);
+        state.Read(b.elevation);
+        state.Read(b.azimuth);
+        state.Read(b.range);
+        beacons[beaconId] = b;
+    }
+}
+
 void USBL::EnableAutoPing(Scalar rate)
 {
     if(rate > Scalar(0))
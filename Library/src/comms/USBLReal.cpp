@@ -25,6 +25,8 @@
 
 #include "comms/USBLReal.h"
 
+#include "core/SimulationState.h"
+
 namespace sf
 {
 
@@ -113,4 +115,22 @@ Scalar USBLReal::CalcModel(Scalar R, Scalar theta)
     return result;
 }
 
+void USBLReal::SaveState(SimulationState& state)
+{
+    USBL::SaveState(state);
+    state.Write(noiseTime);
+    state.Write(noiseSV);
+    state.Write(noisePhase);
+    state.Write(noiseDepth);
+}
+
+void USBLReal::RestoreState(SimulationState& state)
+{
+    USBL::RestoreState(state);
+    state.Read(noiseTime);
+    state.Read(noiseSV);
+    state.Read(noisePhase);
+    state.Read(noiseDepth);
+}
+
 }
\ No newline at end of file
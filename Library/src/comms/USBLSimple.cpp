@@ -25,6 +25,8 @@
 
 #include "comms/USBLSimple.h"
 
+#include "core/SimulationState.h"
+
 namespace sf
 {
         
@@ -117,4 +119,20 @@ void USBLSimple::ProcessMessages()
     }
 }
 
+void USBLSimple::SaveState(SimulationState& state)
+{
+    USBL::SaveState(state);
+    state.Write(noiseRange);
+    state.Write(noiseHAngle);
+    state.Write(noiseVAngle);
+}
+
+void USBLSimple::RestoreState(SimulationState& state)
+{
+    USBL::RestoreState(state);
+    state.Read(noiseRange);
+    state.Read(noiseHAngle);
+    state.Read(noiseVAngle);
+}
+
 }
\ No newline at end of file
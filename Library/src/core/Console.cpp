@@ -26,19 +26,63 @@
 #include "core/Console.h"
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <cstdarg>
+#include <functional>
 
 namespace sf
 {
     
+static int64_t ConsoleTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+    
 Console::Console(bool useStdout)
 {
     stdoutEnabled = useStdout;
-    lines = std::vector<ConsoleMessage>(0);
     linesMutex = SDL_CreateMutex();
+    lines = std::vector<ConsoleMessage>(CONSOLE_HISTORY_LENGTH);
+    linesStart = 0;
+    linesCount = 0;
+    
+    queue = new QueueCell[CONSOLE_QUEUE_SIZE];
+    for(size_t i=0; i<CONSOLE_QUEUE_SIZE; ++i)
+        queue[i].sequence.store(i, std::memory_order_relaxed);
+    enqueuePos.store(0);
+    dequeuePos.store(0);
+    dropped.store(0);
+    suppressedTotal.store(0);
+    droppedReported = 0;
+    
+    for(size_t i=0; i<CONSOLE_RATE_SLOTS; ++i)
+    {
+        rateSlots[i].hash.store(0);
+        rateSlots[i].windowStart.store(0);
+        rateSlots[i].count.store(0);
+        rateSlots[i].suppressed.store(0);
+    }
+    rateLimit.store(0); //Opt-in, to never hide distinct messages sharing a format
+    
+    writerMutex = SDL_CreateMutex();
+    writerCond = SDL_CreateCond();
+    flushCond = SDL_CreateCond();
+    writerRunning.store(true);
+    writerThread = SDL_CreateThread(Console::RunWriter, "consoleWriter", this);
 }
 
 Console::~Console()
 {
+    SDL_LockMutex(writerMutex);
+    writerRunning.store(false);
+    SDL_CondSignal(writerCond);
+    SDL_UnlockMutex(writerMutex);
+    SDL_WaitThread(writerThread, NULL);
+    
+    SDL_DestroyCond(flushCond);
+    SDL_DestroyCond(writerCond);
+    SDL_DestroyMutex(writerMutex);
+    delete [] queue;
     lines.clear();
     SDL_DestroyMutex(linesMutex);
 }
@@ -50,81 +94,87 @@ SDL_mutex* Console::getLinesMutex()
 
 std::vector<ConsoleMessage> Console::getLines()
 {
-    return lines;
+    Flush();
+    std::vector<ConsoleMessage> copy;
+    SDL_LockMutex(linesMutex);
+    copy.reserve(linesCount);
+    for(size_t i=0; i<linesCount; ++i)
+        copy.push_back(getLine(i));
+    SDL_UnlockMutex(linesMutex);
+    return copy;
+}
+    
+size_t Console::getLinesCount() const
+{
+    return linesCount;
+}
+
+const ConsoleMessage& Console::getLine(size_t id) const
+{
+    return lines[(linesStart + id) % CONSOLE_HISTORY_LENGTH];
+}
+    
+uint64_t Console::getDroppedCount() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+    
+uint64_t Console::getSuppressedCount() const
+{
+    return suppressedTotal.load(std::memory_order_relaxed);
+}
+    
+void Console::setRateLimit(unsigned int maxPerSecond)
+{
+    rateLimit.store(maxPerSecond, std::memory_order_relaxed);
 }
 
 void Console::Print(MessageType t, std::string format, ...)
 {
+    if(t != MessageType::CRITICAL && !RateLimit(t, format))
+        return;
+    
     va_list args;
-    char buffer[4096];
+    char buffer[CONSOLE_MESSAGE_LENGTH];
     va_start(args, format);
     vsnprintf(buffer, sizeof(buffer), format.c_str(), args);
     va_end(args);
     
-    if(stdoutEnabled)
+    if(t == MessageType::CRITICAL) //Application is going to abort -> print everything now
     {
-#ifdef COLOR_CONSOLE
-        switch(t)
-        {
-            default:
-            case MessageType::INFO:
-                printf("[INFO] %s\n", buffer);
-                break;
-                
-            case MessageType::WARNING:
-                printf("\033[33m[WARN] %s\033[0m\n", buffer);
-                break;
-                
-            case MessageType::ERROR:
-                printf("\033[31m[ERROR] %s\033[0m\n", buffer);
-                break;
-                
-            case MessageType::CRITICAL:
-                printf("\033[1;31m[CRITICAL] %s\033[0m\n", buffer);
-                break;
-        }
-#else
-        switch(t)
-        {
-            default:
-            case MessageType::INFO:
-                printf("[INFO] %s\n", buffer);
-                break;
-                
-            case MessageType::WARNING:
-                printf("[WARN] %s\n", buffer);
-                break;
-                
-            case MessageType::ERROR:
-                printf("[ERROR] %s\n", buffer);
-                break;
-                
-            case MessageType::CRITICAL:
-                printf("[CRITICAL] %s\n", buffer);
-                break;
-        }
-#endif
+        Flush();
+        Output(t, buffer);
+        PushLine(t, buffer);
+        fflush(stdout);
+        return;
     }
-
-    ConsoleMessage msg;
-    msg.type = t;
-    msg.text = std::string(buffer);
-    SDL_LockMutex(linesMutex);
-    lines.push_back(msg);
-    SDL_UnlockMutex(linesMutex);
+    
+    if(Enqueue(t, buffer))
+        SDL_CondSignal(writerCond);
+    else
+        dropped.fetch_add(1, std::memory_order_relaxed);
 }
 
 void Console::AppendMessage(const ConsoleMessage& msg)
 {
-    SDL_LockMutex(linesMutex);
-    lines.push_back(msg);
-    SDL_UnlockMutex(linesMutex);
+    PushLine(msg.type, msg.text.c_str());
+}
+    
+void Console::Flush()
+{
+    uint64_t target = enqueuePos.load(std::memory_order_acquire);
+    SDL_LockMutex(writerMutex);
+    SDL_CondSignal(writerCond);
+    while(writerRunning.load() && dequeuePos.load(std::memory_order_acquire) < target)
+        SDL_CondWaitTimeout(flushCond, writerMutex, 10);
+    SDL_UnlockMutex(writerMutex);
 }
     
 void Console::Clear()
 {
     SDL_LockMutex(linesMutex);
-    lines.clear();
+    linesStart = 0;
+    linesCount = 0;
     SDL_UnlockMutex(linesMutex);
 }
 
@@ -133,22 +183,24 @@ bool Console::SaveToFile(std::string filename)
     std::ofstream outFile(filename);
     if(outFile.is_open())
     {
+        Flush();
         SDL_LockMutex(linesMutex);
-        for(size_t i=0; i<lines.size(); ++i)
+        for(size_t i=0; i<linesCount; ++i)
         {
-            switch(lines[i].type)
+            const ConsoleMessage& msg = getLine(i);
+            switch(msg.type)
             {
                 case MessageType::INFO:
-                    outFile << "[INFO] " << lines[i].text << std::endl;
+                    outFile << "[INFO] " << msg.text << std::endl;
                     break;
                 case MessageType::WARNING:
-                    outFile << "[WARN] " << lines[i].text << std::endl;
+                    outFile << "[WARN] " << msg.text << std::endl;
                     break;
                 case MessageType::ERROR:
-                    outFile << "[ERROR] " << lines[i].text << std::endl;
+                    outFile << "[ERROR] " << msg.text << std::endl;
                     break;
                 case MessageType::CRITICAL:
-                    outFile << "[CRITICAL] " << lines[i].text << std::endl;
+                    outFile << "[CRITICAL] " << msg.text << std::endl;
                     break;
             }
         }
@@ -159,5 +211,210 @@ bool Console::SaveToFile(std::string filename)
     else
         return false;
 }
+    
+bool Console::Enqueue(MessageType t, const char* text)
+{
+    //Bounded multi-producer queue with per-cell sequence numbers
+    QueueCell* cell;
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        cell = &queue[pos & (CONSOLE_QUEUE_SIZE - 1)];
+        uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)seq - (int64_t)pos;
+        if(diff == 0)
+        {
+            if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0) //Queue full
+            return false;
+        else
+            pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+    
+    cell->type = t;
+    strncpy(cell->text, text, CONSOLE_MESSAGE_LENGTH - 1);
+    cell->text[CONSOLE_MESSAGE_LENGTH - 1] = '\0';
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+    
+bool Console::RateLimit(MessageType t, const std::string& format)
+{
+    uint32_t limit = rateLimit.load(std::memory_order_relaxed);
+    if(limit == 0)
+        return true;
+    
+    //Messages are grouped by their format string, so repeated messages with changing values are limited as well
+    uint64_t h = (uint64_t)std::hash<std::string>()(format) | 1;
+    RateSlot& slot = rateSlots[h % CONSOLE_RATE_SLOTS];
+    int64_t now = ConsoleTime();
+    
+    if(slot.hash.load(std::memory_order_relaxed) != h) //Slot taken over by a new format
+    {
+        slot.hash.store(h, std::memory_order_relaxed);
+        slot.windowStart.store(now, std::memory_order_relaxed);
+        slot.count.store(0, std::memory_order_relaxed);
+    }
+    
+    int64_t ws = slot.windowStart.load(std::memory_order_relaxed);
+    if(now - ws >= 1000000 && slot.windowStart.compare_exchange_strong(ws, now, std::memory_order_relaxed))
+    {
+        slot.count.store(0, std::memory_order_relaxed);
+        uint32_t s = slot.suppressed.exchange(0, std::memory_order_relaxed);
+        if(s > 0)
+        {
+            char buffer[CONSOLE_MESSAGE_LENGTH];
+            snprintf(buffer, sizeof(buffer), "Suppressed %u messages like '%s'.", s, format.c_str());
+            if(!Enqueue(t, buffer))
+                dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    
+    if(slot.count.fetch_add(1, std::memory_order_relaxed) < limit)
+        return true;
+    
+    slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+    suppressedTotal.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+    
+void Console::SweepRateSlots()
+{
+    //Report suppressed messages of formats which stopped repeating
+    int64_t now = ConsoleTime();
+    for(size_t i=0; i<CONSOLE_RATE_SLOTS; ++i)
+    {
+        RateSlot& slot = rateSlots[i];
+        if(slot.suppressed.load(std::memory_order_relaxed) == 0
+           || now - slot.windowStart.load(std::memory_order_relaxed) < 1000000)
+            continue;
+        uint32_t s = slot.suppressed.exchange(0, std::memory_order_relaxed);
+        if(s > 0)
+        {
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "Suppressed %u repeated messages.", s);
+            Output(MessageType::WARNING, buffer);
+            PushLine(MessageType::WARNING, buffer);
+        }
+    }
+}
+    
+void Console::PushLine(MessageType t, const char* text)
+{
+    SDL_LockMutex(linesMutex);
+    size_t id;
+    if(linesCount < CONSOLE_HISTORY_LENGTH)
+        id = (linesStart + linesCount++) % CONSOLE_HISTORY_LENGTH;
+    else //Overwrite the oldest line
+    {
+        id = linesStart;
+        linesStart = (linesStart + 1) % CONSOLE_HISTORY_LENGTH;
+    }
+    lines[id].type = t;
+    lines[id].text.assign(text);
+    SDL_UnlockMutex(linesMutex);
+}
+    
+void Console::Output(MessageType t, const char* text)
+{
+    if(!stdoutEnabled)
+        return;
+    
+#ifdef COLOR_CONSOLE
+    switch(t)
+    {
+        default:
+        case MessageType::INFO:
+            printf("[INFO] %s\n", text);
+            break;
+            
+        case MessageType::WARNING:
+            printf("\033[33m[WARN] %s\033[0m\n", text);
+            break;
+            
+        case MessageType::ERROR:
+            printf("\033[31m[ERROR] %s\033[0m\n", text);
+            break;
+            
+        case MessageType::CRITICAL:
+            printf("\033[1;31m[CRITICAL] %s\033[0m\n", text);
+            break;
+    }
+#else
+    switch(t)
+    {
+        default:
+        case MessageType::INFO:
+            printf("[INFO] %s\n", text);
+            break;
+            
+        case MessageType::WARNING:
+            printf("[WARN] %s\n", text);
+            break;
+            
+        case MessageType::ERROR:
+            printf("[ERROR] %s\n", text);
+            break;
+            
+        case MessageType::CRITICAL:
+            printf("[CRITICAL] %s\n", text);
+            break;
+    }
+#endif
+}
+    
+void Console::Drain()
+{
+    size_t written = 0;
+    for(;;)
+    {
+        uint64_t pos = dequeuePos.load(std::memory_order_relaxed);
+        QueueCell* cell = &queue[pos & (CONSOLE_QUEUE_SIZE - 1)];
+        if(cell->sequence.load(std::memory_order_acquire) != pos + 1) //Empty or not yet committed
+            break;
+        Output(cell->type, cell->text);
+        PushLine(cell->type, cell->text);
+        cell->sequence.store(pos + CONSOLE_QUEUE_SIZE, std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_release);
+        ++written;
+    }
+    
+    uint64_t d = dropped.load(std::memory_order_relaxed);
+    if(d != droppedReported)
+    {
+        char buffer[128];
+        snprintf(buffer, sizeof(buffer), "Console queue full -> %llu messages dropped.", (unsigned long long)(d - droppedReported));
+        Output(MessageType::WARNING, buffer);
+        PushLine(MessageType::WARNING, buffer);
+        droppedReported = d;
+        ++written;
+    }
+    
+    SweepRateSlots();
+    if(written > 0 && stdoutEnabled)
+        fflush(stdout);
+    
+    SDL_LockMutex(writerMutex);
+    SDL_CondBroadcast(flushCond);
+    SDL_UnlockMutex(writerMutex);
+}
+    
+int Console::RunWriter(void* data)
+{
+    Console* c = (Console*)data;
+    while(c->writerRunning.load())
+    {
+        c->Drain();
+        SDL_LockMutex(c->writerMutex);
+        if(c->writerRunning.load() 
+           && c->enqueuePos.load(std::memory_order_acquire) == c->dequeuePos.load(std::memory_order_relaxed))
+            SDL_CondWaitTimeout(c->writerCond, c->writerMutex, 100);
+        SDL_UnlockMutex(c->writerMutex);
+    }
+    c->Drain(); //Write out remaining messages
+    return 0;
+}
 
 }
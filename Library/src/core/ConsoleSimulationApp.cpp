@@ -29,7 +29,10 @@
 #include <thread>
 #include <omp.h>
 #include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "core/RemoteControlServer.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/ZoneProfiler.h"
 
 namespace sf
 {
@@ -38,6 +41,8 @@ ConsoleSimulationApp::ConsoleSimulationApp(std::string name, std::string dataDir
 : SimulationApp(name, dataDirPath, sim)
 {
     simulationThread = NULL;
+    remoteServer = nullptr;
+    remotePort = 0;
 }
 
 ConsoleSimulationApp::~ConsoleSimulationApp()
@@ -55,14 +60,70 @@ void ConsoleSimulationApp::Init()
     SimulationApp::Init();
     cInfo("Initializing simulation:");
     InitializeSimulation();
+    if(remotePort > 0)
+        remoteServer = new RemoteControlServer(remotePort);
+    else if(!remoteSocketPath.empty())
+        remoteServer = new RemoteControlServer(remoteSocketPath);
     cInfo("Ready for running...");
 }
 
+void ConsoleSimulationApp::EnableRemoteControl(uint16_t port)
+{
+    remotePort = port;
+    remoteSocketPath = "";
+}
+
+void ConsoleSimulationApp::EnableRemoteControl(const std::string& socketPath)
+{
+    remotePort = 0;
+    remoteSocketPath = socketPath;
+}
+
+RemoteControlServer* ConsoleSimulationApp::getRemoteControlServer()
+{
+    return remoteServer;
+}
+
 void ConsoleSimulationApp::LoopInternal()
 {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 }
 
+void ConsoleSimulationApp::PrintStatistics()
+{
+    RayTracingStatistics stats = getSimulationManager()->getRayTracingScene()->getStatistics();
+    if(stats.rays > 0)
+    {
+        double t = (double)stats.traceTime/1e6;
+        cInfo("Ray tracing: %llu rays in %.3lf s -> %.2lf Mrays/s (%lu instances, %lu triangles).",
+              (unsigned long long)stats.rays, t, t > 0.0 ? (double)stats.rays/t/1e6 : 0.0,
+              (unsigned long)stats.instances, (unsigned long)stats.triangles);
+    }
+    
+    if(ZoneProfiler::isEnabled())
+    {
+        std::string table = ZoneProfiler::getSummaryTable();
+        size_t start = 0;
+        size_t end;
+        while((end = table.find('\n', start)) != std::string::npos)
+        {
+            cInfo("%s", table.substr(start, end - start).c_str());
+            start = end + 1;
+        }
+    }
+}
+
+void ConsoleSimulationApp::CleanUp()
+{
+    if(remoteServer != nullptr)
+    {
+        delete remoteServer;
+        remoteServer = nullptr;
+    }
+    PrintStatistics();
+    SimulationApp::CleanUp();
+}
+
 void ConsoleSimulationApp::StartSimulation()
 {
     SimulationApp::StartSimulation();
@@ -69,6 +69,7 @@ GraphicalSimulationApp::GraphicalSimulationApp(std::string name, std::string dat
     joystickHats = NULL;
     mouseWasDown.type = SDL_LASTEVENT;
     limitFramerate = true;
+    loading = false;
     simulationThread = NULL;
     loadingThread = NULL;
     glPipeline = NULL;
@@ -643,7 +644,9 @@ void GraphicalSimulationApp::RenderLoop()
     if(displayConsole)
     {
         gui->GenerateBackground();
+        SDL_LockMutex(console->getLinesMutex()); //Lines are appended by the console writer thread
         ((OpenGLConsole*)console)->Render(true);
+        SDL_UnlockMutex(console->getLinesMutex());
     }
     else
     {
@@ -1102,11 +1105,7 @@ int GraphicalSimulationApp::RunSimulation(void* data)
     {
         sim->AdvanceSimulation();
         if(stdata->app->getGLPipeline()->isDrawingQueueEmpty())
-        {
-            SDL_LockMutex(stdata->drawingQueueMutex);
-            sim->UpdateDrawingQueue();
-            SDL_UnlockMutex(stdata->drawingQueueMutex);
-        }
+            sim->UpdateDrawingQueue(); //Locks the drawing queue only to submit it
     }
     
     return 0;
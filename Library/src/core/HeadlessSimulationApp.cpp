@@ -0,0 +1,225 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  HeadlessSimulationApp.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/HeadlessSimulationApp.h"
+
+#include <chrono>
+#include <thread>
+#include "core/SimulationManager.h"
+#include "graphics/OpenGLState.h"
+#include "graphics/GLSLShader.h"
+#include "graphics/OpenGLPipeline.h"
+#include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLView.h"
+#include "utils/SystemUtil.hpp"
+#ifdef HEADLESS_RENDERING
+#ifndef EGLAPIENTRY
+#define EGLAPIENTRY //khrplatform.h embedded in glad does not define KHRONOS_APIENTRY
+#endif
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace sf
+{
+
+HeadlessSimulationApp::HeadlessSimulationApp(std::string name, std::string dataDirPath, RenderSettings s, SimulationManager* sim)
+: GraphicalSimulationApp(name, dataDirPath, s, HelperSettings(), sim)
+{
+    eglDisplay = NULL;
+    eglContext = NULL;
+    sensorFrames = 0;
+    renderTime = 0;
+}
+
+HeadlessSimulationApp::~HeadlessSimulationApp()
+{
+}
+
+uint64_t HeadlessSimulationApp::getSensorFrameCount() const
+{
+    return sensorFrames;
+}
+
+double HeadlessSimulationApp::getSensorFrameRate() const
+{
+    if(renderTime == 0)
+        return 0.0;
+    return (double)sensorFrames/((double)renderTime/1e6);
+}
+
+void HeadlessSimulationApp::Init()
+{
+    //General initialization
+    SimulationApp::Init();
+    loading = true;
+    InitializeEGL();
+    
+    cInfo("Initializing rendering pipeline:");
+    glPipeline = new OpenGLPipeline(rSettings, hSettings);
+    glPipeline->setSensorViewsOnly(true);
+    glPipeline->setViewScheduling(ViewScheduling::SENSOR_RATE);
+    
+    cInfo("Initializing simulation:");
+    InitializeSimulation();
+    
+    cInfo("Ready for running...");
+    loading = false;
+}
+
+void HeadlessSimulationApp::InitializeEGL()
+{
+#ifdef HEADLESS_RENDERING
+    //Prefer the surfaceless platform (Mesa, also with llvmpipe), fall back to the default display
+    EGLDisplay display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if(getPlatformDisplay != NULL)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    if(display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    
+    EGLint emajor, eminor;
+    if(display == EGL_NO_DISPLAY || eglInitialize(display, &emajor, &eminor) != EGL_TRUE)
+        cCritical("EGL: Failed to initialize display (error 0x%x)!", eglGetError());
+    
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    if(extensions == NULL || std::string(extensions).find("EGL_KHR_surfaceless_context") == std::string::npos)
+        cCritical("EGL: Surfaceless contexts are not supported by the driver!");
+    
+    if(eglBindAPI(EGL_OPENGL_API) != EGL_TRUE)
+        cCritical("EGL: Desktop OpenGL is not supported by the driver!");
+    
+    //Choose configuration (rendering only to framebuffer objects)
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint nConfigs = 0;
+    if(eglChooseConfig(display, configAttribs, &config, 1, &nConfigs) != EGL_TRUE || nConfigs == 0)
+        cCritical("EGL: No suitable configuration found!");
+    
+    //Create OpenGL 4.3 core context
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 4,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if(context == EGL_NO_CONTEXT)
+        cCritical("EGL: Failed to create OpenGL 4.3 context (error 0x%x)!", eglGetError());
+    
+    if(eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) != EGL_TRUE)
+        cCritical("EGL: Failed to make context current (error 0x%x)!", eglGetError());
+    
+    eglDisplay = display;
+    eglContext = context;
+    
+    //Initialize OpenGL function handlers
+    int version = gladLoadGL((GLADloadfunc)eglGetProcAddress);
+    int vmajor = GLAD_VERSION_MAJOR(version);
+    int vminor = GLAD_VERSION_MINOR(version);
+    if(vmajor < 4 || (vmajor == 4 && vminor < 3))
+        cCritical("This program requires support for OpenGL 4.3, however OpenGL %d.%d was detected! Exiting...", vmajor, vminor);
+    
+    cInfo("EGL %d.%d initialized. Headless OpenGL %d.%d context created (%s).", emajor, eminor, vmajor, vminor, (const char*)glGetString(GL_RENDERER));
+    OpenGLState::Init();
+    GLSLShader::Init();
+#else
+    cCritical("Headless rendering not available - library built without EGL support!");
+#endif
+}
+
+void HeadlessSimulationApp::LoopInternal()
+{
+    if(!isRunning())
+    {
+        getSimulationManager()->UpdateDrawingQueue();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    
+    //Render sensor views and wait for the results to measure throughput
+    uint64_t start = GetTimeInMicroseconds();
+    glPipeline->Render(getSimulationManager());
+    unsigned int updated = glPipeline->getUpdatedViewsCount();
+    if(updated > 0)
+    {
+        glFinish();
+        renderTime += GetTimeInMicroseconds() - start;
+        sensorFrames += updated;
+    }
+    else
+        std::this_thread::sleep_for(std::chrono::microseconds(500)); //Nothing to render yet
+}
+
+void HeadlessSimulationApp::StartSimulation()
+{
+    sensorFrames = 0;
+    renderTime = 0;
+    GraphicalSimulationApp::StartSimulation();
+}
+
+void HeadlessSimulationApp::PrintStatistics()
+{
+    if(sensorFrames == 0)
+        return;
+    
+    cInfo("Headless rendering: %lu sensor frames in %.3lf s -> %.1lf FPS.",
+          (unsigned long)sensorFrames, (double)renderTime/1e6, getSensorFrameRate());
+    
+    if(glPipeline == NULL)
+        return;
+    
+    for(unsigned int i=0; i<glPipeline->getContent()->getViewsCount(); ++i)
+    {
+        ViewStatistics stats = glPipeline->getViewStatistics(i);
+        cInfo("View %u: %u renders, GPU time %.3f ms (avg) / %.3f ms (max), %u missed updates.",
+              i, stats.renderCount, stats.avgTime, stats.maxTime, stats.missedCount);
+    }
+}
+
+void HeadlessSimulationApp::CleanUp()
+{
+    PrintStatistics();
+    SimulationApp::CleanUp();
+    
+#ifdef HEADLESS_RENDERING
+    if(eglDisplay != NULL)
+    {
+        eglMakeCurrent((EGLDisplay)eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if(eglContext != NULL)
+            eglDestroyContext((EGLDisplay)eglDisplay, (EGLContext)eglContext);
+        eglTerminate((EGLDisplay)eglDisplay);
+    }
+#endif
+    eglDisplay = NULL;
+    eglContext = NULL;
+}
+
+}
@@ -25,53 +25,67 @@
 
 #include "core/NameManager.h"
 
+#include <cctype>
+
 namespace sf
 {
 
 NameManager::NameManager()
 {
-    names = std::vector<std::string>(0);
 }
 
 NameManager::~NameManager()
 {
-    names.clear();
+    ClearNames();
 }
 
 std::string NameManager::AddName(std::string proposedName)
 {
-    std::string goodName = proposedName;
-    int number = 1;
+    if(names.insert(proposedName).second)
+        return proposedName;
     
-checkname:
-    for(unsigned int i = 0; i < names.size(); i++)
+    //Take the lowest free suffix, skipping the ones known to be used
+    unsigned int& number = suffixes[proposedName];
+    std::string goodName;
+    do
     {
-        if(goodName == names[i])
-        {
-            goodName = proposedName + std::to_string(number);
-            number++;
-            goto checkname;
-        }
+        goodName = proposedName + std::to_string(++number);
     }
+    while(names.find(goodName) != names.end());
     
-    names.push_back(goodName);
+    names.insert(goodName);
     return goodName;
 }
 
 void NameManager::RemoveName(std::string name)
 {
-    std::vector<std::string>::iterator it;
-    for(it = names.begin(); it < names.end(); it++)
-        if(*it == name)
-        {
-            names.erase(it);
-            break;
-        }
+    if(names.erase(name) == 0)
+        return;
+    
+    //The removed name frees its suffix for every proposed name it could have been generated from
+    unsigned int number = 0;
+    unsigned int scale = 1;
+    for(size_t i = name.size(); i > 0 && scale <= 100000000 && isdigit((unsigned char)name[i-1]); --i)
+    {
+        number += (name[i-1] - '0') * scale;
+        scale *= 10;
+        if(name[i-1] == '0') //Generated suffixes have no leading zeros
+            continue;
+        auto it = suffixes.find(name.substr(0, i-1));
+        if(it != suffixes.end() && number <= it->second)
+            it->second = number - 1;
+    }
 }
 
 void NameManager::ClearNames()
 {
     names.clear();
+    suffixes.clear();
+}
+
+bool NameManager::isNameUsed(const std::string& name) const
+{
+    return names.find(name) != names.end();
 }
 
 }
@@ -0,0 +1,290 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracingScene.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/RayTracingScene.h"
+
+#include "core/SimulationManager.h"
+#include "entities/StaticEntity.h"
+#include "entities/SolidEntity.h"
+#include "entities/FeatherstoneEntity.h"
+#include "entities/solids/Compound.h"
+#include "utils/SystemUtil.hpp"
+#include <cfloat>
+
+namespace sf
+{
+
+RayTracingScene::RayTracingScene() : lastUpdate(-1), valid(false), nTriangles(0), nRays(0), traceTime(0)
+{
+}
+
+RayTracingScene::~RayTracingScene()
+{
+    Clear();
+}
+
+void RayTracingScene::Clear()
+{
+    for(auto it = bvhCache.begin(); it != bvhCache.end(); ++it)
+        delete it->second;
+    bvhCache.clear();
+    instances.clear();
+    nTriangles = 0;
+    valid = false;
+}
+
+void RayTracingScene::Evict(const Mesh* mesh)
+{
+    auto it = bvhCache.find(mesh);
+    if(it == bvhCache.end())
+        return;
+    delete it->second;
+    bvhCache.erase(it);
+    instances.clear(); //Instances may refer to the deleted hierarchy
+    nTriangles = 0;
+    valid = false;
+}
+
+void RayTracingScene::Update(SimulationManager* sm)
+{
+    Scalar t = sm->getSimulationTime();
+    if(valid && t == lastUpdate)
+        return;
+    
+    instances.clear();
+    nTriangles = 0;
+    Entity* ent;
+    for(unsigned int i=0; (ent = sm->getEntity(i)) != nullptr; ++i)
+    {
+        switch(ent->getType())
+        {
+            case EntityType::STATIC:
+            {
+                StaticEntity* sEnt = (StaticEntity*)ent;
+                AddInstance(sEnt->getPhysicsMesh(), sEnt->getTransform(), sEnt->getMaterial());
+            }
+                break;
+                
+            case EntityType::SOLID:
+                AddSolid((SolidEntity*)ent);
+                break;
+                
+            case EntityType::FEATHERSTONE:
+            {
+                FeatherstoneEntity* fEnt = (FeatherstoneEntity*)ent;
+                for(unsigned int h=0; h<fEnt->getNumOfLinks(); ++h)
+                    AddSolid(fEnt->getLink(h).solid);
+            }
+                break;
+                
+            default: //Animated entities and other types are not traced
+                break;
+        }
+    }
+    
+    lastUpdate = t;
+    valid = true;
+}
+
+void RayTracingScene::AddSolid(SolidEntity* solid)
+{
+    if(solid->getSolidType() == SolidType::COMPOUND)
+    {
+        Compound* cmpd = (Compound*)solid;
+        Transform oTrans = cmpd->getOTransform();
+        for(size_t i=0; i<cmpd->getNumOfParts(); ++i)
+        {
+            CompoundPart part = cmpd->getPart(i);
+            AddInstance(part.solid->getPhysicsMesh(), oTrans * part.origin * part.solid->getO2CTransform(), part.solid->getMaterial());
+        }
+    }
+    else
+        AddInstance(solid->getPhysicsMesh(), solid->getCTransform(), solid->getMaterial());
+}
+
+void RayTracingScene::AddInstance(const Mesh* mesh, const Transform& T, const Material& mat)
+{
+    if(mesh == nullptr)
+        return;
+    
+    BVH* bvh;
+    auto it = bvhCache.find(mesh);
+    if(it == bvhCache.end())
+    {
+        bvh = new BVH(mesh);
+        bvhCache[mesh] = bvh;
+    }
+    else
+        bvh = it->second;
+    
+    if(bvh->getNumOfTriangles() == 0)
+        return;
+    
+    RayTracingInstance inst;
+    inst.bvh = bvh;
+    glm::mat4 M = glMatrixFromTransform(T);
+    inst.R = glm::mat3(M);
+    inst.p = glm::vec3(M[3]);
+    inst.restitution = (GLfloat)mat.restitution;
+    
+    //Transform local bounding box to world frame (Arvo's method)
+    glm::vec3 lMin, lMax;
+    bvh->getAABB(lMin, lMax);
+    inst.aabbMin = inst.p;
+    inst.aabbMax = inst.p;
+    for(int c=0; c<3; ++c)
+        for(int r=0; r<3; ++r)
+        {
+            GLfloat a = inst.R[c][r] * lMin[c];
+            GLfloat b = inst.R[c][r] * lMax[c];
+            inst.aabbMin[r] += std::min(a, b);
+            inst.aabbMax[r] += std::max(a, b);
+        }
+    instances.push_back(inst);
+    nTriangles += bvh->getNumOfTriangles();
+}
+
+void RayTracingScene::Trace(RayPacket& packet) const
+{
+    for(int i=0; i<RAY_PACKET_SIZE; ++i)
+        packet.hit[i] = -1;
+    
+    RayPacket local;
+    for(size_t k=0; k<instances.size(); ++k)
+    {
+        const RayTracingInstance& inst = instances[k];
+        if(!BVH::IntersectAABB(packet, inst.aabbMin, inst.aabbMax))
+            continue;
+        
+        //Transform rays to the mesh frame (R^T * (x - p))
+        #pragma omp simd
+        for(int i=0; i<RAY_PACKET_SIZE; ++i)
+        {
+            GLfloat ox = packet.ox[i] - inst.p.x;
+            GLfloat oy = packet.oy[i] - inst.p.y;
+            GLfloat oz = packet.oz[i] - inst.p.z;
+            local.ox[i] = inst.R[0].x * ox + inst.R[0].y * oy + inst.R[0].z * oz;
+            local.oy[i] = inst.R[1].x * ox + inst.R[1].y * oy + inst.R[1].z * oz;
+            local.oz[i] = inst.R[2].x * ox + inst.R[2].y * oy + inst.R[2].z * oz;
+            local.dx[i] = inst.R[0].x * packet.dx[i] + inst.R[0].y * packet.dy[i] + inst.R[0].z * packet.dz[i];
+            local.dy[i] = inst.R[1].x * packet.dx[i] + inst.R[1].y * packet.dy[i] + inst.R[1].z * packet.dz[i];
+            local.dz[i] = inst.R[2].x * packet.dx[i] + inst.R[2].y * packet.dy[i] + inst.R[2].z * packet.dz[i];
+            local.t[i] = packet.t[i];
+            local.hit[i] = -1;
+        }
+        
+        if(!inst.bvh->Intersect(local, (GLint)k))
+            continue;
+        
+        //Rotate normals back to world frame for closer hits
+        for(int i=0; i<RAY_PACKET_SIZE; ++i)
+        {
+            if(local.hit[i] < 0)
+                continue;
+            glm::vec3 n = inst.R[0] * local.nx[i] + inst.R[1] * local.ny[i] + inst.R[2] * local.nz[i];
+            packet.t[i] = local.t[i];
+            packet.nx[i] = n.x;
+            packet.ny[i] = n.y;
+            packet.nz[i] = n.z;
+            packet.hit[i] = local.hit[i];
+        }
+    }
+}
+
+void RayTracingScene::TraceRays(const glm::vec3& origin, const glm::vec3* directions, size_t count, GLfloat maxDistance, RayHit* hits) const
+{
+    int64_t start = GetTimeInMicroseconds();
+    int nPackets = (int)((count + RAY_PACKET_SIZE - 1)/RAY_PACKET_SIZE);
+    
+    #pragma omp parallel for schedule(dynamic, 16)
+    for(int k=0; k<nPackets; ++k)
+    {
+        RayPacket packet;
+        size_t first = (size_t)k * RAY_PACKET_SIZE;
+        for(int i=0; i<RAY_PACKET_SIZE; ++i)
+        {
+            size_t id = first + i;
+            packet.ox[i] = origin.x;
+            packet.oy[i] = origin.y;
+            packet.oz[i] = origin.z;
+            if(id < count)
+            {
+                packet.dx[i] = directions[id].x;
+                packet.dy[i] = directions[id].y;
+                packet.dz[i] = directions[id].z;
+                packet.t[i] = maxDistance;
+            }
+            else //Padding lanes never hit anything
+            {
+                packet.dx[i] = 0.f;
+                packet.dy[i] = 0.f;
+                packet.dz[i] = 1.f;
+                packet.t[i] = 0.f;
+            }
+        }
+        
+        Trace(packet);
+        
+        for(int i=0; i<RAY_PACKET_SIZE && first + i < count; ++i)
+        {
+            RayHit& h = hits[first + i];
+            h.distance = packet.t[i];
+            h.instance = packet.hit[i];
+            if(h.instance >= 0)
+            {
+                glm::vec3 n(packet.nx[i], packet.ny[i], packet.nz[i]);
+                GLfloat len = glm::length(n);
+                h.normal = len > FLT_EPSILON ? n/len : glm::vec3(0.f);
+            }
+            else
+                h.normal = glm::vec3(0.f);
+        }
+    }
+    
+    nRays += count;
+    traceTime += (uint64_t)(GetTimeInMicroseconds() - start);
+}
+
+const RayTracingInstance& RayTracingScene::getInstance(size_t index) const
+{
+    return instances.at(index);
+}
+
+size_t RayTracingScene::getNumOfInstances() const
+{
+    return instances.size();
+}
+
+RayTracingStatistics RayTracingScene::getStatistics() const
+{
+    RayTracingStatistics stats;
+    stats.rays = nRays;
+    stats.traceTime = traceTime;
+    stats.instances = instances.size();
+    stats.triangles = nTriangles;
+    return stats;
+}
+
+}
@@ -0,0 +1,270 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RemoteControlClient.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/RemoteControlClient.h"
+
+#include "utils/SocketUtil.h"
+
+namespace sf
+{
+
+RemoteControlClient::RemoteControlClient() : clientSocket(-1), batchSize(0)
+{
+}
+
+RemoteControlClient::~RemoteControlClient()
+{
+    Disconnect();
+}
+
+bool RemoteControlClient::Connect(uint16_t port)
+{
+    Disconnect();
+    clientSocket = ConnectSocket(port);
+    return clientSocket >= 0;
+}
+
+bool RemoteControlClient::Connect(const std::string& socketPath)
+{
+    Disconnect();
+    clientSocket = ConnectSocket(socketPath);
+    return clientSocket >= 0;
+}
+
+void RemoteControlClient::Disconnect()
+{
+    CloseSocket(clientSocket);
+    clientSocket = -1;
+}
+
+bool RemoteControlClient::isConnected() const
+{
+    return clientSocket >= 0;
+}
+
+unsigned int RemoteControlClient::getBatchSize() const
+{
+    return batchSize;
+}
+
+void RemoteControlClient::AddCommand(RemoteCommand cmd)
+{
+    batch.Write((uint8_t)cmd);
+    ++batchSize;
+}
+
+void RemoteControlClient::AddIndices(RemoteCommand cmd, const std::vector<uint16_t>& indices)
+{
+    AddCommand(cmd);
+    batch.Write((uint16_t)indices.size());
+    batch.WriteBytes(indices.data(), indices.size() * sizeof(uint16_t));
+}
+
+void RemoteControlClient::Info()
+{
+    AddCommand(RemoteCommand::INFO);
+}
+
+void RemoteControlClient::Step(uint32_t steps)
+{
+    AddCommand(RemoteCommand::STEP);
+    batch.Write(steps);
+}
+
+void RemoteControlClient::Pause()
+{
+    AddCommand(RemoteCommand::PAUSE);
+}
+
+void RemoteControlClient::Resume()
+{
+    AddCommand(RemoteCommand::RESUME);
+}
+
+void RemoteControlClient::Reset(uint32_t seed)
+{
+    AddCommand(RemoteCommand::RESET);
+    batch.Write(seed);
+}
+
+void RemoteControlClient::SetActuators(const std::vector<RemoteSetpoint>& setpoints)
+{
+    AddCommand(RemoteCommand::SET_ACTUATORS);
+    batch.Write((uint16_t)setpoints.size());
+    for(size_t i=0; i<setpoints.size(); ++i)
+    {
+        batch.Write(setpoints[i].index);
+        batch.Write(setpoints[i].channel);
+        batch.Write(setpoints[i].value);
+    }
+}
+
+void RemoteControlClient::GetSensors(const std::vector<uint16_t>& indices)
+{
+    AddIndices(RemoteCommand::GET_SENSORS, indices);
+}
+
+void RemoteControlClient::GetBodies(const std::vector<uint16_t>& indices)
+{
+    AddIndices(RemoteCommand::GET_BODIES, indices);
+}
+
+void RemoteControlClient::GetTime()
+{
+    AddCommand(RemoteCommand::GET_TIME);
+}
+
+void RemoteControlClient::Quit()
+{
+    AddCommand(RemoteCommand::QUIT);
+}
+
+bool RemoteControlClient::Execute(std::vector<RemoteResult>& results)
+{
+    results.clear();
+    if(clientSocket < 0)
+        return false;
+    
+    //Send request
+    uint32_t header[2] = {REMOTE_CONTROL_MAGIC, (uint32_t)batch.getSize()};
+    bool sent = SendAll(clientSocket, header, sizeof(header)) && SendAll(clientSocket, batch.getData(), batch.getSize());
+    batch.Clear();
+    batchSize = 0;
+    
+    //Receive response
+    if(!sent || !ReceiveAll(clientSocket, header, sizeof(header))
+       || header[0] != REMOTE_CONTROL_MAGIC || header[1] > REMOTE_CONTROL_MAX_FRAME)
+    {
+        Disconnect();
+        return false;
+    }
+    std::vector<uint8_t> payload(header[1]);
+    if(!ReceiveAll(clientSocket, payload.data(), payload.size()))
+    {
+        Disconnect();
+        return false;
+    }
+    response.Clear();
+    response.WriteBytes(payload.data(), payload.size());
+    
+    while(response.getRemainingSize() > 0)
+    {
+        results.push_back(RemoteResult());
+        if(!ParseResult(response, results.back()))
+            return false;
+    }
+    return true;
+}
+
+bool RemoteControlClient::ParseResult(SimulationState& response, RemoteResult& result)
+{
+    uint8_t code, status;
+    response.Read(code);
+    response.Read(status);
+    result.command = (RemoteCommand)code;
+    result.status = (RemoteStatus)status;
+    if(result.status != RemoteStatus::OK)
+        return response.isValid();
+    
+    switch(result.command)
+    {
+        case RemoteCommand::INFO:
+        {
+            std::vector<RemoteObjectInfo>* lists[3] = {&result.actuatorsInfo, &result.sensorsInfo, &result.entitiesInfo};
+            for(unsigned int l=0; l<3; ++l)
+            {
+                uint16_t count = 0;
+                response.Read(count);
+                for(uint16_t i=0; i<count && response.isValid(); ++i)
+                {
+                    RemoteObjectInfo info;
+                    info.channels = 0;
+                    response.Read(info.type);
+                    if(l == 1)
+                        response.Read(info.channels);
+                    response.ReadString(info.name);
+                    lists[l]->push_back(info);
+                }
+            }
+        }
+            break;
+            
+        case RemoteCommand::STEP:
+            response.Read(result.time);
+            break;
+            
+        case RemoteCommand::SET_ACTUATORS:
+            response.Read(result.count);
+            break;
+            
+        case RemoteCommand::GET_SENSORS:
+        {
+            response.Read(result.count);
+            result.sensors.resize(result.count);
+            for(uint16_t i=0; i<result.count && response.isValid(); ++i)
+            {
+                RemoteSensorData& s = result.sensors[i];
+                uint16_t channels = 0;
+                response.Read(s.index);
+                response.Read(channels);
+                response.Read(s.timestamp);
+                s.values.resize(channels);
+                response.ReadBytes(s.values.data(), channels * sizeof(double));
+            }
+        }
+            break;
+            
+        case RemoteCommand::GET_BODIES:
+        {
+            response.Read(result.count);
+            result.bodies.resize(result.count);
+            for(uint16_t i=0; i<result.count && response.isValid(); ++i)
+            {
+                RemoteBodyData& b = result.bodies[i];
+                response.Read(b.index);
+                response.ReadBytes(b.position, sizeof(b.position));
+                response.ReadBytes(b.orientation, sizeof(b.orientation));
+                response.ReadBytes(b.linearVelocity, sizeof(b.linearVelocity));
+                response.ReadBytes(b.angularVelocity, sizeof(b.angularVelocity));
+            }
+        }
+            break;
+            
+        case RemoteCommand::GET_TIME:
+        {
+            uint8_t running = 0;
+            response.Read(result.time);
+            response.Read(running);
+            result.running = running != 0;
+        }
+            break;
+            
+        default:
+            break;
+    }
+    return response.isValid();
+}
+
+}
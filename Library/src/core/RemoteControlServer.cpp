@@ -0,0 +1,477 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RemoteControlServer.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/RemoteControlServer.h"
+
+#include <cstdio>
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "core/SimulationState.h"
+#include "entities/MovingEntity.h"
+#include "entities/FeatherstoneEntity.h"
+#include "sensors/ScalarSensor.h"
+#include "sensors/Sample.h"
+#include "actuators/Thruster.h"
+#include "actuators/Propeller.h"
+#include "actuators/Rudder.h"
+#include "actuators/Motor.h"
+#include "actuators/Servo.h"
+#include "actuators/VariableBuoyancy.h"
+#include "actuators/Push.h"
+#include "actuators/SuctionCup.h"
+#include "utils/SocketUtil.h"
+
+#define REMOTE_POLL_TIMEOUT   250 //Time after which the server checks if it should stop [ms]
+#define REMOTE_CLIENT_TIMEOUT 5000 //Maximum time of receiving or sending a frame [ms]
+
+namespace sf
+{
+
+RemoteControlServer::RemoteControlServer(uint16_t port)
+{
+    listenSocket = OpenServerSocket(port);
+    if(!SocketsSupported())
+        cError("Remote control not supported on this platform!");
+    else if(listenSocket < 0)
+        cError("Remote control server could not listen on port %u!", (unsigned int)port);
+    Start();
+}
+
+RemoteControlServer::RemoteControlServer(const std::string& socketPath) : socketPath(socketPath)
+{
+    listenSocket = OpenServerSocket(socketPath);
+    if(!SocketsSupported())
+        cError("Remote control not supported on this platform!");
+    else if(listenSocket < 0)
+        cError("Remote control server could not listen on '%s'!", socketPath.c_str());
+    Start();
+}
+
+RemoteControlServer::~RemoteControlServer()
+{
+    stop = true;
+    if(thread != nullptr)
+        SDL_WaitThread(thread, NULL);
+    if(listenSocket >= 0)
+    {
+        CloseSocket(listenSocket);
+        if(!socketPath.empty())
+            std::remove(socketPath.c_str());
+    }
+    delete output;
+}
+
+void RemoteControlServer::Start()
+{
+    thread = nullptr;
+    stop = false;
+    requests = 0;
+    output = new SimulationState();
+    app = SimulationApp::getApp();
+    sim = app != nullptr ? app->getSimulationManager() : nullptr;
+    
+    if(listenSocket >= 0 && sim != nullptr)
+        thread = SDL_CreateThread(RemoteControlServer::RunServer, "remoteControlServer", this);
+}
+
+bool RemoteControlServer::isRunning() const
+{
+    return thread != nullptr;
+}
+
+uint64_t RemoteControlServer::getRequestsCount() const
+{
+    return requests;
+}
+
+int RemoteControlServer::RunServer(void* data)
+{
+    RemoteControlServer* server = (RemoteControlServer*)data;
+    while(!server->stop)
+    {
+        int client = AcceptConnection(server->listenSocket, REMOTE_POLL_TIMEOUT);
+        if(client < 0)
+            continue;
+        server->Serve(client);
+        CloseSocket(client);
+    }
+    return 0;
+}
+
+void RemoteControlServer::Serve(int client)
+{
+    SetSocketTimeout(client, REMOTE_CLIENT_TIMEOUT);
+    SimulationState request;
+    SimulationState response;
+    SimulationState frame;
+    std::vector<uint8_t> payload;
+    
+    while(!stop)
+    {
+        if(!WaitForData(client, REMOTE_POLL_TIMEOUT))
+            continue;
+        
+        //Receive request
+        uint32_t header[2];
+        if(!ReceiveAll(client, header, sizeof(header)))
+            break; //Connection closed
+        if(header[0] != REMOTE_CONTROL_MAGIC || header[1] > REMOTE_CONTROL_MAX_FRAME)
+        {
+            cError("Remote control received an invalid frame!");
+            break;
+        }
+        payload.resize(header[1]);
+        if(!ReceiveAll(client, payload.data(), payload.size()))
+            break;
+        request.Clear();
+        request.WriteBytes(payload.data(), payload.size());
+        
+        //Execute and respond
+        response.Clear();
+        ProcessRequest(request, response);
+        frame.Clear();
+        frame.Write((uint32_t)REMOTE_CONTROL_MAGIC);
+        frame.Write((uint32_t)response.getSize());
+        frame.WriteBytes(response.getData(), response.getSize());
+        if(!SendAll(client, frame.getData(), frame.getSize()))
+            break;
+        ++requests;
+    }
+}
+
+unsigned int RemoteControlServer::ProcessRequest(SimulationState& request, SimulationState& response)
+{
+    unsigned int executed = 0;
+    while(request.getRemainingSize() > 0)
+    {
+        uint8_t code;
+        request.Read(code);
+        RemoteCommand cmd = (RemoteCommand)code;
+        output->Clear();
+        RemoteStatus status = code <= (uint8_t)RemoteCommand::QUIT ? ExecuteCommand(cmd, request, *output) : RemoteStatus::UNKNOWN_COMMAND;
+        if(!request.isValid())
+            status = RemoteStatus::MALFORMED;
+        
+        response.Write(code);
+        response.Write((uint8_t)status);
+        if(status == RemoteStatus::OK)
+            response.WriteBytes(output->getData(), output->getSize());
+        else if(status == RemoteStatus::MALFORMED || status == RemoteStatus::UNKNOWN_COMMAND)
+            break; //Remaining data can not be interpreted
+        ++executed;
+    }
+    return executed;
+}
+
+RemoteStatus RemoteControlServer::ExecuteCommand(RemoteCommand cmd, SimulationState& request, SimulationState& response)
+{
+    switch(cmd)
+    {
+        case RemoteCommand::INFO:
+            return Info(response);
+            
+        case RemoteCommand::STEP:
+            return Step(request, response);
+            
+        case RemoteCommand::PAUSE:
+            app->Pause();
+            return RemoteStatus::OK;
+            
+        case RemoteCommand::RESUME:
+            app->Resume();
+            return RemoteStatus::OK;
+            
+        case RemoteCommand::RESET:
+        {
+            uint32_t seed;
+            request.Read(seed);
+            if(!request.isValid())
+                return RemoteStatus::MALFORMED;
+            return sim->ResetScenario(seed) ? RemoteStatus::OK : RemoteStatus::WRONG_STATE;
+        }
+            
+        case RemoteCommand::SET_ACTUATORS:
+            return SetActuators(request, response);
+            
+        case RemoteCommand::GET_SENSORS:
+            return GetSensors(request, response);
+            
+        case RemoteCommand::GET_BODIES:
+            return GetBodies(request, response);
+            
+        case RemoteCommand::GET_TIME:
+            response.Write((double)sim->getSimulationTime());
+            response.Write((uint8_t)app->isRunning());
+            return RemoteStatus::OK;
+            
+        case RemoteCommand::QUIT:
+            app->Exit();
+            return RemoteStatus::OK;
+    }
+    return RemoteStatus::UNKNOWN_COMMAND;
+}
+
+RemoteStatus RemoteControlServer::Info(SimulationState& response)
+{
+    SDL_LockMutex(sim->getSimSettingsMutex());
+    response.Write((uint16_t)sim->getNumOfActuators());
+    for(size_t i=0; i<sim->getNumOfActuators(); ++i)
+    {
+        response.Write((uint8_t)sim->getActuator(i)->getType());
+        response.WriteString(sim->getActuator(i)->getName());
+    }
+    response.Write((uint16_t)sim->getNumOfSensors());
+    for(size_t i=0; i<sim->getNumOfSensors(); ++i)
+    {
+        Sensor* sens = sim->getSensor(i);
+        response.Write((uint8_t)sens->getType());
+        response.Write((uint16_t)(sens->getType() != SensorType::VISION ? ((ScalarSensor*)sens)->getNumOfChannels() : 0));
+        response.WriteString(sens->getName());
+    }
+    response.Write((uint16_t)sim->getNumOfEntities());
+    for(size_t i=0; i<sim->getNumOfEntities(); ++i)
+    {
+        response.Write((uint8_t)sim->getEntity(i)->getType());
+        response.WriteString(sim->getEntity(i)->getName());
+    }
+    SDL_UnlockMutex(sim->getSimSettingsMutex());
+    return RemoteStatus::OK;
+}
+
+RemoteStatus RemoteControlServer::Step(SimulationState& request, SimulationState& response)
+{
+    uint32_t steps;
+    request.Read(steps);
+    if(!request.isValid())
+        return RemoteStatus::MALFORMED;
+    if(app->isRunning())
+        return RemoteStatus::WRONG_STATE; //Stepping is only possible when the simulation thread is paused
+    
+    if(sim->isSimulationFresh() && !sim->StartSimulation())
+        return RemoteStatus::WRONG_STATE;
+    if(!sim->StepSimulation(steps))
+        return RemoteStatus::WRONG_STATE; //Initial conditions not solved
+    response.Write((double)sim->getSimulationTime());
+    return RemoteStatus::OK;
+}
+
+RemoteStatus RemoteControlServer::SetActuators(SimulationState& request, SimulationState& response)
+{
+    //Parse the whole command first, so that nothing is applied if any setpoint is invalid
+    uint16_t count;
+    request.Read(count);
+    std::vector<std::pair<Actuator*, std::pair<uint8_t, double>>> setpoints(count);
+    bool valid = true;
+    for(uint16_t i=0; i<count; ++i)
+    {
+        uint16_t index;
+        uint8_t channel;
+        double value;
+        request.Read(index);
+        request.Read(channel);
+        request.Read(value);
+        Actuator* act = sim->getActuator(index);
+        if(act == nullptr || channel > (act->getType() == ActuatorType::SERVO ? 3 : 0)
+           || act->getType() == ActuatorType::LIGHT)
+            valid = false;
+        setpoints[i] = std::make_pair(act, std::make_pair(channel, value));
+    }
+    if(!request.isValid())
+        return RemoteStatus::MALFORMED;
+    if(!valid)
+        return RemoteStatus::INVALID_ARGUMENT;
+    
+    SDL_LockMutex(sim->getSimSettingsMutex());
+    for(size_t i=0; i<setpoints.size(); ++i)
+    {
+        Actuator* act = setpoints[i].first;
+        uint8_t channel = setpoints[i].second.first;
+        Scalar value = (Scalar)setpoints[i].second.second;
+        switch(act->getType())
+        {
+            case ActuatorType::THRUSTER:
+                ((Thruster*)act)->setSetpoint(value);
+                break;
+                
+            case ActuatorType::PROPELLER:
+                ((Propeller*)act)->setSetpoint(value);
+                break;
+                
+            case ActuatorType::RUDDER:
+                ((Rudder*)act)->setSetpoint(value);
+                break;
+                
+            case ActuatorType::MOTOR:
+                ((Motor*)act)->setIntensity(value);
+                break;
+                
+            case ActuatorType::VBS:
+                ((VariableBuoyancy*)act)->setFlowRate(value);
+                break;
+                
+            case ActuatorType::PUSH:
+                ((Push*)act)->setForce(value);
+                break;
+                
+            case ActuatorType::SUCTION_CUP:
+                ((SuctionCup*)act)->setPump(value != Scalar(0));
+                break;
+                
+            case ActuatorType::SERVO:
+            {
+                Servo* srv = (Servo*)act;
+                switch(channel)
+                {
+                    case 0:
+                        srv->setDesiredPosition(value);
+                        break;
+                    case 1:
+                        srv->setDesiredVelocity(value);
+                        break;
+                    case 2:
+                        srv->setMaxTorque(value);
+                        break;
+                    default:
+                        srv->setControlMode((ServoControlMode)btClamped((int)value, 0, 2));
+                        break;
+                }
+            }
+                break;
+                
+            default:
+                break;
+        }
+    }
+    SDL_UnlockMutex(sim->getSimSettingsMutex());
+    response.Write(count);
+    return RemoteStatus::OK;
+}
+
+RemoteStatus RemoteControlServer::GetSensors(SimulationState& request, SimulationState& response)
+{
+    uint16_t count;
+    request.Read(count);
+    std::vector<uint16_t> indices(count);
+    for(uint16_t i=0; i<count; ++i)
+        request.Read(indices[i]);
+    if(!request.isValid())
+        return RemoteStatus::MALFORMED;
+    
+    SDL_LockMutex(sim->getSimSettingsMutex());
+    if(count == 0)
+    {
+        for(size_t i=0; i<sim->getNumOfSensors(); ++i)
+            if(sim->getSensor(i)->getType() != SensorType::VISION)
+                indices.push_back((uint16_t)i);
+    }
+    else
+    {
+        for(uint16_t i=0; i<count; ++i)
+            if(indices[i] >= sim->getNumOfSensors() || sim->getSensor(indices[i])->getType() == SensorType::VISION)
+            {
+                SDL_UnlockMutex(sim->getSimSettingsMutex());
+                return RemoteStatus::INVALID_ARGUMENT;
+            }
+    }
+    
+    response.Write((uint16_t)indices.size());
+    for(size_t i=0; i<indices.size(); ++i)
+    {
+        Sample s = ((ScalarSensor*)sim->getSensor(indices[i]))->getLastSample();
+        uint16_t channels = s.getNumOfDimensions();
+        response.Write(indices[i]);
+        response.Write(channels);
+        response.Write((double)s.getTimestamp());
+        for(uint16_t h=0; h<channels; ++h)
+            response.Write((double)s.getValue(h));
+    }
+    SDL_UnlockMutex(sim->getSimSettingsMutex());
+    return RemoteStatus::OK;
+}
+
+RemoteStatus RemoteControlServer::GetBodies(SimulationState& request, SimulationState& response)
+{
+    auto isMoving = [](Entity* ent)
+    {
+        return ent->getType() == EntityType::SOLID || ent->getType() == EntityType::ANIMATED || ent->getType() == EntityType::FEATHERSTONE;
+    };
+    
+    uint16_t count;
+    request.Read(count);
+    std::vector<uint16_t> indices(count);
+    for(uint16_t i=0; i<count; ++i)
+        request.Read(indices[i]);
+    if(!request.isValid())
+        return RemoteStatus::MALFORMED;
+    
+    SDL_LockMutex(sim->getSimSettingsMutex());
+    if(count == 0)
+    {
+        for(size_t i=0; i<sim->getNumOfEntities(); ++i)
+            if(isMoving(sim->getEntity(i)))
+                indices.push_back((uint16_t)i);
+    }
+    else
+    {
+        for(uint16_t i=0; i<count; ++i)
+            if(indices[i] >= sim->getNumOfEntities() || !isMoving(sim->getEntity(indices[i])))
+            {
+                SDL_UnlockMutex(sim->getSimSettingsMutex());
+                return RemoteStatus::INVALID_ARGUMENT;
+            }
+    }
+    
+    response.Write((uint16_t)indices.size());
+    for(size_t i=0; i<indices.size(); ++i)
+    {
+        Entity* ent = sim->getEntity(indices[i]);
+        Transform T;
+        Vector3 v, w;
+        if(ent->getType() == EntityType::FEATHERSTONE)
+        {
+            FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
+            T = fe->getLinkTransform(0);
+            v = fe->getLinkLinearVelocity(0);
+            w = fe->getLinkAngularVelocity(0);
+        }
+        else
+        {
+            MovingEntity* me = (MovingEntity*)ent;
+            T = me->getOTransform();
+            v = me->getLinearVelocity();
+            w = me->getAngularVelocity();
+        }
+        Quaternion q = T.getRotation();
+        double values[13] = {T.getOrigin().getX(), T.getOrigin().getY(), T.getOrigin().getZ(),
+                             q.getX(), q.getY(), q.getZ(), q.getW(),
+                             v.getX(), v.getY(), v.getZ(), w.getX(), w.getY(), w.getZ()};
+        response.Write(indices[i]);
+        response.WriteBytes(values, sizeof(values));
+    }
+    SDL_UnlockMutex(sim->getSimSettingsMutex());
+    return RemoteStatus::OK;
+}
+
+}
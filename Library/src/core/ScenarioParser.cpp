@@ -80,7 +80,9 @@
 #include "comms/USBLReal.h"
 #include "joints/FixedJoint.h"
 #include "graphics/OpenGLDataStructs.h"
+#include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
+#include "utils/GeometryFileUtil.h"
 #include "tinyexpr.h"
 
 namespace sf
@@ -102,129 +104,44 @@ SimulationManager* ScenarioParser::getSimulationManager()
 }
 
 bool ScenarioParser::Parse(std::string filename)
+{
+    bool compiled = IsCompiled(filename);
+    if(!compiled)
+        return ParseScenario(filename, false);
+    
+    //Meshes of a compiled scenario are served from the mesh cache while the scenario is built
+    bool caching = OpenGLContent::isMeshCaching();
+    OpenGLContent::setMeshCaching(true);
+    bool success = ParseScenario(filename, true);
+    OpenGLContent::setMeshCaching(caching);
+    if(!caching)
+        OpenGLContent::ClearMeshCache();
+    return success;
+}
+
+bool ScenarioParser::ParseScenario(const std::string& filename, bool compiled)
 {
     cInfo("Scenario parser: Loading scenario from '%s'.", filename.c_str());
     log.Print(MessageType::INFO, "Scenario file: %s", filename.c_str());
+    int64_t startTime = GetTimeInMicroseconds();
     
-    //Open file
-    XMLError result = doc.LoadFile(filename.c_str());
-    if(result != XML_SUCCESS)
+    //Load compiled scenario or pre-process the XML description
+    if(compiled)
     {
-        switch(result)
-        {
-            case XMLError::XML_ERROR_FILE_NOT_FOUND:
-            {
-                cInfo("Scenario parser: File not found!");
-                log.Print(MessageType::ERROR, "File not found!");
-            }
-                break;
-
-            default:
-            {
-                cInfo("Scenario parser: Syntax error in file!");
-                log.Print(MessageType::ERROR, "Syntax error in file!");
-            }
-                break;
-        }
-        return false;
+        if(!LoadCompiled(filename))
+            return false;
     }
+    else if(!LoadFile(filename))
+        return false;
+    int64_t loadTime = GetTimeInMicroseconds();
     
-    //Find root node
     XMLNode* root = doc.FirstChildElement("scenario");
     if(root == nullptr)
     {
         log.Print(MessageType::ERROR, "Root node not found!");
         return false;
     }
-    
-    if(!PreProcess(root))
-    {
-        log.Print(MessageType::ERROR, "Pre-processing failed!");
-        return false;
-    }
-
-    //Include other scenario files
-    XMLElement* element = root->FirstChildElement("include");
-    while(element != nullptr)
-    {
-        //Get file path
-        const char* path = nullptr;
-        if(element->QueryStringAttribute("file", &path) != XML_SUCCESS)
-        {
-            log.Print(MessageType::ERROR, "Include not properly defined!");
-            return false;
-        }
-        
-        //Read optional arguments
-        std::map<std::string, std::string> args;	
-		XMLElement* argElement = element->FirstChildElement("arg");
-		while(argElement != nullptr)
-        {
-			const char* name = argElement->Attribute("name");
-			const char* value = argElement->Attribute("value");
-			
-			if(value == nullptr || name == nullptr)
-			{
-			    log.Print(MessageType::ERROR, "Include file argument not properly defined!");
-				return false;
-			}
-
-			args.insert(std::make_pair(std::string(name), std::string(value)));
-			argElement = argElement->NextSiblingElement("arg");
-		}
-
-        //Load file
-        std::string includedPath = GetFullPath(std::string(path));
-        XMLDocument includedDoc;
-        result = includedDoc.LoadFile(includedPath.c_str());
-        if(result != XML_SUCCESS)
-        {
-            switch(result)
-            {
-                case XMLError::XML_ERROR_FILE_NOT_FOUND:
-                {
-                    cInfo("Scenario parser: Included file not found!");
-                    log.Print(MessageType::ERROR, "Included file '%s' not found!", includedPath.c_str());
-                }
-                    break;
-
-                default:
-                {
-                    cInfo("Scenario parser: Syntax error in included file!");
-                    log.Print(MessageType::ERROR, "Syntax error in included file '%s'!", includedPath.c_str());
-                }
-                    break;
-            }
-            return false;
-        }
-        cInfo("Scenario parser: Including file '%s'", includedPath.c_str());
-        log.Print(MessageType::INFO, "Including file '%s'", includedPath.c_str());
-        
-        root->DeleteChild(element); //Delete "include" element
-        
-        XMLNode* includedRoot = includedDoc.FirstChildElement("scenario");
-        if(includedRoot == nullptr)
-        {
-            log.Print(MessageType::ERROR, "Root node not found in included file '%s'!", includedPath.c_str());
-            return false;
-        }
-        
-        if(!PreProcess(includedRoot, args))
-        {
-            log.Print(MessageType::ERROR, "Pre-processing of included file '%s' failed!", includedPath.c_str());
-            return false;
-        }
-        
-        for(const XMLNode* child = includedRoot->FirstChild(); child != nullptr; child = child->NextSibling())
-        {
-            if(!CopyNode(root, child))
-            {
-                log.Print(MessageType::ERROR, "Could not copy included XML elements!");
-                return false;
-            }
-        }
-        element = root->FirstChildElement("include");
-    }
+    XMLElement* element;
 
     //Load solver settings
     element = root->FirstChildElement("solver");
@@ -411,10 +328,276 @@ bool ScenarioParser::Parse(std::string filename)
         element = element->NextSiblingElement("contact");
     }
     
+    int64_t endTime = GetTimeInMicroseconds();
+    cInfo("Scenario parser: %s scenario loaded in %.3lf ms (%s: %.3lf ms, building: %.3lf ms).", 
+          compiled ? "Compiled" : "XML", (endTime - startTime)/1000.0,
+          compiled ? "snapshot" : "pre-processing", (loadTime - startTime)/1000.0, (endTime - loadTime)/1000.0);
     log.Print(MessageType::INFO, "Parsing finished normally.");
     return true;
 }
 
+bool ScenarioParser::ParseAndCompile(std::string filename, std::string compiledFilename)
+{
+    bool caching = OpenGLContent::isMeshCaching();
+    OpenGLContent::setMeshCaching(true);
+    bool success = Parse(filename) && SaveCompiled(compiledFilename);
+    OpenGLContent::setMeshCaching(caching);
+    if(!caching)
+        OpenGLContent::ClearMeshCache();
+    return success;
+}
+
+bool ScenarioParser::SaveCompiled(std::string filename)
+{
+    if(doc.FirstChildElement("scenario") == nullptr)
+    {
+        cError("Scenario parser: No scenario to compile!");
+        return false;
+    }
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if(file == nullptr)
+    {
+        cError("Scenario parser: Failed to open file '%s' for writing!", filename.c_str());
+        return false;
+    }
+
+    XMLPrinter printer(nullptr, true);
+    doc.Print(&printer);
+    uint64_t xmlSize = (uint64_t)printer.CStrSize() - 1;
+    const std::map<std::string, Mesh*>& meshes = OpenGLContent::getMeshCache();
+    uint32_t version = SCENARIO_COMPILED_VERSION;
+    uint32_t nMeshes = (uint32_t)meshes.size();
+    
+    bool success = fwrite(SCENARIO_COMPILED_MAGIC, 1, 8, file) == 8
+                   && fwrite(&version, sizeof(uint32_t), 1, file) == 1
+                   && fwrite(&xmlSize, sizeof(uint64_t), 1, file) == 1
+                   && fwrite(printer.CStr(), 1, xmlSize, file) == xmlSize
+                   && fwrite(&nMeshes, sizeof(uint32_t), 1, file) == 1;
+    
+    for(std::map<std::string, Mesh*>::const_iterator it = meshes.begin(); success && it != meshes.end(); ++it)
+    {
+        uint32_t keySize = (uint32_t)it->first.size();
+        success = fwrite(&keySize, sizeof(uint32_t), 1, file) == 1
+                  && fwrite(it->first.data(), 1, keySize, file) == keySize
+                  && WriteMeshBinary(file, it->second);
+    }
+    fclose(file);
+
+    if(!success)
+    {
+        cError("Scenario parser: Failed to write compiled scenario to '%s'!", filename.c_str());
+        return false;
+    }
+    cInfo("Scenario parser: Compiled scenario saved to '%s' (%u meshes).", filename.c_str(), nMeshes);
+    return true;
+}
+
+bool ScenarioParser::IsCompiled(const std::string& filename)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if(file == nullptr)
+        return false;
+    char magic[8];
+    bool compiled = fread(magic, 1, 8, file) == 8 && memcmp(magic, SCENARIO_COMPILED_MAGIC, 8) == 0;
+    fclose(file);
+    return compiled;
+}
+
+bool ScenarioParser::LoadCompiled(const std::string& filename)
+{
+    FILE* file = fopen(filename.c_str(), "rb");
+    if(file == nullptr)
+    {
+        cInfo("Scenario parser: File not found!");
+        log.Print(MessageType::ERROR, "File not found!");
+        return false;
+    }
+
+    char magic[8];
+    uint32_t version;
+    uint64_t xmlSize;
+    if(fread(magic, 1, 8, file) != 8 
+       || fread(&version, sizeof(uint32_t), 1, file) != 1
+       || version != SCENARIO_COMPILED_VERSION
+       || fread(&xmlSize, sizeof(uint64_t), 1, file) != 1)
+    {
+        fclose(file);
+        cInfo("Scenario parser: Unsupported compiled scenario version!");
+        log.Print(MessageType::ERROR, "Unsupported compiled scenario version!");
+        return false;
+    }
+
+    if(xmlSize > FileBytesLeft(file))
+    {
+        fclose(file);
+        log.Print(MessageType::ERROR, "Compiled scenario file corrupted!");
+        return false;
+    }
+    std::string xml(xmlSize, '\0');
+    uint32_t nMeshes;
+    if(fread(&xml[0], 1, xmlSize, file) != xmlSize
+       || fread(&nMeshes, sizeof(uint32_t), 1, file) != 1)
+    {
+        fclose(file);
+        log.Print(MessageType::ERROR, "Compiled scenario file corrupted!");
+        return false;
+    }
+
+    for(uint32_t i=0; i<nMeshes; ++i)
+    {
+        uint32_t keySize;
+        std::string key;
+        Mesh* mesh = nullptr;
+        if(fread(&keySize, sizeof(uint32_t), 1, file) == 1 && keySize <= FileBytesLeft(file))
+        {
+            key.resize(keySize);
+            if(keySize == 0 || fread(&key[0], 1, keySize, file) == keySize)
+                mesh = ReadMeshBinary(file);
+        }
+        if(mesh == nullptr)
+        {
+            fclose(file);
+            log.Print(MessageType::ERROR, "Compiled scenario file corrupted!");
+            return false;
+        }
+        OpenGLContent::AddMeshToCache(key, mesh);
+    }
+    fclose(file);
+    
+    if(doc.Parse(xml.c_str(), xmlSize) != XML_SUCCESS)
+    {
+        log.Print(MessageType::ERROR, "Compiled scenario file corrupted!");
+        return false;
+    }
+    log.Print(MessageType::INFO, "Compiled scenario with %u processed meshes.", nMeshes);
+    return true;
+}
+
+bool ScenarioParser::LoadFile(const std::string& filename)
+{
+    //Open file
+    XMLError result = doc.LoadFile(filename.c_str());
+    if(result != XML_SUCCESS)
+    {
+        switch(result)
+        {
+            case XMLError::XML_ERROR_FILE_NOT_FOUND:
+            {
+                cInfo("Scenario parser: File not found!");
+                log.Print(MessageType::ERROR, "File not found!");
+            }
+                break;
+
+            default:
+            {
+                cInfo("Scenario parser: Syntax error in file!");
+                log.Print(MessageType::ERROR, "Syntax error in file!");
+            }
+                break;
+        }
+        return false;
+    }
+    
+    //Find root node
+    XMLNode* root = doc.FirstChildElement("scenario");
+    if(root == nullptr)
+    {
+        log.Print(MessageType::ERROR, "Root node not found!");
+        return false;
+    }
+    
+    if(!PreProcess(root))
+    {
+        log.Print(MessageType::ERROR, "Pre-processing failed!");
+        return false;
+    }
+
+    //Include other scenario files
+    XMLElement* element = root->FirstChildElement("include");
+    while(element != nullptr)
+    {
+        //Get file path
+        const char* path = nullptr;
+        if(element->QueryStringAttribute("file", &path) != XML_SUCCESS)
+        {
+            log.Print(MessageType::ERROR, "Include not properly defined!");
+            return false;
+        }
+        
+        //Read optional arguments
+        std::map<std::string, std::string> args;	
+		XMLElement* argElement = element->FirstChildElement("arg");
+		while(argElement != nullptr)
+        {
+			const char* name = argElement->Attribute("name");
+			const char* value = argElement->Attribute("value");
+			
+			if(value == nullptr || name == nullptr)
+			{
+			    log.Print(MessageType::ERROR, "Include file argument not properly defined!");
+				return false;
+			}
+
+			args.insert(std::make_pair(std::string(name), std::string(value)));
+			argElement = argElement->NextSiblingElement("arg");
+		}
+
+        //Load file
+        std::string includedPath = GetFullPath(std::string(path));
+        XMLDocument includedDoc;
+        result = includedDoc.LoadFile(includedPath.c_str());
+        if(result != XML_SUCCESS)
+        {
+            switch(result)
+            {
+                case XMLError::XML_ERROR_FILE_NOT_FOUND:
+                {
+                    cInfo("Scenario parser: Included file not found!");
+                    log.Print(MessageType::ERROR, "Included file '%s' not found!", includedPath.c_str());
+                }
+                    break;
+
+                default:
+                {
+                    cInfo("Scenario parser: Syntax error in included file!");
+                    log.Print(MessageType::ERROR, "Syntax error in included file '%s'!", includedPath.c_str());
+                }
+                    break;
+            }
+            return false;
+        }
+        cInfo("Scenario parser: Including file '%s'", includedPath.c_str());
+        log.Print(MessageType::INFO, "Including file '%s'", includedPath.c_str());
+        
+        root->DeleteChild(element); //Delete "include" element
+        
+        XMLNode* includedRoot = includedDoc.FirstChildElement("scenario");
+        if(includedRoot == nullptr)
+        {
+            log.Print(MessageType::ERROR, "Root node not found in included file '%s'!", includedPath.c_str());
+            return false;
+        }
+        
+        if(!PreProcess(includedRoot, args))
+        {
+            log.Print(MessageType::ERROR, "Pre-processing of included file '%s' failed!", includedPath.c_str());
+            return false;
+        }
+        
+        for(const XMLNode* child = includedRoot->FirstChild(); child != nullptr; child = child->NextSibling())
+        {
+            if(!CopyNode(root, child))
+            {
+                log.Print(MessageType::ERROR, "Could not copy included XML elements!");
+                return false;
+            }
+        }
+        element = root->FirstChildElement("include");
+    }
+    return true;
+}
+
 bool ScenarioParser::SaveLog(std::string filename)
 {
     if(log.SaveToFile(filename))
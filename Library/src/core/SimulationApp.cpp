@@ -110,6 +110,24 @@ void SimulationApp::Run(bool autostart)
 	CleanUp();
 }
 
+void SimulationApp::Pause()
+{
+    if(running)
+        StopSimulation();
+}
+
+void SimulationApp::Resume()
+{
+    if(!running)
+        ResumeSimulation();
+}
+
+void SimulationApp::Exit()
+{
+    Pause();
+    Quit();
+}
+
 void SimulationApp::Loop()
 {
     startTime = GetTimeInMicroseconds();
@@ -25,6 +25,7 @@
 
 #include "core/SimulationManager.h"
 
+#include <random>
 #include "BulletDynamics/ConstraintSolver/btNNCGConstraintSolver.h"
 #include "BulletDynamics/MLCPSolvers/btDantzigSolver.h"
 #include "BulletDynamics/MLCPSolvers/btSolveProjectedGaussSeidel.h"
@@ -45,6 +46,8 @@
 #include "core/MaterialManager.h"
 #include "core/Robot.h"
 #include "core/NED.h"
+#include "core/SimulationState.h"
+#include "core/RayTracingScene.h"
 #include "graphics/OpenGLState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
@@ -53,6 +56,9 @@
 #include "utils/SystemUtil.hpp"
 #include "utils/UnitSystem.h"
 #include "utils/RayTest.hpp"
+#include "utils/ZoneProfiler.h"
+#include "utils/TelemetryRecorder.h"
+#include "utils/SharedMemoryBridge.h"
 #include "entities/Entity.h"
 //#include "entities/CableEntity.h"
 #include "entities/FeatherstoneEntity.h"
@@ -94,6 +100,7 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     currentTime = 0;
     simulationTime = 0;
     mlcpFallbacks = 0;
+    initialState = new SimulationState();
     dynamicsWorld = nullptr;
     mbSolver = nullptr;
     sbSolver = nullptr;
@@ -118,6 +125,9 @@ SimulationManager::SimulationManager(Scalar stepsPerSecond, SolverType st, Colli
     nameManager = new NameManager();
     materialManager = new MaterialManager();
     ned = new NED();
+    rtScene = nullptr;
+    telemetry = nullptr;
+    shmBridge = nullptr;
 }
 
 SimulationManager::~SimulationManager()
@@ -130,12 +140,22 @@ SimulationManager::~SimulationManager()
     delete materialManager;
     delete nameManager;
     delete ned;
+    if(rtScene != nullptr) delete rtScene;
+    delete initialState;
+    OpenGLContent::ClearMeshCache();
+}
+
+//Key of an unordered entity pair
+static inline std::pair<const Entity*, const Entity*> OrderedPair(const Entity* entA, const Entity* entB)
+{
+    return std::less<const Entity*>()(entA, entB) ? std::make_pair(entA, entB) : std::make_pair(entB, entA);
 }
 
 void SimulationManager::AddRobot(Robot* robot, const Transform& worldTransform)
 {
     if(robot != nullptr)
     {
+        robotIds.emplace(robot->getName(), robots.size());
         robots.push_back(robot);
         robot->AddToSimulation(this, worldTransform);
     }
@@ -145,6 +165,7 @@ void SimulationManager::AddEntity(Entity *ent)
 {
     if(ent != nullptr)
     {
+        entityIds.emplace(ent->getName(), entities.size());
         entities.push_back(ent);
         ent->AddToSimulation(this);
     }
@@ -154,6 +175,7 @@ void SimulationManager::AddStaticEntity(StaticEntity* ent, const Transform& orig
 {
     if(ent != nullptr)
     {
+        entityIds.emplace(ent->getName(), entities.size());
         entities.push_back(ent);
         ent->AddToSimulation(this, origin);
     }
@@ -163,6 +185,7 @@ void SimulationManager::AddAnimatedEntity(AnimatedEntity* ent)
 {
     if(ent != nullptr)
     {
+        entityIds.emplace(ent->getName(), entities.size());
         entities.push_back(ent);
         ent->AddToSimulation(this);
     }
@@ -172,6 +195,7 @@ void SimulationManager::AddSolidEntity(SolidEntity* ent, const Transform& origin
 {
     if(ent != nullptr)
     {
+        entityIds.emplace(ent->getName(), entities.size());
         entities.push_back(ent);
         ent->AddToSimulation(this, origin);
     }
@@ -181,6 +205,7 @@ void SimulationManager::AddSolidEntity(SolidEntity* ent, const Transform& origin
  {
      if(ent != nullptr)
      {
+         entityIds.emplace(ent->getName(), entities.size());
          entities.push_back(ent);
          ent->AddToSimulation(this, origin);
      }
@@ -230,19 +255,26 @@ void SimulationManager::EnableAtmosphere()
 void SimulationManager::AddSensor(Sensor* sens)
 {
     if(sens != nullptr)
+    {
+        sensorIds.emplace(sens->getName(), sensors.size());
         sensors.push_back(sens);
+    }
 }
 
 void SimulationManager::AddComm(Comm* comm)
 {
     if(comm != nullptr)
+    {
+        commIds.emplace(comm->getName(), comms.size());
         comms.push_back(comm);
+    }
 }
 
 void SimulationManager::AddJoint(Joint* jnt)
 {
     if(jnt != nullptr)
     {
+        jointIds.emplace(jnt->getName(), joints.size());
         joints.push_back(jnt);
         jnt->AddToSimulation(this);
     }
@@ -255,9 +287,12 @@ void SimulationManager::RemoveJoint(Joint* jnt)
         auto it = std::find(joints.begin(), joints.end(), jnt);
         if(it != joints.end())
         {
-            (*it)->RemoveFromSimulation(this);
-            delete *it;
-            joints.erase(it);
+            jointIds.erase(jnt->getName());
+            it = joints.erase(it);
+            for(; it != joints.end(); ++it)
+                jointIds[(*it)->getName()] = it - joints.begin();
+            jnt->RemoveFromSimulation(this);
+            delete jnt;
         }
     }
 }
@@ -265,14 +300,19 @@ void SimulationManager::RemoveJoint(Joint* jnt)
 void SimulationManager::AddActuator(Actuator *act)
 {
     if(act != nullptr)
+    {
+        actuatorIds.emplace(act->getName(), actuators.size());
         actuators.push_back(act);
+    }
 }
 
 void SimulationManager::AddContact(Contact* cnt)
 {
     if(cnt != nullptr)
     {
+        contactIds.emplace(cnt->getName(), contacts.size());
         contacts.push_back(cnt);
+        contactPairs.emplace(OrderedPair(cnt->getEntityA(), cnt->getEntityB()), cnt);
         EnableCollision(cnt->getEntityA(), cnt->getEntityB());
     }
 }
@@ -326,21 +366,10 @@ void SimulationManager::DisableCollision(const Entity* entA, const Entity* entB)
 
 Contact* SimulationManager::getContact(Entity* entA, Entity* entB)
 {
-    for(size_t i = 0; i < contacts.size(); ++i)
-    {
-        if(contacts[i]->getEntityA() == entA)
-        {
-            if(contacts[i]->getEntityB() == entB)
-                return contacts[i];
-        }
-        else if(contacts[i]->getEntityB() == entA)
-        {
-            if(contacts[i]->getEntityA() == entB)
-                return contacts[i];
-        }
-    }
-    
-    return nullptr;
+    if(contactPairs.empty())
+        return nullptr;
+    auto it = contactPairs.find(OrderedPair(entA, entB));
+    return it != contactPairs.end() ? it->second : nullptr;
 }
 
 Contact* SimulationManager::getContact(unsigned int index)
@@ -353,11 +382,14 @@ Contact* SimulationManager::getContact(unsigned int index)
 
 Contact* SimulationManager::getContact(const std::string& name)
 {
-    for(size_t i = 0; i < contacts.size(); ++i)
-        if(contacts[i]->getName() == name)
-            return contacts[i];
-    
-    return nullptr;
+    auto it = contactIds.find(name);
+    return it != contactIds.end() ? contacts[it->second] : nullptr;
+}
+
+int SimulationManager::getContactIndex(const std::string& name) const
+{
+    auto it = contactIds.find(name);
+    return it != contactIds.end() ? (int)it->second : -1;
 }
 
 CollisionFilteringType SimulationManager::getCollisionFilter() const
@@ -380,11 +412,14 @@ Robot* SimulationManager::getRobot(unsigned int index)
 
 Robot* SimulationManager::getRobot(const std::string& name)
 {
-    for(size_t i = 0; i < robots.size(); ++i)
-        if(robots[i]->getName() == name)
-            return robots[i];
-    
-    return nullptr;
+    auto it = robotIds.find(name);
+    return it != robotIds.end() ? robots[it->second] : nullptr;
+}
+
+int SimulationManager::getRobotIndex(const std::string& name) const
+{
+    auto it = robotIds.find(name);
+    return it != robotIds.end() ? (int)it->second : -1;
 }
 
 Entity* SimulationManager::getEntity(unsigned int index)
@@ -395,13 +430,21 @@ Entity* SimulationManager::getEntity(unsigned int index)
         return nullptr;
 }
 
+size_t SimulationManager::getNumOfEntities() const
+{
+    return entities.size();
+}
+
 Entity* SimulationManager::getEntity(const std::string& name)
 {
-    for(size_t i = 0; i < entities.size(); ++i)
-        if(entities[i]->getName() == name)
-            return entities[i];
-    
-    return nullptr;
+    auto it = entityIds.find(name);
+    return it != entityIds.end() ? entities[it->second] : nullptr;
+}
+
+int SimulationManager::getEntityIndex(const std::string& name) const
+{
+    auto it = entityIds.find(name);
+    return it != entityIds.end() ? (int)it->second : -1;
 }
 
 Joint* SimulationManager::getJoint(unsigned int index)
@@ -414,11 +457,14 @@ Joint* SimulationManager::getJoint(unsigned int index)
 
 Joint* SimulationManager::getJoint(const std::string& name)
 {
-    for(size_t i = 0; i < joints.size(); ++i)
-        if(joints[i]->getName() == name)
-            return joints[i];
-    
-    return nullptr;
+    auto it = jointIds.find(name);
+    return it != jointIds.end() ? joints[it->second] : nullptr;
+}
+
+int SimulationManager::getJointIndex(const std::string& name) const
+{
+    auto it = jointIds.find(name);
+    return it != jointIds.end() ? (int)it->second : -1;
 }
 
 Actuator* SimulationManager::getActuator(unsigned int index)
@@ -429,13 +475,21 @@ Actuator* SimulationManager::getActuator(unsigned int index)
         return nullptr;
 }
 
+size_t SimulationManager::getNumOfActuators() const
+{
+    return actuators.size();
+}
+
 Actuator* SimulationManager::getActuator(const std::string& name)
 {
-    for(size_t i = 0; i < actuators.size(); ++i)
-        if(actuators[i]->getName() == name)
-            return actuators[i];
-    
-    return nullptr;
+    auto it = actuatorIds.find(name);
+    return it != actuatorIds.end() ? actuators[it->second] : nullptr;
+}
+
+int SimulationManager::getActuatorIndex(const std::string& name) const
+{
+    auto it = actuatorIds.find(name);
+    return it != actuatorIds.end() ? (int)it->second : -1;
 }
 
 Sensor* SimulationManager::getSensor(unsigned int index)
@@ -446,13 +500,21 @@ Sensor* SimulationManager::getSensor(unsigned int index)
         return nullptr;
 }
 
+size_t SimulationManager::getNumOfSensors() const
+{
+    return sensors.size();
+}
+
 Sensor* SimulationManager::getSensor(const std::string& name)
 {
-    for(size_t i = 0; i < sensors.size(); ++i)
-        if(sensors[i]->getName() == name)
-            return sensors[i];
-    
-    return nullptr;
+    auto it = sensorIds.find(name);
+    return it != sensorIds.end() ? sensors[it->second] : nullptr;
+}
+
+int SimulationManager::getSensorIndex(const std::string& name) const
+{
+    auto it = sensorIds.find(name);
+    return it != sensorIds.end() ? (int)it->second : -1;
 }
 
 Comm* SimulationManager::getComm(unsigned int index)
@@ -465,11 +527,14 @@ Comm* SimulationManager::getComm(unsigned int index)
 
 Comm* SimulationManager::getComm(const std::string& name)
 {
-    for(size_t i = 0; i < comms.size(); ++i)
-        if(comms[i]->getName() == name)
-            return comms[i];
-    
-    return nullptr;
+    auto it = commIds.find(name);
+    return it != commIds.end() ? comms[it->second] : nullptr;
+}
+
+int SimulationManager::getCommIndex(const std::string& name) const
+{
+    auto it = commIds.find(name);
+    return it != commIds.end() ? (int)it->second : -1;
 }
 
 NED* SimulationManager::getNED()
@@ -497,6 +562,11 @@ bool SimulationManager::isSimulationFresh() const
     return simulationFresh;
 }
 
+SDL_mutex* SimulationManager::getSimSettingsMutex()
+{
+    return simSettingsMutex;
+}
+
 Scalar SimulationManager::getSimulationTime() const
 {
     SDL_LockMutex(simInfoMutex);
@@ -521,16 +591,48 @@ MaterialManager* SimulationManager::getMaterialManager()
     return materialManager;
 }
 
+RayTracingScene* SimulationManager::getRayTracingScene()
+{
+    if(rtScene == nullptr)
+        rtScene = new RayTracingScene();
+    return rtScene;
+}
+
 NameManager* SimulationManager::getNameManager()
 {
     return nameManager;
 }
 
+void SimulationManager::setTelemetryRecorder(TelemetryRecorder* recorder)
+{
+    telemetry = recorder;
+}
+
+TelemetryRecorder* SimulationManager::getTelemetryRecorder()
+{
+    return telemetry;
+}
+
+void SimulationManager::setSharedMemoryBridge(SharedMemoryBridge* bridge)
+{
+    shmBridge = bridge;
+}
+
+SharedMemoryBridge* SimulationManager::getSharedMemoryBridge()
+{
+    return shmBridge;
+}
+
 PerformanceMonitor& SimulationManager::getPerformanceMonitor()
 {
     return perfMon;
 }
 
+const SimulationMetrics& SimulationManager::getMetrics() const
+{
+    return metrics;
+}
+
 OpenGLTrackball* SimulationManager::getTrackball()
 {
     return trackball;
@@ -797,13 +899,13 @@ void SimulationManager::InitializeScenario()
     {
 		OpenGLState::Init();
 		
-        OpenGLView* view = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->getView(0);
-        if(view == nullptr)
+        GraphicalSimulationApp* gApp = (GraphicalSimulationApp*)SimulationApp::getApp();
+        OpenGLView* view = gApp->getGLPipeline()->getContent()->getView(0);
+        if(view == nullptr && !gApp->getGLPipeline()->isSensorViewsOnly()) //No window when rendering headless
         {
-            GraphicalSimulationApp* gApp = (GraphicalSimulationApp*)SimulationApp::getApp();
             trackball = new OpenGLTrackball(glm::vec3(0.f,0.f,-1.f), 5.0, glm::vec3(0.f,0.f,-1.f), 0, 0, gApp->getWindowWidth(), gApp->getWindowHeight(), 90.f, glm::vec2(STD_NEAR_PLANE_DISTANCE, STD_FAR_PLANE_DISTANCE));
             trackball->Rotate(glm::quat(glm::eulerAngleYXZ(0.0, 0.0, 0.25)));
-            ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(trackball);
+            gApp->getGLPipeline()->getContent()->AddView(trackball);
         }
     }
 	
@@ -823,6 +925,83 @@ void SimulationManager::RestartScenario()
     simulationFresh = true;
 }
 
+void SimulationManager::SaveState(SimulationState& state)
+{
+    SDL_LockMutex(simSettingsMutex);
+    state.Clear();
+    
+    //Layout of the scenario (used for validation)
+    uint64_t layout[4] = {entities.size(), actuators.size(), sensors.size(), comms.size()};
+    state.Write(layout);
+    state.Write(simulationTime);
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->SaveState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->SaveState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->SaveState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->SaveState(state);
+    
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::RestoreState(SimulationState& state)
+{
+    SDL_LockMutex(simSettingsMutex);
+    state.Rewind();
+    
+    uint64_t layout[4];
+    state.Read(layout);
+    if(!state.isValid() || layout[0] != entities.size() || layout[1] != actuators.size() 
+       || layout[2] != sensors.size() || layout[3] != comms.size())
+    {
+        SDL_UnlockMutex(simSettingsMutex);
+        cError("Simulation state does not match the current scenario!");
+        return false;
+    }
+    
+    SDL_LockMutex(simInfoMutex);
+    state.Read(simulationTime);
+    SDL_UnlockMutex(simInfoMutex);
+    
+    for(size_t i=0; i<entities.size(); ++i)
+        entities[i]->RestoreState(state);
+    for(size_t i=0; i<actuators.size(); ++i)
+        actuators[i]->RestoreState(state);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->RestoreState(state);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->RestoreState(state);
+    
+    //Contacts of the previous state are not valid anymore
+    ClearContactCaches();
+    SDL_UnlockMutex(simSettingsMutex);
+    
+    if(!state.isValid())
+    {
+        cError("Simulation state corrupted!");
+        return false;
+    }
+    return true;
+}
+
+void SimulationManager::ClearContactCaches()
+{
+    if(dynamicsWorld == nullptr)
+        return;
+    
+    //Remove contact manifolds together with their warm-start impulses
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    for(int i=0; i<objects.size(); ++i)
+        if(objects[i]->getBroadphaseHandle() != nullptr)
+            dwBroadphase->getOverlappingPairCache()->cleanProxyFromPairs(objects[i]->getBroadphaseHandle(), dwDispatcher);
+    
+    dynamicsWorld->updateAabbs();
+    mbSolver->reset();
+}
+
 void SimulationManager::DestroyScenario()
 {
     if(dynamicsWorld != nullptr)
@@ -854,14 +1033,23 @@ void SimulationManager::DestroyScenario()
         delete debugDrawer;
     }
     
+    //invalidate initial state
+    initialState->Clear();
+    
+    //drop ray tracing data referring to entity meshes
+    if(rtScene != nullptr)
+        rtScene->Clear();
+    
     //remove sim manager objects
     for(size_t i=0; i<robots.size(); ++i)
         delete robots[i];
     robots.clear();
+    robotIds.clear();
     
     for(size_t i=0; i<entities.size(); ++i)
         delete entities[i];
     entities.clear();
+    entityIds.clear();
     
     if(ocean != nullptr)
     {
@@ -878,22 +1066,28 @@ void SimulationManager::DestroyScenario()
     for(size_t i=0; i<joints.size(); ++i)
         delete joints[i];
     joints.clear();
+    jointIds.clear();
     
     for(size_t i=0; i<contacts.size(); ++i)
         delete contacts[i];
     contacts.clear();
+    contactIds.clear();
+    contactPairs.clear();
     
     for(size_t i=0; i<sensors.size(); ++i)
         delete sensors[i];
     sensors.clear();
+    sensorIds.clear();
     
     for(size_t i=0; i<comms.size(); ++i)
         delete comms[i];
     comms.clear();
+    commIds.clear();
     
     for(size_t i=0; i<actuators.size(); ++i)
         delete actuators[i];
     actuators.clear();
+    actuatorIds.clear();
     
     if(nameManager != nullptr)
         nameManager->ClearNames();
@@ -928,11 +1122,67 @@ bool SimulationManager::StartSimulation()
     for(unsigned int i = 0; i < sensors.size(); i++)
         sensors[i]->Reset();
 
+    //Capture initial state for soft resets
+    SaveState(*initialState);
+
     perfMon.SimulationStarted();
     
     return true;
 }
 
+bool SimulationManager::ResetScenario()
+{
+    return SoftReset(std::random_device()());
+}
+
+bool SimulationManager::ResetScenario(uint32_t seed)
+{
+    return SoftReset(seed);
+}
+
+void SimulationManager::setRandomSeed(uint64_t seed)
+{
+    SDL_LockMutex(simSettingsMutex);
+    RandomStream::setGlobalSeed(seed);
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->setRandomSeed(seed);
+    for(size_t i=0; i<comms.size(); ++i)
+        comms[i]->setRandomSeed(seed);
+    SDL_UnlockMutex(simSettingsMutex);
+}
+
+bool SimulationManager::SoftReset(uint32_t seed)
+{
+    if(initialState->getSize() == 0)
+    {
+        cError("Soft reset not possible before the simulation was started!");
+        return false;
+    }
+    
+    //Restore bodies, actuators and comms (clears contact manifolds and solver caches)
+    if(!RestoreState(*initialState))
+        return false;
+    
+    SDL_LockMutex(simSettingsMutex);
+    setRandomSeed(seed);
+    
+    currentTime = 0;
+    mlcpFallbacks = 0;
+    fdCounter = 0;
+    
+    //Reset contacts
+    for(unsigned int i = 0; i < contacts.size(); i++)
+        contacts[i]->ClearHistory();
+    
+    //Reset sensors
+    for(unsigned int i = 0; i < sensors.size(); i++)
+        sensors[i]->Reset();
+    SDL_UnlockMutex(simSettingsMutex);
+    
+    perfMon.SimulationStarted();
+    return true;
+}
+
 void SimulationManager::ResumeSimulation()
 {
     if(!icProblemSolved)
@@ -1029,10 +1279,30 @@ void SimulationManager::AdvanceSimulation()
         currentTime = timeInMicroseconds;
     }
     
+    ComputeStep(deltaTime);
+}
+
+bool SimulationManager::StepSimulation(unsigned int steps)
+{
+    //Check if initial conditions solved
+    if(!icProblemSolved)
+        return false;
+    
+    //Each call computes exactly one physics step, independent of the simulation clock
+    for(unsigned int i=0; i<steps; ++i)
+        ComputeStep(ssus);
+    return true;
+}
+
+void SimulationManager::ComputeStep(uint64_t deltaTime)
+{
     //Step simulation
     SDL_LockMutex(simSettingsMutex);
     perfMon.PhysicsStarted();
-    dynamicsWorld->stepSimulation((Scalar)deltaTime/Scalar(1000000.0), 1000000, (Scalar)ssus/Scalar(1000000.0));
+    {
+        PROFILE_ZONE("Physics step");
+        dynamicsWorld->stepSimulation((Scalar)deltaTime/Scalar(1000000.0), 1000000, (Scalar)ssus/Scalar(1000000.0));
+    }
     perfMon.PhysicsFinished();
     SDL_UnlockMutex(simSettingsMutex);
 
@@ -1056,6 +1326,18 @@ void SimulationManager::AdvanceSimulation()
         }
     }
     
+    //Publish metrics
+    metrics.cpuUsage.store((double)cpuUsage, std::memory_order_relaxed);
+    metrics.physicsTime.store(perfMon.getPhysicsTime(), std::memory_order_relaxed);
+    metrics.physicsTimeAverage.store(perfMon.getPhysicsTimeAverage(), std::memory_order_relaxed);
+    metrics.hydrodynamicsTime.store(perfMon.getHydrodynamicsTime(), std::memory_order_relaxed);
+    metrics.hydrodynamicsTimeAverage.store(perfMon.getHydrodynamicsTimeAverage(), std::memory_order_relaxed);
+    metrics.mlcpFallbacks.store(mlcpFallbacks, std::memory_order_relaxed);
+    metrics.entities.store((uint32_t)entities.size(), std::memory_order_relaxed);
+    metrics.sensors.store((uint32_t)sensors.size(), std::memory_order_relaxed);
+    metrics.actuators.store((uint32_t)actuators.size(), std::memory_order_relaxed);
+    metrics.comms.store((uint32_t)comms.size(), std::memory_order_relaxed);
+    metrics.contactManifolds.store((uint32_t)dynamicsWorld->getDispatcher()->getNumManifolds(), std::memory_order_relaxed);
     SDL_UnlockMutex(simInfoMutex);
 }
 
@@ -1069,7 +1351,9 @@ void SimulationManager::SimulationStepCompleted(Scalar timeStep)
 
 void SimulationManager::UpdateDrawingQueue()
 {
-    //Build new drawing queue
+    PROFILE_ZONE("Drawing queue");
+    
+    //Build new drawing queue (the back buffer is not shared with the rendering thread)
     OpenGLPipeline* glPipeline = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline();
  
     //Solids, manipulators, systems....
@@ -1091,28 +1375,16 @@ void SimulationManager::UpdateDrawingQueue()
         
     //Actuators
     for(size_t i=0; i<actuators.size(); ++i)
-    {
         glPipeline->AddToDrawingQueue(actuators[i]->Render());
-        if(actuators[i]->getType() == ActuatorType::LIGHT)
-            ((Light*)actuators[i])->UpdateTransform();
-    }
     
     //Sensors
     for(size_t i=0; i<sensors.size(); ++i)
-    {
         glPipeline->AddToDrawingQueue(sensors[i]->Render());
-        if(sensors[i]->getType() == SensorType::VISION)
-            ((VisionSensor*)sensors[i])->UpdateTransform();
-    }
     
     //Comms
     for(size_t i=0; i<comms.size(); ++i)
         glPipeline->AddToDrawingQueue(comms[i]->Render());
     
-    //Trackball
-    if(trackball != nullptr)
-        trackball->UpdateCenterPos();
-    
     //Contacts
     for(size_t i=0; i<contacts.size(); ++i)
         glPipeline->AddToDrawingQueue(contacts[i]->Render());
@@ -1120,6 +1392,19 @@ void SimulationManager::UpdateDrawingQueue()
     //Ocean currents
     if(ocean != nullptr)
         glPipeline->AddToDrawingQueue(ocean->Render(actuators));
+    
+    //Hand the queue over together with the transforms read by the rendering thread
+    SDL_LockMutex(glPipeline->getDrawingQueueMutex());
+    for(size_t i=0; i<actuators.size(); ++i)
+        if(actuators[i]->getType() == ActuatorType::LIGHT)
+            ((Light*)actuators[i])->UpdateTransform();
+    for(size_t i=0; i<sensors.size(); ++i)
+        if(sensors[i]->getType() == SensorType::VISION)
+            ((VisionSensor*)sensors[i])->UpdateTransform();
+    if(trackball != nullptr)
+        trackball->UpdateCenterPos();
+    glPipeline->SubmitDrawingQueue(getSimulationTime()); //Time stamp of the drawing queue (and sensor transforms)
+    SDL_UnlockMutex(glPipeline->getDrawingQueueMutex());
 }
 
 std::pair<Entity*, int>  SimulationManager::PickEntity(Vector3 eye, Vector3 ray)
@@ -1423,65 +1708,82 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
         
     //Clear all forces to ensure that no summing occurs
     mbDynamicsWorld->clearForces(); //Includes clearing of multibody forces!
+    
+    //Apply setpoints received from co-located controllers
+    if(simManager->shmBridge != nullptr)
+        simManager->shmBridge->StepStarted();
         
     //loop through all actuators -> apply forces to bodies (free and connected by joints)
-    for(size_t i = 0; i < simManager->actuators.size(); ++i)
-        simManager->actuators[i]->Update(timeStep);
+    {
+        PROFILE_ZONE("Actuators");
+        for(size_t i = 0; i < simManager->actuators.size(); ++i)
+        {
+            PROFILE_ZONE_DETAIL("Actuator", simManager->actuators[i]->getZoneName());
+            simManager->actuators[i]->Update(timeStep);
+        }
+    }
     
     //loop through all joints -> apply damping forces to bodies connected by joints
-    for(size_t i = 0; i < simManager->joints.size(); ++i)
-        simManager->joints[i]->ApplyDamping();
+    {
+        PROFILE_ZONE("Joint damping");
+        for(size_t i = 0; i < simManager->joints.size(); ++i)
+            simManager->joints[i]->ApplyDamping();
+    }
     
     //loop through all entities that may need special actions
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
     {
-        Entity* ent = simManager->entities[i];
-        
-        if(ent->getType() == EntityType::SOLID)
-        {
-            SolidEntity* solid = (SolidEntity*)ent;
-            solid->ApplyGravity(mbDynamicsWorld->getGravity());
-        }
-        else if(ent->getType() == EntityType::FEATHERSTONE)
-        {
-            FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
-            multibody->ApplyGravity(mbDynamicsWorld->getGravity());
-            multibody->ApplyDamping();
-        }
-        /*else if(ent->getType() == EntityType::CABLE)
-        {
-            CableEntity* cable = (CableEntity*)ent;
-            cable->ApplyGravity(mbDynamicsWorld->getGravity());
-        }*/
-        else if(ent->getType() == EntityType::FORCEFIELD)
+        PROFILE_ZONE("Gravity and triggers");
+        for(size_t i = 0; i < simManager->entities.size(); ++i)
         {
-            ForcefieldEntity* ff = (ForcefieldEntity*)ent;
-            if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
-            {				
-                Trigger* trigger = (Trigger*)ff;
-                trigger->Clear();
-                btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
-                int numPairs = pairArray.size();
+            Entity* ent = simManager->entities[i];
+            PROFILE_ZONE_DETAIL(ent->getType() == EntityType::FORCEFIELD ? "Trigger" : "Gravity", ent->getZoneName());
+            
+            if(ent->getType() == EntityType::SOLID)
+            {
+                SolidEntity* solid = (SolidEntity*)ent;
+                solid->ApplyGravity(mbDynamicsWorld->getGravity());
+            }
+            else if(ent->getType() == EntityType::FEATHERSTONE)
+            {
+                FeatherstoneEntity* multibody = (FeatherstoneEntity*)ent;
+                multibody->ApplyGravity(mbDynamicsWorld->getGravity());
+                multibody->ApplyDamping();
+            }
+            /*else if(ent->getType() == EntityType::CABLE)
+            {
+                CableEntity* cable = (CableEntity*)ent;
+                cable->ApplyGravity(mbDynamicsWorld->getGravity());
+            }*/
+            else if(ent->getType() == EntityType::FORCEFIELD)
+            {
+                ForcefieldEntity* ff = (ForcefieldEntity*)ent;
+                if(ff->getForcefieldType() == ForcefieldType::TRIGGER)
+                {				
+                    Trigger* trigger = (Trigger*)ff;
+                    trigger->Clear();
+                    btBroadphasePairArray& pairArray = trigger->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
+                    int numPairs = pairArray.size();
                     
-                for(int h = 0; h < numPairs; ++h)
-                {
-                    const btBroadphasePair& pair = pairArray[h];
-                    btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
-                    if(!colPair)
-                        continue;
+                    for(int h = 0; h < numPairs; ++h)
+                    {
+                        const btBroadphasePair& pair = pairArray[h];
+                        btBroadphasePair* colPair = world->getPairCache()->findPair(pair.m_pProxy0, pair.m_pProxy1);
+                        if(!colPair)
+                            continue;
                     
-                    btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
-                    btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
+                        btCollisionObject* co1 = (btCollisionObject*)colPair->m_pProxy0->m_clientObject;
+                        btCollisionObject* co2 = (btCollisionObject*)colPair->m_pProxy1->m_clientObject;
                 
-                    if(co1 == trigger->getGhost())
-                        trigger->Activate(co2);
-                    else if(co2 == trigger->getGhost())
-                        trigger->Activate(co1);
+                        if(co1 == trigger->getGhost())
+                            trigger->Activate(co2);
+                        else if(co2 == trigger->getGhost())
+                            trigger->Activate(co1);
+                    }
                 }
             }
         }
     }
-    
+
     //Geometry-based forces
     bool recompute = simManager->fdCounter % simManager->fdPrescaler == 0;
     ++simManager->fdCounter;
@@ -1489,6 +1791,7 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
     //Aerodynamic forces
     if(simManager->atmosphere != nullptr)
     {
+        PROFILE_ZONE("Aerodynamics");
         btBroadphasePairArray& pairArray = simManager->atmosphere->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
         int numPairs = pairArray.size();
         
@@ -1518,6 +1821,7 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
     {
         if(recompute) SDL_LockMutex(simManager->simHydroMutex);
         simManager->perfMon.HydrodynamicsStarted();
+        PROFILE_ZONE("Hydrodynamics");
         
         btBroadphasePairArray& pairArray = simManager->ocean->getGhost()->getOverlappingPairCache()->getOverlappingPairArray();
         int numPairs = pairArray.size();
@@ -1551,26 +1855,30 @@ void SimulationManager::SimulationTickCallback(btDynamicsWorld* world, Scalar ti
 void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scalar timeStep)
 {
     SimulationManager* simManager = (SimulationManager*)world->getWorldUserInfo();
+    PROFILE_ZONE("Post-tick");
     
     //Update motion data
-    for(size_t i = 0; i < simManager->entities.size(); ++i)
     {
-        Entity* ent = simManager->entities[i];
-            
-        if(ent->getType() == EntityType::SOLID)
-        {
-            SolidEntity* solid = (SolidEntity*)ent;
-            solid->UpdateAcceleration(timeStep);
-        }
-        else if(ent->getType() == EntityType::FEATHERSTONE)
-        {
-            FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
-            fe->UpdateAcceleration(timeStep);
-        }
-        else if(ent->getType() == EntityType::ANIMATED)
+        PROFILE_ZONE("Motion update");
+        for(size_t i = 0; i < simManager->entities.size(); ++i)
         {
-            AnimatedEntity* anim = (AnimatedEntity*)ent;
-            anim->Update(timeStep);
+            Entity* ent = simManager->entities[i];
+            
+            if(ent->getType() == EntityType::SOLID)
+            {
+                SolidEntity* solid = (SolidEntity*)ent;
+                solid->UpdateAcceleration(timeStep);
+            }
+            else if(ent->getType() == EntityType::FEATHERSTONE)
+            {
+                FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
+                fe->UpdateAcceleration(timeStep);
+            }
+            else if(ent->getType() == EntityType::ANIMATED)
+            {
+                AnimatedEntity* anim = (AnimatedEntity*)ent;
+                anim->Update(timeStep);
+            }
         }
     }
 
@@ -1580,32 +1888,58 @@ void SimulationManager::SimulationPostTickCallback(btDynamicsWorld *world, Scala
             ((SuctionCup*)simManager->actuators[i])->Engage(simManager);
 
     //Loop through all sensors -> update measurements
-    for(size_t i = 0; i < simManager->sensors.size(); ++i)
-        simManager->sensors[i]->Update(timeStep);
+    {
+        PROFILE_ZONE("Sensors");
+        for(size_t i = 0; i < simManager->sensors.size(); ++i)
+        {
+            PROFILE_ZONE_DETAIL("Sensor", simManager->sensors[i]->getZoneName());
+            simManager->sensors[i]->Update(timeStep);
+        }
+    }
         
     //Loop through all comms -> update state and measurements
-    for(size_t i = 0; i < simManager->comms.size(); ++i)
-        simManager->comms[i]->Update(timeStep);
+    {
+        PROFILE_ZONE("Comms");
+        for(size_t i = 0; i < simManager->comms.size(); ++i)
+        {
+            PROFILE_ZONE_DETAIL("Comm", simManager->comms[i]->getZoneName());
+            simManager->comms[i]->Update(timeStep);
+        }
+    }
     
     //Loop through contact manifolds -> update contacts
-    if(simManager->getContact(0) != nullptr) // If at least one contact is defined
+    if(!simManager->contactPairs.empty()) // If at least one contact is defined
     {
+        PROFILE_ZONE("Contacts");
         int numManifolds = world->getDispatcher()->getNumManifolds();
         for(int i=0; i<numManifolds; ++i)
         {
             btPersistentManifold* contactManifold = world->getDispatcher()->getManifoldByIndexInternal(i);
-            btCollisionObject* coA = (btCollisionObject*)contactManifold->getBody0();
-            btCollisionObject* coB = (btCollisionObject*)contactManifold->getBody1();
-            Entity* entA = (Entity*)coA->getUserPointer();
-            Entity* entB = (Entity*)coB->getUserPointer();
-            Contact* contact = simManager->getContact(entA, entB);
-            if(contact != nullptr && contactManifold->getNumContacts() > 0)
-                contact->AddContactPoint(contactManifold, contact->getEntityA() != entA, timeStep);        
+            if(contactManifold->getNumContacts() == 0)
+                continue;
+            Entity* entA = (Entity*)contactManifold->getBody0()->getUserPointer();
+            Entity* entB = (Entity*)contactManifold->getBody1()->getUserPointer();
+            auto it = simManager->contactPairs.find(OrderedPair(entA, entB)); //O(1) per manifold
+            if(it != simManager->contactPairs.end())
+                it->second->AddContactPoint(contactManifold, it->second->getEntityA() != entA, timeStep);
         }
     }
 
     //Update simulation time
     simManager->simulationTime += timeStep;
+    simManager->metrics.steps.fetch_add(1, std::memory_order_relaxed);
+    simManager->metrics.simulationTime.store((double)simManager->simulationTime, std::memory_order_relaxed);
+    
+    //Record body and actuator states
+    if(simManager->telemetry != nullptr)
+    {
+        PROFILE_ZONE("Telemetry");
+        simManager->telemetry->StepCompleted(simManager->simulationTime);
+    }
+    
+    //Notify co-located controllers about new sensor data
+    if(simManager->shmBridge != nullptr)
+        simManager->shmBridge->StepCompleted(simManager->simulationTime);
     
     //Optional method to update some post simulation data (like ROS messages...)
     simManager->SimulationStepCompleted(timeStep);
@@ -0,0 +1,140 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SimulationState.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "core/SimulationState.h"
+
+namespace sf
+{
+
+SimulationState::SimulationState() : readPos(0), valid(true)
+{
+}
+
+void SimulationState::Clear()
+{
+    data.clear(); //Capacity is preserved
+    readPos = 0;
+    valid = true;
+}
+
+void SimulationState::Rewind()
+{
+    readPos = 0;
+    valid = true;
+}
+
+void SimulationState::WriteBytes(const void* src, size_t size)
+{
+    size_t pos = data.size();
+    data.resize(pos + size);
+    if(size > 0)
+        memcpy(&data[pos], src, size);
+}
+
+void SimulationState::ReadBytes(void* dst, size_t size)
+{
+    if(readPos + size > data.size())
+    {
+        valid = false;
+        memset(dst, 0, size);
+        return;
+    }
+    if(size > 0)
+        memcpy(dst, &data[readPos], size);
+    readPos += size;
+}
+
+void SimulationState::Write(const Vector3& v)
+{
+    WriteBytes(&v.x(), sizeof(Scalar)*3);
+}
+
+void SimulationState::Read(Vector3& v)
+{
+    Scalar xyz[3];
+    ReadBytes(xyz, sizeof(Scalar)*3);
+    v.setValue(xyz[0], xyz[1], xyz[2]);
+}
+
+void SimulationState::Write(const Transform& T)
+{
+    for(int i=0; i<3; ++i)
+        Write(T.getBasis().getRow(i));
+    Write(T.getOrigin());
+}
+
+void SimulationState::Read(Transform& T)
+{
+    Vector3 r0, r1, r2, o;
+    Read(r0);
+    Read(r1);
+    Read(r2);
+    Read(o);
+    T.getBasis().setValue(r0.x(), r0.y(), r0.z(), r1.x(), r1.y(), r1.z(), r2.x(), r2.y(), r2.z());
+    T.setOrigin(o);
+}
+
+void SimulationState::WriteString(const std::string& str)
+{
+    uint64_t len = str.size();
+    Write(len);
+    WriteBytes(str.data(), len);
+}
+
+void SimulationState::ReadString(std::string& str)
+{
+    uint64_t len = 0;
+    Read(len);
+    if(readPos + len > data.size())
+    {
+        valid = false;
+        str.clear();
+        return;
+    }
+    str.assign((const char*)&data[readPos], len);
+    readPos += len;
+}
+
+size_t SimulationState::getSize() const
+{
+    return data.size();
+}
+
+const uint8_t* SimulationState::getData() const
+{
+    return data.data();
+}
+
+size_t SimulationState::getRemainingSize() const
+{
+    return data.size() - readPos;
+}
+
+bool SimulationState::isValid() const
+{
+    return valid;
+}
+
+}
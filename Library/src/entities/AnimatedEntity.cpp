@@ -27,6 +27,7 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -240,6 +241,21 @@ Trajectory* AnimatedEntity::getTrajectory()
     return tr;
 }
 
+void AnimatedEntity::SaveState(SimulationState& state)
+{
+    if(tr != nullptr)
+        tr->SaveState(state);
+}
+
+void AnimatedEntity::RestoreState(SimulationState& state)
+{
+    if(tr == nullptr)
+        return;
+    
+    tr->RestoreState(state);
+    Update(Scalar(0)); //Apply restored trajectory state to the body
+}
+
 void AnimatedEntity::getAABB(Vector3& min, Vector3& max)
 {
     if(rigidBody != nullptr)
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/ZoneProfiler.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
@@ -35,6 +36,7 @@ namespace sf
 Entity::Entity(std::string uniqueName)
 {
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
+    zoneName = ZoneProfiler::Intern(name);
     renderable = true;
 }
 
@@ -58,5 +60,18 @@ std::string Entity::getName() const
 {
     return name;
 }
+
+const char* Entity::getZoneName() const
+{
+    return zoneName;
+}
+
+void Entity::SaveState(SimulationState& state)
+{
+}
+
+void Entity::RestoreState(SimulationState& state)
+{
+}
         
 }
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "entities/StaticEntity.h"
 
 namespace sf
@@ -69,6 +70,65 @@ EntityType FeatherstoneEntity::getType() const
     return EntityType::FEATHERSTONE;
 }
 
+void FeatherstoneEntity::SaveState(SimulationState& state)
+{
+    btQuaternion q = multiBody->getWorldToBaseRot();
+    state.Write(multiBody->getBasePos());
+    state.Write(q.x());
+    state.Write(q.y());
+    state.Write(q.z());
+    state.Write(q.w());
+    state.Write(multiBody->getBaseVel());
+    state.Write(multiBody->getBaseOmega());
+    
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        const btMultibodyLink& link = multiBody->getLink(i);
+        state.WriteBytes(multiBody->getJointPosMultiDof(i), sizeof(Scalar) * link.m_posVarCount);
+        state.WriteBytes(multiBody->getJointVelMultiDof(i), sizeof(Scalar) * link.m_dofCount);
+    }
+    
+    for(size_t i=0; i<links.size(); ++i)
+        links[i].solid->SaveState(state);
+}
+
+void FeatherstoneEntity::RestoreState(SimulationState& state)
+{
+    Vector3 pos, v, omega;
+    Scalar qx, qy, qz, qw;
+    state.Read(pos);
+    state.Read(qx);
+    state.Read(qy);
+    state.Read(qz);
+    state.Read(qw);
+    state.Read(v);
+    state.Read(omega);
+    multiBody->setBasePos(pos);
+    multiBody->setWorldToBaseRot(btQuaternion(qx, qy, qz, qw));
+    multiBody->setBaseVel(v);
+    multiBody->setBaseOmega(omega);
+    
+    Scalar buffer[7]; //Maximum number of position variables per link
+    for(int i=0; i<multiBody->getNumLinks(); ++i)
+    {
+        const btMultibodyLink& link = multiBody->getLink(i);
+        state.ReadBytes(buffer, sizeof(Scalar) * link.m_posVarCount);
+        multiBody->setJointPosMultiDof(i, buffer);
+        state.ReadBytes(buffer, sizeof(Scalar) * link.m_dofCount);
+        multiBody->setJointVelMultiDof(i, buffer);
+    }
+    
+    multiBody->clearForcesAndTorques();
+    multiBody->clearConstraintForces();
+    btAlignedObjectArray<btQuaternion> scratchQ;
+    btAlignedObjectArray<Vector3> scratchM;
+    multiBody->forwardKinematics(scratchQ, scratchM);
+    multiBody->updateCollisionObjectWorldTransforms(scratchQ, scratchM);
+    
+    for(size_t i=0; i<links.size(); ++i)
+        links[i].solid->RestoreState(state);
+}
+
 void FeatherstoneEntity::getAABB(Vector3& min, Vector3& max)
 {
     //Initialize AABB
@@ -27,6 +27,8 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "utils/SystemUtil.hpp"
@@ -106,7 +108,13 @@ SolidEntity::SolidEntity(std::string uniqueName, BodyPhysicsSettings phy, std::s
 
 SolidEntity::~SolidEntity()
 {
-    if(phyMesh != nullptr) delete phyMesh;
+    if(phyMesh != nullptr)
+    {
+        //Cached ray tracing data is keyed by the mesh address
+        if(SimulationApp::getApp() != nullptr)
+            SimulationApp::getApp()->getSimulationManager()->getRayTracingScene()->Evict(phyMesh);
+        delete phyMesh;
+    }
 }
 
 EntityType SolidEntity::getType() const
@@ -195,6 +203,44 @@ int SolidEntity::getPhysicalObject() const
     return phyObjectId;
 }
 
+void SolidEntity::SaveState(SimulationState& state)
+{
+    if(rigidBody != nullptr) //Multibody links are stored by the multibody
+    {
+        state.Write(rigidBody->getCenterOfMassTransform());
+        state.Write(rigidBody->getLinearVelocity());
+        state.Write(rigidBody->getAngularVelocity());
+    }
+    state.Write(lastV);
+    state.Write(lastOmega);
+    state.Write(linearAcc);
+    state.Write(angularAcc);
+}
+
+void SolidEntity::RestoreState(SimulationState& state)
+{
+    if(rigidBody != nullptr)
+    {
+        Transform T;
+        Vector3 v, omega;
+        state.Read(T);
+        state.Read(v);
+        state.Read(omega);
+        rigidBody->setCenterOfMassTransform(T);
+        rigidBody->getMotionState()->setWorldTransform(T);
+        rigidBody->setLinearVelocity(v);
+        rigidBody->setAngularVelocity(omega);
+        rigidBody->setInterpolationLinearVelocity(v);
+        rigidBody->setInterpolationAngularVelocity(omega);
+        rigidBody->clearForces();
+        rigidBody->activate(true);
+    }
+    state.Read(lastV);
+    state.Read(lastOmega);
+    state.Read(linearAcc);
+    state.Read(angularAcc);
+}
+
 bool SolidEntity::isBuoyant() const
 {
     return (phy.mode == BodyPhysicsMode::SUBMERGED || phy.mode == BodyPhysicsMode::FLOATING) && phy.buoyancy;
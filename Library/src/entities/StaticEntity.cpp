@@ -27,6 +27,7 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
@@ -48,7 +49,13 @@ StaticEntity::StaticEntity(std::string uniqueName, std::string material, std::st
 
 StaticEntity::~StaticEntity()
 {
-    if(phyMesh != NULL) delete phyMesh;
+    if(phyMesh != NULL)
+    {
+        //Cached ray tracing data is keyed by the mesh address
+        if(SimulationApp::getApp() != nullptr)
+            SimulationApp::getApp()->getSimulationManager()->getRayTracingScene()->Evict(phyMesh);
+        delete phyMesh;
+    }
 }
 
 EntityType StaticEntity::getType() const
@@ -61,6 +68,11 @@ Material StaticEntity::getMaterial() const
     return mat;
 }
 
+const Mesh* StaticEntity::getPhysicsMesh() const
+{
+    return phyMesh;
+}
+
 void StaticEntity::setTransform(const Transform& trans)
 {
     if(rigidBody != NULL)
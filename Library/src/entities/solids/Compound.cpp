@@ -101,6 +101,11 @@ const CompoundPart Compound::getPart(size_t partId) const
         return nopart;
     }
 }
+
+size_t Compound::getNumOfParts() const
+{
+    return parts.size();
+}
     
 SolidType Compound::getSolidType()
 {
@@ -80,11 +80,8 @@ Polyhedron::Polyhedron(std::string uniqueName, BodyPhysicsSettings phy,
 
 Polyhedron::~Polyhedron()
 {
-    if(graMesh != NULL)
-    {
-        if(graMesh == phyMesh) phyMesh = NULL;
+    if(graMesh != NULL && graMesh != phyMesh) //Shared mesh deleted (and evicted from the ray tracing cache) by the base class
         delete graMesh;
-    }
 }
     
 SolidType Polyhedron::getSolidType()
@@ -158,11 +158,8 @@ Obstacle::Obstacle(std::string uniqueName, Scalar cylinderRadius, Scalar cylinde
     
 Obstacle::~Obstacle()
 {
-    if(graMesh != NULL)
-    {
-        if(graMesh == phyMesh) phyMesh = NULL;
+    if(graMesh != NULL && graMesh != phyMesh) //Shared mesh deleted (and evicted from the ray tracing cache) by the base class
         delete graMesh;
-    }
 }
 
 StaticEntityType Obstacle::getStaticType()
@@ -101,12 +101,12 @@ void OpenGLConsole::Render(bool overlay)
     GLfloat dt = (lastTime-now)/1000000.f;
     lastTime = now;
         
-    if(lines.size() == 0)
+    if(getLinesCount() == 0)
         return;
         
     //Calculate visible lines range
     long int maxVisibleLines = (long int)floorf((GLfloat)windowH/(GLfloat)(STANDARD_FONT_SIZE + 5)) + 1;
-    long int linesCount = lines.size();
+    long int linesCount = getLinesCount();
     long int visibleLines = maxVisibleLines;
     long int scrolledLines = 0;
         
@@ -185,7 +185,7 @@ void OpenGLConsole::Render(bool overlay)
         //Text rendering
         for(long int i = scrolledLines; i < scrolledLines + visibleLines; i++)
         {
-            ConsoleMessage* msg = &lines[linesCount-1-i];
+            const ConsoleMessage* msg = &getLine(linesCount-1-i);
             glm::vec4 color;
             switch(msg->type)
             {
@@ -224,7 +224,7 @@ void OpenGLConsole::Render(bool overlay)
         //Text rendering
         for(long int i = scrolledLines; i < scrolledLines + visibleLines; i++)
         {
-            ConsoleMessage* msg = &lines[linesCount-1-i];
+            const ConsoleMessage* msg = &getLine(linesCount-1-i);
             glm::vec4 color;
             switch(msg->type)
             {
@@ -52,12 +52,18 @@
 namespace sf
 {
 
+std::map<std::string, Mesh*> OpenGLContent::meshCache;
+bool OpenGLContent::meshCaching = false;
+
 OpenGLContent::OpenGLContent()
 {
     //Initialize members
     baseVertexArray = 0;
     cubeBuf = 0;
     lightsUBO = 0;
+    viewUBO = 0;
+    instancesSSBO = 0;
+    instancesSSBOSize = 0;
     csBuf[0] = 0;
     csBuf[1] = 0;
     cylinder.vao = 0;
@@ -74,6 +80,7 @@ OpenGLContent::OpenGLContent()
     currentLookId = -1;
     currentTexturable = false;
     currentShaderMode = -1;
+    currentInstanced = false;
 
     //Get OpenGL capabilities
     maxAnisotropy = 0.0f;
@@ -200,6 +207,9 @@ OpenGLContent::OpenGLContent()
     glBindBufferRange(GL_UNIFORM_BUFFER, UBO_VIEW, viewUBO, 0, sizeof(ViewUBO));
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ViewUBO), &viewZero);
     
+    //Generate SSBO for per-instance data (allocated on first use)
+    glGenBuffers(1, &instancesSSBO);
+    
     //Load shaders
     //-----BASIC-----
     basicShaders["helper"] = new GLSLShader("helpers.frag","helpers.vert");
@@ -235,6 +245,13 @@ OpenGLContent::OpenGLContent()
     basicShaders["shadow"] = new GLSLShader("shadow.frag", "shadow.vert");
     basicShaders["shadow"]->AddUniform("MVP", ParameterType::MAT4);
     
+    basicShaders["flat_instanced"] = new GLSLShader("flat.frag", "flatInstanced.vert");
+    basicShaders["flat_instanced"]->AddUniform("VP", ParameterType::MAT4);
+    basicShaders["flat_instanced"]->AddUniform("FC", ParameterType::FLOAT);
+    
+    basicShaders["shadow_instanced"] = new GLSLShader("shadow.frag", "shadowInstanced.vert");
+    basicShaders["shadow_instanced"]->AddUniform("VP", ParameterType::MAT4);
+    
     //-----MATERIALS-----
     std::vector<std::string> shadingAlgorithms;
     shadingAlgorithms.push_back("blinnPhong");
@@ -250,6 +267,8 @@ OpenGLContent::OpenGLContent()
     //Shaders common for all algorithms
     GLuint materialVertex = GLSLShader::LoadShader(GL_VERTEX_SHADER, "material.vert", "", &compiled);
     GLuint materialUvVertex = GLSLShader::LoadShader(GL_VERTEX_SHADER, "materialUv.vert", "", &compiled);
+    GLuint materialInstancedVertex = GLSLShader::LoadShader(GL_VERTEX_SHADER, "materialInstanced.vert", "", &compiled);
+    GLuint materialUvInstancedVertex = GLSLShader::LoadShader(GL_VERTEX_SHADER, "materialUvInstanced.vert", "", &compiled);
     GLuint materialFragment = GLSLShader::LoadShader(GL_FRAGMENT_SHADER, "material.frag", "", &compiled);
     GLuint materialUvFragment = GLSLShader::LoadShader(GL_FRAGMENT_SHADER, "materialUv.frag", "", &compiled);
     GLuint materialUFragment = GLSLShader::LoadShader(GL_FRAGMENT_SHADER, "materialU.frag", "", &compiled);
@@ -260,103 +279,118 @@ OpenGLContent::OpenGLContent()
     
     for(size_t i=0; i<shadingAlgorithms.size(); ++i)
     {
-        std::vector<GLuint> precompiled = commonMaterialShaders;
+        std::vector<GLuint> precompiled;
         GLuint shadingFragment = GLSLShader::LoadShader(GL_FRAGMENT_SHADER, shadingAlgorithms[i] + ".frag", "", &compiled); 
-        precompiled.push_back(shadingFragment);
 
         MaterialShader ms;
         ms.shadingAlgorithm = shadingAlgorithms[i];
         
-        //Plain
-        precompiled.push_back(materialVertex);
-        precompiled.push_back(materialFragment);
-        ms.shaders[0] = new GLSLShader(precompiled);
-        //Plain underwater
-        precompiled.pop_back();
-        precompiled.push_back(materialUFragment);
-        precompiled.push_back(oceanOpticsFragment);
-        precompiled.push_back(oceanFlatFragment);
-        ms.shaders[1] = new GLSLShader(precompiled);
-        ms.shaders[1]->AddUniform("cWater", ParameterType::VEC3);
-        ms.shaders[1]->AddUniform("bWater", ParameterType::VEC3);
-        //Plain underwater waves
-        precompiled.pop_back();
-        precompiled.push_back(oceanWavesFragment);
-        ms.shaders[2] = new GLSLShader(precompiled);
-        ms.shaders[2]->AddUniform("cWater", ParameterType::VEC3);
-        ms.shaders[2]->AddUniform("bWater", ParameterType::VEC3);
-        ms.shaders[2]->AddUniform("texWaveFFT", ParameterType::INT);
-        ms.shaders[2]->AddUniform("gridSizes", ParameterType::VEC4);
-
-        //Textured
-        precompiled.clear();
-        precompiled = commonMaterialShaders;
-        precompiled.push_back(shadingFragment);
-        precompiled.push_back(materialUvVertex);
-        precompiled.push_back(materialUvFragment);
-        ms.shaders[3] = new GLSLShader(precompiled);
-        ms.shaders[3]->AddUniform("texAlbedo", ParameterType::INT);
-        ms.shaders[3]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders[3]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders[3]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
-        //Textured underwater
-        precompiled.pop_back();
-        precompiled.push_back(materialUUvFragment);
-        precompiled.push_back(oceanOpticsFragment);
-        precompiled.push_back(oceanFlatFragment);
-        ms.shaders[4] = new GLSLShader(precompiled);
-        ms.shaders[4]->AddUniform("texAlbedo", ParameterType::INT);
-        ms.shaders[4]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders[4]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders[4]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
-        ms.shaders[4]->AddUniform("cWater", ParameterType::VEC3);
-        ms.shaders[4]->AddUniform("bWater", ParameterType::VEC3);
-        //Textured underwater waves
-        precompiled.pop_back();
-        precompiled.push_back(oceanWavesFragment);
-        ms.shaders[5] = new GLSLShader(precompiled);
-        ms.shaders[5]->AddUniform("texAlbedo", ParameterType::INT);
-        ms.shaders[5]->AddUniform("texNormal", ParameterType::INT);
-        ms.shaders[5]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
-        ms.shaders[5]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
-        ms.shaders[5]->AddUniform("cWater", ParameterType::VEC3);
-        ms.shaders[5]->AddUniform("bWater", ParameterType::VEC3);
-        ms.shaders[5]->AddUniform("texWaveFFT", ParameterType::INT);
-        ms.shaders[5]->AddUniform("gridSizes", ParameterType::VEC4);
-
-        //Add common uniforms
-        for(size_t h = 0; h<6; ++h)
+        //Per-object (0) and instanced (1) variants
+        for(int inst=0; inst<2; ++inst)
         {
-            ms.shaders[h]->AddUniform("MVP", ParameterType::MAT4);
-            ms.shaders[h]->AddUniform("M", ParameterType::MAT4);
-            ms.shaders[h]->AddUniform("N", ParameterType::MAT3);
-            ms.shaders[h]->AddUniform("MV", ParameterType::MAT3);
-            ms.shaders[h]->AddUniform("FC", ParameterType::FLOAT);
-            ms.shaders[h]->AddUniform("eyePos", ParameterType::VEC3);
-            ms.shaders[h]->AddUniform("viewDir", ParameterType::VEC3);
-            ms.shaders[h]->AddUniform("color", ParameterType::VEC4);
-            ms.shaders[h]->AddUniform("spotLightsDepthMap", ParameterType::INT);
-            ms.shaders[h]->AddUniform("spotLightsShadowMap", ParameterType::INT);
-            ms.shaders[h]->AddUniform("sunShadowMap", ParameterType::INT);
-            ms.shaders[h]->AddUniform("sunDepthMap", ParameterType::INT);
-            ms.shaders[h]->AddUniform("transmittance_texture", ParameterType::INT);
-            ms.shaders[h]->AddUniform("scattering_texture", ParameterType::INT);
-            ms.shaders[h]->AddUniform("irradiance_texture", ParameterType::INT);
-            ms.shaders[h]->BindUniformBlock("SunSky", UBO_SUNSKY);
-            ms.shaders[h]->BindUniformBlock("Lights", UBO_LIGHTS);
-
-            ms.shaders[h]->Use();
-            ms.shaders[h]->SetUniform("spotLightsShadowMap", TEX_SPOT_SHADOW);
-            ms.shaders[h]->SetUniform("spotLightsDepthMap", TEX_SPOT_DEPTH);
-            ms.shaders[h]->SetUniform("sunDepthMap", TEX_SUN_DEPTH);
-            ms.shaders[h]->SetUniform("sunShadowMap", TEX_SUN_SHADOW);
-            ms.shaders[h]->SetUniform("transmittance_texture", TEX_ATM_TRANSMITTANCE);
-            ms.shaders[h]->SetUniform("scattering_texture", TEX_ATM_SCATTERING);
-            ms.shaders[h]->SetUniform("irradiance_texture", TEX_ATM_IRRADIANCE);
-            if(h > 2) //Textured?
+            GLSLShader** shaderSet = inst ? ms.shadersInstanced : ms.shaders;
+            precompiled = commonMaterialShaders;
+            precompiled.push_back(shadingFragment);
+
+            //Plain
+            precompiled.push_back(inst ? materialInstancedVertex : materialVertex);
+            precompiled.push_back(materialFragment);
+            shaderSet[0] = new GLSLShader(precompiled);
+            //Plain underwater
+            precompiled.pop_back();
+            precompiled.push_back(materialUFragment);
+            precompiled.push_back(oceanOpticsFragment);
+            precompiled.push_back(oceanFlatFragment);
+            shaderSet[1] = new GLSLShader(precompiled);
+            shaderSet[1]->AddUniform("cWater", ParameterType::VEC3);
+            shaderSet[1]->AddUniform("bWater", ParameterType::VEC3);
+            //Plain underwater waves
+            precompiled.pop_back();
+            precompiled.push_back(oceanWavesFragment);
+            shaderSet[2] = new GLSLShader(precompiled);
+            shaderSet[2]->AddUniform("cWater", ParameterType::VEC3);
+            shaderSet[2]->AddUniform("bWater", ParameterType::VEC3);
+            shaderSet[2]->AddUniform("texWaveFFT", ParameterType::INT);
+            shaderSet[2]->AddUniform("gridSizes", ParameterType::VEC4);
+
+            //Textured
+            precompiled.clear();
+            precompiled = commonMaterialShaders;
+            precompiled.push_back(shadingFragment);
+            precompiled.push_back(inst ? materialUvInstancedVertex : materialUvVertex);
+            precompiled.push_back(materialUvFragment);
+            shaderSet[3] = new GLSLShader(precompiled);
+            shaderSet[3]->AddUniform("texAlbedo", ParameterType::INT);
+            shaderSet[3]->AddUniform("texNormal", ParameterType::INT);
+            shaderSet[3]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
+            shaderSet[3]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
+            //Textured underwater
+            precompiled.pop_back();
+            precompiled.push_back(materialUUvFragment);
+            precompiled.push_back(oceanOpticsFragment);
+            precompiled.push_back(oceanFlatFragment);
+            shaderSet[4] = new GLSLShader(precompiled);
+            shaderSet[4]->AddUniform("texAlbedo", ParameterType::INT);
+            shaderSet[4]->AddUniform("texNormal", ParameterType::INT);
+            shaderSet[4]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
+            shaderSet[4]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
+            shaderSet[4]->AddUniform("cWater", ParameterType::VEC3);
+            shaderSet[4]->AddUniform("bWater", ParameterType::VEC3);
+            //Textured underwater waves
+            precompiled.pop_back();
+            precompiled.push_back(oceanWavesFragment);
+            shaderSet[5] = new GLSLShader(precompiled);
+            shaderSet[5]->AddUniform("texAlbedo", ParameterType::INT);
+            shaderSet[5]->AddUniform("texNormal", ParameterType::INT);
+            shaderSet[5]->AddUniform("enableAlbedoTex", ParameterType::BOOLEAN);
+            shaderSet[5]->AddUniform("enableNormalTex", ParameterType::BOOLEAN);
+            shaderSet[5]->AddUniform("cWater", ParameterType::VEC3);
+            shaderSet[5]->AddUniform("bWater", ParameterType::VEC3);
+            shaderSet[5]->AddUniform("texWaveFFT", ParameterType::INT);
+            shaderSet[5]->AddUniform("gridSizes", ParameterType::VEC4);
+
+            //Add common uniforms
+            for(size_t h = 0; h<6; ++h)
             {
-                ms.shaders[h]->SetUniform("texAlbedo", TEX_MAT_ALBEDO);
-                ms.shaders[h]->SetUniform("texNormal", TEX_MAT_NORMAL);
+                if(inst)
+                {
+                    shaderSet[h]->AddUniform("VP", ParameterType::MAT4);
+                    shaderSet[h]->AddUniform("V", ParameterType::MAT3);
+                }
+                else
+                {
+                    shaderSet[h]->AddUniform("MVP", ParameterType::MAT4);
+                    shaderSet[h]->AddUniform("M", ParameterType::MAT4);
+                    shaderSet[h]->AddUniform("N", ParameterType::MAT3);
+                    shaderSet[h]->AddUniform("MV", ParameterType::MAT3);
+                }
+                shaderSet[h]->AddUniform("FC", ParameterType::FLOAT);
+                shaderSet[h]->AddUniform("eyePos", ParameterType::VEC3);
+                shaderSet[h]->AddUniform("viewDir", ParameterType::VEC3);
+                shaderSet[h]->AddUniform("color", ParameterType::VEC4);
+                shaderSet[h]->AddUniform("spotLightsDepthMap", ParameterType::INT);
+                shaderSet[h]->AddUniform("spotLightsShadowMap", ParameterType::INT);
+                shaderSet[h]->AddUniform("sunShadowMap", ParameterType::INT);
+                shaderSet[h]->AddUniform("sunDepthMap", ParameterType::INT);
+                shaderSet[h]->AddUniform("transmittance_texture", ParameterType::INT);
+                shaderSet[h]->AddUniform("scattering_texture", ParameterType::INT);
+                shaderSet[h]->AddUniform("irradiance_texture", ParameterType::INT);
+                shaderSet[h]->BindUniformBlock("SunSky", UBO_SUNSKY);
+                shaderSet[h]->BindUniformBlock("Lights", UBO_LIGHTS);
+
+                shaderSet[h]->Use();
+                shaderSet[h]->SetUniform("spotLightsShadowMap", TEX_SPOT_SHADOW);
+                shaderSet[h]->SetUniform("spotLightsDepthMap", TEX_SPOT_DEPTH);
+                shaderSet[h]->SetUniform("sunDepthMap", TEX_SUN_DEPTH);
+                shaderSet[h]->SetUniform("sunShadowMap", TEX_SUN_SHADOW);
+                shaderSet[h]->SetUniform("transmittance_texture", TEX_ATM_TRANSMITTANCE);
+                shaderSet[h]->SetUniform("scattering_texture", TEX_ATM_SCATTERING);
+                shaderSet[h]->SetUniform("irradiance_texture", TEX_ATM_IRRADIANCE);
+                if(h > 2) //Textured?
+                {
+                    shaderSet[h]->SetUniform("texAlbedo", TEX_MAT_ALBEDO);
+                    shaderSet[h]->SetUniform("texNormal", TEX_MAT_NORMAL);
+                }
             }
         }
 
@@ -365,14 +399,14 @@ OpenGLContent::OpenGLContent()
         glDeleteShader(shadingFragment);
     }
 
-    for(size_t i=0; i<6; ++i)
+    for(size_t i=0; i<12; ++i)
     {
         GLSLShader* shader;
-        shader = materialShaders[0].shaders[i];
+        shader = i < 6 ? materialShaders[0].shaders[i] : materialShaders[0].shadersInstanced[i-6];
         shader->AddUniform("shininess", ParameterType::FLOAT);
         shader->AddUniform("specularStrength", ParameterType::FLOAT);
         shader->AddUniform("reflectivity", ParameterType::FLOAT);
-        shader = materialShaders[1].shaders[i];
+        shader = i < 6 ? materialShaders[1].shaders[i] : materialShaders[1].shadersInstanced[i-6];
         shader->AddUniform("roughness", ParameterType::FLOAT);
         shader->AddUniform("metallic", ParameterType::FLOAT);
         shader->AddUniform("reflectivity", ParameterType::FLOAT);
@@ -380,6 +414,8 @@ OpenGLContent::OpenGLContent()
 
     glDeleteShader(materialVertex);
     glDeleteShader(materialUvVertex);
+    glDeleteShader(materialInstancedVertex);
+    glDeleteShader(materialUvInstancedVertex);
     glDeleteShader(materialFragment);
     glDeleteShader(materialUvFragment);
     glDeleteShader(materialUFragment);
@@ -464,6 +500,7 @@ OpenGLContent::~OpenGLContent()
     if(csBuf[0] != 0) glDeleteBuffers(2, csBuf);
     if(lightsUBO != 0) glDeleteBuffers(1, &lightsUBO);
     if(viewUBO != 0) glDeleteBuffers(1, &viewUBO);
+    if(instancesSSBO != 0) glDeleteBuffers(1, &instancesSSBO);
     delete basicShaders["helper"];
     delete basicShaders["tex_saq"];
     delete basicShaders["tex_quad"];
@@ -472,6 +509,8 @@ OpenGLContent::~OpenGLContent()
     delete basicShaders["tex_cube"];
     delete basicShaders["flat"];
     delete basicShaders["shadow"];
+    delete basicShaders["flat_instanced"];
+    delete basicShaders["shadow_instanced"];
     if(lightSourceShader[0] != NULL) delete lightSourceShader[0];
     if(lightSourceShader[1] != NULL) delete lightSourceShader[1];
     
@@ -479,7 +518,10 @@ OpenGLContent::~OpenGLContent()
     for(size_t i=0; i<materialShaders.size(); ++i)
     {
         for(size_t h=0; h<6; ++h)
+        {
             delete materialShaders[i].shaders[h];
+            delete materialShaders[i].shadersInstanced[h];
+        }
     }
     
     //Views
@@ -813,6 +855,79 @@ void OpenGLContent::DrawObject(int objectId, int lookId, const glm::mat4& M)
     }
 }
 
+void OpenGLContent::DrawObjectInstanced(int objectId, int lookId, const glm::mat4* M, GLsizei count)
+{
+    if(objectId < 0 || objectId >= (int)objects.size() || count < 1)
+        return;
+    
+    //Raw mode relies on external shaders which do not read instance data
+    if(count < INSTANCING_MIN_COUNT || mode == DrawingMode::RAW)
+    {
+        for(GLsizei i=0; i<count; ++i)
+            DrawObject(objectId, lookId, M[i]);
+        return;
+    }
+    
+    UploadInstances(M, count);
+    
+    switch(mode)
+    {
+        case DrawingMode::SHADOW:
+        {
+            basicShaders["shadow_instanced"]->Use();
+            basicShaders["shadow_instanced"]->SetUniform("VP", viewProjection);
+        }
+        break;
+        
+        case DrawingMode::FLAT:
+        {
+            basicShaders["flat_instanced"]->Use();
+            basicShaders["flat_instanced"]->SetUniform("VP", viewProjection);
+            basicShaders["flat_instanced"]->SetUniform("FC", FC);
+        }
+        break;
+
+        default:
+        {
+            GLSLShader* shader = SetupLook((lookId >= 0 && lookId < (int)looks.size()) ? lookId : -1, objects[objectId].texturable, true);
+            shader->SetUniform("VP", viewProjection);
+            shader->SetUniform("V", glm::mat3(view)); //View matrix is rigid, so its normal matrix is its rotation part
+        }
+        break;
+    }
+    
+    OpenGLState::BindVertexArray(objects[objectId].vao);
+    glDrawElementsInstanced(GL_TRIANGLES, sizeof(Face) * objects[objectId].faceCount, GL_UNSIGNED_INT, 0, count);
+    OpenGLState::BindVertexArray(0);
+}
+
+void OpenGLContent::DrawObjects(const std::vector<Renderable>& queue, bool useLooks)
+{
+    size_t i = 0;
+    while(i < queue.size())
+    {
+        if(queue[i].type != RenderableType::SOLID)
+        {
+            ++i;
+            continue;
+        }
+        
+        //Collect consecutive copies of the same object (queue sorted by look and object)
+        int objectId = queue[i].objectId;
+        int lookId = useLooks ? queue[i].lookId : -1;
+        instanceMatrices.clear();
+        for(; i < queue.size(); ++i)
+        {
+            if(queue[i].type != RenderableType::SOLID 
+               || queue[i].objectId != objectId
+               || (useLooks && queue[i].lookId != lookId))
+                break;
+            instanceMatrices.push_back(queue[i].model);
+        }
+        DrawObjectInstanced(objectId, lookId, &instanceMatrices[0], (GLsizei)instanceMatrices.size());
+    }
+}
+
 void OpenGLContent::DrawLightSource(unsigned int lightId)
 {
     if(lightId >= lights.size())
@@ -877,79 +992,108 @@ void OpenGLContent::SetupLights()
 }
 
 void OpenGLContent::UseLook(unsigned int lookId, bool texturable, const glm::mat4& M)
-{	
+{
+    GLSLShader* shader = SetupLook((int)lookId, texturable, false);
+    shader->SetUniform("MVP", viewProjection*M);
+    shader->SetUniform("M", M);
+    shader->SetUniform("N", glm::mat3(glm::transpose(glm::inverse(M))));
+    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view*M))));
+}
+
+void OpenGLContent::UseStandardLook(const glm::mat4& M)
+{
+    GLSLShader* shader = SetupLook(-1, false, false);
+    shader->SetUniform("MVP", viewProjection*M);
+    shader->SetUniform("M", M);
+    shader->SetUniform("N", glm::mat3(glm::transpose(glm::inverse(M))));
+    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view*M))));
+}
+
+GLSLShader* OpenGLContent::SetupLook(int lookId, bool texturable, bool instanced)
+{
     bool waves = false;
     Ocean* ocean = SimulationApp::getApp()->getSimulationManager()->getOcean();
     if(ocean != NULL && ocean->hasWaves()) waves = true;
     
-    Look& l = looks[lookId];
-    texturable = texturable && (l.albedoTexture > 0 || l.normalTexture > 0);
+    Look* l = lookId >= 0 ? &looks[lookId] : NULL; //NULL -> standard look
+    texturable = l != NULL && texturable && (l->albedoTexture > 0 || l->normalTexture > 0);
     int shaderMode = (mode == DrawingMode::UNDERWATER) ? (waves ? 2 : 1) : 0;
 
-    bool updateMaterial = ((int)lookId != currentLookId) 
+    bool updateMaterial = (lookId != currentLookId) 
                           || (currentTexturable != texturable)
-                          || (currentShaderMode != shaderMode);
-    currentLookId = (int)lookId;
+                          || (currentShaderMode != shaderMode)
+                          || (currentInstanced != instanced);
+    currentLookId = lookId;
     currentTexturable = texturable;
     currentShaderMode = shaderMode;
+    currentInstanced = instanced;
 
     size_t shaderId = (currentTexturable ? 3 : 0) + (size_t)currentShaderMode;
-    GLSLShader* shader = materialShaders[l.type == LookType::SIMPLE ? 0 : 1].shaders[shaderId];
+    MaterialShader& ms = materialShaders[(l != NULL && l->type == LookType::SIMPLE) ? 0 : 1];
+    GLSLShader* shader = instanced ? ms.shadersInstanced[shaderId] : ms.shaders[shaderId];
     shader->Use();
-    shader->SetUniform("MVP", viewProjection*M);
-    shader->SetUniform("M", M);
-    shader->SetUniform("N", glm::mat3(glm::transpose(glm::inverse(M))));
-    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view*M))));
     shader->SetUniform("FC", FC);
     shader->SetUniform("eyePos", eyePos);
     shader->SetUniform("viewDir", viewDir);
 
     if(updateMaterial)
     {
-        switch(l.type)
-        {		
-            default:
-            case LookType::SIMPLE: //Blinn-Phong
-            {
-                shader->SetUniform("specularStrength", l.params[0]);
-                shader->SetUniform("shininess", l.params[1]);
-                shader->SetUniform("reflectivity", l.reflectivity);
-                shader->SetUniform("color", glm::vec4(l.color, 1.f));
-            }
-            break;
-            
-            case LookType::PHYSICAL: //Cook-Torrance
-            {
-                shader->SetUniform("roughness", l.params[0]);
-                shader->SetUniform("metallic", l.params[1]);
-                shader->SetUniform("reflectivity", l.reflectivity);
-                shader->SetUniform("color", glm::vec4(l.color, 1.f));
-            }
-            break;
+        if(l == NULL)
+        {
+            shader->SetUniform("roughness", 0.5f);
+            shader->SetUniform("metallic", 0.f);
+            shader->SetUniform("reflectivity", 0.f);
+            shader->SetUniform("color", glm::vec4(0.5f, 0.5f, 0.5f, 0.f));
+            OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
+            OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
         }
-
-        if(currentTexturable)
+        else
         {
-            if(l.albedoTexture > 0)
-            {
-                shader->SetUniform("enableAlbedoTex", true);
-                OpenGLState::BindTexture(TEX_MAT_ALBEDO, GL_TEXTURE_2D, l.albedoTexture);
-            }
-            else
-            {
-                shader->SetUniform("enableAlbedoTex", false);
-                OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
+            switch(l->type)
+            {		
+                default:
+                case LookType::SIMPLE: //Blinn-Phong
+                {
+                    shader->SetUniform("specularStrength", l->params[0]);
+                    shader->SetUniform("shininess", l->params[1]);
+                    shader->SetUniform("reflectivity", l->reflectivity);
+                    shader->SetUniform("color", glm::vec4(l->color, 1.f));
+                }
+                break;
+                
+                case LookType::PHYSICAL: //Cook-Torrance
+                {
+                    shader->SetUniform("roughness", l->params[0]);
+                    shader->SetUniform("metallic", l->params[1]);
+                    shader->SetUniform("reflectivity", l->reflectivity);
+                    shader->SetUniform("color", glm::vec4(l->color, 1.f));
+                }
+                break;
             }
 
-            if(l.normalTexture > 0)
+            if(currentTexturable)
             {
-                shader->SetUniform("enableNormalTex", true);
-                OpenGLState::BindTexture(TEX_MAT_NORMAL, GL_TEXTURE_2D, l.normalTexture);
-            }
-            else
-            {
-                shader->SetUniform("enableNormalTex", false);
-                OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
+                if(l->albedoTexture > 0)
+                {
+                    shader->SetUniform("enableAlbedoTex", true);
+                    OpenGLState::BindTexture(TEX_MAT_ALBEDO, GL_TEXTURE_2D, l->albedoTexture);
+                }
+                else
+                {
+                    shader->SetUniform("enableAlbedoTex", false);
+                    OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
+                }
+
+                if(l->normalTexture > 0)
+                {
+                    shader->SetUniform("enableNormalTex", true);
+                    OpenGLState::BindTexture(TEX_MAT_NORMAL, GL_TEXTURE_2D, l->normalTexture);
+                }
+                else
+                {
+                    shader->SetUniform("enableNormalTex", false);
+                    OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
+                }
             }
         }
     }
@@ -965,52 +1109,29 @@ void OpenGLContent::UseLook(unsigned int lookId, bool texturable, const glm::mat
             shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
         }
     }
+    
+    return shader;
 }
 
-void OpenGLContent::UseStandardLook(const glm::mat4& M)
+void OpenGLContent::UploadInstances(const glm::mat4* M, GLsizei count)
 {
-    bool waves = false;
-    Ocean* ocean = SimulationApp::getApp()->getSimulationManager()->getOcean();
-    if(ocean != NULL && ocean->hasWaves()) waves = true;
-    
-    int shaderMode = (mode == DrawingMode::UNDERWATER) ? (waves ? 2 : 1) : 0;
-    bool updateMaterial = (currentLookId >= 0)
-                          || (currentShaderMode != shaderMode);
-    currentLookId = -1;
-    currentTexturable = false;
-    currentShaderMode = shaderMode;
-
-    GLSLShader* shader = materialShaders[1].shaders[(size_t)currentShaderMode];
-    shader->Use();
-    shader->SetUniform("MVP", viewProjection*M);
-    shader->SetUniform("M", M);
-    shader->SetUniform("N", glm::mat3(glm::transpose(glm::inverse(M))));
-    shader->SetUniform("MV", glm::mat3(glm::transpose(glm::inverse(view*M))));
-    shader->SetUniform("FC", FC);
-    shader->SetUniform("eyePos", eyePos);
-    shader->SetUniform("viewDir", viewDir);
-
-    if(updateMaterial)
+    //Model and normal matrix per instance (std430 layout)
+    instanceData.resize(count * 2);
+    for(GLsizei i=0; i<count; ++i)
     {
-        shader->SetUniform("roughness", 0.5f);
-        shader->SetUniform("metallic", 0.f);
-        shader->SetUniform("reflectivity", 0.f);
-        shader->SetUniform("color", glm::vec4(0.5f, 0.5f, 0.5f, 0.f));
-        OpenGLState::UnbindTexture(TEX_MAT_ALBEDO);
-        OpenGLState::UnbindTexture(TEX_MAT_NORMAL);
-    }
-
-    if(mode == DrawingMode::UNDERWATER)
-    {
-        shader->SetUniform("cWater", ocean->getOpenGLOcean()->getLightAttenuation());
-        shader->SetUniform("bWater", ocean->getOpenGLOcean()->getLightScattering());
-        if(waves)
-        {
-            OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D_ARRAY, ocean->getOpenGLOcean()->getWaveTexture());
-            shader->SetUniform("texWaveFFT", TEX_POSTPROCESS1);
-            shader->SetUniform("gridSizes", ocean->getOpenGLOcean()->getWaveGridSizes());
-        }
+        instanceData[i*2] = M[i];
+        instanceData[i*2+1] = glm::mat4(glm::mat3(glm::transpose(glm::inverse(M[i]))));
     }
+    
+    GLsizeiptr size = (GLsizeiptr)(sizeof(glm::mat4) * instanceData.size());
+    if(size > instancesSSBOSize)
+        instancesSSBOSize = size > 2 * instancesSSBOSize ? size : 2 * instancesSSBOSize;
+    
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, instancesSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, instancesSSBOSize, NULL, GL_STREAM_DRAW); //Orphan storage used by previous draws
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size, &instanceData[0]);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_INSTANCES, instancesSSBO);
 }
 
 unsigned int OpenGLContent::BuildObject(Mesh* mesh)
@@ -1022,6 +1143,7 @@ unsigned int OpenGLContent::BuildObject(Mesh* mesh)
     glGenBuffers(1, &obj.vboIndex);
     obj.faceCount = (GLsizei)mesh->faces.size();
     obj.texturable = false;
+    AABB(mesh, obj.aabbMin, obj.aabbMax);
     
     OpenGLState::BindVertexArray(obj.vao);	
     glEnableVertexAttribArray(0); //Position
@@ -1151,6 +1273,11 @@ const Object& OpenGLContent::getObject(size_t id)
     return objects[id];
 }
 
+size_t OpenGLContent::getObjectsCount()
+{
+    return objects.size();
+}
+
 const Look& OpenGLContent::getLook(size_t id)
 {
     return looks[id];
@@ -2279,18 +2406,77 @@ Mesh* OpenGLContent::BuildTerrain(GLfloat* heightfield, int sizeX, int sizeY, GL
 
 Mesh* OpenGLContent::LoadMesh(const std::string& filename, GLfloat scale, bool smooth)
 {
-    Mesh* mesh = LoadGeometryFromFile(filename, scale);
-    CheckAndRepairFaceVertexOrder(mesh);
+    std::string key;
+    if(meshCaching)
+    {
+        key = MeshCacheKey(filename, scale, smooth);
+        std::map<std::string, Mesh*>::iterator it = meshCache.find(key);
+        if(it != meshCache.end()) //Return a copy of the processed mesh
+        {
+            if(it->second->isTexturable())
+                return new TexturableMesh(*(TexturableMesh*)it->second);
+            else
+                return new PlainMesh(*(PlainMesh*)it->second);
+        }
+    }
 
+    Mesh* mesh = LoadGeometryFromFile(filename, scale);
     if(mesh == nullptr)
         abort();
+    
+    CheckAndRepairFaceVertexOrder(mesh);
     if(smooth)
         SmoothNormals(mesh);
     if(mesh->isTexturable())
         ComputeTangents((TexturableMesh*)mesh);
+
+    if(meshCaching)
+    {
+        if(mesh->isTexturable())
+            meshCache[key] = new TexturableMesh(*(TexturableMesh*)mesh);
+        else
+            meshCache[key] = new PlainMesh(*(PlainMesh*)mesh);
+    }
     return mesh;
 }
 
+void OpenGLContent::setMeshCaching(bool enabled)
+{
+    meshCaching = enabled;
+}
+
+bool OpenGLContent::isMeshCaching()
+{
+    return meshCaching;
+}
+
+void OpenGLContent::AddMeshToCache(const std::string& key, Mesh* mesh)
+{
+    std::map<std::string, Mesh*>::iterator it = meshCache.find(key);
+    if(it != meshCache.end())
+        delete it->second;
+    meshCache[key] = mesh;
+}
+
+void OpenGLContent::ClearMeshCache()
+{
+    for(std::map<std::string, Mesh*>::iterator it = meshCache.begin(); it != meshCache.end(); ++it)
+        delete it->second;
+    meshCache.clear();
+}
+
+const std::map<std::string, Mesh*>& OpenGLContent::getMeshCache()
+{
+    return meshCache;
+}
+
+std::string OpenGLContent::MeshCacheKey(const std::string& filename, GLfloat scale, bool smooth)
+{
+    char buffer[64];
+    snprintf(buffer, 64, "|%.9g|%d", (double)scale, smooth ? 1 : 0);
+    return filename + std::string(buffer);
+}
+
 void OpenGLContent::TransformMesh(Mesh* mesh, const Transform& T)
 {
     glm::mat4 gT = glMatrixFromTransform(T);
@@ -32,6 +32,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLReadbackRing.h"
 
 namespace sf
 {
@@ -47,14 +48,13 @@ OpenGLDepthCamera::OpenGLDepthCamera(glm::vec3 eyePosition, glm::vec3 direction,
 {
     _needsUpdate = false;
     continuous = continuousUpdate;
-    newData = false;
     camera = NULL;
     noiseDepth = 0.f;
     idx = 0;
     range.x = minDepth;
     range.y = maxDepth;
     usesRanges = useRanges;
-    linearDepthPBO = 0;
+    readback = NULL;
     
     SetupCamera(eyePosition, direction, cameraUp);
     UpdateTransform();
@@ -123,10 +123,8 @@ OpenGLDepthCamera::~OpenGLDepthCamera()
     glDeleteTextures(1, &linearDepthTex);
     glDeleteFramebuffers(1, &linearDepthFBO);
 
-    if(camera != NULL)
-    {
-        glDeleteBuffers(1, &linearDepthPBO);
-    }
+    if(readback != NULL)
+        delete readback;
 }
 
 void OpenGLDepthCamera::SetupCamera(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
@@ -142,19 +140,26 @@ void OpenGLDepthCamera::UpdateTransform()
     dir = tempDir;
     up = tempUp;
     SetupCamera();
+    
+    viewUBOData.VP = GetProjectionMatrix() * GetViewMatrix();
+    viewUBOData.eye = GetEyePosition();
+    ExtractFrustumFromVP(viewUBOData.frustum, viewUBOData.VP);
 
-    //Inform camera to run callback
-    if(newData)
+    //Inform camera to run callback (only for completed frames)
+    if(readback != NULL)
+        ProcessReadback(false);
+}
+
+void OpenGLDepthCamera::ProcessReadback(bool wait)
+{
+    void* src;
+    Scalar timeStamp;
+    while(readback->Map(src, timeStamp, wait))
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
-        GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
-        {
-            camera->NewDataReady(src, idx);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
-        }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        newData = false;
+        camera->setFrameTimeStamp(timeStamp);
+        camera->NewDataReady(src, idx);
+        readback->Unmap();
+        wait = false;
     }
 }
 
@@ -195,6 +200,8 @@ GLfloat OpenGLDepthCamera::GetFarClip() const
 
 void OpenGLDepthCamera::Update()
 {
+    if(_needsUpdate) //Previous request not rendered yet
+        ++missedUpdates;
     _needsUpdate = true;
 }
 
@@ -214,10 +221,7 @@ void OpenGLDepthCamera::setCamera(Camera* cam, unsigned int index)
     camera = cam;
     idx = index;
 
-    glGenBuffers(1, &linearDepthPBO);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * sizeof(GLfloat), 0, GL_STREAM_READ);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback = new OpenGLReadbackRing(viewportWidth * viewportHeight * sizeof(GLfloat));
 }
 
 void OpenGLDepthCamera::setNoise(GLfloat depthStdDev)
@@ -239,12 +243,7 @@ void OpenGLDepthCamera::ComputeOutput(std::vector<Renderable>& objects)
     OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
     glClear(GL_DEPTH_BUFFER_BIT);
     glDisable(GL_DEPTH_CLAMP);
-    for(size_t h=0; h<objects.size(); ++h)
-    {
-        if(objects[h].type != RenderableType::SOLID)
-            continue;
-        content->DrawObject(objects[h].objectId, -1, objects[h].model);
-    }
+    content->DrawObjects(objects, false);
     glEnable(GL_DEPTH_CLAMP);
     OpenGLState::BindFramebuffer(0);
 }
@@ -327,12 +326,15 @@ void OpenGLDepthCamera::DrawLDR(GLuint destinationFBO, bool updated)
             else LinearizeDepth();
         }
                 
+        if(!readback->BeginReadback()) //Ring full -> consume the oldest frame first
+        {
+            ProcessReadback(true);
+            readback->BeginReadback();
+        }
         OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, linearDepthTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, linearDepthPBO);
         glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        readback->EndReadback(((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getFrameTimeStamp());
         OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
-        newData = true;
     }
 }
 
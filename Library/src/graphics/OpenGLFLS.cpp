@@ -260,26 +260,7 @@ void OpenGLFLS::UpdateTransform()
     }
 
     //Inform sonar to run callback
-    if(newData)
-    {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
-        {
-            sonar->NewDataReady(src, 0);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
-        }
-        
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
-        {
-            sonar->NewDataReady(src, 1);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
-        }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        newData = false;
-    }
+    ProcessReadback(sonar, false);
 }
 
 void OpenGLFLS::setNoise(glm::vec2 signalStdDev)
@@ -287,19 +268,27 @@ void OpenGLFLS::setNoise(glm::vec2 signalStdDev)
     noise = signalStdDev;
 }
 
+bool OpenGLFLS::isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const
+{
+    if(!OpenGLSonar::isVisible(aabbMin, aabbMax))
+        return false;
+    
+    //Bounding sphere against a cone enclosing the field of view
+    glm::vec3 c = (aabbMin + aabbMax) * 0.5f - GetEyePosition();
+    GLfloat r = glm::length(aabbMax - aabbMin) * 0.5f;
+    GLfloat dist = glm::length(c);
+    if(dist <= r)
+        return true;
+    GLfloat halfAngle = glm::max(fov.x, fov.y) * 0.5f;
+    GLfloat angle = acosf(glm::clamp(glm::dot(c/dist, GetLookingDirection()), -1.f, 1.f));
+    return angle - asinf(r/dist) <= halfAngle;
+}
+
 void OpenGLFLS::setSonar(FLS* s)
 {
     sonar = s;
 
-    glGenBuffers(1, &outputPBO);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, nBeams * nBins, 0, GL_STREAM_READ);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-
-    glGenBuffers(1, &displayPBO);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * 3, 0, GL_STREAM_READ);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    InitReadback(nBeams * nBins);
 }
 
 void OpenGLFLS::ComputeOutput(std::vector<Renderable>& objects)
@@ -429,16 +418,7 @@ void OpenGLFLS::DrawLDR(GLuint destinationFBO, bool updated)
     //Copy texture to sonar buffer
     if(sonar != nullptr && updated)
     {
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTex[1]);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, outputPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, displayPBO);
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
-        newData = true;
+        ReadbackOutput(sonar, outputTex[1]);
     }
 }
 
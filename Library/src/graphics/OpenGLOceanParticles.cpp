@@ -25,6 +25,7 @@
 
 #include "graphics/OpenGLOceanParticles.h"
 
+#include <random>
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
 #include "graphics/OpenGLState.h"
@@ -80,6 +80,16 @@ OpenGLPipeline::OpenGLPipeline(RenderSettings s, HelperSettings h) : rSettings(s
         cError("Display FBO initialization failed!");
     OpenGLState::BindFramebuffer(0);
     lastSimTime = Scalar(0);
+    sensorViewsOnly = false;
+    updatedViews = 0;
+    scheduling = ViewScheduling::ROUND_ROBIN;
+    cullingCacheValid = false;
+    drawingQueueSize = 0;
+    selectedDrawingQueueSize = 0;
+    drawingQueuePendingSize = 0;
+    selectedDrawingQueuePendingSize = 0;
+    drawingQueueTimeStamp = Scalar(0);
+    frameTimeStamp = Scalar(0);
 }
 
 OpenGLPipeline::~OpenGLPipeline()
@@ -91,6 +101,8 @@ OpenGLPipeline::~OpenGLPipeline()
     OpenGLLight::Destroy();
     delete content;
     
+    if(viewQueries.size() > 0)
+        glDeleteQueries((GLsizei)viewQueries.size(), &viewQueries[0]);
     glDeleteTextures(1, &screenTex);
     glDeleteFramebuffers(1, &screenFBO);
     SDL_DestroyMutex(drawingQueueMutex);
@@ -121,34 +133,119 @@ OpenGLContent* OpenGLPipeline::getContent()
     return content;
 }
 
+void OpenGLPipeline::setSensorViewsOnly(bool enabled)
+{
+    sensorViewsOnly = enabled;
+}
+
+bool OpenGLPipeline::isSensorViewsOnly() const
+{
+    return sensorViewsOnly;
+}
+
+unsigned int OpenGLPipeline::getUpdatedViewsCount() const
+{
+    return updatedViews;
+}
+
+void OpenGLPipeline::setViewScheduling(ViewScheduling s)
+{
+    scheduling = s;
+    viewsQueue.clear();
+}
+
+ViewScheduling OpenGLPipeline::getViewScheduling() const
+{
+    return scheduling;
+}
+
+ViewStatistics OpenGLPipeline::getViewStatistics(size_t id)
+{
+    ViewStatistics stats;
+    if(id < viewStats.size())
+        stats = viewStats[id];
+    if(id < content->getViewsCount())
+        stats.missedCount += content->getView(id)->getMissedUpdatesCount();
+    return stats;
+}
+
+Scalar OpenGLPipeline::getFrameTimeStamp() const
+{
+    return frameTimeStamp;
+}
+
+//Returns the next free slot of a queue, taking a spare slot (if available) when the queue has to grow
+static Renderable& NextSlot(std::vector<Renderable>& queue, size_t& size, std::vector<Renderable>* spare)
+{
+    if(size == queue.size())
+    {
+        if(spare == nullptr || spare->empty())
+            queue.emplace_back();
+        else
+        {
+            queue.push_back(std::move(spare->back()));
+            spare->pop_back();
+        }
+    }
+    return queue[size++];
+}
+
+//Copy-assignment reuses the memory of the material name and the points of the slot
+static void PushToQueue(std::vector<Renderable>& queue, size_t& size, const Renderable& r, std::vector<Renderable>* spare = nullptr)
+{
+    NextSlot(queue, size, spare) = r;
+}
+
+//Shortens a queue to its used slots, moving the rest (with their memory) to the spare slots
+static void TrimQueue(std::vector<Renderable>& queue, size_t size, std::vector<Renderable>& spare)
+{
+    for(size_t i=size; i<queue.size(); ++i)
+        spare.push_back(std::move(queue[i]));
+    queue.resize(size);
+}
+
 void OpenGLPipeline::AddToDrawingQueue(const Renderable& r)
 {
-    drawingQueue.push_back(r);
+    PushToQueue(drawingQueue, drawingQueueSize, r);
 }
 
 void OpenGLPipeline::AddToDrawingQueue(const std::vector<Renderable>& r)
 {
-    drawingQueue.insert(drawingQueue.end(), r.begin(), r.end());
+    for(size_t i=0; i<r.size(); ++i)
+        PushToQueue(drawingQueue, drawingQueueSize, r[i]);
 }
 
 void OpenGLPipeline::AddToSelectedDrawingQueue(const std::vector<Renderable>& r)
 {
-    selectedDrawingQueue.insert(selectedDrawingQueue.end(), r.begin(), r.end());
+    for(size_t i=0; i<r.size(); ++i)
+        PushToQueue(selectedDrawingQueue, selectedDrawingQueueSize, r[i]);
+}
+
+void OpenGLPipeline::SubmitDrawingQueue(Scalar t)
+{
+    //The pending buffers come back with their slots (unused if the rendering thread did not take them)
+    drawingQueue.swap(drawingQueuePending);
+    selectedDrawingQueue.swap(selectedDrawingQueuePending);
+    drawingQueuePendingSize = drawingQueueSize;
+    selectedDrawingQueuePendingSize = selectedDrawingQueueSize;
+    drawingQueueSize = 0;
+    selectedDrawingQueueSize = 0;
+    drawingQueueTimeStamp = t;
 }
 
 void OpenGLPipeline::PurgeDrawingQueue()
 {
-    drawingQueue.clear();
+    drawingQueueSize = 0;
 }
 
 void OpenGLPipeline::PurgeSelectedDrawingQueue()
 {
-    selectedDrawingQueue.clear();
+    selectedDrawingQueueSize = 0;
 }
 
 bool OpenGLPipeline::isDrawingQueueEmpty()
 {
-    return drawingQueue.empty();
+    return drawingQueuePendingSize == 0;
 }
     
 void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
@@ -156,6 +253,7 @@ void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
     SDL_LockMutex(drawingQueueMutex);
 
     //Update vision sensor transforms and copy generated data to ensure consistency
+    frameTimeStamp = drawingQueueTimeStamp;
     glMemoryBarrier(GL_PIXEL_BUFFER_BARRIER_BIT);
     for(unsigned int i=0; i < content->getViewsCount(); ++i)
         content->getView(i)->UpdateTransform();
@@ -166,22 +264,190 @@ void OpenGLPipeline::PerformDrawingQueueCopy(SimulationManager* sim)
     Ocean* ocean = sim->getOcean();
     if(ocean != NULL) ocean->UpdateCurrentsData();
 
-    if(!drawingQueue.empty())
+    if(drawingQueuePendingSize > 0)
     {
-        drawingQueueCopy.clear();
-        selectedDrawingQueueCopy.clear();
-        //Double buffering
-        drawingQueueCopy.insert(drawingQueueCopy.end(), drawingQueue.begin(), drawingQueue.end());
-        selectedDrawingQueueCopy.insert(selectedDrawingQueueCopy.end(), selectedDrawingQueue.begin(), selectedDrawingQueue.end());
-        //Enable update of drawing queue by clearing old queue
-        drawingQueue.clear(); 
-        selectedDrawingQueue.clear();
+        //Buffers are swapped, not copied
+        drawingQueuePending.swap(drawingQueueCopy);
+        selectedDrawingQueuePending.swap(selectedDrawingQueueCopy);
+        //Slots left over from a larger frame go back to the simulation with the old front buffer
+        TrimQueue(drawingQueueCopy, drawingQueuePendingSize, drawingQueuePending);
+        TrimQueue(selectedDrawingQueueCopy, selectedDrawingQueuePendingSize, selectedDrawingQueuePending);
+        //Enable submission of the next drawing queue
+        drawingQueuePendingSize = 0;
+        selectedDrawingQueuePendingSize = 0;
     }
 
     SDL_UnlockMutex(drawingQueueMutex);
+    
 
     //Sort objects by material to reduce uniform/texture switching
     std::sort(drawingQueueCopy.begin(), drawingQueueCopy.end(), Renderable::SortByMaterial);
+    ComputeBoundingBoxes();
+}
+
+void OpenGLPipeline::ComputeBoundingBoxes()
+{
+    drawingQueueAABBs.resize(drawingQueueCopy.size() * 2);
+    size_t nObjects = content->getObjectsCount();
+    
+    #pragma omp parallel for
+    for(int i=0; i<(int)drawingQueueCopy.size(); ++i)
+    {
+        const Renderable& r = drawingQueueCopy[i];
+        if(r.type != RenderableType::SOLID || r.objectId < 0 || r.objectId >= (int)nObjects)
+        {
+            //Empty box (never visible)
+            drawingQueueAABBs[i*2] = glm::vec3(1.f);
+            drawingQueueAABBs[i*2+1] = glm::vec3(-1.f);
+            continue;
+        }
+        
+        //Transform local box to the world frame
+        const Object& obj = content->getObject(r.objectId);
+        glm::vec3 c = glm::vec3(r.model * glm::vec4((obj.aabbMin + obj.aabbMax) * 0.5f, 1.f));
+        glm::vec3 e = (obj.aabbMax - obj.aabbMin) * 0.5f;
+        glm::mat3 R = glm::mat3(r.model);
+        glm::vec3 we = glm::abs(R[0]) * e.x + glm::abs(R[1]) * e.y + glm::abs(R[2]) * e.z;
+        drawingQueueAABBs[i*2] = c - we;
+        drawingQueueAABBs[i*2+1] = c + we;
+    }
+    cullingCacheValid = false;
+}
+
+unsigned int OpenGLPipeline::ScheduleViews(std::vector<unsigned int>& viewsNoUpdate)
+{
+    //Keep statistics in sync with the list of views
+    if(viewStats.size() != content->getViewsCount())
+    {
+        if(viewQueries.size() > 0)
+            glDeleteQueries((GLsizei)viewQueries.size(), &viewQueries[0]);
+        viewStats.assign(content->getViewsCount(), ViewStatistics());
+        viewQueries.resize(viewStats.size() * 4);
+        if(viewQueries.size() > 0)
+            glGenQueries((GLsizei)viewQueries.size(), &viewQueries[0]);
+        viewQueriesPending.assign(viewStats.size() * 2, 0);
+        viewsQueue.clear();
+    }
+    
+    unsigned int updateCount = 0;
+    viewsNoUpdate.clear();
+    
+    if(scheduling == ViewScheduling::SENSOR_RATE)
+    {
+        //Render all views requested by their sensors
+        viewsQueue.clear();
+        for(unsigned int i=0; i<content->getViewsCount(); ++i)
+        {
+            OpenGLView* view = content->getView(i);
+            if(sensorViewsOnly && view->getType() == ViewType::TRACKBALL)
+                continue;
+            if(view->needsUpdate())
+                viewsQueue.push_back(i);
+            else
+                viewsNoUpdate.push_back(i);
+        }
+        
+        //Real-time views first, then co-located views next to each other to reuse culling
+        std::stable_sort(viewsQueue.begin(), viewsQueue.end(), [this](unsigned int a, unsigned int b)
+        {
+            OpenGLView* va = content->getView(a);
+            OpenGLView* vb = content->getView(b);
+            if(va->isContinuous() != vb->isContinuous())
+                return va->isContinuous();
+            glm::vec3 ea = va->GetEyePosition();
+            glm::vec3 eb = vb->GetEyePosition();
+            if(ea.x != eb.x) return ea.x < eb.x;
+            if(ea.y != eb.y) return ea.y < eb.y;
+            if(ea.z != eb.z) return ea.z < eb.z;
+            return (int)va->getType() < (int)vb->getType();
+        });
+        updateCount = (unsigned int)viewsQueue.size();
+        return updateCount;
+    }
+    
+    //Continuous views and one of the pending views per frame
+    for(int i=content->getViewsCount()-1; i >= 0; --i)
+    {
+        OpenGLView* view = content->getView(i);
+        if(sensorViewsOnly && view->getType() == ViewType::TRACKBALL)
+            continue;
+        if(view->needsUpdate())
+        {
+            if(view->isContinuous())
+            {
+                viewsQueue.push_front(i);
+                ++updateCount;
+            }
+            else
+            {
+                viewsQueue.push_back(i);
+                viewsNoUpdate.push_back(i);
+            }
+        }
+        else
+        {
+            viewsNoUpdate.push_back(i);
+        }
+    }
+    
+    if(viewsQueue.size() > content->getViewsCount())
+    {
+        updateCount = viewsQueue.size();
+        viewsNoUpdate.clear();
+    }
+    else if(updateCount < (unsigned int)viewsQueue.size())
+    {
+        ++updateCount;
+        viewsNoUpdate.erase(std::find(viewsNoUpdate.begin(), viewsNoUpdate.end(), viewsQueue[updateCount-1]));
+    }
+    return updateCount;
+}
+
+std::vector<Renderable>& OpenGLPipeline::CullObjects(const OpenGLView* view)
+{
+    return CullObjects(view, nullptr);
+}
+
+std::vector<Renderable>& OpenGLPipeline::CullObjects(const glm::mat4& VP)
+{
+    glm::vec4 frustum[6];
+    OpenGLView::ExtractFrustumFromVP(frustum, VP);
+    return CullObjects(nullptr, frustum);
+}
+
+std::vector<Renderable>& OpenGLPipeline::CullObjects(const OpenGLView* view, const glm::vec4* frustum)
+{
+    //Views sharing the same pose and projection (batched by the scheduler) reuse the last result
+    bool cacheable = view != nullptr && dynamic_cast<const OpenGLSonar*>(view) == nullptr;
+    if(cacheable && cullingCacheValid && cullingCacheVP == view->getViewUBOData()->VP)
+        return visibleQueue;
+    
+    visibleFlags.resize(drawingQueueCopy.size());
+    
+    #pragma omp parallel for
+    for(int i=0; i<(int)drawingQueueCopy.size(); ++i)
+    {
+        const glm::vec3& aabbMin = drawingQueueAABBs[i*2];
+        const glm::vec3& aabbMax = drawingQueueAABBs[i*2+1];
+        if(aabbMin.x > aabbMax.x)
+            visibleFlags[i] = 0;
+        else if(view != nullptr)
+            visibleFlags[i] = view->isVisible(aabbMin, aabbMax) ? 1 : 0;
+        else
+            visibleFlags[i] = OpenGLView::AABBInFrustum(frustum, aabbMin, aabbMax) ? 1 : 0;
+    }
+    
+    //Compact list preserving the material order
+    size_t nVisible = 0;
+    for(size_t i=0; i<drawingQueueCopy.size(); ++i)
+        if(visibleFlags[i])
+            PushToQueue(visibleQueue, nVisible, drawingQueueCopy[i], &visibleSpareSlots);
+    TrimQueue(visibleQueue, nVisible, visibleSpareSlots);
+    
+    cullingCacheValid = cacheable;
+    if(cacheable)
+        cullingCacheVP = view->getViewUBOData()->VP;
+    return visibleQueue;
 }
 
 void OpenGLPipeline::DrawDisplay()
@@ -193,11 +459,12 @@ void OpenGLPipeline::DrawDisplay()
 
 void OpenGLPipeline::DrawObjects()
 {
-    for(size_t i=0; i<drawingQueueCopy.size(); ++i)
-    {
-		if(drawingQueueCopy[i].type == RenderableType::SOLID)
-			content->DrawObject(drawingQueueCopy[i].objectId, drawingQueueCopy[i].lookId, drawingQueueCopy[i].model);
-    }
+    content->DrawObjects(drawingQueueCopy);
+}
+
+void OpenGLPipeline::DrawVisibleObjects()
+{
+    content->DrawObjects(visibleQueue);
 }
 
 void OpenGLPipeline::DrawLights()
@@ -329,6 +596,55 @@ void OpenGLPipeline::DrawHelpers()
     }
 }
 
+void OpenGLPipeline::BeginViewTiming(unsigned int id)
+{
+    if(id >= viewStats.size())
+        return;
+    
+    //Two sets of queries are used alternately to avoid stalling on the last measurement
+    unsigned int set = viewStats[id].renderCount % 2;
+    CollectViewTiming(id, 1 - set, false);
+    CollectViewTiming(id, set, true);
+    glQueryCounter(viewQueries[id * 4 + set * 2], GL_TIMESTAMP);
+}
+
+void OpenGLPipeline::EndViewTiming(unsigned int id)
+{
+    if(id >= viewStats.size())
+        return;
+    
+    unsigned int set = viewStats[id].renderCount % 2;
+    glQueryCounter(viewQueries[id * 4 + set * 2 + 1], GL_TIMESTAMP);
+    viewQueriesPending[id * 2 + set] = 1;
+    ++viewStats[id].renderCount;
+}
+
+void OpenGLPipeline::CollectViewTiming(unsigned int id, unsigned int set, bool wait)
+{
+    if(!viewQueriesPending[id * 2 + set])
+        return;
+    
+    GLuint* queries = &viewQueries[id * 4 + set * 2];
+    if(!wait)
+    {
+        GLint available = 0;
+        glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+            return;
+    }
+    
+    GLuint64 start, end;
+    glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &start);
+    glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &end);
+    viewQueriesPending[id * 2 + set] = 0;
+    
+    ViewStatistics& stats = viewStats[id];
+    GLfloat t = (GLfloat)((end - start)/1000000.0); //ns -> ms
+    stats.avgTime = stats.avgTime == 0.f ? t : stats.avgTime * 59.f/60.f + t/60.f; //Smoothed
+    stats.maxTime = t > stats.maxTime ? t : stats.maxTime;
+    stats.lastTime = t;
+}
+
 void OpenGLPipeline::Render(SimulationManager* sim)
 {	
     //Update time step for animation purposes
@@ -348,6 +664,16 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         renderMode = rSettings.ocean > RenderQuality::DISABLED && ocean->isRenderable() ? 1 : 0;
     }
     Atmosphere* atm = sim->getAtmosphere();
+    
+    //Update the queue of views needing update
+    std::vector<unsigned int> viewsNoUpdate;
+    unsigned int updateCount = ScheduleViews(viewsNoUpdate);
+    updatedViews = updateCount;
+    
+    //Nothing to present when rendering sensors only
+    if(sensorViewsOnly && updateCount == 0)
+        return;
+    
     OpenGLState::EnableDepthTest();
     OpenGLState::EnableCullFace();
     
@@ -368,42 +694,6 @@ void OpenGLPipeline::Render(SimulationManager* sim)
     OpenGLState::BindFramebuffer(screenFBO);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    //Update the queue of views needing update
-    unsigned int updateCount = 0;
-    std::vector<unsigned int> viewsNoUpdate;
-    for(int i=content->getViewsCount()-1; i >= 0; --i)
-    {
-        OpenGLView* view = content->getView(i);
-        if(view->needsUpdate())
-        {
-            if(view->isContinuous())
-            {
-                viewsQueue.push_front(i);
-                ++updateCount;
-            }
-            else
-            {
-                viewsQueue.push_back(i);
-                viewsNoUpdate.push_back(i);
-            }
-        }
-        else
-        {
-            viewsNoUpdate.push_back(i);
-        }
-    }
-    
-    if(viewsQueue.size() > content->getViewsCount())
-    {
-        updateCount = viewsQueue.size();
-        viewsNoUpdate.clear();
-    }
-    else if(updateCount < (unsigned int)viewsQueue.size())
-    {
-        ++updateCount;
-        viewsNoUpdate.erase(std::find(viewsNoUpdate.begin(), viewsNoUpdate.end(), viewsQueue[updateCount-1]));
-    }
-   
     //Loop through all views -> trackballs, cameras, depth cameras...
     for(unsigned int i=0; i<updateCount; ++i)
     {
@@ -411,12 +701,13 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         OpenGLState::EnableCullFace();
         OpenGLState::DisableBlend();
         OpenGLView* view = content->getView(viewsQueue[i]);
+        BeginViewTiming(viewsQueue[i]);
             
         if(view->getType() == ViewType::DEPTH_CAMERA)
         {
             OpenGLDepthCamera* camera = static_cast<OpenGLDepthCamera*>(view);
             //Draw objects and compute depth data
-            camera->ComputeOutput(drawingQueueCopy);
+            camera->ComputeOutput(CullObjects(camera));
             //Draw camera output
             camera->DrawLDR(screenFBO, true);
         }
@@ -424,7 +715,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         {
             OpenGLSonar* sonar = static_cast<OpenGLSonar*>(view);
             //Draw objects and compute sonar data
-            sonar->ComputeOutput(drawingQueueCopy);
+            sonar->ComputeOutput(CullObjects(sonar));
             //Draw sonar output
             sonar->DrawLDR(screenFBO, true);
         }
@@ -444,6 +735,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             }
 
             atm->getOpenGLAtmosphere()->SetupMaterialShaders();
+            CullObjects(camera);
         
             //Clear main framebuffer and setup camera
             OpenGLState::BindFramebuffer(camera->getRenderFBO());
@@ -458,7 +750,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
             {
                 //Render all objects
                 content->SetDrawingMode(DrawingMode::FULL);
-                DrawObjects();
+                DrawVisibleObjects();
                 DrawLights();
 
                 //Ambient occlusion
@@ -482,7 +774,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                 if(ocean->GetDepth(eye) > 0.0) //Underwater
                 {  
                     content->SetDrawingMode(DrawingMode::UNDERWATER);
-                    DrawObjects();
+                    DrawVisibleObjects();
                     glOcean->DrawBackground(camera);
                     glOcean->DrawBacksurface(camera);
                     //camera->GenerateBloom();
@@ -499,7 +791,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                         glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
                         glCullFace(GL_FRONT);
                         content->SetDrawingMode(DrawingMode::FLAT);
-                        DrawObjects();
+                        DrawVisibleObjects();
                         glCullFace(GL_BACK);
                         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
                         camera->GenerateLinearDepth(false);
@@ -520,7 +812,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                 else //Above water
                 {
                     content->SetDrawingMode(DrawingMode::UNDERWATER);
-                    DrawObjects();
+                    DrawVisibleObjects();
                     DrawLights();
                     glOcean->DrawBackground(camera);
 
@@ -542,7 +834,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                     //(depth testing will secure drawing only what is above water)
                     camera->SetRenderBuffers(0, true, false); //Color + Normal
                     content->SetDrawingMode(DrawingMode::FULL);
-                    DrawObjects();
+                    DrawVisibleObjects();
                     DrawLights();
                 
                     //Render sky (left for the end to only fill empty spaces)
@@ -560,7 +852,7 @@ void OpenGLPipeline::Render(SimulationManager* sim)
                         glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
                         glCullFace(GL_FRONT);
                         content->SetDrawingMode(DrawingMode::FLAT);
-                        DrawObjects();
+                        DrawVisibleObjects();
                         glCullFace(GL_BACK);
                         glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
                         camera->GenerateLinearDepth(false);
@@ -621,10 +913,12 @@ void OpenGLPipeline::Render(SimulationManager* sim)
         
             delete [] viewport;
         }
+        EndViewTiming(viewsQueue[i]);
     }
     //Draw views that are displayed but not updated
-    for(size_t i=0; i<viewsNoUpdate.size(); ++i)
-        content->getView(viewsNoUpdate[i])->DrawLDR(screenFBO, false);
+    if(!sensorViewsOnly)
+        for(size_t i=0; i<viewsNoUpdate.size(); ++i)
+            content->getView(viewsNoUpdate[i])->DrawLDR(screenFBO, false);
     //Remove views drawn in this frame
     viewsQueue.erase(viewsQueue.begin(), viewsQueue.begin() + updateCount);
 }
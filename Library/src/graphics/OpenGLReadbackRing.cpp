@@ -0,0 +1,124 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  OpenGLReadbackRing.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "graphics/OpenGLReadbackRing.h"
+
+namespace sf
+{
+
+OpenGLReadbackRing::OpenGLReadbackRing(GLsizeiptr size, unsigned int depth) : frameSize(size), head(0), tail(0), pending(0), mapped(false)
+{
+    slots.resize(depth < 1 ? 1 : depth);
+    for(size_t i=0; i<slots.size(); ++i)
+    {
+        glGenBuffers(1, &slots[i].pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slots[i].pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameSize, 0, GL_STREAM_READ);
+        slots[i].fence = 0;
+        slots[i].timeStamp = Scalar(0);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+OpenGLReadbackRing::~OpenGLReadbackRing()
+{
+    for(size_t i=0; i<slots.size(); ++i)
+    {
+        if(slots[i].fence != 0)
+            glDeleteSync(slots[i].fence);
+        glDeleteBuffers(1, &slots[i].pbo);
+    }
+}
+
+bool OpenGLReadbackRing::isFull() const
+{
+    return pending == slots.size();
+}
+
+unsigned int OpenGLReadbackRing::getPendingCount() const
+{
+    return pending;
+}
+
+bool OpenGLReadbackRing::BeginReadback()
+{
+    if(isFull())
+        return false;
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slots[head].pbo);
+    return true;
+}
+
+void OpenGLReadbackRing::EndReadback(Scalar timeStamp)
+{
+    Slot& s = slots[head];
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s.timeStamp = timeStamp;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    head = (head + 1) % (unsigned int)slots.size();
+    ++pending;
+}
+
+bool OpenGLReadbackRing::Map(void*& data, Scalar& timeStamp, bool wait)
+{
+    if(pending == 0 || mapped)
+        return false;
+    
+    //Check if the GPU finished writing the oldest frame
+    Slot& s = slots[tail];
+    GLenum status = glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    while(wait && status == GL_TIMEOUT_EXPIRED)
+        status = glClientWaitSync(s.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); //1 ms
+    if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+        return false;
+    
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+    data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameSize, GL_MAP_READ_BIT);
+    if(data == NULL)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return false;
+    }
+    timeStamp = s.timeStamp;
+    mapped = true;
+    return true;
+}
+
+void OpenGLReadbackRing::Unmap()
+{
+    if(!mapped)
+        return;
+    
+    Slot& s = slots[tail];
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glDeleteSync(s.fence);
+    s.fence = 0;
+    tail = (tail + 1) % (unsigned int)slots.size();
+    --pending;
+    mapped = false;
+}
+
+}
@@ -31,6 +31,7 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLReadbackRing.h"
 
 namespace sf
 {
@@ -41,10 +42,10 @@ OpenGLRealCamera::OpenGLRealCamera(glm::vec3 eyePosition, glm::vec3 direction, g
                                    : OpenGLCamera(x, y, width, height, range)
 {
     _needsUpdate = false;
-    newData = false;
     continuous = continuousUpdate;
     camera = NULL;
     cameraFBO = 0;
+    readback = NULL;
     
     //Setup view
     SetupCamera(eyePosition, direction, cameraUp);
@@ -61,7 +62,7 @@ OpenGLRealCamera::~OpenGLRealCamera()
     if(camera != NULL)
     {
         glDeleteFramebuffers(1, &cameraFBO);
-        glDeleteBuffers(1, &cameraPBO);
+        delete readback;
         glDeleteTextures(2, cameraColorTex);
     }
 }
@@ -73,6 +74,8 @@ ViewType OpenGLRealCamera::getType()
 
 void OpenGLRealCamera::Update()
 {
+    if(_needsUpdate) //Previous request not rendered yet
+        ++missedUpdates;
     _needsUpdate = true;
 }
 
@@ -102,10 +105,7 @@ void OpenGLRealCamera::setCamera(ColorCamera* cam)
     textures.push_back(FBOTexture(GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, cameraColorTex[1]));
     cameraFBO = OpenGLContent::GenerateFramebuffer(textures);
     
-    glGenBuffers(1, &cameraPBO);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-    glBufferData(GL_PIXEL_PACK_BUFFER, viewportWidth * viewportHeight * 3, 0, GL_STREAM_READ);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback = new OpenGLReadbackRing(viewportWidth * viewportHeight * 3);
 }
 
 glm::vec3 OpenGLRealCamera::GetEyePosition() const
@@ -141,19 +141,33 @@ void OpenGLRealCamera::UpdateTransform()
     viewUBOData.eye = GetEyePosition();
     ExtractFrustumFromVP(viewUBOData.frustum, viewUBOData.VP);
 
-    //Inform camera to run callback
-    if(newData)
+    //Inform camera to run callback (only for completed frames)
+    if(readback != NULL)
+        ProcessReadback(false);
+}
+
+void OpenGLRealCamera::ProcessReadback(bool wait)
+{
+    void* src;
+    Scalar timeStamp;
+    while(readback->Map(src, timeStamp, wait))
     {
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
-        {
-            camera->NewDataReady(src);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER); //Release pointer to the mapped buffer
-        }
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
-        newData = false;
+        camera->setFrameTimeStamp(timeStamp);
+        camera->NewDataReady(src);
+        readback->Unmap();
+        wait = false;
+    }
+}
+
+void OpenGLRealCamera::ReadbackTexture()
+{
+    if(!readback->BeginReadback()) //Ring full -> consume the oldest frame first
+    {
+        ProcessReadback(true);
+        readback->BeginReadback();
     }
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    readback->EndReadback(((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getFrameTimeStamp());
 }
 
 void OpenGLRealCamera::SetupCamera()
@@ -204,9 +218,7 @@ void OpenGLRealCamera::DrawLDR(GLuint destinationFBO, bool updated)
                 OpenGLState::BindFramebuffer(0);
 
                 OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[1]);
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                ReadbackTexture();
                 OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
             }
             else
@@ -232,9 +244,7 @@ void OpenGLRealCamera::DrawLDR(GLuint destinationFBO, bool updated)
                 OpenGLState::BindFramebuffer(0);
 
                 OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[1]);
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-                glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                ReadbackTexture();
                 OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
             }
         }
@@ -252,13 +262,9 @@ void OpenGLRealCamera::DrawLDR(GLuint destinationFBO, bool updated)
             OpenGLState::BindFramebuffer(0);
 
             OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, cameraColorTex[1]);
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, cameraPBO);
-            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            ReadbackTexture();
             OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
         }
-        
-        newData = true;
     }
 }
 
@@ -33,6 +33,8 @@
 #include "graphics/GLSLShader.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
+#include "graphics/OpenGLReadbackRing.h"
+#include "sensors/vision/Camera.h"
 
 namespace sf
 {
@@ -45,12 +47,11 @@ OpenGLSonar::OpenGLSonar(glm::vec3 eyePosition, glm::vec3 direction, glm::vec3 s
 {
     _needsUpdate = false;
     continuous = false;
-    newData = false;
     range = range_;
     gain = 1.f;
     settingsUpdated = true;
-    outputPBO = 0;
-    displayPBO = 0;
+    outputReadback = NULL;
+    displayReadback = NULL;
     cMap = ColorMap::GREEN_BLUE;
     SetupSonar(eyePosition, direction, sonarUp);
 }
@@ -64,8 +65,54 @@ OpenGLSonar::~OpenGLSonar()
     glDeleteFramebuffers(1, &displayFBO);
     glDeleteVertexArrays(1, &displayVAO);
     glDeleteBuffers(1, &displayVBO);
-    if(outputPBO != 0) glDeleteBuffers(1, &outputPBO);
-    if(displayPBO != 0) glDeleteBuffers(1, &displayPBO);
+    if(outputReadback != NULL) delete outputReadback;
+    if(displayReadback != NULL) delete displayReadback;
+}
+
+void OpenGLSonar::InitReadback(GLsizeiptr outputSize)
+{
+    outputReadback = new OpenGLReadbackRing(outputSize);
+    displayReadback = new OpenGLReadbackRing(viewportWidth * viewportHeight * 3);
+}
+
+void OpenGLSonar::ReadbackOutput(Camera* sensor, GLuint outputTexture)
+{
+    if(outputReadback->isFull() || displayReadback->isFull()) //Ring full -> consume the oldest frame first
+        ProcessReadback(sensor, true);
+    
+    Scalar timeStamp = ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getFrameTimeStamp();
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, outputTexture);
+    outputReadback->BeginReadback();
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_BYTE, NULL);
+    outputReadback->EndReadback(timeStamp);
+    OpenGLState::BindTexture(TEX_POSTPROCESS1, GL_TEXTURE_2D, displayTex);
+    displayReadback->BeginReadback();
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    displayReadback->EndReadback(timeStamp);
+    OpenGLState::UnbindTexture(TEX_POSTPROCESS1);
+}
+
+void OpenGLSonar::ProcessReadback(Camera* sensor, bool wait)
+{
+    if(outputReadback == NULL || displayReadback == NULL)
+        return;
+    
+    //Display data is read after the output data, so its completion implies completion of both
+    void* src;
+    Scalar timeStamp;
+    while(displayReadback->Map(src, timeStamp, wait))
+    {
+        sensor->setFrameTimeStamp(timeStamp);
+        sensor->NewDataReady(src, 0);
+        displayReadback->Unmap();
+        
+        if(outputReadback->Map(src, timeStamp, true))
+        {
+            sensor->NewDataReady(src, 1);
+            outputReadback->Unmap();
+        }
+        wait = false;
+    }
 }
 
 void OpenGLSonar::SetupSonar(glm::vec3 _eye, glm::vec3 _dir, glm::vec3 _up)
@@ -108,6 +155,14 @@ glm::mat4 OpenGLSonar::GetProjectionMatrix() const
     return projection;
 }
 
+bool OpenGLSonar::isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const
+{
+    //Objects beyond maximum range do not produce echoes
+    glm::vec3 closest = glm::clamp(GetEyePosition(), aabbMin, aabbMax);
+    glm::vec3 d = closest - GetEyePosition();
+    return glm::dot(d, d) <= range.y * range.y;
+}
+
 glm::mat4 OpenGLSonar::GetViewMatrix() const
 {
     return sonarTransform;
@@ -120,6 +175,8 @@ GLfloat OpenGLSonar::GetFarClip() const
 
 void OpenGLSonar::Update()
 {
+    if(_needsUpdate) //Previous request not rendered yet
+        ++missedUpdates;
     _needsUpdate = true;
 }
 
@@ -168,7 +168,8 @@ void OpenGLSpotLight::BakeShadowmap(OpenGLPipeline* pipe)
     glClear(GL_DEPTH_BUFFER_BIT);
     //glEnable(GL_POLYGON_OFFSET_FILL);
     //glPolygonOffset(4.0f, 32.0f);
-    pipe->DrawObjects();
+    pipe->CullObjects(proj * view);
+    pipe->DrawVisibleObjects();
     //glDisable(GL_POLYGON_OFFSET_FILL);
     OpenGLState::BindFramebuffer(0);
 }
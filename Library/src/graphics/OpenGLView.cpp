@@ -38,6 +38,7 @@ OpenGLView::OpenGLView(GLint x, GLint y, GLint width, GLint height)
     viewportHeight = height + height % 2;
     enabled = true;
 	continuous = false;
+    missedUpdates = 0;
     viewUBOData.VP = glm::mat4(1.f);
     viewUBOData.eye = glm::vec3(0.f);
     ExtractFrustumFromVP(viewUBOData.frustum, viewUBOData.VP);
@@ -72,6 +73,30 @@ bool OpenGLView::isContinuous()
 	return continuous;
 }
 
+unsigned int OpenGLView::getMissedUpdatesCount() const
+{
+    return missedUpdates;
+}
+
+bool OpenGLView::isVisible(const glm::vec3& aabbMin, const glm::vec3& aabbMax) const
+{
+    return AABBInFrustum(viewUBOData.frustum, aabbMin, aabbMax);
+}
+
+bool OpenGLView::AABBInFrustum(const glm::vec4 frustum[6], const glm::vec3& aabbMin, const glm::vec3& aabbMax)
+{
+    for(short i=0; i<6; ++i)
+    {
+        //Corner of the box furthest along the plane normal
+        glm::vec3 p(frustum[i].x >= 0.f ? aabbMax.x : aabbMin.x,
+                    frustum[i].y >= 0.f ? aabbMax.y : aabbMin.y,
+                    frustum[i].z >= 0.f ? aabbMax.z : aabbMin.z);
+        if(glm::dot(glm::vec3(frustum[i]), p) + frustum[i].w < 0.f)
+            return false;
+    }
+    return true;
+}
+
 void OpenGLView::SetViewport()
 {
     OpenGLState::Viewport(0, 0, viewportWidth, viewportHeight);
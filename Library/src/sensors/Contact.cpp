@@ -39,10 +39,10 @@ Contact::Contact(std::string uniqueName, Entity* entityA, Entity* entityB, unsig
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
     A = entityA;
     B = entityB;
-    historyLen = inclusiveHistoryLength;
+    historyLen = (inclusiveHistoryLength == 0 || inclusiveHistoryLength > CONTACT_MAX_HISTORY_LENGTH) ? CONTACT_MAX_HISTORY_LENGTH : inclusiveHistoryLength;
     displayMask = CONTACT_DISPLAY_NONE;
     newDataAvailable = false;
-    pointsLastBeg = points.begin();
+    pointsLastAdded = 0;
 }
 
 Contact::~Contact()
@@ -108,13 +108,13 @@ void Contact::AddContactPoint(const btPersistentManifold* manifold, bool swapped
         AddContactPoint(p);
         ++added;
     }
-    pointsLastBeg = points.end()-added; // Save iterator to the beginning of new points
+    pointsLastAdded = std::min(added, points.size()); // Save number of new points (iterators are invalidated by the deque)
 }
 
 void Contact::AddContactPoint(ContactPoint p)
 {
-    //historyLen = 0 means "full history"
-    if(historyLen > 0 && points.size() == historyLen)
+    //History is always bounded
+    if(points.size() >= historyLen)
         points.pop_front();
 
     p.timeStamp = SimulationApp::getApp()->getSimulationManager()->getSimulationTime();
@@ -126,6 +126,7 @@ void Contact::AddContactPoint(ContactPoint p)
 void Contact::ClearHistory()
 {
     points.clear();
+    pointsLastAdded = 0;
 }
 
 const std::deque<ContactPoint>& Contact::getHistory()
@@ -209,7 +210,7 @@ std::vector<Renderable> Contact::Render()
     
     if(displayMask & CONTACT_DISPLAY_NORMAL_FORCE_A)
     {
-        for(auto it=pointsLastBeg; it != points.end(); ++it)
+        for(auto it=points.end()-pointsLastAdded; it != points.end(); ++it)
         {
             Vector3 p1 = (*it).locationA;
             Vector3 p2 = (*it).locationA + (*it).normalForceA;
@@ -220,7 +221,7 @@ std::vector<Renderable> Contact::Render()
     
     if(displayMask & CONTACT_DISPLAY_NORMAL_FORCE_B)
     {
-        for(auto it=pointsLastBeg; it != points.end(); ++it)
+        for(auto it=points.end()-pointsLastAdded; it != points.end(); ++it)
         {
             Vector3 p1 = (*it).locationB;
             Vector3 p2 = (*it).locationB - (*it).normalForceA;
@@ -0,0 +1,176 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  FramePool.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/FramePool.h"
+
+#include <cstring>
+
+namespace sf
+{
+
+//SensorFrame
+SensorFrame::SensorFrame(FramePool* owner, size_t dataSize) : pool(owner), size(dataSize), timeStamp(0), index(0), refCount(0)
+{
+    data = new uint8_t[size];
+}
+
+SensorFrame::~SensorFrame()
+{
+    delete [] data;
+}
+
+void SensorFrame::Retain()
+{
+    refCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SensorFrame::Release()
+{
+    if(refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        pool->Return(this);
+}
+
+void* SensorFrame::getData()
+{
+    return data;
+}
+
+size_t SensorFrame::getSize() const
+{
+    return size;
+}
+
+Scalar SensorFrame::getTimeStamp() const
+{
+    return timeStamp;
+}
+
+unsigned int SensorFrame::getIndex() const
+{
+    return index;
+}
+
+//FramePool
+FramePool::FramePool(size_t frameSize, unsigned int capacity) : frameSize(frameSize), dropped(0), destroyed(false)
+{
+    mutex = SDL_CreateMutex();
+    capacity = capacity < 1 ? 1 : capacity;
+    frames.reserve(capacity);
+    freeFrames.reserve(capacity);
+    for(unsigned int i=0; i<capacity; ++i)
+    {
+        SensorFrame* frame = new SensorFrame(this, frameSize);
+        frames.push_back(frame);
+        freeFrames.push_back(frame);
+    }
+}
+
+FramePool::~FramePool()
+{
+    for(size_t i=0; i<frames.size(); ++i)
+        delete frames[i];
+    SDL_DestroyMutex(mutex);
+}
+
+SensorFrame* FramePool::Acquire()
+{
+    SensorFrame* frame = nullptr;
+    SDL_LockMutex(mutex);
+    if(!destroyed)
+    {
+        if(freeFrames.size() > 0)
+        {
+            frame = freeFrames.back();
+            freeFrames.pop_back();
+            frame->refCount.store(1, std::memory_order_relaxed);
+        }
+        else
+            ++dropped;
+    }
+    SDL_UnlockMutex(mutex);
+    return frame;
+}
+
+SensorFrame* FramePool::Fill(const void* src, Scalar timeStamp, unsigned int index)
+{
+    SensorFrame* frame = Acquire();
+    if(frame != nullptr)
+    {
+        memcpy(frame->data, src, frameSize);
+        frame->timeStamp = timeStamp;
+        frame->index = index;
+    }
+    return frame;
+}
+
+void FramePool::Return(SensorFrame* frame)
+{
+    SDL_LockMutex(mutex);
+    freeFrames.push_back(frame);
+    bool orphaned = destroyed && freeFrames.size() == frames.size();
+    SDL_UnlockMutex(mutex);
+    
+    if(orphaned)
+        delete this;
+}
+
+void FramePool::Destroy()
+{
+    SDL_LockMutex(mutex);
+    destroyed = true;
+    bool orphaned = freeFrames.size() == frames.size();
+    SDL_UnlockMutex(mutex);
+    
+    if(orphaned)
+        delete this;
+}
+
+size_t FramePool::getFrameSize() const
+{
+    return frameSize;
+}
+
+unsigned int FramePool::getCapacity() const
+{
+    return (unsigned int)frames.size();
+}
+
+unsigned int FramePool::getFreeCount()
+{
+    SDL_LockMutex(mutex);
+    unsigned int count = (unsigned int)freeFrames.size();
+    SDL_UnlockMutex(mutex);
+    return count;
+}
+
+uint64_t FramePool::getDroppedCount() const
+{
+    SDL_LockMutex(mutex);
+    uint64_t count = dropped;
+    SDL_UnlockMutex(mutex);
+    return count;
+}
+
+}
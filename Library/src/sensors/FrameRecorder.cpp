@@ -0,0 +1,403 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  FrameRecorder.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/FrameRecorder.h"
+
+#include "stb_image_write.h"
+#include "core/SimulationApp.h"
+#include "sensors/vision/Camera.h"
+#include "sensors/vision/FLS.h"
+#include "sensors/vision/SSS.h"
+#include "sensors/vision/MSIS.h"
+#include "utils/SystemUtil.hpp"
+
+namespace sf
+{
+
+static void AppendToBuffer(void* context, void* data, int size)
+{
+    std::vector<uint8_t>* buffer = (std::vector<uint8_t>*)context;
+    buffer->insert(buffer->end(), (uint8_t*)data, (uint8_t*)data + size);
+}
+
+template<typename T> static void WriteValue(FILE* f, const T& value, uint64_t& offset)
+{
+    fwrite(&value, sizeof(T), 1, f);
+    offset += sizeof(T);
+}
+
+FrameRecorder::FrameRecorder(const std::string& path, RecordingFormat format, RecordingContainer container, 
+                             unsigned int numOfWorkers, unsigned int queueCapacity) 
+    : path(path), format(format), container(container), queueCapacity(queueCapacity < 1 ? 1 : queueCapacity)
+{
+    jpegQuality = 90;
+    busyWorkers = 0;
+    stop = false;
+    fileOffset = 0;
+    queueMutex = SDL_CreateMutex();
+    fileMutex = SDL_CreateMutex();
+    jobAvailable = SDL_CreateCond();
+    jobsDone = SDL_CreateCond();
+    
+    if(container == RecordingContainer::FILES)
+    {
+        file = fopen((path + "/index.csv").c_str(), "w");
+        if(file != nullptr)
+            fprintf(file, "sensor,output,sequence,time,width,height,channels,bytes_per_channel,file\n");
+    }
+    else
+    {
+        file = fopen(path.c_str(), "wb");
+        if(file != nullptr)
+        {
+            fwrite("SFREC001", 1, 8, file);
+            fileOffset = 8;
+        }
+    }
+    
+    if(file == nullptr)
+    {
+        cError("Frame recorder could not open '%s' for writing!", path.c_str());
+        return;
+    }
+    
+    numOfWorkers = numOfWorkers < 1 ? 1 : numOfWorkers;
+    for(unsigned int i=0; i<numOfWorkers; ++i)
+        workers.push_back(SDL_CreateThread(FrameRecorder::RunWorker, "frameRecorder", this));
+}
+
+FrameRecorder::~FrameRecorder()
+{
+    //Workers drain the queue before quitting
+    SDL_LockMutex(queueMutex);
+    stop = true;
+    SDL_CondBroadcast(jobAvailable);
+    SDL_UnlockMutex(queueMutex);
+    for(size_t i=0; i<workers.size(); ++i)
+        SDL_WaitThread(workers[i], NULL);
+    
+    if(file != nullptr)
+    {
+        if(container == RecordingContainer::INDEXED)
+            WriteIndex();
+        fclose(file);
+    }
+    
+    SDL_DestroyCond(jobAvailable);
+    SDL_DestroyCond(jobsDone);
+    SDL_DestroyMutex(queueMutex);
+    SDL_DestroyMutex(fileMutex);
+}
+
+bool FrameRecorder::isOpen() const
+{
+    return file != nullptr;
+}
+
+void FrameRecorder::setJPEGQuality(int q)
+{
+    jpegQuality = q < 1 ? 1 : (q > 100 ? 100 : q);
+}
+
+void FrameRecorder::AddSensor(VisionSensor* sensor, unsigned int poolCapacity)
+{
+    if(file == nullptr)
+    {
+        cError("Frame recorder output not available! Sensor '%s' will not be recorded.", sensor->getName().c_str());
+        return;
+    }
+    sensors.push_back(sensor);
+    sensor->InstallFrameHandler([this](VisionSensor* s, SensorFrame* f){ Submit(s, f); }, poolCapacity);
+}
+
+void FrameRecorder::Detach()
+{
+    for(size_t i=0; i<sensors.size(); ++i)
+        sensors[i]->InstallFrameHandler(nullptr);
+    sensors.clear();
+    Flush(); //Return all queued frames to the pools
+}
+
+void FrameRecorder::Flush()
+{
+    SDL_LockMutex(queueMutex);
+    while(!queue.empty() || busyWorkers > 0)
+        SDL_CondWait(jobsDone, queueMutex);
+    SDL_UnlockMutex(queueMutex);
+    
+    SDL_LockMutex(fileMutex);
+    if(file != nullptr) fflush(file);
+    SDL_UnlockMutex(fileMutex);
+}
+
+RecorderStatistics FrameRecorder::getStatistics()
+{
+    SDL_LockMutex(queueMutex);
+    RecorderStatistics s = stats;
+    s.queueLength = (unsigned int)queue.size();
+    SDL_UnlockMutex(queueMutex);
+    
+    for(size_t i=0; i<sensors.size(); ++i)
+    {
+        for(unsigned int h=0; h<2; ++h) //Vision sensors have at most two outputs
+        {
+            FramePool* pool = sensors[i]->getFramePool(h);
+            if(pool != nullptr) s.droppedPool += pool->getDroppedCount();
+        }
+    }
+    return s;
+}
+
+unsigned int FrameRecorder::getStream(VisionSensor* sensor, unsigned int index)
+{
+    for(size_t i=0; i<streams.size(); ++i)
+        if(streams[i].sensor == sensor && streams[i].index == index)
+            return (unsigned int)i;
+    
+    Stream s;
+    s.sensor = sensor;
+    s.index = index;
+    s.name = sensor->getName();
+    s.sequence = 0;
+    streams.push_back(s);
+    return (unsigned int)streams.size()-1;
+}
+
+bool FrameRecorder::getFrameLayout(VisionSensor* sensor, SensorFrame* frame, Job& job) const
+{
+    Camera* cam = dynamic_cast<Camera*>(sensor);
+    if(cam == nullptr)
+        return false;
+    
+    cam->getResolution(job.width, job.height);
+    job.channels = 1;
+    job.bytesPerChannel = 1;
+    
+    switch(sensor->getVisionSensorType())
+    {
+        case VisionSensorType::COLOR_CAMERA:
+            job.channels = 3;
+            break;
+            
+        case VisionSensorType::DEPTH_CAMERA:
+        case VisionSensorType::MULTIBEAM2:
+            job.bytesPerChannel = sizeof(GLfloat);
+            break;
+            
+        case VisionSensorType::FLS:
+        case VisionSensorType::SSS:
+        case VisionSensorType::MSIS:
+            if(frame->getIndex() == 0) //Display image
+            {
+                if(sensor->getVisionSensorType() == VisionSensorType::FLS)
+                    ((FLS*)sensor)->getDisplayResolution(job.width, job.height);
+                else if(sensor->getVisionSensorType() == VisionSensorType::SSS)
+                    ((SSS*)sensor)->getDisplayResolution(job.width, job.height);
+                else
+                    ((MSIS*)sensor)->getDisplayResolution(job.width, job.height);
+                job.channels = 3;
+            }
+            break;
+    }
+    
+    return (size_t)job.width * job.height * job.channels * job.bytesPerChannel == frame->getSize();
+}
+
+void FrameRecorder::Submit(VisionSensor* sensor, SensorFrame* frame)
+{
+    Job job;
+    bool valid = getFrameLayout(sensor, frame, job);
+    
+    SDL_LockMutex(queueMutex);
+    ++stats.received;
+    if(!valid || stop || queue.size() >= queueCapacity)
+    {
+        if(valid) 
+            ++stats.droppedQueue;
+        else
+            ++stats.failed;
+        SDL_UnlockMutex(queueMutex);
+        frame->Release();
+        return;
+    }
+    
+    job.frame = frame;
+    job.stream = getStream(sensor, frame->getIndex());
+    job.source = &streams[job.stream];
+    job.sequence = streams[job.stream].sequence++;
+    queue.push_back(job);
+    stats.queuePeak = std::max(stats.queuePeak, (unsigned int)queue.size());
+    SDL_CondSignal(jobAvailable);
+    SDL_UnlockMutex(queueMutex);
+}
+
+bool FrameRecorder::Encode(const Job& job, std::vector<uint8_t>& buffer) const
+{
+    buffer.clear();
+    int w = (int)job.width;
+    int h = (int)job.height;
+    int c = (int)job.channels;
+    if(format == RecordingFormat::PNG)
+        return stbi_write_png_to_func(AppendToBuffer, &buffer, w, h, c, job.frame->getData(), w * c) != 0;
+    else
+        return stbi_write_jpg_to_func(AppendToBuffer, &buffer, w, h, c, job.frame->getData(), jpegQuality) != 0;
+}
+
+bool FrameRecorder::Write(const Job& job, const void* data, size_t size)
+{
+    const Stream& s = *job.source;
+    bool raw = format == RecordingFormat::RAW || job.bytesPerChannel != 1;
+    
+    if(container == RecordingContainer::FILES)
+    {
+        char filename[32];
+        snprintf(filename, 32, "_%u_%06llu.%s", s.index, (unsigned long long)job.sequence, 
+                 raw ? "raw" : (format == RecordingFormat::PNG ? "png" : "jpg"));
+        std::string filepath = path + "/" + s.name + std::string(filename);
+        FILE* f = fopen(filepath.c_str(), "wb");
+        if(f == nullptr)
+            return false;
+        bool ok = fwrite(data, 1, size, f) == size;
+        fclose(f);
+        if(!ok)
+            return false;
+        
+        SDL_LockMutex(fileMutex);
+        fprintf(file, "%s,%u,%llu,%.6lf,%u,%u,%u,%u,%s\n", s.name.c_str(), s.index, (unsigned long long)job.sequence, 
+                (double)job.frame->getTimeStamp(), job.width, job.height, job.channels, job.bytesPerChannel, (s.name + std::string(filename)).c_str());
+        SDL_UnlockMutex(fileMutex);
+    }
+    else
+    {
+        SDL_LockMutex(fileMutex);
+        IndexEntry entry;
+        entry.stream = job.stream;
+        entry.sequence = job.sequence;
+        entry.timeStamp = job.frame->getTimeStamp();
+        entry.offset = fileOffset;
+        index.push_back(entry);
+        
+        WriteValue(file, (uint32_t)job.stream, fileOffset);
+        WriteValue(file, (uint64_t)job.sequence, fileOffset);
+        WriteValue(file, (double)entry.timeStamp, fileOffset);
+        WriteValue(file, (uint32_t)job.width, fileOffset);
+        WriteValue(file, (uint32_t)job.height, fileOffset);
+        WriteValue(file, (uint32_t)job.channels, fileOffset);
+        WriteValue(file, (uint32_t)job.bytesPerChannel, fileOffset);
+        WriteValue(file, (uint32_t)(raw ? RecordingFormat::RAW : format), fileOffset);
+        WriteValue(file, (uint64_t)size, fileOffset);
+        bool ok = fwrite(data, 1, size, file) == size;
+        fileOffset += size;
+        SDL_UnlockMutex(fileMutex);
+        if(!ok)
+            return false;
+    }
+    return true;
+}
+
+/*
+ Layout of the INDEXED container (little endian):
+ header: "SFREC001"
+ record: u32 stream, u64 sequence, f64 time, u32 width, u32 height, u32 channels, u32 bytes per channel, u32 format, u64 size, data
+ index:  u32 number of streams, {u32 name length, name, u32 output} per stream,
+         u64 number of records, {u32 stream, u64 sequence, f64 time, u64 record offset} per record
+ footer: u64 index offset, "SFRECIDX"
+ */
+void FrameRecorder::WriteIndex()
+{
+    uint64_t indexOffset = fileOffset;
+    WriteValue(file, (uint32_t)streams.size(), fileOffset);
+    for(size_t i=0; i<streams.size(); ++i)
+    {
+        WriteValue(file, (uint32_t)streams[i].name.size(), fileOffset);
+        fwrite(streams[i].name.c_str(), 1, streams[i].name.size(), file);
+        fileOffset += streams[i].name.size();
+        WriteValue(file, (uint32_t)streams[i].index, fileOffset);
+    }
+    WriteValue(file, (uint64_t)index.size(), fileOffset);
+    for(size_t i=0; i<index.size(); ++i)
+    {
+        WriteValue(file, (uint32_t)index[i].stream, fileOffset);
+        WriteValue(file, (uint64_t)index[i].sequence, fileOffset);
+        WriteValue(file, (double)index[i].timeStamp, fileOffset);
+        WriteValue(file, (uint64_t)index[i].offset, fileOffset);
+    }
+    WriteValue(file, indexOffset, fileOffset);
+    fwrite("SFRECIDX", 1, 8, file);
+}
+
+int FrameRecorder::RunWorker(void* data)
+{
+    FrameRecorder* rec = (FrameRecorder*)data;
+    std::vector<uint8_t> buffer; //Reused between frames
+    
+    SDL_LockMutex(rec->queueMutex);
+    while(true)
+    {
+        while(rec->queue.empty() && !rec->stop)
+            SDL_CondWait(rec->jobAvailable, rec->queueMutex);
+        if(rec->queue.empty()) //Stopped and drained
+            break;
+        
+        Job job = rec->queue.front();
+        rec->queue.pop_front();
+        ++rec->busyWorkers;
+        SDL_UnlockMutex(rec->queueMutex);
+        
+        int64_t start = GetTimeInMicroseconds();
+        bool ok;
+        size_t size;
+        if(rec->format == RecordingFormat::RAW || job.bytesPerChannel != 1)
+        {
+            size = job.frame->getSize();
+            ok = rec->Write(job, job.frame->getData(), size);
+        }
+        else
+        {
+            ok = rec->Encode(job, buffer);
+            size = buffer.size();
+            ok = ok && rec->Write(job, buffer.data(), size);
+        }
+        job.frame->Release();
+        int64_t time = GetTimeInMicroseconds() - start;
+        
+        SDL_LockMutex(rec->queueMutex);
+        --rec->busyWorkers;
+        if(ok)
+        {
+            ++rec->stats.written;
+            rec->stats.bytesWritten += size;
+        }
+        else
+            ++rec->stats.failed;
+        rec->stats.encodeTime += time/1e6;
+        if(rec->queue.empty() && rec->busyWorkers == 0)
+            SDL_CondBroadcast(rec->jobsDone);
+    }
+    SDL_UnlockMutex(rec->queueMutex);
+    return 0;
+}
+
+}
@@ -27,6 +27,7 @@
 
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "utils/ScientificFileUtil.h"
 #include "sensors/Sample.h"
 
@@ -38,6 +39,7 @@ ScalarSensor::ScalarSensor(std::string uniqueName, Scalar frequency, int history
     historyLen = historyLength;
     history = std::deque<Sample*>(0);
     sampleCount = 0;
+    newDataCallback = NULL;
 }
 
 ScalarSensor::~ScalarSensor()
@@ -72,6 +74,16 @@ const std::vector<Sample>* ScalarSensor::getHistory()
     return historyCopy;
 }
 
+void ScalarSensor::InstallNewDataHandler(std::function<void(ScalarSensor*, const Sample&)> callback)
+{
+    newDataCallback = callback;
+}
+
+bool ScalarSensor::hasNewDataHandler() const
+{
+    return newDataCallback != nullptr;
+}
+
 unsigned short ScalarSensor::getNumOfChannels() const
 {
     return channels.size();
@@ -125,13 +137,24 @@ void ScalarSensor::AddSampleToHistory(const Sample& s)
     Sample* sample = new Sample(s, sampleCount);
     ++sampleCount;
     
-    for(unsigned int i=0; i<sample->getNumOfDimensions(); ++i)
+    //Generate standard normal noise for all channels at once
+    Scalar* data = sample->getDataPointer();
+    unsigned int nDim = sample->getNumOfDimensions();
+    bool noisy = false;
+    for(unsigned int i=0; i<nDim && !noisy; ++i)
+        noisy = channels[i].stdDev > Scalar(0);
+    if(noisy)
+    {
+        if(noiseBuffer.size() < nDim)
+            noiseBuffer.resize(nDim);
+        randomGenerator.FillNormal(noiseBuffer.data(), nDim);
+    }
+    
+    for(unsigned int i=0; i<nDim; ++i)
     {
-        Scalar* data = sample->getDataPointer();
-        
         //Add noise
         if(channels[i].stdDev > Scalar(0) && data[i] < channels[i].rangeMax && data[i] > channels[i].rangeMin)
-            data[i] += channels[i].noise(randomGenerator);
+            data[i] += channels[i].stdDev * noiseBuffer[i];
     
         //Limit readings
         if(data[i] > channels[i].rangeMax)
@@ -142,6 +165,9 @@ void ScalarSensor::AddSampleToHistory(const Sample& s)
     
     //Add to history
     history.push_back(sample);
+    
+    if(newDataCallback != NULL)
+        newDataCallback(this, *sample);
 }
 
 void ScalarSensor::ClearHistory()
@@ -152,6 +178,62 @@ void ScalarSensor::ClearHistory()
     history.clear();
 }
 
+void ScalarSensor::SaveState(SimulationState& state)
+{
+    Sensor::SaveState(state);
+    state.Write(sampleCount);
+    uint64_t nSamples = history.size();
+    state.Write(nSamples);
+    for(size_t i=0; i<history.size(); ++i)
+    {
+        Sample* s = history[i];
+        state.Write(s->timestamp);
+        state.Write(s->nDim);
+        state.Write(s->id);
+        state.WriteBytes(s->data, sizeof(Scalar) * s->nDim);
+    }
+}
+
+void ScalarSensor::RestoreState(SimulationState& state)
+{
+    Sensor::RestoreState(state);
+    state.Read(sampleCount);
+    uint64_t nSamples;
+    state.Read(nSamples);
+    
+    //Reuse allocated samples when possible
+    while(history.size() > nSamples)
+    {
+        delete history.back();
+        history.pop_back();
+    }
+    for(uint64_t i=0; i<nSamples; ++i)
+    {
+        Scalar timestamp;
+        unsigned short nDim;
+        uint64_t id;
+        state.Read(timestamp);
+        state.Read(nDim);
+        state.Read(id);
+        
+        if(i >= history.size())
+        {
+            std::vector<Scalar> zeros(nDim > 0 ? nDim : 1, Scalar(0));
+            history.push_back(new Sample(nDim, zeros.data(), true));
+        }
+        Sample* s = history[i];
+        if(s->nDim != nDim)
+        {
+            delete [] s->data;
+            s->nDim = nDim;
+            s->data = new Scalar[nDim];
+        }
+        s->timestamp = timestamp;
+        s->id = id;
+        state.ReadBytes(s->data, sizeof(Scalar) * nDim);
+    }
+}
+
 void ScalarSensor::SaveMeasurementsToTextFile(const std::string& path, bool includeTime, unsigned int fixedPrecision)
 {
     if(history.size() == 0)
@@ -27,19 +27,19 @@
 
 #include "core/GraphicalSimulationApp.h"
 #include "core/SimulationManager.h"
+#include "utils/ZoneProfiler.h"
 #include "core/Console.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 
 namespace sf
 {
 
-std::random_device Sensor::randomDevice;
-std::mt19937 Sensor::randomGenerator(randomDevice());
-
 Sensor::Sensor(std::string uniqueName, Scalar frequency)
 {
     name = SimulationApp::getApp()->getSimulationManager()->getNameManager()->AddName(uniqueName);
+    zoneName = ZoneProfiler::Intern(name);
     setUpdateFrequency(frequency);
     eleapsedTime = Scalar(0);
     enabled = true;
@@ -48,6 +48,7 @@ Sensor::Sensor(std::string uniqueName, Scalar frequency)
     updateMutex = SDL_CreateMutex();
     lookId = -1;
     graObjectId = -1;
+    randomGenerator.Seed(RandomStream::getGlobalSeed(), name);
 }
 
 Sensor::~Sensor()
@@ -62,6 +63,11 @@ std::string Sensor::getName() const
     return name;
 }
 
+const char* Sensor::getZoneName() const
+{
+    return zoneName;
+}
+
 Scalar Sensor::getUpdateFrequency() const
 {
     return freq;
@@ -165,5 +171,24 @@ std::vector<Renderable> Sensor::Render()
     }
     return items;
 }
+
+void Sensor::SaveState(SimulationState& state)
+{
+    state.Write(eleapsedTime);
+    state.Write(newDataAvailable);
+    state.Write(randomGenerator);
+}
+
+void Sensor::RestoreState(SimulationState& state)
+{
+    state.Read(eleapsedTime);
+    state.Read(newDataAvailable);
+    state.Read(randomGenerator);
+}
+
+void Sensor::setRandomSeed(uint64_t seed)
+{
+    randomGenerator.Seed(seed, name);
+}
     
 }
@@ -34,15 +34,48 @@ namespace sf
 
 VisionSensor::VisionSensor(std::string uniqueName, Scalar frequency) : Sensor(uniqueName, frequency)
 {
-    if(!SimulationApp::getApp()->hasGraphics())
-        cCritical("Not possible to use vision sensors in console simulation! Use graphical simulation if possible.");
-    
     attach = nullptr;
     o2s = Transform::getIdentity();
+    frameTimeStamp = Scalar(0);
+    framePoolCapacity = FRAME_POOL_CAPACITY;
+    newFrameCallback = nullptr;
 }
 
 VisionSensor::~VisionSensor()
 {
+    for(size_t i=0; i<framePools.size(); ++i)
+        if(framePools[i] != nullptr) framePools[i]->Destroy();
+}
+
+void VisionSensor::InstallFrameHandler(std::function<void(VisionSensor*, SensorFrame*)> callback, unsigned int poolCapacity)
+{
+    newFrameCallback = callback;
+    framePoolCapacity = poolCapacity;
+}
+
+FramePool* VisionSensor::getFramePool(unsigned int index)
+{
+    return index < framePools.size() ? framePools[index] : nullptr;
+}
+
+void VisionSensor::DeliverFrame(const void* data, size_t size, unsigned int index)
+{
+    if(newFrameCallback == nullptr)
+        return;
+    
+    if(index >= framePools.size())
+        framePools.resize(index+1, nullptr);
+    
+    //(Re)create pool if the output size changed
+    if(framePools[index] == nullptr || framePools[index]->getFrameSize() != size)
+    {
+        if(framePools[index] != nullptr) framePools[index]->Destroy();
+        framePools[index] = new FramePool(size, framePoolCapacity);
+    }
+    
+    SensorFrame* frame = framePools[index]->Fill(data, frameTimeStamp, index);
+    if(frame != nullptr)
+        newFrameCallback(this, frame);
 }
 
 void VisionSensor::setRelativeSensorFrame(const Transform& origin)
@@ -72,7 +105,7 @@ void VisionSensor::AttachToWorld(const Transform& origin)
 {
     attach = nullptr;
     o2s = origin;
-    InitGraphics();
+    InitBackend();
 }
 
 void VisionSensor::AttachToStatic(StaticEntity* body, const Transform& origin)
@@ -81,7 +114,7 @@ void VisionSensor::AttachToStatic(StaticEntity* body, const Transform& origin)
     {
         attach = body;
         o2s = origin;
-        InitGraphics();
+        InitBackend();
     }
 }
 
@@ -91,8 +124,31 @@ void VisionSensor::AttachToSolid(MovingEntity* body, const Transform& origin)
     {
         attach = body;
         o2s = origin;
-        InitGraphics();
+        InitBackend();
     }
 }
 
+void VisionSensor::InitBackend()
+{
+    if(SimulationApp::getApp()->hasGraphics())
+        InitGraphics();
+    else if(!InitRayTracing())
+        cCritical("Not possible to use this vision sensor in console simulation! Use graphical simulation if possible.");
+}
+
+bool VisionSensor::InitRayTracing()
+{
+    return false;
+}
+
+void VisionSensor::setFrameTimeStamp(Scalar t)
+{
+    frameTimeStamp = t;
+}
+
+Scalar VisionSensor::getFrameTimeStamp() const
+{
+    return frameTimeStamp;
+}
+
 }
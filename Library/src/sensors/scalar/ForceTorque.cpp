@@ -25,6 +25,8 @@
 
 #include "sensors/scalar/ForceTorque.h"
 
+#include "core/SimulationState.h"
+
 #include "entities/SolidEntity.h"
 #include "entities/FeatherstoneEntity.h"
 #include "sensors/Sample.h"
@@ -140,4 +142,16 @@ ScalarSensorType ForceTorque::getScalarSensorType() const
     return ScalarSensorType::FT;
 }
 
+void ForceTorque::SaveState(SimulationState& state)
+{
+    JointSensor::SaveState(state);
+    state.Write(lastFrame);
+}
+
+void ForceTorque::RestoreState(SimulationState& state)
+{
+    JointSensor::RestoreState(state);
+    state.Read(lastFrame);
+}
+
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/NED.h"
+#include "core/SimulationState.h"
 #include "entities/forcefields/Ocean.h"
 #include "sensors/Sample.h"
 
@@ -98,4 +99,16 @@ ScalarSensorType GPS::getScalarSensorType() const
     return ScalarSensorType::GPS;
 }
 
+void GPS::SaveState(SimulationState& state)
+{
+    LinkSensor::SaveState(state);
+    state.Write(noise);
+}
+
+void GPS::RestoreState(SimulationState& state)
+{
+    LinkSensor::RestoreState(state);
+    state.Read(noise);
+}
+
 }
@@ -29,6 +29,7 @@
 #include "sensors/Sample.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 
 namespace sf
 {
@@ -121,4 +122,16 @@ ScalarSensorType IMU::getScalarSensorType() const
     return ScalarSensorType::IMU;
 }
 
+void IMU::SaveState(SimulationState& state)
+{
+    LinkSensor::SaveState(state);
+    state.Write(accumulatedYawDrift);
+}
+
+void IMU::RestoreState(SimulationState& state)
+{
+    LinkSensor::RestoreState(state);
+    state.Read(accumulatedYawDrift);
+}
+
 }
@@ -28,6 +28,7 @@
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
 #include "core/NED.h"
+#include "core/SimulationState.h"
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
 
@@ -252,4 +253,38 @@ std::vector<Renderable> INS::Render()
     return items;
 }
 
+void INS::SaveState(SimulationState& state)
+{
+    LinkSensor::SaveState(state);
+    state.Write(latitude);
+    state.Write(longitude);
+    state.Write(altitude);
+    state.Write(ned);
+    state.Write(velocity);
+    state.Write(out);
+    state.Write(accNoiseX);
+    state.Write(accNoiseY);
+    state.Write(accNoiseZ);
+    state.Write(avNoiseX);
+    state.Write(avNoiseY);
+    state.Write(avNoiseZ);
+}
+
+void INS::RestoreState(SimulationState& state)
+{
+    LinkSensor::RestoreState(state);
+    state.Read(latitude);
+    state.Read(longitude);
+    state.Read(altitude);
+    state.Read(ned);
+    state.Read(velocity);
+    state.Read(out);
+    state.Read(accNoiseX);
+    state.Read(accNoiseY);
+    state.Read(accNoiseZ);
+    state.Read(avNoiseX);
+    state.Read(avNoiseY);
+    state.Read(avNoiseZ);
+}
+
 }
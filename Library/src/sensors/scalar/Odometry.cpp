@@ -25,6 +25,8 @@
 
 #include "sensors/scalar/Odometry.h"
 
+#include "core/SimulationState.h"
+
 #include "entities/MovingEntity.h"
 #include "sensors/Sample.h"
 
@@ -90,5 +92,16 @@ ScalarSensorType Odometry::getScalarSensorType() const
     return ScalarSensorType::ODOM;
 }
 
+void Odometry::SaveState(SimulationState& state)
+{
+    LinkSensor::SaveState(state);
+    state.Write(ornNoise);
+}
+
+void Odometry::RestoreState(SimulationState& state)
+{
+    LinkSensor::RestoreState(state);
+    state.Read(ornNoise);
+}
 
 }
@@ -28,6 +28,7 @@
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "core/SimulationApp.h"
 #include "core/SimulationManager.h"
+#include "core/SimulationState.h"
 #include "utils/UnitSystem.h"
 #include "sensors/Sample.h"
 #include "graphics/OpenGLContent.h"
@@ -133,4 +134,20 @@ ScalarSensorType Profiler::getScalarSensorType() const
     return ScalarSensorType::PROFILER;
 }
 
+void Profiler::SaveState(SimulationState& state)
+{
+    LinkSensor::SaveState(state);
+    state.Write(currentAngStep);
+    state.Write(distance);
+    state.Write(clockwise);
+}
+
+void Profiler::RestoreState(SimulationState& state)
+{
+    LinkSensor::RestoreState(state);
+    state.Read(currentAngStep);
+    state.Read(distance);
+    state.Read(clockwise);
+}
+
 }
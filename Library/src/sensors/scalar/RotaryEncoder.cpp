@@ -25,6 +25,8 @@
 
 #include "sensors/scalar/RotaryEncoder.h"
 
+#include "core/SimulationState.h"
+
 #include "sensors/Sample.h"
 #include "joints/RevoluteJoint.h"
 #include "utils/UnitSystem.h"
@@ -158,4 +160,18 @@ ScalarSensorType RotaryEncoder::getScalarSensorType() const
     return ScalarSensorType::ENCODER;
 }
 
+void RotaryEncoder::SaveState(SimulationState& state)
+{
+    JointSensor::SaveState(state);
+    state.Write(angle);
+    state.Write(lastAngle);
+}
+
+void RotaryEncoder::RestoreState(SimulationState& state)
+{
+    JointSensor::RestoreState(state);
+    state.Read(angle);
+    state.Read(lastAngle);
+}
+
 }
@@ -93,8 +93,15 @@ void ColorCamera::InstallNewDataHandler(std::function<void(ColorCamera*)> callba
     newDataCallback = callback;
 }
 
+bool ColorCamera::hasNewDataHandler() const
+{
+    return newDataCallback != nullptr;
+}
+
 void ColorCamera::NewDataReady(void* data, unsigned int index)
 {
+    DeliverFrame(data, resX*resY*3);
+    
     if(newDataCallback != NULL)
     {
         imageData = (GLubyte*)data;
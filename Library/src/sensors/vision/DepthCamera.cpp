@@ -29,6 +29,9 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLDepthCamera.h"
+#include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "sensors/vision/RayTracedDepthCamera.h"
 
 namespace sf
 {
@@ -42,10 +45,12 @@ DepthCamera::DepthCamera(std::string uniqueName, unsigned int resolutionX, unsig
     newDataCallback = nullptr;
     imageData = nullptr;
     glCamera = nullptr;
+    rtCamera = nullptr;
 }
 
 DepthCamera::~DepthCamera()
 {
+    if(rtCamera != nullptr) delete rtCamera;
     glCamera = nullptr;
 }
 
@@ -56,6 +61,8 @@ void DepthCamera::setNoise(float depthStdDev)
         noiseStdDev = depthStdDev;
         if(glCamera != nullptr)
             glCamera->setNoise(noiseStdDev);
+        if(rtCamera != nullptr)
+            rtCamera->setNoise(noiseStdDev);
     }
 }
 
@@ -85,6 +92,15 @@ void DepthCamera::InitGraphics()
     ((GraphicalSimulationApp*)SimulationApp::getApp())->getGLPipeline()->getContent()->AddView(glCamera);
 }
 
+bool DepthCamera::InitRayTracing()
+{
+    GLfloat fovV = glm::degrees(2.f * atanf((GLfloat)resY/(GLfloat)resX * tanf(glm::radians((GLfloat)fovH)/2.f)));
+    rtCamera = new RayTracedDepthCamera(resX, resY, depthRange, randomGenerator);
+    rtCamera->AddView(0, resX, (GLfloat)fovH, fovV, 0.f);
+    rtCamera->setNoise(noiseStdDev);
+    return true;
+}
+
 void DepthCamera::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
@@ -98,8 +114,15 @@ void DepthCamera::InstallNewDataHandler(std::function<void(DepthCamera*)> callba
     newDataCallback = callback;
 }
 
+bool DepthCamera::hasNewDataHandler() const
+{
+    return newDataCallback != nullptr;
+}
+
 void DepthCamera::NewDataReady(void* data, unsigned int index)
 {
+    DeliverFrame(data, resX*resY*sizeof(GLfloat));
+    
     if(newDataCallback != nullptr)
     {
         imageData = (GLfloat*)data;
@@ -110,7 +133,17 @@ void DepthCamera::NewDataReady(void* data, unsigned int index)
 
 void DepthCamera::InternalUpdate(Scalar dt)
 {
-    glCamera->Update();
+    if(glCamera != nullptr)
+        glCamera->Update();
+    else if(rtCamera != nullptr)
+    {
+        SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+        RayTracingScene* scene = sm->getRayTracingScene();
+        scene->Update(sm);
+        rtCamera->ComputeDepth(scene, getSensorFrame());
+        setFrameTimeStamp(sm->getSimulationTime());
+        NewDataReady(rtCamera->getOutputDataPointer());
+    }
 }
 
 }
@@ -29,6 +29,9 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLFLS.h"
+#include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "sensors/vision/RayTracedFLS.h"
 
 namespace sf
 {
@@ -49,11 +52,13 @@ FLS::FLS(std::string uniqueName, unsigned int numOfBeams, unsigned int numOfBins
     displayData = NULL;
     newDataCallback = NULL;
     glFLS = nullptr;
+    rtFLS = nullptr;
 }
 
 FLS::~FLS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rtFLS != nullptr) delete rtFLS;
     glFLS = nullptr;
 }
 
@@ -82,6 +87,8 @@ void FLS::setNoise(float multiplicativeStdDev, float additiveStdDev)
         noise.y = additiveStdDev;
     if(glFLS != nullptr)
         glFLS->setNoise(noise);
+    if(rtFLS != nullptr)
+        rtFLS->setNoise(noise);
 }
 
 void* FLS::getImageDataPointer(unsigned int index)
@@ -138,6 +145,16 @@ void FLS::InitGraphics()
     displayData = new GLubyte[w*h*3];
 }
 
+bool FLS::InitRayTracing()
+{
+    unsigned int w, h;
+    getDisplayResolution(w, h);
+    rtFLS = new RayTracedFLS(resX, resY, (GLfloat)fovH, (GLfloat)fovV, w, cMap, randomGenerator);
+    rtFLS->setNoise(noise);
+    displayData = new GLubyte[w*h*3];
+    return true;
+}
+
 void FLS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
@@ -153,6 +170,15 @@ void FLS::InstallNewDataHandler(std::function<void(FLS*)> callback)
 
 void FLS::NewDataReady(void* data, unsigned int index)
 {
+    if(index == 0)
+    {
+        unsigned int w, h;
+        getDisplayResolution(w, h);
+        DeliverFrame(data, w*h*3, 0);
+    }
+    else
+        DeliverFrame(data, resX*resY, 1);
+    
     if(newDataCallback != NULL)
     {
         if(index == 0)
@@ -174,6 +200,16 @@ void FLS::InternalUpdate(Scalar dt)
 {
     if(glFLS != nullptr)
         glFLS->Update();
+    else if(rtFLS != nullptr)
+    {
+        SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+        RayTracingScene* scene = sm->getRayTracingScene();
+        scene->Update(sm);
+        rtFLS->ComputeOutput(scene, getSensorFrame(), range, (GLfloat)gain);
+        setFrameTimeStamp(sm->getSimulationTime());
+        NewDataReady(rtFLS->getDisplayDataPointer(), 0);
+        NewDataReady(rtFLS->getOutputDataPointer(), 1);
+    }
 }
 
 std::vector<Renderable> FLS::Render()
@@ -26,9 +26,13 @@
 #include "sensors/vision/MSIS.h"
 
 #include "core/GraphicalSimulationApp.h"
+#include "core/SimulationState.h"
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLMSIS.h"
+#include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "sensors/vision/RayTracedMSIS.h"
 
 namespace sf
 {
@@ -52,11 +56,13 @@ MSIS::MSIS(std::string uniqueName, Scalar stepAngleDeg, unsigned int numOfBins,
     displayData = NULL;
     newDataCallback = NULL;
     glMSIS = nullptr;
+    rtMSIS = nullptr;
 }
 
 MSIS::~MSIS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rtMSIS != nullptr) delete rtMSIS;
     glMSIS = nullptr;
 }
 
@@ -109,6 +115,8 @@ void MSIS::setNoise(float multiplicativeStdDev, float additiveStdDev)
         noise.y = additiveStdDev;
     if(glMSIS != nullptr)
         glMSIS->setNoise(noise);
+    if(rtMSIS != nullptr)
+        rtMSIS->setNoise(noise);
 }
 
 void* MSIS::getImageDataPointer(unsigned int index)
@@ -180,6 +188,16 @@ void MSIS::InitGraphics()
     displayData = new GLubyte[w*h*3];
 }
 
+bool MSIS::InitRayTracing()
+{
+    rtMSIS = new RayTracedMSIS(resX, resY, (GLfloat)fovH, (GLfloat)fovV, cMap, randomGenerator);
+    rtMSIS->setNoise(noise);
+    unsigned int w, h;
+    getDisplayResolution(w, h);
+    displayData = new GLubyte[w*h*3];
+    return true;
+}
+
 void MSIS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
@@ -195,6 +213,15 @@ void MSIS::InstallNewDataHandler(std::function<void(MSIS*)> callback)
 
 void MSIS::NewDataReady(void* data, unsigned int index)
 {
+    if(index == 0)
+    {
+        unsigned int w, h;
+        getDisplayResolution(w, h);
+        DeliverFrame(data, w*h*3, 0);
+    }
+    else
+        DeliverFrame(data, resX*resY, 1);
+    
     if(newDataCallback != NULL)
     {
         if(index == 0)
@@ -236,6 +263,18 @@ void MSIS::InternalUpdate(Scalar dt)
 {
     if(glMSIS != nullptr)
         glMSIS->Update();
+    else if(rtMSIS != nullptr)
+    {
+        SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+        RayTracingScene* scene = sm->getRayTracingScene();
+        scene->Update(sm);
+        Scalar l1, l2;
+        getRotationLimits(l1, l2);
+        rtMSIS->ComputeOutput(scene, getSensorFrame(), range, (GLfloat)gain, currentStep, glm::vec2((GLfloat)l1, (GLfloat)l2));
+        setFrameTimeStamp(sm->getSimulationTime());
+        NewDataReady(rtMSIS->getDisplayDataPointer(), 0);
+        NewDataReady(rtMSIS->getOutputDataPointer(), 1);
+    }
 }
 
 std::vector<Renderable> MSIS::Render()
@@ -338,4 +377,18 @@ std::vector<Renderable> MSIS::Render()
     return items;
 }
 
+void MSIS::SaveState(SimulationState& state)
+{
+    Camera::SaveState(state);
+    state.Write(currentStep);
+    state.Write(cw);
+}
+
+void MSIS::RestoreState(SimulationState& state)
+{
+    Camera::RestoreState(state);
+    state.Read(currentStep);
+    state.Read(cw);
+}
+
 }
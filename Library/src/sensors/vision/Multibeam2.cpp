@@ -29,6 +29,9 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLDepthCamera.h"
+#include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "sensors/vision/RayTracedDepthCamera.h"
 
 namespace sf
 {
@@ -45,6 +48,7 @@ Multibeam2::Multibeam2(std::string uniqueName, unsigned int horizontalRes, unsig
     memset(imageData, 0, resX*resY*sizeof(GLfloat));
     rangeData = new GLfloat[resX*resY]; // Buffer for storing final data
     memset(rangeData, 0, resX*resY*sizeof(GLfloat));
+    rtCamera = nullptr;
 }
 
 Multibeam2::~Multibeam2()
@@ -53,6 +57,8 @@ Multibeam2::~Multibeam2()
         delete [] imageData;
     if(rangeData != NULL)
         delete [] rangeData;
+    if(rtCamera != nullptr)
+        delete rtCamera;
     cameras.clear();
 }
     
@@ -84,7 +90,7 @@ VisionSensorType Multibeam2::getVisionSensorType() const
     return VisionSensorType::MULTIBEAM2;
 }
     
-void Multibeam2::InitGraphics()
+void Multibeam2::SetupCameraLayout()
 {
     if(fovH <= Scalar(MULTIBEAM_MAX_SINGLE_FOV))
     {
@@ -137,16 +143,25 @@ void Multibeam2::InitGraphics()
         }
     }
     
-    //Create depth cameras
     GLint accResX = 0;
     for(size_t i=0; i<cameras.size(); ++i)
     {
-        cameras[i].cam = new OpenGLDepthCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0),
-                                                            accResX, 0, cameras[i].width, resY, cameras[i].fovH, range.x, range.y, true, (GLfloat)fovV);
-        cameras[i].cam->setCamera(this, (unsigned int)i);
         cameras[i].dataOffset = accResX*resY;
         accResX += cameras[i].width;
     }
+}
+
+void Multibeam2::InitGraphics()
+{
+    SetupCameraLayout();
+    
+    //Create depth cameras
+    for(size_t i=0; i<cameras.size(); ++i)
+    {
+        cameras[i].cam = new OpenGLDepthCamera(glm::vec3(0,0,0), glm::vec3(0,0,1.f), glm::vec3(0,-1.f,0),
+                                                            (GLint)(cameras[i].dataOffset/resY), 0, cameras[i].width, resY, cameras[i].fovH, range.x, range.y, true, (GLfloat)fovV);
+        cameras[i].cam->setCamera(this, (unsigned int)i);
+    }
     
     //Update camera transformations
     UpdateTransform();
@@ -159,8 +174,37 @@ void Multibeam2::InitGraphics()
     }
 }
 
+bool Multibeam2::InitRayTracing()
+{
+    SetupCameraLayout();
+    
+    //Same view directions as in UpdateTransform()
+    rtCamera = new RayTracedDepthCamera(resX, resY, range, randomGenerator);
+    GLfloat accFov = 0.f;
+    GLfloat offset = glm::radians((GLfloat)fovH)/2.f;
+    for(size_t i=0; i<cameras.size(); ++i)
+    {
+        GLfloat halfFov = glm::radians(cameras[i].fovH)/2.f;
+        rtCamera->AddView((unsigned int)(cameras[i].dataOffset/resY), cameras[i].width, cameras[i].fovH, (GLfloat)fovV, offset - accFov - halfFov);
+        accFov += 2.f*halfFov;
+    }
+    return true;
+}
+
 void Multibeam2::InternalUpdate(Scalar dt)
 {
+    if(rtCamera != nullptr)
+    {
+        SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+        RayTracingScene* scene = sm->getRayTracingScene();
+        scene->Update(sm);
+        rtCamera->ComputeRanges(scene, getSensorFrame());
+        setFrameTimeStamp(sm->getSimulationTime());
+        memcpy(rangeData, rtCamera->getOutputDataPointer(), resX*resY*sizeof(GLfloat));
+        RangeDataReady();
+        return;
+    }
+    
     for(size_t i=0; i<cameras.size(); ++i)
         cameras[i].cam->Update();
 }
@@ -230,11 +274,18 @@ void Multibeam2::NewDataReady(void* data, unsigned int index)
             }
         }
         
-        //Call callback
-        if(newDataCallback != NULL)
-            newDataCallback(this);
+        RangeDataReady();
     }
 }
+
+void Multibeam2::RangeDataReady()
+{
+    DeliverFrame(rangeData, resX*resY*sizeof(GLfloat));
+    
+    //Call callback
+    if(newDataCallback != NULL)
+        newDataCallback(this);
+}
     
 std::vector<Renderable> Multibeam2::Render()
 {
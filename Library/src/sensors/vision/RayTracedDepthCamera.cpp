@@ -0,0 +1,117 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedDepthCamera.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/RayTracedDepthCamera.h"
+
+namespace sf
+{
+
+RayTracedDepthCamera::RayTracedDepthCamera(unsigned int width, unsigned int height, glm::vec2 depthRange, RandomStream& rng)
+    : resX(width), resY(height), range(depthRange), noiseStdDev(0.f), minDepthFactor(1.f), randGen(rng)
+{
+    localDirs.resize(resX*resY, glm::vec3(0.f, 0.f, 1.f));
+    depthFactor.resize(resX*resY, 1.f);
+    output.resize(resX*resY, 0.f);
+}
+
+void RayTracedDepthCamera::AddView(unsigned int offsetX, unsigned int viewWidth, GLfloat horizontalFOVDeg, GLfloat verticalFOVDeg, GLfloat yaw)
+{
+    //View axes in the sensor frame (Z forward, -Y up, X right)
+    glm::vec3 f(-sinf(yaw), 0.f, cosf(yaw));
+    glm::vec3 r(cosf(yaw), 0.f, sinf(yaw));
+    glm::vec3 u(0.f, -1.f, 0.f);
+    GLfloat tx = tanf(glm::radians(horizontalFOVDeg)/2.f);
+    GLfloat ty = tanf(glm::radians(verticalFOVDeg)/2.f);
+    
+    for(unsigned int y=0; y<resY; ++y)
+    {
+        GLfloat ndcY = 1.f - (y + 0.5f)/(GLfloat)resY * 2.f; //First row at the top
+        for(unsigned int x=0; x<viewWidth && offsetX + x < resX; ++x)
+        {
+            GLfloat ndcX = (x + 0.5f)/(GLfloat)viewWidth * 2.f - 1.f;
+            glm::vec3 d = r * (ndcX * tx) + u * (ndcY * ty) + f;
+            GLfloat len = glm::length(d);
+            size_t id = y * resX + offsetX + x;
+            localDirs[id] = d/len;
+            depthFactor[id] = 1.f/len;
+            minDepthFactor = std::min(minDepthFactor, depthFactor[id]);
+        }
+    }
+}
+
+void RayTracedDepthCamera::setNoise(GLfloat depthStdDev)
+{
+    noiseStdDev = depthStdDev;
+}
+
+GLfloat* RayTracedDepthCamera::getOutputDataPointer()
+{
+    return output.data();
+}
+
+void RayTracedDepthCamera::TracePixels(const RayTracingScene* scene, const Transform& sensorFrame)
+{
+    glm::mat4 T = glMatrixFromTransform(sensorFrame);
+    glm::mat3 R = glm::mat3(T);
+    glm::vec3 eye = glm::vec3(T[3]);
+    
+    worldDirs.resize(localDirs.size());
+    hits.resize(localDirs.size());
+    for(size_t i=0; i<localDirs.size(); ++i)
+        worldDirs[i] = R[0] * localDirs[i].x + R[1] * localDirs[i].y + R[2] * localDirs[i].z;
+    
+    //Far plane is flat, so the corner rays are the longest
+    scene->TraceRays(eye, worldDirs.data(), worldDirs.size(), range.y/minDepthFactor, hits.data());
+}
+
+void RayTracedDepthCamera::ComputeDepth(const RayTracingScene* scene, const Transform& sensorFrame)
+{
+    TracePixels(scene, sensorFrame);
+    
+    if(noiseStdDev > 0.f)
+    {
+        noise.resize(hits.size());
+        randGen.FillNormal(noise.data(), noise.size());
+    }
+    
+    for(size_t i=0; i<hits.size(); ++i)
+    {
+        GLfloat depth = hits[i].distance * depthFactor[i];
+        if(hits[i].instance < 0 || depth < range.x || depth > range.y) //Clipped
+            output[i] = 0.f;
+        else
+            output[i] = noiseStdDev > 0.f ? depth + depth * depth * noiseStdDev * (GLfloat)noise[i] : depth;
+    }
+}
+
+void RayTracedDepthCamera::ComputeRanges(const RayTracingScene* scene, const Transform& sensorFrame)
+{
+    TracePixels(scene, sensorFrame);
+    
+    for(size_t i=0; i<hits.size(); ++i)
+        output[i] = hits[i].instance < 0 ? range.y : glm::clamp(hits[i].distance, range.x, range.y);
+}
+
+}
@@ -0,0 +1,152 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedFLS.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/RayTracedFLS.h"
+
+#define FLS_VRES_FACTOR 0.1f
+#define GAUSSIAN_WIDTH 5
+
+namespace sf
+{
+
+//Beam interference blur (same as sonar postprocess shader)
+static const GLfloat sampleWeight2D[GAUSSIAN_WIDTH][GAUSSIAN_WIDTH] =
+{
+    {0.003765f, 0.015019f, 0.023792f, 0.015019f, 0.003765f}, //sigma = 1.0
+    {0.015019f, 0.059912f, 0.094907f, 0.059912f, 0.015019f},
+    {0.023792f, 0.094907f, 0.150342f, 0.094907f, 0.023792f},
+    {0.015019f, 0.059912f, 0.094907f, 0.059912f, 0.015019f},
+    {0.003765f, 0.015019f, 0.023792f, 0.015019f, 0.003765f}
+};
+
+RayTracedFLS::RayTracedFLS(unsigned int numOfBeams, unsigned int numOfBins, GLfloat horizontalFOVDeg, GLfloat verticalFOVDeg,
+                           unsigned int displayWidth, ColorMap cm, RandomStream& rng)
+    : RayTracedSonar(numOfBeams, numOfBins, displayWidth, numOfBins, cm, rng)
+{
+    nBeams = numOfBeams;
+    nBins = numOfBins;
+    nBeamSamples = glm::max(glm::min((GLuint)ceilf(verticalFOVDeg * (GLfloat)numOfBins * FLS_VRES_FACTOR), (GLuint)2048), (GLuint)2);
+    fovH = glm::radians(horizontalFOVDeg);
+    GLfloat fovV = glm::radians(verticalFOVDeg);
+    binHistogram.resize(nBeams * nBins);
+    image.resize(nBeams * nBins);
+    
+    //Beam directions (sensor frame: Z forward, -Y up, X right)
+    localDirs.resize(nBeams * nBeamSamples);
+    for(GLuint b=0; b<nBeams; ++b)
+    {
+        GLfloat theta = -fovH/2.f + (b + 0.5f)/(GLfloat)nBeams * fovH;
+        for(GLuint i=0; i<nBeamSamples; ++i)
+        {
+            GLfloat phi = -fovV/2.f + i/(GLfloat)(nBeamSamples-1) * fovV;
+            localDirs[b * nBeamSamples + i] = glm::vec3(cosf(phi) * sinf(theta), -sinf(phi), cosf(phi) * cosf(theta));
+        }
+    }
+}
+
+void RayTracedFLS::ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain)
+{
+    TraceBeams(scene, sensorFrame, range.y);
+    
+    //Histograms of each beam
+    GLfloat rangeStep = (range.y - range.x)/(GLfloat)nBins;
+    std::fill(binHistogram.begin(), binHistogram.end(), glm::vec2(0.f));
+    for(GLuint b=0; b<nBeams; ++b)
+    {
+        glm::vec2* hist = &binHistogram[b * nBins];
+        for(GLuint i=0; i<nBeamSamples; ++i)
+        {
+            size_t id = b * nBeamSamples + i;
+            if(hits[id].instance < 0 || hits[id].distance < range.x || hits[id].distance >= range.y)
+                continue;
+            GLfloat factor = i/(GLfloat)(nBeamSamples-1);
+            GLuint bin = glm::min((GLuint)floorf((hits[id].distance - range.x)/rangeStep), nBins-1);
+            hist[bin].x += echo[id] * glm::smoothstep(0.f, 0.2f, factor) * (1.f - glm::smoothstep(0.8f, 1.f, factor)); //Lobe intensity correction
+            hist[bin].y += 1.f;
+        }
+    }
+    
+    //Bin values with noise
+    for(GLuint b=0; b<nBeams; ++b)
+    {
+        const glm::vec2* hist = &binHistogram[b * nBins];
+        GLfloat mulNoise = Gaussian(1.f, noise.x);
+        for(GLuint i=0; i<nBins; ++i)
+        {
+            GLfloat data = gain * Gaussian(0.f, noise.y); //Additive noise (Gaussian background noise)
+            if(hist[i].y > 0.f)
+                data += gain * (hist[i].x/hist[i].y) * mulNoise; //Signal + multiplicative noise (Gaussian beam gain noise)
+            image[(nBins-1-i) * nBeams + b] = data;
+        }
+    }
+    
+    //Gaussian blur
+    #pragma omp parallel for
+    for(int y=0; y<(int)nBins; ++y)
+        for(int x=0; x<(int)nBeams; ++x)
+        {
+            GLfloat value = 0.f;
+            for(int i=-GAUSSIAN_WIDTH/2; i<=GAUSSIAN_WIDTH/2; ++i) //Horizontal blur (beam interference)
+                for(int h=-GAUSSIAN_WIDTH/2; h<=GAUSSIAN_WIDTH/2; ++h) //Vertical blur
+                {
+                    int sx = x + i;
+                    int sy = y + h;
+                    if(sx < 0 || sy < 0 || sx >= (int)nBeams || sy >= (int)nBins)
+                        continue;
+                    value += sampleWeight2D[i+GAUSSIAN_WIDTH/2][h+GAUSSIAN_WIDTH/2] * image[sy * nBeams + sx];
+                }
+            output[y * nBeams + x] = (GLubyte)(glm::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+        }
+    
+    UpdateDisplay(range.x/range.y);
+}
+
+void RayTracedFLS::UpdateDisplay(GLfloat rangeMin)
+{
+    GLfloat hFactor = sinf(fovH/2.f);
+    
+    #pragma omp parallel for
+    for(int py=0; py<(int)dispH; ++py)
+        for(GLuint px=0; px<dispW; ++px)
+        {
+            GLubyte* rgb = &display[(py * dispW + px) * 3];
+            GLfloat ndcX = (px + 0.5f)/(GLfloat)dispW * 2.f - 1.f;
+            GLfloat ndcY = (py + 0.5f)/(GLfloat)dispH * 2.f - 1.f;
+            GLfloat Rs = -ndcX * hFactor;
+            GLfloat Rc = (1.f - ndcY)/2.f;
+            GLfloat R = sqrtf(Rs*Rs + Rc*Rc);
+            GLfloat alpha = atan2f(Rs, Rc);
+            if(R < rangeMin || R > 1.f || fabsf(alpha) > fovH/2.f) //Outside of the sonar fan
+            {
+                rgb[0] = rgb[1] = rgb[2] = 0;
+                continue;
+            }
+            GLfloat u = (fovH/2.f - alpha)/fovH;
+            GLfloat v = (1.f - R)/(1.f - rangeMin);
+            MapColor(SampleOutput(u, v), cMap, rgb);
+        }
+}
+
+}
@@ -0,0 +1,129 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedMSIS.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/RayTracedMSIS.h"
+
+#define MSIS_RES_FACTOR 0.1f
+
+namespace sf
+{
+
+RayTracedMSIS::RayTracedMSIS(unsigned int numOfSteps, unsigned int numOfBins, GLfloat horizontalBeamWidthDeg, GLfloat verticalBeamWidthDeg, ColorMap cm, RandomStream& rng)
+    : RayTracedSonar(numOfSteps, numOfBins, numOfBins, numOfBins, cm, rng)
+{
+    nSteps = numOfSteps;
+    nBins = numOfBins;
+    nBeamSamples.x = glm::max(glm::min((GLuint)ceilf(horizontalBeamWidthDeg * (GLfloat)numOfBins * MSIS_RES_FACTOR), (GLuint)2048), (GLuint)2);
+    nBeamSamples.y = glm::max(glm::min((GLuint)ceilf(verticalBeamWidthDeg * (GLfloat)numOfBins * MSIS_RES_FACTOR), (GLuint)2048), (GLuint)2);
+    fov.x = glm::radians(horizontalBeamWidthDeg);
+    fov.y = glm::radians(verticalBeamWidthDeg);
+    settings = glm::vec3(-1.f);
+    limits = glm::vec2(0.f);
+    binHistogram.resize(nBins);
+    localDirs.resize(nBeamSamples.x * nBeamSamples.y);
+}
+
+void RayTracedMSIS::ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain,
+                                  GLint rotationStep, glm::vec2 rotationLimits)
+{
+    //Clear image when settings change
+    if(settings != glm::vec3(range, gain) || limits != rotationLimits)
+    {
+        settings = glm::vec3(range, gain);
+        limits = rotationLimits;
+        std::fill(output.begin(), output.end(), 0);
+    }
+    
+    //Beam directions (sensor frame: Z forward, -Y rotation axis, X right)
+    GLfloat rotAngle = rotationStep * (2.f*M_PI/(GLfloat)nSteps);
+    for(GLuint y=0; y<nBeamSamples.y; ++y)
+    {
+        GLfloat v = (y/(GLfloat)(nBeamSamples.y-1) - 0.5f) * fov.y;
+        for(GLuint x=0; x<nBeamSamples.x; ++x)
+        {
+            GLfloat h = rotAngle + (x/(GLfloat)(nBeamSamples.x-1) - 0.5f) * fov.x;
+            localDirs[y * nBeamSamples.x + x] = glm::vec3(cosf(v) * sinf(h), -sinf(v), cosf(v) * cosf(h));
+        }
+    }
+    TraceBeams(scene, sensorFrame, range.y);
+    
+    //Histogram of the beam
+    GLfloat rangeStep = (range.y - range.x)/(GLfloat)nBins;
+    std::fill(binHistogram.begin(), binHistogram.end(), glm::vec2(0.f));
+    for(GLuint y=0; y<nBeamSamples.y; ++y)
+    {
+        GLfloat vFrac2 = (y/(GLfloat)(nBeamSamples.y-1) - 0.5f) * 2.f;
+        vFrac2 *= vFrac2;
+        for(GLuint x=0; x<nBeamSamples.x; ++x)
+        {
+            size_t id = y * nBeamSamples.x + x;
+            if(hits[id].instance < 0 || hits[id].distance < range.x || hits[id].distance >= range.y)
+                continue;
+            GLfloat hFrac2 = (x/(GLfloat)(nBeamSamples.x-1) - 0.5f) * 2.f;
+            hFrac2 *= hFrac2;
+            GLuint bin = glm::min((GLuint)floorf((hits[id].distance - range.x)/rangeStep), nBins-1);
+            GLfloat beamPattern = glm::clamp(1.f - (hFrac2 + vFrac2)/2.f, 0.f, 1.f);
+            binHistogram[bin].x += echo[id] * beamPattern;
+            binHistogram[bin].y += 1.f;
+        }
+    }
+    
+    //Update sonar output
+    GLuint column = (GLuint)(rotationStep + (GLint)(nSteps/2)) % nSteps;
+    GLfloat mulNoise = Gaussian(1.f, noise.x);
+    for(GLuint i=0; i<nBins; ++i)
+    {
+        GLfloat value = gain * (i/(GLfloat)(nBins-1)*0.5f+0.5f) * Gaussian(0.f, noise.y); //Distance dependent additive noise
+        if(binHistogram[i].y > 0.f)
+            value += binHistogram[i].x/binHistogram[i].y * gain * mulNoise; //Multiplicative noise
+        output[(nBins-1-i) * nSteps + column] = (GLubyte)(glm::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+    }
+    
+    UpdateDisplay(range.x/range.y);
+}
+
+void RayTracedMSIS::UpdateDisplay(GLfloat rangeMin)
+{
+    #pragma omp parallel for
+    for(int py=0; py<(int)dispH; ++py)
+        for(GLuint px=0; px<dispW; ++px)
+        {
+            GLubyte* rgb = &display[(py * dispW + px) * 3];
+            GLfloat ndcX = (px + 0.5f)/(GLfloat)dispW * 2.f - 1.f;
+            GLfloat ndcY = (py + 0.5f)/(GLfloat)dispH * 2.f - 1.f;
+            GLfloat R = sqrtf(ndcX*ndcX + ndcY*ndcY);
+            if(R < rangeMin || R > 1.f) //Outside of the sonar disc
+            {
+                rgb[0] = rgb[1] = rgb[2] = 0;
+                continue;
+            }
+            GLfloat alpha = atan2f(-ndcX, -ndcY);
+            GLfloat u = (M_PI - alpha)/(2.f*M_PI);
+            GLfloat v = (1.f - R)/(1.f - rangeMin);
+            MapColor(SampleOutput(u, v), cMap, rgb);
+        }
+}
+
+}
@@ -0,0 +1,117 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RayTracedSSS.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "sensors/vision/RayTracedSSS.h"
+
+#include <cstring>
+
+#define SSS_VRES_FACTOR 0.2f
+#define SSS_HRES_FACTOR 100.f
+
+namespace sf
+{
+
+RayTracedSSS::RayTracedSSS(unsigned int numOfBins, unsigned int numOfLines, GLfloat verticalBeamWidthDeg, GLfloat horizontalBeamWidthDeg,
+                           GLfloat verticalTiltDeg, ColorMap cm, RandomStream& rng)
+    : RayTracedSonar(numOfBins, numOfLines, numOfBins, numOfLines, cm, rng)
+{
+    nHalfBins = numOfBins/2;
+    tilt = glm::radians(verticalTiltDeg);
+    fovV = glm::radians(verticalBeamWidthDeg);
+    GLfloat fovH = glm::radians(horizontalBeamWidthDeg);
+    nBeamSamples.x = glm::max(glm::min((GLuint)ceilf(verticalBeamWidthDeg * (GLfloat)numOfBins/2.f * SSS_VRES_FACTOR), (GLuint)2048), (GLuint)2);
+    nBeamSamples.y = glm::max(glm::min((GLuint)ceilf(horizontalBeamWidthDeg * SSS_HRES_FACTOR), (GLuint)2048), (GLuint)2);
+    lineHistogram.resize(numOfBins);
+    
+    //Beam directions (sensor frame: Z down, -Y forward, X starboard)
+    GLfloat offsetAngle = M_PI_2 - tilt;
+    localDirs.resize(2 * nBeamSamples.x * nBeamSamples.y);
+    for(GLuint s=0; s<2; ++s)
+        for(GLuint x=0; x<nBeamSamples.x; ++x)
+        {
+            GLfloat factor = x/(GLfloat)(nBeamSamples.x-1);
+            GLfloat beta = s == 0 ? offsetAngle - (factor-0.5f) * fovV : offsetAngle + (factor-0.5f) * fovV; //Angle from the Z axis
+            glm::vec3 across(s == 0 ? -sinf(beta) : sinf(beta), 0.f, cosf(beta));
+            for(GLuint i=0; i<nBeamSamples.y; ++i)
+            {
+                GLfloat chi = (i/(GLfloat)(nBeamSamples.y-1) - 0.5f) * fovH;
+                localDirs[(s * nBeamSamples.x + x) * nBeamSamples.y + i] = across * cosf(chi) + glm::vec3(0.f, -sinf(chi), 0.f);
+            }
+        }
+}
+
+void RayTracedSSS::ComputeOutput(const RayTracingScene* scene, const Transform& sensorFrame, glm::vec2 range, GLfloat gain)
+{
+    TraceBeams(scene, sensorFrame, range.y);
+    
+    //Accumulate histograms of both sides
+    GLfloat rangeStep = (range.y - range.x)/(GLfloat)nHalfBins;
+    std::fill(lineHistogram.begin(), lineHistogram.end(), glm::vec2(0.f));
+    for(GLuint s=0; s<2; ++s)
+    {
+        glm::vec2* hist = &lineHistogram[s * nHalfBins];
+        GLfloat fov = s == 0 ? fovV : -fovV;
+        for(GLuint x=0; x<nBeamSamples.x; ++x)
+        {
+            GLfloat factor = x/(GLfloat)(nBeamSamples.x-1);
+            GLfloat theta = tilt + (factor-0.5f) * fov;
+            GLfloat vWeight = glm::smoothstep(0.f, 0.2f, factor) * (1.f - glm::smoothstep(0.8f, 1.f, factor))
+                              / glm::clamp(sinf(theta), 0.01f, 1.f); //Intensity compensation based on flat bottom model
+            
+            for(GLuint i=0; i<nBeamSamples.y; ++i)
+            {
+                size_t id = (s * nBeamSamples.x + x) * nBeamSamples.y + i;
+                if(hits[id].instance < 0 || hits[id].distance < range.x || hits[id].distance >= range.y)
+                    continue;
+                GLuint bin = glm::min((GLuint)floorf((hits[id].distance - range.x)/rangeStep), nHalfBins-1);
+                GLfloat hFrac2 = (i/(GLfloat)(nBeamSamples.y-1) - 0.5f) * 2.f;
+                hFrac2 *= hFrac2;
+                GLfloat beamPattern = glm::clamp(1.f - hFrac2/2.f, 0.f, 1.f);
+                hist[bin].x += echo[id] * beamPattern * vWeight;
+                hist[bin].y += 1.f;
+            }
+        }
+    }
+    
+    //Shift waterfall down
+    memmove(&output[outW], &output[0], outW * (outH-1));
+    memmove(&display[dispW*3], &display[0], dispW * 3 * (dispH-1));
+    
+    //Compute new line
+    GLfloat mulNoise = Gaussian(1.f, noise.x);
+    for(GLuint s=0; s<2; ++s)
+        for(GLuint x=0; x<nHalfBins; ++x)
+        {
+            const glm::vec2& data = lineHistogram[s * nHalfBins + x];
+            GLuint bin = s == 0 ? nHalfBins - 1 - x : nHalfBins + x;
+            GLfloat value = gain * (x/(GLfloat)(nHalfBins-1)*0.5f+0.5f) * Gaussian(0.f, noise.y); //Distance dependent additive noise
+            if(data.y > 0.f)
+                value += 0.7f * data.x/data.y * gain * mulNoise; //Multiplicative noise
+            output[bin] = (GLubyte)(glm::clamp(value, 0.f, 1.f) * 255.f + 0.5f);
+            MapColor(output[bin]/255.f, cMap, &display[bin*3]);
+        }
+}
+
+}
@@ -29,6 +29,9 @@
 #include "graphics/OpenGLPipeline.h"
 #include "graphics/OpenGLContent.h"
 #include "graphics/OpenGLSSS.h"
+#include "core/SimulationManager.h"
+#include "core/RayTracingScene.h"
+#include "sensors/vision/RayTracedSSS.h"
 
 namespace sf
 {
@@ -50,11 +53,13 @@ SSS::SSS(std::string uniqueName, unsigned int numOfBins, unsigned int numOfLines
     displayData = NULL;
     newDataCallback = NULL;
     glSSS = nullptr;
+    rtSSS = nullptr;
 }
 
 SSS::~SSS()
 {
     if(displayData != NULL) delete [] displayData;
+    if(rtSSS != nullptr) delete rtSSS;
     glSSS = nullptr;
 }
 
@@ -83,6 +88,8 @@ void SSS::setNoise(float multiplicativeStdDev, float additiveStdDev)
         noise.y = additiveStdDev;
     if(glSSS != nullptr)
         glSSS->setNoise(noise);
+    if(rtSSS != nullptr)
+        rtSSS->setNoise(noise);
 }
 
 void* SSS::getImageDataPointer(unsigned int index)
@@ -137,6 +144,16 @@ void SSS::InitGraphics()
     displayData = new GLubyte[w*h*3];
 }
 
+bool SSS::InitRayTracing()
+{
+    rtSSS = new RayTracedSSS(resX, resY, (GLfloat)fovH, (GLfloat)fovV, (GLfloat)tilt, cMap, randomGenerator);
+    rtSSS->setNoise(noise);
+    unsigned int w, h;
+    getDisplayResolution(w, h);
+    displayData = new GLubyte[w*h*3];
+    return true;
+}
+
 void SSS::SetupCamera(const Vector3& eye, const Vector3& dir, const Vector3& up)
 {
     glm::vec3 eye_ = glm::vec3((GLfloat)eye.x(), (GLfloat)eye.y(), (GLfloat)eye.z());
@@ -152,6 +169,15 @@ void SSS::InstallNewDataHandler(std::function<void(SSS*)> callback)
 
 void SSS::NewDataReady(void* data, unsigned int index)
 {
+    if(index == 0)
+    {
+        unsigned int w, h;
+        getDisplayResolution(w, h);
+        DeliverFrame(data, w*h*3, 0);
+    }
+    else
+        DeliverFrame(data, resX*resY, 1);
+    
     if(newDataCallback != NULL)
     {
         if(index == 0)
@@ -173,6 +199,16 @@ void SSS::InternalUpdate(Scalar dt)
 {
     if(glSSS != nullptr)
         glSSS->Update();
+    else if(rtSSS != nullptr)
+    {
+        SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+        RayTracingScene* scene = sm->getRayTracingScene();
+        scene->Update(sm);
+        rtSSS->ComputeOutput(scene, getSensorFrame(), range, (GLfloat)gain);
+        setFrameTimeStamp(sm->getSimulationTime());
+        NewDataReady(rtSSS->getDisplayDataPointer(), 0);
+        NewDataReady(rtSSS->getOutputDataPointer(), 1);
+    }
 }
 
 std::vector<Renderable> SSS::Render()
@@ -0,0 +1,388 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BVH.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/BVH.h"
+
+#include <cfloat>
+#include <algorithm>
+
+namespace sf
+{
+
+static inline GLfloat SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+{
+    glm::vec3 e = max - min;
+    if(e.x < 0.f || e.y < 0.f || e.z < 0.f)
+        return 0.f;
+    return 2.f * (e.x * e.y + e.y * e.z + e.z * e.x);
+}
+
+static inline bool PacketHitsBox(const RayPacket& p, const GLfloat* ix, const GLfloat* iy, const GLfloat* iz,
+                                 const glm::vec3& bMin, const glm::vec3& bMax)
+{
+    int hit = 0;
+    #pragma omp simd reduction(|:hit)
+    for(int i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        //Slab test
+        GLfloat t1 = (bMin.x - p.ox[i]) * ix[i];
+        GLfloat t2 = (bMax.x - p.ox[i]) * ix[i];
+        GLfloat tmin = std::min(t1, t2);
+        GLfloat tmax = std::max(t1, t2);
+        t1 = (bMin.y - p.oy[i]) * iy[i];
+        t2 = (bMax.y - p.oy[i]) * iy[i];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+        t1 = (bMin.z - p.oz[i]) * iz[i];
+        t2 = (bMax.z - p.oz[i]) * iz[i];
+        tmin = std::max(tmin, std::min(t1, t2));
+        tmax = std::min(tmax, std::max(t1, t2));
+        tmin = std::max(tmin, 0.f);
+        hit |= (tmin <= tmax && tmin < p.t[i]) ? 1 : 0;
+    }
+    return hit != 0;
+}
+
+BVH::BVH(const Mesh* mesh)
+{
+    size_t nTri = mesh == nullptr ? 0 : mesh->faces.size();
+    if(nTri == 0)
+        return;
+    
+    //Precompute triangle data
+    triangles.resize(nTri);
+    centroids.resize(nTri);
+    triIds.resize(nTri);
+    const GLubyte* vData = (const GLubyte*)mesh->getVertexDataPointer();
+    size_t stride = mesh->getVertexSize();
+    
+    for(size_t i=0; i<nTri; ++i)
+    {
+        glm::vec3 v[3];
+        for(unsigned short h=0; h<3; ++h)
+        {
+            const Vertex* vt = (const Vertex*)(vData + mesh->faces[i].vertexID[h] * stride);
+            v[h] = vt->pos;
+            triangles[i].n[h] = vt->normal;
+        }
+        triangles[i].v0 = v[0];
+        triangles[i].e1 = v[1] - v[0];
+        triangles[i].e2 = v[2] - v[0];
+        
+        //Fall back to the face normal if vertex normals are missing
+        glm::vec3 fn = glm::cross(triangles[i].e1, triangles[i].e2);
+        GLfloat fnLen = glm::length(fn);
+        for(unsigned short h=0; h<3; ++h)
+            if(glm::dot(triangles[i].n[h], triangles[i].n[h]) < 1e-12f)
+                triangles[i].n[h] = fnLen > 0.f ? fn/fnLen : glm::vec3(0.f, 0.f, 1.f);
+        
+        centroids[i] = (v[0] + v[1] + v[2])/3.f;
+        triIds[i] = (GLuint)i;
+    }
+    
+    //Build hierarchy
+    nodes.reserve(nTri * 2);
+    BVHNode root;
+    root.first = 0;
+    root.count = (GLuint)nTri;
+    root.axis = 0;
+    nodes.push_back(root);
+    UpdateBounds(0);
+    Subdivide(0, 0);
+    nodes.shrink_to_fit();
+    
+    //Reorder triangles to match the leaves
+    std::vector<Triangle> sorted(nTri);
+    for(size_t i=0; i<nTri; ++i)
+        sorted[i] = triangles[triIds[i]];
+    triangles.swap(sorted);
+    triIds.clear();
+    triIds.shrink_to_fit();
+    centroids.clear();
+    centroids.shrink_to_fit();
+}
+
+void BVH::UpdateBounds(GLuint nodeId)
+{
+    BVHNode& node = nodes[nodeId];
+    node.aabbMin = glm::vec3(FLT_MAX);
+    node.aabbMax = glm::vec3(-FLT_MAX);
+    for(GLuint i=node.first; i<node.first+node.count; ++i)
+    {
+        const Triangle& tri = triangles[triIds[i]];
+        glm::vec3 v1 = tri.v0 + tri.e1;
+        glm::vec3 v2 = tri.v0 + tri.e2;
+        node.aabbMin = glm::min(node.aabbMin, glm::min(tri.v0, glm::min(v1, v2)));
+        node.aabbMax = glm::max(node.aabbMax, glm::max(tri.v0, glm::max(v1, v2)));
+    }
+}
+
+void BVH::Subdivide(GLuint nodeId, unsigned int depth)
+{
+    GLuint first = nodes[nodeId].first;
+    GLuint count = nodes[nodeId].count;
+    if(count <= BVH_MAX_LEAF_SIZE || depth >= BVH_MAX_DEPTH)
+        return;
+    
+    //Bounds of triangle centroids
+    glm::vec3 cMin(FLT_MAX);
+    glm::vec3 cMax(-FLT_MAX);
+    for(GLuint i=first; i<first+count; ++i)
+    {
+        cMin = glm::min(cMin, centroids[triIds[i]]);
+        cMax = glm::max(cMax, centroids[triIds[i]]);
+    }
+    
+    //Find the best split with the binned surface area heuristic
+    GLfloat bestCost = FLT_MAX;
+    int bestAxis = -1;
+    GLfloat bestSplit = 0.f;
+    
+    for(int a=0; a<3; ++a)
+    {
+        GLfloat extent = cMax[a] - cMin[a];
+        if(extent <= 0.f)
+            continue;
+        
+        glm::vec3 binMin[BVH_SAH_BINS];
+        glm::vec3 binMax[BVH_SAH_BINS];
+        GLuint binCount[BVH_SAH_BINS];
+        for(int b=0; b<BVH_SAH_BINS; ++b)
+        {
+            binMin[b] = glm::vec3(FLT_MAX);
+            binMax[b] = glm::vec3(-FLT_MAX);
+            binCount[b] = 0;
+        }
+        
+        GLfloat scale = (GLfloat)BVH_SAH_BINS/extent;
+        for(GLuint i=first; i<first+count; ++i)
+        {
+            const Triangle& tri = triangles[triIds[i]];
+            int b = std::min(BVH_SAH_BINS-1, (int)((centroids[triIds[i]][a] - cMin[a]) * scale));
+            glm::vec3 v1 = tri.v0 + tri.e1;
+            glm::vec3 v2 = tri.v0 + tri.e2;
+            binMin[b] = glm::min(binMin[b], glm::min(tri.v0, glm::min(v1, v2)));
+            binMax[b] = glm::max(binMax[b], glm::max(tri.v0, glm::max(v1, v2)));
+            ++binCount[b];
+        }
+        
+        //Sweep from both sides
+        GLfloat leftArea[BVH_SAH_BINS-1];
+        GLfloat rightArea[BVH_SAH_BINS-1];
+        GLuint leftCount[BVH_SAH_BINS-1];
+        GLuint rightCount[BVH_SAH_BINS-1];
+        glm::vec3 lMin(FLT_MAX), lMax(-FLT_MAX), rMin(FLT_MAX), rMax(-FLT_MAX);
+        GLuint lSum = 0;
+        GLuint rSum = 0;
+        for(int b=0; b<BVH_SAH_BINS-1; ++b)
+        {
+            lSum += binCount[b];
+            lMin = glm::min(lMin, binMin[b]);
+            lMax = glm::max(lMax, binMax[b]);
+            leftCount[b] = lSum;
+            leftArea[b] = SurfaceArea(lMin, lMax);
+            
+            rSum += binCount[BVH_SAH_BINS-1-b];
+            rMin = glm::min(rMin, binMin[BVH_SAH_BINS-1-b]);
+            rMax = glm::max(rMax, binMax[BVH_SAH_BINS-1-b]);
+            rightCount[BVH_SAH_BINS-2-b] = rSum;
+            rightArea[BVH_SAH_BINS-2-b] = SurfaceArea(rMin, rMax);
+        }
+        
+        for(int b=0; b<BVH_SAH_BINS-1; ++b)
+        {
+            GLfloat cost = leftCount[b] * leftArea[b] + rightCount[b] * rightArea[b];
+            if(leftCount[b] > 0 && rightCount[b] > 0 && cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = a;
+                bestSplit = cMin[a] + (GLfloat)(b+1)/scale;
+            }
+        }
+    }
+    
+    if(bestAxis < 0 || bestCost >= count * SurfaceArea(nodes[nodeId].aabbMin, nodes[nodeId].aabbMax))
+        return; //Splitting does not pay off
+    
+    //Partition triangles
+    int64_t i = first;
+    int64_t j = (int64_t)first + count - 1;
+    while(i <= j)
+    {
+        if(centroids[triIds[i]][bestAxis] < bestSplit)
+            ++i;
+        else
+            std::swap(triIds[i], triIds[j--]);
+    }
+    GLuint leftCount = (GLuint)(i - first);
+    if(leftCount == 0 || leftCount == count)
+        return;
+    
+    //Create children
+    GLuint leftId = (GLuint)nodes.size();
+    BVHNode child;
+    child.axis = 0;
+    child.first = first;
+    child.count = leftCount;
+    nodes.push_back(child);
+    child.first = first + leftCount;
+    child.count = count - leftCount;
+    nodes.push_back(child);
+    nodes[nodeId].first = leftId;
+    nodes[nodeId].count = 0;
+    nodes[nodeId].axis = (GLuint)bestAxis;
+    
+    UpdateBounds(leftId);
+    UpdateBounds(leftId+1);
+    Subdivide(leftId, depth+1);
+    Subdivide(leftId+1, depth+1);
+}
+
+bool BVH::IntersectTriangle(RayPacket& p, const Triangle& tri, GLint id)
+{
+    int any = 0;
+    #pragma omp simd reduction(|:any)
+    for(int i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        //Moller-Trumbore algorithm
+        GLfloat px = p.dy[i] * tri.e2.z - p.dz[i] * tri.e2.y;
+        GLfloat py = p.dz[i] * tri.e2.x - p.dx[i] * tri.e2.z;
+        GLfloat pz = p.dx[i] * tri.e2.y - p.dy[i] * tri.e2.x;
+        GLfloat det = tri.e1.x * px + tri.e1.y * py + tri.e1.z * pz;
+        GLfloat invDet = 1.f/det;
+        GLfloat sx = p.ox[i] - tri.v0.x;
+        GLfloat sy = p.oy[i] - tri.v0.y;
+        GLfloat sz = p.oz[i] - tri.v0.z;
+        GLfloat u = (sx * px + sy * py + sz * pz) * invDet;
+        GLfloat qx = sy * tri.e1.z - sz * tri.e1.y;
+        GLfloat qy = sz * tri.e1.x - sx * tri.e1.z;
+        GLfloat qz = sx * tri.e1.y - sy * tri.e1.x;
+        GLfloat v = (p.dx[i] * qx + p.dy[i] * qy + p.dz[i] * qz) * invDet;
+        GLfloat t = (tri.e2.x * qx + tri.e2.y * qy + tri.e2.z * qz) * invDet;
+        
+        if(std::fabs(det) > 1e-12f && u >= 0.f && v >= 0.f && u + v <= 1.f && t > 0.f && t < p.t[i])
+        {
+            GLfloat w = 1.f - u - v;
+            p.t[i] = t;
+            p.nx[i] = w * tri.n[0].x + u * tri.n[1].x + v * tri.n[2].x;
+            p.ny[i] = w * tri.n[0].y + u * tri.n[1].y + v * tri.n[2].y;
+            p.nz[i] = w * tri.n[0].z + u * tri.n[1].z + v * tri.n[2].z;
+            p.hit[i] = id;
+            any |= 1;
+        }
+    }
+    return any != 0;
+}
+
+bool BVH::Intersect(RayPacket& p, GLint id) const
+{
+    if(nodes.empty())
+        return false;
+    
+    GLfloat ix[RAY_PACKET_SIZE];
+    GLfloat iy[RAY_PACKET_SIZE];
+    GLfloat iz[RAY_PACKET_SIZE];
+    #pragma omp simd
+    for(int i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        ix[i] = 1.f/p.dx[i];
+        iy[i] = 1.f/p.dy[i];
+        iz[i] = 1.f/p.dz[i];
+    }
+    
+    GLuint stack[BVH_MAX_DEPTH + 2];
+    int sp = 0;
+    stack[sp++] = 0;
+    bool any = false;
+    
+    while(sp > 0)
+    {
+        const BVHNode& node = nodes[stack[--sp]];
+        if(!PacketHitsBox(p, ix, iy, iz, node.aabbMin, node.aabbMax))
+            continue;
+        
+        if(node.count > 0) //Leaf
+        {
+            for(GLuint i=node.first; i<node.first+node.count; ++i)
+                any |= IntersectTriangle(p, triangles[i], id);
+        }
+        else //Visit the child closer along the split axis first
+        {
+            const GLfloat* d = node.axis == 0 ? p.dx : (node.axis == 1 ? p.dy : p.dz);
+            if(d[0] > 0.f)
+            {
+                stack[sp++] = node.first + 1;
+                stack[sp++] = node.first;
+            }
+            else
+            {
+                stack[sp++] = node.first;
+                stack[sp++] = node.first + 1;
+            }
+        }
+    }
+    return any;
+}
+
+bool BVH::IntersectAABB(const RayPacket& p, const glm::vec3& aabbMin, const glm::vec3& aabbMax)
+{
+    GLfloat ix[RAY_PACKET_SIZE];
+    GLfloat iy[RAY_PACKET_SIZE];
+    GLfloat iz[RAY_PACKET_SIZE];
+    #pragma omp simd
+    for(int i=0; i<RAY_PACKET_SIZE; ++i)
+    {
+        ix[i] = 1.f/p.dx[i];
+        iy[i] = 1.f/p.dy[i];
+        iz[i] = 1.f/p.dz[i];
+    }
+    return PacketHitsBox(p, ix, iy, iz, aabbMin, aabbMax);
+}
+
+void BVH::getAABB(glm::vec3& min, glm::vec3& max) const
+{
+    if(nodes.empty())
+    {
+        min = glm::vec3(0.f);
+        max = glm::vec3(0.f);
+    }
+    else
+    {
+        min = nodes[0].aabbMin;
+        max = nodes[0].aabbMax;
+    }
+}
+
+size_t BVH::getNumOfTriangles() const
+{
+    return triangles.size();
+}
+
+size_t BVH::getNumOfNodes() const
+{
+    return nodes.size();
+}
+
+}
@@ -296,6 +296,90 @@ Mesh* LoadSTL(const std::string& path, GLfloat scale)
     return mesh;
 }
 
+uint64_t FileBytesLeft(FILE* file)
+{
+#ifdef _WIN32
+    int64_t pos = _ftelli64(file);
+    _fseeki64(file, 0, SEEK_END);
+    int64_t end = _ftelli64(file);
+    _fseeki64(file, pos, SEEK_SET);
+#else
+    off_t pos = ftello(file);
+    fseeko(file, 0, SEEK_END);
+    off_t end = ftello(file);
+    fseeko(file, pos, SEEK_SET);
+#endif
+    return (pos < 0 || end < pos) ? 0 : (uint64_t)(end - pos);
+}
+
+bool WriteMeshBinary(FILE* file, const Mesh* mesh)
+{
+    uint8_t texturable = mesh->isTexturable() ? 1 : 0;
+    uint64_t nVertices = mesh->getNumOfVertices();
+    uint64_t nFaces = mesh->faces.size();
+    
+    if(fwrite(&texturable, sizeof(uint8_t), 1, file) != 1
+       || fwrite(&nVertices, sizeof(uint64_t), 1, file) != 1
+       || fwrite(&nFaces, sizeof(uint64_t), 1, file) != 1)
+        return false;
+    
+    if(nVertices > 0 && fwrite(mesh->getVertexDataPointer(), mesh->getVertexSize(), nVertices, file) != nVertices)
+        return false;
+    if(nFaces > 0 && fwrite(mesh->getFaceDataPointer(), sizeof(Face), nFaces, file) != nFaces)
+        return false;
+    return true;
+}
+
+Mesh* ReadMeshBinary(FILE* file)
+{
+    uint8_t texturable;
+    uint64_t nVertices;
+    uint64_t nFaces;
+    
+    if(fread(&texturable, sizeof(uint8_t), 1, file) != 1
+       || fread(&nVertices, sizeof(uint64_t), 1, file) != 1
+       || fread(&nFaces, sizeof(uint64_t), 1, file) != 1
+       || texturable > 1)
+        return nullptr;
+    
+    //Reject counts which do not fit in the rest of the file (corrupted or truncated data)
+    uint64_t bytesLeft = FileBytesLeft(file);
+    uint64_t vertexSize = texturable ? sizeof(TexturableVertex) : sizeof(Vertex);
+    if(nVertices > bytesLeft/vertexSize
+       || nFaces > (bytesLeft - nVertices * vertexSize)/sizeof(Face))
+        return nullptr;
+    
+    Mesh* mesh;
+    if(texturable)
+    {
+        TexturableMesh* tmesh = new TexturableMesh;
+        tmesh->vertices.resize(nVertices);
+        mesh = tmesh;
+    }
+    else
+    {
+        PlainMesh* pmesh = new PlainMesh;
+        pmesh->vertices.resize(nVertices);
+        mesh = pmesh;
+    }
+    mesh->faces.resize(nFaces);
+    
+    if((nVertices > 0 && fread(mesh->getVertexDataPointer(), mesh->getVertexSize(), nVertices, file) != nVertices)
+       || (nFaces > 0 && fread(mesh->getFaceDataPointer(), sizeof(Face), nFaces, file) != nFaces))
+    {
+        delete mesh;
+        return nullptr;
+    }
+    
+    for(size_t i=0; i<mesh->faces.size(); ++i)
+        if(mesh->faces[i].vertexID[0] >= nVertices || mesh->faces[i].vertexID[1] >= nVertices || mesh->faces[i].vertexID[2] >= nVertices)
+        {
+            delete mesh;
+            return nullptr;
+        }
+    return mesh;
+}
+
 void ComputePhysicalProperties(const Mesh* mesh, Scalar thickness, Scalar density, Scalar& mass, Vector3& CG, Scalar& volume, Scalar& surface, Vector3& Ipri, Matrix3& Irot)
 {
     //1.Calculate mesh volume, CG and mass
@@ -0,0 +1,111 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MappedFile.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/MappedFile.h"
+
+#include <cstdio>
+#if defined(__linux__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace sf
+{
+
+MappedFile::MappedFile(const std::string& path)
+{
+    data = nullptr;
+    size = 0;
+    
+#if defined(__linux__) || defined(__APPLE__)
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return;
+    }
+    void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(ptr == MAP_FAILED)
+        return;
+#ifdef __linux__
+    madvise(ptr, (size_t)st.st_size, MADV_WILLNEED);
+#endif
+    data = (const char*)ptr;
+    size = (size_t)st.st_size;
+#else
+    FILE* f = fopen(path.c_str(), "rb");
+    if(f == NULL)
+        return;
+    _fseeki64(f, 0, SEEK_END);
+    int64_t len = _ftelli64(f);
+    _fseeki64(f, 0, SEEK_SET);
+    if(len <= 0)
+    {
+        fclose(f);
+        return;
+    }
+    buffer.resize((size_t)len);
+    size_t n = fread(&buffer[0], 1, (size_t)len, f);
+    fclose(f);
+    if(n != (size_t)len)
+    {
+        buffer.clear();
+        return;
+    }
+    data = &buffer[0];
+    size = buffer.size();
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(__linux__) || defined(__APPLE__)
+    if(data != nullptr)
+        munmap((void*)data, size);
+#endif
+}
+
+const char* MappedFile::getData() const
+{
+    return data;
+}
+
+size_t MappedFile::getSize() const
+{
+    return size;
+}
+
+bool MappedFile::isOpen() const
+{
+    return data != nullptr;
+}
+
+}
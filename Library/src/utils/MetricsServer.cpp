@@ -0,0 +1,206 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  MetricsServer.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/MetricsServer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "utils/SocketUtil.h"
+#ifdef __linux__
+    #include <unistd.h>
+#endif
+
+#define METRICS_POLL_TIMEOUT   250 //Time after which the server checks if it should stop [ms]
+#define METRICS_CLIENT_TIMEOUT 1000 //Clients are not trusted to send requests quickly [ms]
+#define METRICS_REQUEST_LENGTH 4096
+
+namespace sf
+{
+
+MetricsServer::MetricsServer(uint16_t port)
+{
+    listenSocket = OpenServerSocket(port);
+    if(!SocketsSupported())
+        cError("Metrics server not supported on this platform!");
+    else if(listenSocket < 0)
+        cError("Metrics server could not listen on port %u!", (unsigned int)port);
+    Start();
+}
+
+MetricsServer::MetricsServer(const std::string& socketPath) : socketPath(socketPath)
+{
+    listenSocket = OpenServerSocket(socketPath);
+    if(!SocketsSupported())
+        cError("Metrics server not supported on this platform!");
+    else if(listenSocket < 0)
+        cError("Metrics server could not listen on '%s'!", socketPath.c_str());
+    Start();
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop = true;
+    if(thread != nullptr)
+        SDL_WaitThread(thread, NULL);
+    if(listenSocket >= 0)
+    {
+        CloseSocket(listenSocket);
+        if(!socketPath.empty())
+            std::remove(socketPath.c_str());
+    }
+}
+
+void MetricsServer::Start()
+{
+    metrics = nullptr;
+    thread = nullptr;
+    stop = false;
+    requests = 0;
+    if(SimulationApp::getApp() != nullptr)
+        metrics = &SimulationApp::getApp()->getSimulationManager()->getMetrics();
+    
+    if(listenSocket >= 0 && metrics != nullptr)
+        thread = SDL_CreateThread(MetricsServer::RunServer, "metricsServer", this);
+}
+
+bool MetricsServer::isRunning() const
+{
+    return thread != nullptr;
+}
+
+uint64_t MetricsServer::getRequestsCount() const
+{
+    return requests;
+}
+
+int MetricsServer::RunServer(void* data)
+{
+    MetricsServer* server = (MetricsServer*)data;
+    while(!server->stop)
+    {
+        int client = AcceptConnection(server->listenSocket, METRICS_POLL_TIMEOUT);
+        if(client < 0)
+            continue;
+        server->Serve(client);
+        CloseSocket(client);
+    }
+    return 0;
+}
+
+void MetricsServer::Serve(int client)
+{
+    SetSocketTimeout(client, METRICS_CLIENT_TIMEOUT);
+    
+    //Read the request header
+    char request[METRICS_REQUEST_LENGTH];
+    size_t length = 0;
+    while(length < sizeof(request) - 1)
+    {
+        int64_t n = ReceiveSome(client, request + length, sizeof(request) - 1 - length);
+        if(n <= 0)
+            break;
+        length += (size_t)n;
+        request[length] = '\0';
+        if(strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL)
+            break;
+    }
+    request[length] = '\0';
+    
+    std::string response;
+    if(strncmp(request, "GET / ", 6) == 0 || strncmp(request, "GET /metrics", 12) == 0)
+    {
+        std::string page = GeneratePage();
+        response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " 
+                   + std::to_string(page.size()) + "\r\nConnection: close\r\n\r\n" + page;
+    }
+    else
+        response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    
+    SendAll(client, response.data(), response.size());
+    ++requests;
+}
+
+std::string MetricsServer::GeneratePage()
+{
+    uint64_t steps = metrics->steps.load(std::memory_order_relaxed);
+    double simTime = metrics->simulationTime.load(std::memory_order_relaxed);
+    uint64_t memory = getResidentMemory();
+    
+    std::ostringstream page;
+    auto metric = [&page](const char* name, const char* type, const char* help)
+    {
+        page << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+    };
+    
+    metric("stonefish_steps_total", "counter", "Number of physics steps computed.");
+    page << "stonefish_steps_total " << steps << "\n";
+    metric("stonefish_simulation_time_seconds", "gauge", "Simulation time (its rate is the real-time factor).");
+    page << "stonefish_simulation_time_seconds " << simTime << "\n";
+    metric("stonefish_cpu_usage_percent", "gauge", "Usage of the CPU by the physics computation.");
+    page << "stonefish_cpu_usage_percent " << metrics->cpuUsage.load(std::memory_order_relaxed) << "\n";
+    metric("stonefish_phase_time_microseconds", "gauge", "Computation time of the simulation phases.");
+    page << "stonefish_phase_time_microseconds{phase=\"physics\",stat=\"last\"} " << metrics->physicsTime.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_phase_time_microseconds{phase=\"physics\",stat=\"average\"} " << metrics->physicsTimeAverage.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_phase_time_microseconds{phase=\"hydrodynamics\",stat=\"last\"} " << metrics->hydrodynamicsTime.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_phase_time_microseconds{phase=\"hydrodynamics\",stat=\"average\"} " << metrics->hydrodynamicsTimeAverage.load(std::memory_order_relaxed) << "\n";
+    metric("stonefish_mlcp_fallbacks_total", "counter", "Number of MLCP solver failures.");
+    page << "stonefish_mlcp_fallbacks_total " << metrics->mlcpFallbacks.load(std::memory_order_relaxed) << "\n";
+    metric("stonefish_objects", "gauge", "Number of objects in the scenario.");
+    page << "stonefish_objects{type=\"entity\"} " << metrics->entities.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_objects{type=\"sensor\"} " << metrics->sensors.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_objects{type=\"actuator\"} " << metrics->actuators.load(std::memory_order_relaxed) << "\n";
+    page << "stonefish_objects{type=\"comm\"} " << metrics->comms.load(std::memory_order_relaxed) << "\n";
+    metric("stonefish_contact_manifolds", "gauge", "Number of contact manifolds after the last step.");
+    page << "stonefish_contact_manifolds " << metrics->contactManifolds.load(std::memory_order_relaxed) << "\n";
+    if(memory > 0) //Not available on all platforms
+    {
+        metric("stonefish_resident_memory_bytes", "gauge", "Resident memory of the process.");
+        page << "stonefish_resident_memory_bytes " << memory << "\n";
+    }
+    return page.str();
+}
+
+uint64_t MetricsServer::getResidentMemory()
+{
+#if defined(__linux__)
+    FILE* f = fopen("/proc/self/statm", "r");
+    if(f != NULL)
+    {
+        unsigned long size, resident;
+        int n = fscanf(f, "%lu %lu", &size, &resident);
+        fclose(f);
+        if(n == 2)
+            return (uint64_t)resident * (uint64_t)sysconf(_SC_PAGESIZE);
+    }
+    return 0;
+#else //Only the peak value is available elsewhere (e.g. ru_maxrss on macOS)
+    return 0;
+#endif
+}
+
+}
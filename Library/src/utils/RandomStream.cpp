@@ -0,0 +1,258 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RandomStream.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/RandomStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#define PHILOX_M0 0xD2511F53
+#define PHILOX_M1 0xCD9E8D57
+#define PHILOX_W0 0x9E3779B9
+#define PHILOX_W1 0xBB67AE85
+#define NORMAL_BATCH 64 //Number of Box-Muller pairs generated at once
+
+namespace sf
+{
+
+uint64_t RandomStream::globalSeed = 0;
+
+static inline uint64_t SplitMix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static inline void Philox4x32(uint64_t ctr, uint32_t k0, uint32_t k1, uint32_t* out)
+{
+    uint32_t c0 = (uint32_t)ctr;
+    uint32_t c1 = (uint32_t)(ctr >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    
+    for(unsigned int r = 0; r < 10; ++r)
+    {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+//Natural logarithm of a positive, normal number (branchless, accurate to ~1e-12)
+static inline double LogPositive(double x)
+{
+    uint64_t bits;
+    memcpy(&bits, &x, 8);
+    uint64_t high = (bits >> 51) & 1; //Mantissa above 1.5, moved to [0.75,1) to keep s small
+    double e = (double)((int32_t)((bits >> 52) & 0x7FF) - 1023 + (int32_t)high);
+    bits = (bits & 0x000FFFFFFFFFFFFFULL) | ((0x3FFULL - high) << 52);
+    double m;
+    memcpy(&m, &bits, 8); //m in [0.75,1.5)
+    double s = (m - 1.0)/(m + 1.0); //|s| < 0.2
+    double s2 = s * s;
+    double p = 1.0/17.0;
+    p = p * s2 + 1.0/15.0;
+    p = p * s2 + 1.0/13.0;
+    p = p * s2 + 1.0/11.0;
+    p = p * s2 + 1.0/9.0;
+    p = p * s2 + 1.0/7.0;
+    p = p * s2 + 1.0/5.0;
+    p = p * s2 + 1.0/3.0;
+    p = p * s2 + 1.0;
+    return (double)e * 0.6931471805599453 + 2.0 * s * p;
+}
+
+//Square root of a positive, normal number (Newton iterations, vectorizable without disabling errno)
+static inline double SqrtPositive(double x)
+{
+    uint64_t bits;
+    memcpy(&bits, &x, 8);
+    bits = 0x5FE6EB50C7B537A9ULL - (bits >> 1);
+    double y;
+    memcpy(&y, &bits, 8); //Initial guess of 1/sqrt(x)
+    for(unsigned int i = 0; i < 4; ++i)
+        y = y * (1.5 - 0.5 * x * y * y);
+    return x * y;
+}
+
+//Sine and cosine of an angle in [-pi/4, pi/4] (accurate to ~1e-11)
+static inline void SinCosReduced(double a, double& s, double& c)
+{
+    double a2 = a * a;
+    s = -1.0/39916800.0;
+    s = s * a2 + 1.0/362880.0;
+    s = s * a2 - 1.0/5040.0;
+    s = s * a2 + 1.0/120.0;
+    s = s * a2 - 1.0/6.0;
+    s = a + a * a2 * s;
+    c = 1.0/479001600.0;
+    c = c * a2 - 1.0/3628800.0;
+    c = c * a2 + 1.0/40320.0;
+    c = c * a2 - 1.0/720.0;
+    c = c * a2 + 1.0/24.0;
+    c = c * a2 - 0.5;
+    c = 1.0 + a2 * c;
+}
+
+static inline uint64_t HashName(const std::string& name)
+{
+    uint64_t h = 0xCBF29CE484222325ULL; //FNV-1a
+    for(size_t i = 0; i < name.size(); ++i)
+    {
+        h ^= (unsigned char)name[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+RandomStream::RandomStream()
+{
+    Seed(SplitMix64(globalSeed));
+}
+
+RandomStream::RandomStream(uint64_t key)
+{
+    Seed(key);
+}
+
+void RandomStream::Seed(uint64_t seed, const std::string& name)
+{
+    Seed(SplitMix64(seed ^ SplitMix64(HashName(name))));
+}
+
+void RandomStream::Seed(uint64_t k)
+{
+    key[0] = (uint32_t)k;
+    key[1] = (uint32_t)(k >> 32);
+    counter = 0;
+    index = 4;
+}
+
+RandomStream::result_type RandomStream::operator()()
+{
+    if(index == 4)
+    {
+        Generate();
+        ++counter;
+        index = 0;
+    }
+    return block[index++];
+}
+
+uint64_t RandomStream::getKey() const
+{
+    return ((uint64_t)key[1] << 32) | key[0];
+}
+
+uint64_t RandomStream::getPosition() const
+{
+    return counter * 4 - (index == 4 ? 0 : 4 - index);
+}
+
+void RandomStream::FillNormal(Scalar* out, size_t n, Scalar mean, Scalar stdDev)
+{
+    uint32_t u[NORMAL_BATCH * 2];
+    Scalar z[2][NORMAL_BATCH];
+    index = 4; //Discard the partially consumed block, the batches start at the counter
+    
+    while(n > 0)
+    {
+        size_t pairs = std::min((n + 1)/2, (size_t)NORMAL_BATCH);
+        size_t blocks = (pairs + 1)/2; //Each block holds two pairs of uniform numbers
+        GenerateBlocks(counter, blocks, u);
+        counter += blocks;
+        
+        //Box-Muller transform: the radius uses u1 in (0,1) to avoid log(0), 
+        //the angle is uniform in a quadrant selected by the two highest bits of u2 and rotated accordingly
+        //(signed 32-bit conversions are used because unsigned ones are not available in all SIMD instruction sets)
+        #pragma omp simd
+        for(size_t i = 0; i < pairs; ++i)
+        {
+            uint32_t u1 = u[2*i];
+            uint32_t u2 = u[2*i+1];
+            double x1 = ((double)(int32_t)(u1 ^ 0x80000000) + 2147483648.5) * (1.0/4294967296.0);
+            double r = (double)stdDev * SqrtPositive(-2.0 * LogPositive(x1));
+            double odd = (double)(int32_t)((u2 >> 30) & 1);
+            double sign = 1.0 - 2.0 * (double)(int32_t)(u2 >> 31);
+            double a = ((double)(int32_t)(u2 & 0x3FFFFFFF) * (1.0/1073741824.0) - 0.5) * (M_PI/2.0);
+            double s, c;
+            SinCosReduced(a, s, c);
+            z[0][i] = mean + (Scalar)(r * sign * (c - odd * (c + s))); //Rotation by multiples of pi/2
+            z[1][i] = mean + (Scalar)(r * sign * (s + odd * (c - s)));
+        }
+        
+        size_t m = std::min(n, pairs * 2);
+        for(size_t i = 0; i < m/2; ++i)
+        {
+            out[2*i] = z[0][i];
+            out[2*i+1] = z[1][i];
+        }
+        if(m & 1)
+            out[m-1] = z[0][m/2];
+        out += m;
+        n -= m;
+    }
+}
+
+void RandomStream::Generate()
+{
+    Philox4x32(counter, key[0], key[1], block);
+}
+
+void RandomStream::GenerateBlocks(uint64_t first, size_t nBlocks, uint32_t* out) const
+{
+    const uint32_t k0 = key[0];
+    const uint32_t k1 = key[1];
+    
+    #pragma omp simd
+    for(size_t i = 0; i < nBlocks; ++i)
+        Philox4x32(first + i, k0, k1, out + 4*i);
+}
+
+void RandomStream::setGlobalSeed(uint64_t seed)
+{
+    globalSeed = seed;
+}
+
+uint64_t RandomStream::getGlobalSeed()
+{
+    return globalSeed;
+}
+
+}
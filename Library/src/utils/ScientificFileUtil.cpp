@@ -27,7 +27,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstring>
 #include "core/SimulationApp.h"
+#include "utils/MappedFile.h"
 
 namespace sf
 {
@@ -99,220 +101,450 @@ btMatrixXu ScientificData::getMatrix(std::string name)
         return btMatrixXu();
 }
 
-ScientificData* LoadOctaveData(const std::string& path)
+//------ Zero-copy access ------
+
+static inline uint16_t SwapBytes16(uint16_t v)
 {
-    //Open file
-    cInfo("Loading scientific data from: %s", path.c_str());
-    
-    std::ifstream file;
-    file.open(path.c_str());
-    if(!file.is_open())
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+static inline uint32_t SwapBytes32(uint32_t v)
+{
+    return ((v >> 24) & 0xFF) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+static inline uint64_t SwapBytes64(uint64_t v)
+{
+    return ((uint64_t)SwapBytes32((uint32_t)v) << 32) | SwapBytes32((uint32_t)(v >> 32));
+}
+
+static inline bool HostIsBigEndian()
+{
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 0;
+}
+
+static inline Scalar ReadElement(const char* p, OctaveStorageType type, bool swap)
+{
+    switch(type)
     {
-        cError("File could not be opened!");
-        return NULL;
+        case OctaveStorageType::UINT8:
+            return (Scalar)*(const uint8_t*)p;
+            
+        case OctaveStorageType::INT8:
+            return (Scalar)*(const int8_t*)p;
+            
+        case OctaveStorageType::UINT16:
+        case OctaveStorageType::INT16:
+        {
+            uint16_t v;
+            memcpy(&v, p, 2);
+            if(swap) v = SwapBytes16(v);
+            return type == OctaveStorageType::UINT16 ? (Scalar)v : (Scalar)(int16_t)v;
+        }
+            
+        case OctaveStorageType::UINT32:
+        case OctaveStorageType::INT32:
+        case OctaveStorageType::FLOAT:
+        {
+            uint32_t v;
+            memcpy(&v, p, 4);
+            if(swap) v = SwapBytes32(v);
+            if(type == OctaveStorageType::FLOAT)
+            {
+                float f;
+                memcpy(&f, &v, 4);
+                return (Scalar)f;
+            }
+            return type == OctaveStorageType::UINT32 ? (Scalar)v : (Scalar)(int32_t)v;
+        }
+            
+        case OctaveStorageType::UINT64:
+        case OctaveStorageType::INT64:
+        case OctaveStorageType::DOUBLE:
+        {
+            uint64_t v;
+            memcpy(&v, p, 8);
+            if(swap) v = SwapBytes64(v);
+            if(type == OctaveStorageType::DOUBLE)
+            {
+                double d;
+                memcpy(&d, &v, 8);
+                return (Scalar)d;
+            }
+            return type == OctaveStorageType::UINT64 ? (Scalar)v : (Scalar)(int64_t)v;
+        }
     }
-    
-    //Check file identifier [10 bytes]
-    const int idStringLen = 10;
-    char idString[idStringLen + 1];
-    file.read(idString, idStringLen);
-    idString[idStringLen] = '\0';
-    
-    //Get endianness
-    //bool littleEndian;
-    
-    if(strncmp(idString, "Octave-1-L", idStringLen) == 0)
-        ; //littleEndian = true;
-    else if(strncmp(idString, "Octave-1-B", idStringLen) == 0)
+    return Scalar(0);
+}
+
+ScientificDataView::ScientificDataView() 
+    : data(nullptr), nRows(0), nCols(0), rowStride(0), colStride(0), type(OctaveStorageType::DOUBLE), swap(false)
+{
+}
+
+ScientificDataView::ScientificDataView(const char* data, unsigned int rows, unsigned int cols, int64_t rowStride, int64_t colStride,
+                                       OctaveStorageType type, bool swapBytes)
+    : data(data), nRows(rows), nCols(cols), rowStride(rowStride), colStride(colStride), type(type), swap(swapBytes)
+{
+}
+
+size_t ScientificDataView::getElementSize(OctaveStorageType type)
+{
+    switch(type)
     {
-        //littleEndian = false;
-        cError("File format not supported!");
-        return NULL;
+        case OctaveStorageType::UINT8:
+        case OctaveStorageType::INT8:
+            return 1;
+        case OctaveStorageType::UINT16:
+        case OctaveStorageType::INT16:
+            return 2;
+        case OctaveStorageType::UINT32:
+        case OctaveStorageType::INT32:
+        case OctaveStorageType::FLOAT:
+            return 4;
+        default:
+            return 8;
     }
+}
+
+Scalar ScientificDataView::operator()(unsigned int row, unsigned int col) const
+{
+    return ReadElement(data + (row * rowStride + col * colStride) * (int64_t)getElementSize(type), type, swap);
+}
+
+Scalar ScientificDataView::operator[](size_t i) const
+{
+    return nRows == 1 ? (*this)(0, (unsigned int)i) : (*this)((unsigned int)(i % nRows), (unsigned int)(i / nRows));
+}
+
+ScientificDataView ScientificDataView::row(unsigned int r) const
+{
+    return block(r, 0, 1, nCols);
+}
+
+ScientificDataView ScientificDataView::col(unsigned int c) const
+{
+    return block(0, c, nRows, 1);
+}
+
+ScientificDataView ScientificDataView::block(unsigned int r, unsigned int c, unsigned int nr, unsigned int nc) const
+{
+    if(r + nr > nRows || c + nc > nCols)
+        return ScientificDataView();
+    return ScientificDataView(data + (r * rowStride + c * colStride) * (int64_t)getElementSize(type), nr, nc, rowStride, colStride, type, swap);
+}
+
+ScientificDataView ScientificDataView::transposed() const
+{
+    return ScientificDataView(data, nCols, nRows, colStride, rowStride, type, swap);
+}
+
+const double* ScientificDataView::getDoubleData() const
+{
+    if(data == nullptr || type != OctaveStorageType::DOUBLE || swap || rowStride != 1 
+       || (nCols > 1 && colStride != (int64_t)nRows) || ((uintptr_t)data % alignof(double)) != 0)
+        return nullptr;
+    return (const double*)data;
+}
+
+btMatrixXu ScientificDataView::toMatrix() const
+{
+    btMatrixXu m(nRows, nCols);
+    for(unsigned int r = 0; r < nRows; ++r)
+        for(unsigned int c = 0; c < nCols; ++c)
+            m.setElem(r, c, (*this)(r, c));
+    return m;
+}
+
+btVectorXu ScientificDataView::toVector() const
+{
+    btVectorXu v((int)size());
+    for(size_t i = 0; i < size(); ++i)
+        v[(int)i] = (*this)[i];
+    return v;
+}
+
+unsigned int ScientificDataView::rows() const
+{
+    return nRows;
+}
+
+unsigned int ScientificDataView::cols() const
+{
+    return nCols;
+}
+
+size_t ScientificDataView::size() const
+{
+    return (size_t)nRows * nCols;
+}
+
+OctaveStorageType ScientificDataView::getStorageType() const
+{
+    return type;
+}
+
+MappedScientificData::MappedScientificData(const std::string& path) : path(path)
+{
+    bigEndian = false;
+    valid = false;
+    file = new MappedFile(path);
+    if(file->isOpen())
+        valid = Parse();
+}
+
+MappedScientificData::~MappedScientificData()
+{
+    items.clear();
+    delete file;
+}
+
+bool MappedScientificData::isOpen() const
+{
+    return valid;
+}
+
+bool MappedScientificData::isBigEndian() const
+{
+    return bigEndian;
+}
+
+unsigned int MappedScientificData::getItemsCount() const
+{
+    return (unsigned int)items.size();
+}
+
+std::string MappedScientificData::getItemName(unsigned int index) const
+{
+    return index < items.size() ? items[index].name : std::string("");
+}
+
+bool MappedScientificData::getItemType(const std::string& name, ScientificDataType& type) const
+{
+    for(size_t i = 0; i < items.size(); ++i)
+        if(items[i].name == name)
+        {
+            type = items[i].type;
+            return true;
+        }
+    return false;
+}
+
+ScientificDataView MappedScientificData::getView(const std::string& name) const
+{
+    for(size_t i = 0; i < items.size(); ++i)
+        if(items[i].name == name)
+            return items[i].view;
+    return ScientificDataView();
+}
+
+Scalar MappedScientificData::getScalar(const std::string& name) const
+{
+    ScientificDataView v = getView(name);
+    return v.size() > 0 ? v(0, 0) : Scalar(0);
+}
+
+bool MappedScientificData::Parse()
+{
+    const char* d = file->getData();
+    size_t n = file->getSize();
+    
+    //Check file identifier [10 bytes] and skip float format [1 byte]
+    if(n < 11)
+        return false;
+    if(strncmp(d, "Octave-1-L", 10) == 0)
+        bigEndian = false;
+    else if(strncmp(d, "Octave-1-B", 10) == 0)
+        bigEndian = true;
     else
     {
         cError("File format not recognized!");
-        return NULL;
+        return false;
     }
     
-    //Get float format [1 byte]
-    char floatFormat;
-    file.read(&floatFormat, 1);
-    
-    if(floatFormat > 1)
+    bool swap = bigEndian != HostIsBigEndian();
+    size_t pos = 11;
+    auto readInt32 = [d, n, swap, &pos](int32_t& v) -> bool
     {
-        cError("Float format not recognized!");
-        return NULL;
-    }
-    
-    //Read data items
-    ScientificData* sdata = new ScientificData(path);
+        if(pos + 4 > n) return false;
+        uint32_t u;
+        memcpy(&u, d + pos, 4);
+        if(swap) u = SwapBytes32(u);
+        v = (int32_t)u;
+        pos += 4;
+        return true;
+    };
+    auto readString = [d, n, &pos, &readInt32](std::string& s) -> bool
+    {
+        int32_t len;
+        if(!readInt32(len) || len < 0 || pos + (size_t)len > n) return false;
+        s = std::string(d + pos, (size_t)len);
+        pos += (size_t)len;
+        return true;
+    };
     
-    while(!file.eof())
+    while(pos < n)
     {
-        //read item name [4 bytes + nameLen]
-        int32_t nameLen = 0;
-        file.read(reinterpret_cast<char*>(&nameLen), 4);
-        
-        //check if EOF reached
-        if(file.eof())
-            break;
-        
-        char cname[nameLen + 1];
-        cname[nameLen] = '\0';
-        file.read(cname, nameLen);
-        
-        //skip doc [4 bytes + docLen]
-        int32_t docLen = 0;
-        file.read(reinterpret_cast<char*>(&docLen), 4);
-        file.seekg(docLen, std::ios_base::cur);
-        
-        //skip global flag [1 byte]
-        file.seekg(1, std::ios_base::cur);
-        
-        //get data type [1 byte]
-        unsigned char dataType;
-        file.read(reinterpret_cast<char*>(&dataType), 1);
+        //Item name, doc, global flag [1 byte] and data type [1 byte]
+        Item item;
+        std::string doc;
+        if(!readString(item.name) || !readString(doc) || pos + 2 > n)
+        {
+            cError("Unexpected end of file!");
+            return false;
+        }
+        unsigned char dataType = (unsigned char)d[pos + 1];
+        pos += 2;
         
-        //only scalars and real matrices supported!
-        if(dataType == 1) //scalar
+        bool isScalar;
+        if(dataType == 1 || dataType == 2) //legacy scalar or matrix
+            isScalar = dataType == 1;
+        else if(dataType == 255) //new type specifier
         {
-            ScientificDataItem* item = new ScientificDataItem();
-            item->name = std::string(cname);
-            
-            if(!LoadOctaveScalar(file, item, floatFormat != 0))
+            std::string typeName;
+            if(!readString(typeName))
+                return false;
+            if(typeName == "scalar" || typeName == "float scalar")
+                isScalar = true;
+            else if(typeName == "matrix" || typeName == "float matrix")
+                isScalar = false;
+            else
             {
-                cError("Failed to load scalar \"%s\"!", cname);
-                delete item;
-                delete sdata;
-                return NULL;
+                cError("Data type of \"%s\" not supported!", item.name.c_str());
+                return false;
             }
-            
-            sdata->addItem(item);
         }
-        else if(dataType == 2) //matrix
+        else
         {
-            ScientificDataItem* item = new ScientificDataItem();
-            item->name = std::string(cname);
-            
-            if(!LoadOctaveMatrix(file, item, floatFormat != 0))
-            {
-                cError("Failed to load matrix \"%s\"!", cname);
-                delete item;
-                delete sdata;
-                return NULL;
-            }
-            
-            sdata->addItem(item);
+            cError("Data type of \"%s\" not supported!", item.name.c_str());
+            return false;
         }
-        else if(dataType == 255) //new type specifier
+        
+        //Dimensions
+        uint64_t rows = 1;
+        uint64_t cols = 1;
+        if(!isScalar)
         {
-            //get type name [4 bytes + typeLen]
-            int32_t typeLen = 0;
-            file.read(reinterpret_cast<char*>(&typeLen), 4);
-            
-            char typeName[typeLen + 1];
-            typeName[typeLen] = '\0';
-            file.read(typeName, typeLen);
-            
-            if(strncmp(typeName, "scalar", typeLen) == 0)
-            {
-                ScientificDataItem* item = new ScientificDataItem();
-                item->name = std::string(cname);
-                
-                if(!LoadOctaveScalar(file, item))
-                {
-                    cError("Failed to load scalar \"%s\"!", cname);
-                    delete item;
-                    delete sdata;
-                    return NULL;
-                }
-                
-                sdata->addItem(item);
-            }
-            else if(strncmp(typeName, "matrix", typeLen) == 0)
+            int32_t mdims;
+            if(!readInt32(mdims))
+                return false;
+            if(mdims < 0) //number of dimensions followed by dimensions
             {
-                ScientificDataItem* item = new ScientificDataItem();
-                item->name = std::string(cname);
-                
-                if(!LoadOctaveMatrix(file, item))
+                int32_t dim;
+                for(int32_t i = 0; i < -mdims; ++i)
                 {
-                    cError("Failed to load matrix \"%s\"!", cname);
-                    delete item;
-                    delete sdata;
-                    return NULL;
+                    if(!readInt32(dim) || dim < 0)
+                        return false;
+                    if(i == 0)
+                        rows = (uint64_t)dim;
+                    else
+                        cols *= (uint64_t)dim; //Higher dimensions folded into columns
                 }
-                sdata->addItem(item);
             }
-            else if(strncmp(typeName, "float scalar", typeLen) == 0)
+            else //legacy rows and columns
             {
-                ScientificDataItem* item = new ScientificDataItem();
-                item->name = std::string(cname);
-                
-                if(!LoadOctaveScalar(file, item, true))
-                {
-                    cError("Failed to load scalar \"%s\"!", cname);
-                    delete item;
-                    delete sdata;
-                    return NULL;
-                }
-                
-                sdata->addItem(item);
-            }
-            else if(strncmp(typeName, "float matrix", typeLen) == 0)
-            {
-                ScientificDataItem* item = new ScientificDataItem();
-                item->name = std::string(cname);
-                
-                if(!LoadOctaveMatrix(file, item, true))
-                {
-                    cError("Failed to load matrix \"%s\"!", cname);
-                    delete item;
-                    delete sdata;
-                    return NULL;
-                }
-                
-                sdata->addItem(item);
-            }
-            else
-            {
-                cError("Data type of \"%s\" not supported!", cname);
-                delete sdata;
-                return NULL;
+                int32_t nc;
+                if(!readInt32(nc) || nc < 0)
+                    return false;
+                rows = (uint64_t)mdims;
+                cols = (uint64_t)nc;
             }
         }
-        else
+        
+        //Storage type [1 byte] and data
+        if(pos + 1 > n || (unsigned char)d[pos] > 9)
         {
-            cError("Data type of \"%s\" not supported!", cname);
-            delete sdata;
-            return NULL;
+            cError("Storage type of \"%s\" not recognized!", item.name.c_str());
+            return false;
         }
+        OctaveStorageType st = (OctaveStorageType)d[pos];
+        pos += 1;
+        uint64_t bytes = rows * cols * ScientificDataView::getElementSize(st);
+        if(pos + bytes > n)
+        {
+            cError("Data of \"%s\" truncated!", item.name.c_str());
+            return false;
+        }
+        
+        item.view = ScientificDataView(d + pos, (unsigned int)rows, (unsigned int)cols, 1, (int64_t)rows, st, swap);
+        item.type = isScalar ? DATA_SCALAR : ((rows == 1 || cols == 1) ? DATA_VECTOR : DATA_MATRIX);
+        items.push_back(item);
+        pos += (size_t)bytes;
     }
-    
-    return sdata;
+    return true;
 }
 
-bool LoadOctaveScalar(std::ifstream& file, ScientificDataItem* it, bool isFloat)
+//Copies the data of a view into a newly allocated value of a data item
+static void* CopyViewData(const ScientificDataView& v, ScientificDataType type)
 {
-    it->type = DATA_SCALAR;
-    
-    //skip 1 byte
-    file.seekg(1, std::ios_base::cur);
+    switch(type)
+    {
+        case DATA_SCALAR:
+            return new Scalar(v.size() > 0 ? v(0, 0) : Scalar(0));
+            
+        case DATA_VECTOR:
+        {
+            btVectorXu* vec = new btVectorXu((int)v.size());
+            for(size_t h = 0; h < v.size(); ++h)
+                (*vec)[(int)h] = v[h];
+            return vec;
+        }
+            
+        case DATA_MATRIX:
+        {
+            btMatrixXu* m = new btMatrixXu(v.rows(), v.cols());
+            for(unsigned int c = 0; c < v.cols(); ++c) //Follow the storage order
+                for(unsigned int r = 0; r < v.rows(); ++r)
+                    m->setElem(r, c, v(r, c));
+            return m;
+        }
+    }
+    return NULL;
+}
+
+ScientificData* MappedScientificData::Load() const
+{
+    if(!valid)
+        return NULL;
     
-    //read value
-    if(isFloat)
+    ScientificData* sdata = new ScientificData(path);
+    for(size_t i = 0; i < items.size(); ++i)
     {
-        float* scalar = new float;
-        file.read(reinterpret_cast<char*>(scalar), 4);
-        it->value = scalar;
+        ScientificDataItem* it = new ScientificDataItem();
+        it->name = items[i].name;
+        it->type = items[i].type;
+        it->value = CopyViewData(items[i].view, it->type);
+        sdata->addItem(it);
     }
-    else //double
+    return sdata;
+}
+
+ScientificData* LoadOctaveData(const std::string& path)
+{
+    cInfo("Loading scientific data from: %s", path.c_str());
+    
+    MappedScientificData mdata(path);
+    if(!mdata.isOpen())
     {
-        double* scalar = new double;
-        file.read(reinterpret_cast<char*>(scalar), 8);
-        it->value = scalar;
+        cError("File could not be loaded!");
+        return NULL;
     }
+    return mdata.Load();
+}
+
+bool LoadOctaveScalar(std::ifstream& file, ScientificDataItem* it, bool isFloat)
+{
+    //skip storage type [1 byte] and read the value
+    char data[8];
+    file.seekg(1, std::ios_base::cur);
+    file.read(data, isFloat ? 4 : 8);
+    if(!file)
+        return false;
     
+    //decode as in the memory-mapped reader
+    it->type = DATA_SCALAR;
+    it->value = CopyViewData(ScientificDataView(data, 1, 1, 1, 1, isFloat ? OctaveStorageType::FLOAT : OctaveStorageType::DOUBLE, false), it->type);
     return true;
 }
 
@@ -323,163 +555,177 @@ bool LoadOctaveMatrix(std::ifstream& file, ScientificDataItem* it, bool isFloat)
     file.read(reinterpret_cast<char*>(&dims), 4);
     dims = -dims;
     
-    if(dims != 2) //something is wrong...
+    if(!file || dims != 2) //something is wrong...
         return false;
     
-    //get matrix dimensions
+    //get matrix dimensions and skip storage type [1 byte]
     uint32_t rows;
     uint32_t cols;
     file.read(reinterpret_cast<char*>(&rows), 4);
     file.read(reinterpret_cast<char*>(&cols), 4);
-    
-    //skip 1 byte
     file.seekg(1, std::ios_base::cur);
+    if(!file)
+        return false;
+    
+    //read the data block and decode it as in the memory-mapped reader
+    OctaveStorageType st = isFloat ? OctaveStorageType::FLOAT : OctaveStorageType::DOUBLE;
+    std::vector<char> data((size_t)rows * cols * ScientificDataView::getElementSize(st));
+    file.read(data.data(), data.size());
+    if(!file)
+        return false;
     
-    if(rows == 1 || cols == 1) //vector
+    it->type = (rows == 1 || cols == 1) ? DATA_VECTOR : DATA_MATRIX;
+    it->value = CopyViewData(ScientificDataView(data.data(), rows, cols, 1, rows, st, false), it->type);
+    return true;
+}
+
+//------ Buffered writing ------
+
+#define OCTAVE_WRITE_BUFFER (4 << 20)
+
+//! A helper staging small writes in a large buffer and passing large blocks directly to the file.
+class OctaveFileWriter
+{
+public:
+    OctaveFileWriter(FILE* f) : file(f), used(0), ok(true)
     {
-        //setup vector with size
-        it->type = DATA_VECTOR;
-        uint32_t vLen = rows == 1 ? cols : rows;
-        btVectorXu* v = new btVectorXu(vLen);
-        
-        //choose float format
-        if(isFloat)
-        {
-            for(uint32_t i = 0; i < vLen; ++i)
-            {
-                float value;
-                file.read(reinterpret_cast<char*>(&value), 4);
-                (*v)[i] = (Scalar)value;
-            }
-        }
-        else //double
-        {
-            for(uint32_t i = 0; i < vLen; ++i)
-            {
-                double value;
-                file.read(reinterpret_cast<char*>(&value), 8);
-                (*v)[i] = (Scalar)value;
-            }
-        }
-        
-        it->value = v;
+        buffer.resize(OCTAVE_WRITE_BUFFER);
+        setvbuf(file, NULL, _IONBF, 0); //Buffering done here
     }
-    else //matrix
+    
+    void Write(const void* src, size_t n)
     {
-        //setup matrix with size
-        it->type = DATA_MATRIX;
-        btMatrixXu* m = new btMatrixXu(rows, cols);
-        
-        //choose float format
-        if(isFloat)
-        {
-            for(uint32_t i = 0; i < cols; ++i)
-                for (uint32_t h = 0; h < rows; ++h)
-                {
-                    float value;
-                    file.read(reinterpret_cast<char*>(&value), 4);
-                    m->setElem(h, i, (Scalar)value);
-                }
-        }
-        else //double
+        if(used + n > buffer.size())
+            Flush();
+        if(n >= buffer.size())
+            ok = ok && fwrite(src, 1, n, file) == n;
+        else
         {
-            for(uint32_t i = 0; i < cols; ++i)
-                for (uint32_t h = 0; h < rows; ++h)
-                {
-                    double value;
-                    file.read(reinterpret_cast<char*>(&value), 8);
-                    m->setElem(h, i, (Scalar)value);
-                }
+            memcpy(&buffer[used], src, n);
+            used += n;
         }
-        
-        it->value = m;
     }
     
-    return true;
-}
+    template<typename T> void WriteValue(const T& value)
+    {
+        Write(&value, sizeof(T));
+    }
+    
+    void Flush()
+    {
+        if(used > 0)
+            ok = ok && fwrite(&buffer[0], 1, used, file) == used;
+        used = 0;
+    }
+    
+    bool isOk() const
+    {
+        return ok;
+    }
+    
+private:
+    FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool ok;
+};
+
+#ifdef BT_USE_DOUBLE_PRECISION
+typedef double OctaveScalar;
+static const char octaveStorageType = 7;
+static const std::string octaveScalarName = "scalar";
+static const std::string octaveMatrixName = "matrix";
+#else
+typedef float OctaveScalar;
+static const char octaveStorageType = 6;
+static const std::string octaveScalarName = "float scalar";
+static const std::string octaveMatrixName = "float matrix";
+#endif
 
 bool SaveOctaveData(const std::string& path, const ScientificData& data)
 {
     //open file
     cInfo("Saving scientific data to: %s", path.c_str());
     
-    std::ofstream file;
-    file.open(path.c_str());
-    if(!file.is_open())
+    FILE* f = fopen(path.c_str(), "wb");
+    if(f == NULL)
     {
         cError("File could not be opened!");
         return false;
     }
+    OctaveFileWriter file(f);
     
-    //write file identifier [10 bytes]
-    file.write("Octave-1-L", 10);
-    
-    //write float format [1 byte]
-    char floatFormat = 0;
-    file.write(&floatFormat, 1);
+    //write file identifier [10 bytes] and float format [1 byte]
+    file.Write(HostIsBigEndian() ? "Octave-1-B" : "Octave-1-L", 10);
+    file.WriteValue((char)0);
     
     //write data items
+    std::vector<OctaveScalar> column;
     for(unsigned int i = 0; i < data.getItemsCount(); ++i)
     {
         const ScientificDataItem* it = data.getItem(i);
         
-        //write item name [4 bytes + nameLen]
-        int32_t nameLen = (int32_t)it->name.length();
-        file.write(reinterpret_cast<char*>(&nameLen), 4);
-        file.write(it->name.c_str(), nameLen);
-
-        //write empty doc [4 bytes]
-        int32_t docLen = 0;
-        file.write(reinterpret_cast<char*>(&docLen), 4);
+        //write item name [4 bytes + nameLen], empty doc [4 bytes], global flag [1 byte] and new type definition [1 byte]
+        file.WriteValue((int32_t)it->name.length());
+        file.Write(it->name.c_str(), it->name.length());
+        file.WriteValue((int32_t)0);
+        file.WriteValue((char)0);
+        file.WriteValue((unsigned char)255);
         
-        //write global flag [1 byte]
-        char global = 0;
-        file.write(&global, 1);
+        //write type name [4 bytes + typeLen]
+        const std::string& typeName = it->type == DATA_SCALAR ? octaveScalarName : octaveMatrixName;
+        file.WriteValue((int32_t)typeName.length());
+        file.Write(typeName.c_str(), typeName.length());
         
-        //write data type [1 byte]
-        unsigned char dataType = 255; //new type definition
-        file.write(reinterpret_cast<char*>(&dataType), 1);
-
-        //write data
-        switch (it->type)
+        switch(it->type)
         {
             case DATA_SCALAR:
-            {
-                //write type name [4 bytes + typeLen]
-#ifdef BT_USE_DOUBLE_PRECISION
-                std::string typeName = "scalar";
-#else
-                std::string typeName = "float scalar";
-#endif
-                int32_t typeLen = (int32_t)typeName.length();
-                file.write(reinterpret_cast<char*>(&typeLen), 4);
-                file.write(typeName.c_str(), typeLen);
+                file.WriteValue(octaveStorageType);
+                file.WriteValue((OctaveScalar)*((Scalar*)it->value));
+                break;
                 
-                //write data
-                SaveOctaveScalar(file, *it);
+            case DATA_VECTOR: //column vector
+            {
+                btVectorXu* vector = (btVectorXu*)it->value;
+                uint32_t rows = vector->size();
+                file.WriteValue((int32_t)-2);
+                file.WriteValue(rows);
+                file.WriteValue((uint32_t)1);
+                file.WriteValue(octaveStorageType);
+                if(rows > 0)
+                    file.Write(&(*vector)[0], rows * sizeof(OctaveScalar)); //Contiguous storage
             }
                 break;
                 
-            case DATA_VECTOR:
-            case DATA_MATRIX:
+            case DATA_MATRIX: //column-major
             {
-                //write type name [4 bytes + typeLen]
-#ifdef BT_USE_DOUBLE_PRECISION
-                std::string typeName = "matrix";
-#else
-                std::string typeName = "float matrix";
-#endif
-                int32_t typeLen = (int32_t)typeName.length();
-                file.write(reinterpret_cast<char*>(&typeLen), 4);
-                file.write(typeName.c_str(), typeLen);
-                
-                //write data
-                SaveOctaveMatrix(file, *it);
+                btMatrixXu* matrix = (btMatrixXu*)it->value;
+                uint32_t rows = matrix->rows();
+                uint32_t cols = matrix->cols();
+                file.WriteValue((int32_t)-2);
+                file.WriteValue(rows);
+                file.WriteValue(cols);
+                file.WriteValue(octaveStorageType);
+                column.resize(rows);
+                for(unsigned int c = 0; c < cols; ++c)
+                {
+                    for(unsigned int r = 0; r < rows; ++r)
+                        column[r] = (OctaveScalar)(*matrix)(r, c);
+                    if(rows > 0)
+                        file.Write(&column[0], rows * sizeof(OctaveScalar));
+                }
             }
                 break;
         }
     }
     
+    file.Flush();
+    bool ok = file.isOk();
+    if(fclose(f) != 0 || !ok)
+    {
+        cError("Failed to write scientific data!");
+        return false;
+    }
     return true;
 }
 
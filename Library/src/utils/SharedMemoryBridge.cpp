@@ -0,0 +1,512 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryBridge.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/SharedMemoryBridge.h"
+
+#include <cmath>
+#include <climits>
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "sensors/ScalarSensor.h"
+#include "sensors/Sample.h"
+#include "sensors/vision/ColorCamera.h"
+#include "sensors/vision/DepthCamera.h"
+#include "actuators/Thruster.h"
+#include "actuators/Propeller.h"
+#include "actuators/Rudder.h"
+#include "actuators/Motor.h"
+#include "actuators/Servo.h"
+#include "actuators/VariableBuoyancy.h"
+#include "actuators/Push.h"
+#include "actuators/SuctionCup.h"
+#if defined(__linux__) || defined(__APPLE__)
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define SHM_SUPPORTED
+    #ifdef __linux__
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+namespace sf
+{
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free, 
+              "Shared memory bridge requires lock-free atomics!");
+static_assert(sizeof(SharedMemoryHeader) == 64 && sizeof(SharedMemoryChannel) == 128 && sizeof(SharedMemorySlot) == 64,
+              "Unexpected layout of the shared memory structures!");
+
+static inline size_t PadAlign(size_t size)
+{
+    return (size + SHM_BRIDGE_ALIGN - 1) & ~(size_t)(SHM_BRIDGE_ALIGN - 1);
+}
+
+SharedMemoryBridge::SharedMemoryBridge(const std::string& name, unsigned int slotCount) 
+    : name(name), slotCount(slotCount < 2 ? 2 : slotCount)
+{
+    fd = -1;
+    segment = nullptr;
+    size = 0;
+    header = nullptr;
+    channels = nullptr;
+    opened = false;
+#ifndef SHM_SUPPORTED
+    cError("Shared memory bridge not supported on this platform!");
+#endif
+    if(SimulationApp::getApp() != nullptr)
+        SimulationApp::getApp()->getSimulationManager()->setSharedMemoryBridge(this);
+}
+
+SharedMemoryBridge::~SharedMemoryBridge()
+{
+    if(SimulationApp::getApp() != nullptr 
+       && SimulationApp::getApp()->getSimulationManager()->getSharedMemoryBridge() == this)
+        SimulationApp::getApp()->getSimulationManager()->setSharedMemoryBridge(nullptr);
+    
+#ifdef SHM_SUPPORTED
+    if(segment != nullptr)
+    {
+        munmap(segment, size);
+        close(fd);
+        shm_unlink(name.c_str());
+    }
+#endif
+}
+
+void SharedMemoryBridge::Detach()
+{
+    if(SimulationApp::getApp() != nullptr 
+       && SimulationApp::getApp()->getSimulationManager()->getSharedMemoryBridge() == this)
+        SimulationApp::getApp()->getSimulationManager()->setSharedMemoryBridge(nullptr);
+    
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        if(sources[i].object == nullptr)
+            continue;
+        if(sources[i].kind == SharedMemoryKind::OUTPUT)
+            ((ScalarSensor*)sources[i].object)->InstallNewDataHandler(nullptr);
+        else if(sources[i].kind == SharedMemoryKind::IMAGE)
+        {
+            Camera* cam = (Camera*)sources[i].object;
+            if(cam->getVisionSensorType() == VisionSensorType::COLOR_CAMERA)
+                ((ColorCamera*)cam)->InstallNewDataHandler(nullptr);
+            else
+                ((DepthCamera*)cam)->InstallNewDataHandler(nullptr);
+        }
+        sources[i].object = nullptr;
+    }
+}
+
+std::string SharedMemoryBridge::getName() const
+{
+    return name;
+}
+
+bool SharedMemoryBridge::isOpen() const
+{
+    return opened;
+}
+
+size_t SharedMemoryBridge::getSize() const
+{
+    return size;
+}
+
+int SharedMemoryBridge::AddChannel(const std::string& chName, SharedMemoryKind kind, SharedMemoryFormat format, unsigned int numValues, 
+                                   unsigned int width, unsigned int height, unsigned int slots, void* object)
+{
+    if(segment != nullptr)
+    {
+        cError("Shared memory channels have to be added before the segment is created! '%s' will not be bridged.", chName.c_str());
+        return -1;
+    }
+    if(chName.size() >= SHM_BRIDGE_NAME_LENGTH)
+        cWarning("Name of the shared memory channel '%s' will be truncated!", chName.c_str());
+    
+    Source src;
+    src.name = chName.substr(0, SHM_BRIDGE_NAME_LENGTH - 1);
+    src.kind = kind;
+    src.format = format;
+    src.numValues = numValues;
+    src.slotCount = slots;
+    src.width = width;
+    src.height = height;
+    src.slotSize = kind == SharedMemoryKind::IMAGE ? (uint64_t)width * height * numValues : (uint64_t)numValues * sizeof(double);
+    src.object = object;
+    src.lastRead = 0;
+    sources.push_back(src);
+    return (int)sources.size() - 1;
+}
+
+int SharedMemoryBridge::AddSensor(ScalarSensor* sensor)
+{
+    if(sensor->hasNewDataHandler())
+    {
+        cError("Sensor '%s' already has a data handler and will not be bridged!", sensor->getName().c_str());
+        return -1;
+    }
+    unsigned short n = sensor->getNumOfChannels();
+    int id = AddChannel(sensor->getName(), SharedMemoryKind::OUTPUT, SharedMemoryFormat::DOUBLE, n, n, 1, slotCount, sensor);
+    if(id >= 0)
+        sensor->InstallNewDataHandler([this, id](ScalarSensor* s, const Sample& sample){ PublishSample(id, sample); });
+    return id;
+}
+
+int SharedMemoryBridge::AddCamera(Camera* camera)
+{
+    unsigned int w, h;
+    camera->getResolution(w, h);
+    int id;
+    switch(camera->getVisionSensorType())
+    {
+        case VisionSensorType::COLOR_CAMERA:
+            if(((ColorCamera*)camera)->hasNewDataHandler())
+                break;
+            id = AddChannel(camera->getName(), SharedMemoryKind::IMAGE, SharedMemoryFormat::RGB8, 3, w, h, slotCount, camera);
+            if(id >= 0)
+                ((ColorCamera*)camera)->InstallNewDataHandler([this, id](ColorCamera* c){ PublishFrame(id, c); });
+            return id;
+            
+        case VisionSensorType::DEPTH_CAMERA:
+            if(((DepthCamera*)camera)->hasNewDataHandler())
+                break;
+            id = AddChannel(camera->getName(), SharedMemoryKind::IMAGE, SharedMemoryFormat::FLOAT32, sizeof(float), w, h, slotCount, camera);
+            if(id >= 0)
+                ((DepthCamera*)camera)->InstallNewDataHandler([this, id](DepthCamera* c){ PublishFrame(id, c); });
+            return id;
+            
+        default:
+            cError("Shared memory bridge supports only color and depth cameras! '%s' will not be bridged.", camera->getName().c_str());
+            return -1;
+    }
+    cError("Camera '%s' already has a data handler and will not be bridged!", camera->getName().c_str());
+    return -1;
+}
+
+int SharedMemoryBridge::AddActuator(Actuator* actuator)
+{
+    unsigned int numValues;
+    switch(actuator->getType())
+    {
+        case ActuatorType::SERVO:
+            numValues = 4;
+            break;
+            
+        case ActuatorType::THRUSTER:
+        case ActuatorType::PROPELLER:
+        case ActuatorType::RUDDER:
+        case ActuatorType::MOTOR:
+        case ActuatorType::VBS:
+        case ActuatorType::PUSH:
+        case ActuatorType::SUCTION_CUP:
+            numValues = 1;
+            break;
+            
+        default:
+            cError("Shared memory bridge does not support the type of actuator '%s'!", actuator->getName().c_str());
+            return -1;
+    }
+    return AddChannel(actuator->getName(), SharedMemoryKind::INPUT, SharedMemoryFormat::DOUBLE, numValues, numValues, 1, 1, actuator);
+}
+
+int SharedMemoryBridge::AddOutput(const std::string& chName, unsigned int numValues)
+{
+    return AddChannel(chName, SharedMemoryKind::OUTPUT, SharedMemoryFormat::DOUBLE, numValues, numValues, 1, slotCount, nullptr);
+}
+
+int SharedMemoryBridge::AddInput(const std::string& chName, unsigned int numValues)
+{
+    return AddChannel(chName, SharedMemoryKind::INPUT, SharedMemoryFormat::DOUBLE, numValues, numValues, 1, 1, nullptr);
+}
+
+void SharedMemoryBridge::AddAll()
+{
+    if(SimulationApp::getApp() == nullptr)
+        return;
+    SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+    
+    Sensor* sens;
+    for(unsigned int i=0; (sens = sm->getSensor(i)) != nullptr; ++i)
+    {
+        if(sens->getType() != SensorType::VISION)
+            AddSensor((ScalarSensor*)sens);
+        else
+        {
+            VisionSensorType vt = ((VisionSensor*)sens)->getVisionSensorType();
+            if(vt == VisionSensorType::COLOR_CAMERA || vt == VisionSensorType::DEPTH_CAMERA)
+                AddCamera((Camera*)sens);
+        }
+    }
+    
+    Actuator* act;
+    for(unsigned int i=0; (act = sm->getActuator(i)) != nullptr; ++i)
+        if(act->getType() != ActuatorType::LIGHT)
+            AddActuator(act);
+}
+
+bool SharedMemoryBridge::Open()
+{
+    if(segment != nullptr)
+        return true;
+#ifdef SHM_SUPPORTED
+    //Compute layout
+    std::vector<uint64_t> offsets(sources.size());
+    size_t offset = PadAlign(sizeof(SharedMemoryHeader)) + PadAlign(sizeof(SharedMemoryChannel) * sources.size());
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        offsets[i] = offset;
+        offset += (sizeof(SharedMemorySlot) + PadAlign(sources[i].slotSize)) * sources[i].slotCount;
+    }
+    
+    //Create segment
+    shm_unlink(name.c_str()); //Remove stale segment
+    fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0)
+    {
+        cError("Shared memory bridge could not create '%s'!", name.c_str());
+        return false;
+    }
+    if(ftruncate(fd, (off_t)offset) != 0)
+    {
+        cError("Shared memory bridge could not allocate %lu bytes!", (unsigned long)offset);
+        close(fd);
+        shm_unlink(name.c_str());
+        fd = -1;
+        return false;
+    }
+    void* ptr = mmap(NULL, offset, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(ptr == MAP_FAILED)
+    {
+        cError("Shared memory bridge could not map '%s'!", name.c_str());
+        close(fd);
+        shm_unlink(name.c_str());
+        fd = -1;
+        return false;
+    }
+    segment = (uint8_t*)ptr; //Zero filled
+    size = offset;
+    
+    //Write descriptors
+    channels = (SharedMemoryChannel*)(segment + PadAlign(sizeof(SharedMemoryHeader)));
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        SharedMemoryChannel& ch = channels[i];
+        strncpy(ch.name, sources[i].name.c_str(), SHM_BRIDGE_NAME_LENGTH - 1);
+        ch.kind = (uint8_t)sources[i].kind;
+        ch.format = (uint8_t)sources[i].format;
+        ch.numValues = (uint16_t)sources[i].numValues;
+        ch.slotCount = sources[i].slotCount;
+        ch.width = sources[i].width;
+        ch.height = sources[i].height;
+        ch.slotSize = sources[i].slotSize;
+        ch.offset = offsets[i];
+    }
+    header = (SharedMemoryHeader*)segment;
+    header->version = SHM_BRIDGE_VERSION;
+    header->numChannels = (uint32_t)sources.size();
+    header->size = size;
+    header->writerPid = (uint32_t)getpid();
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(header->magic, SHM_BRIDGE_MAGIC, 8); //Readers check the magic last
+    opened.store(true, std::memory_order_release);
+    cInfo("Shared memory bridge '%s' created (%lu channels, %.1lf kB).", name.c_str(), (unsigned long)sources.size(), size/1024.0);
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint8_t* SharedMemoryBridge::BeginWrite(int channel, Scalar time, size_t dataSize)
+{
+    if(!opened.load(std::memory_order_acquire) || channel < 0 || channel >= (int)sources.size())
+        return nullptr;
+    SharedMemoryChannel& ch = channels[channel];
+    uint64_t n = ch.writeCount.load(std::memory_order_relaxed);
+    size_t stride = sizeof(SharedMemorySlot) + PadAlign(ch.slotSize);
+    SharedMemorySlot* slot = (SharedMemorySlot*)(segment + ch.offset + stride * (n % ch.slotCount));
+    slot->seq.store(2*n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); //Seq is odd before payload changes
+    slot->time = (double)time;
+    slot->size = dataSize < ch.slotSize ? dataSize : ch.slotSize;
+    return (uint8_t*)slot + sizeof(SharedMemorySlot);
+}
+
+void SharedMemoryBridge::EndWrite(int channel)
+{
+    SharedMemoryChannel& ch = channels[channel];
+    uint64_t n = ch.writeCount.load(std::memory_order_relaxed);
+    size_t stride = sizeof(SharedMemorySlot) + PadAlign(ch.slotSize);
+    SharedMemorySlot* slot = (SharedMemorySlot*)(segment + ch.offset + stride * (n % ch.slotCount));
+    slot->seq.store(2*n + 2, std::memory_order_release);
+    ch.writeCount.store(n + 1, std::memory_order_release);
+}
+
+void SharedMemoryBridge::Publish(int channel, Scalar time, const double* values)
+{
+    if(channel < 0 || channel >= (int)sources.size() || sources[channel].kind != SharedMemoryKind::OUTPUT)
+        return;
+    uint8_t* dst = BeginWrite(channel, time, sources[channel].slotSize);
+    if(dst == nullptr)
+        return;
+    memcpy(dst, values, sources[channel].slotSize);
+    EndWrite(channel);
+}
+
+void SharedMemoryBridge::PublishSample(int channel, const Sample& s)
+{
+    unsigned short n = s.getNumOfDimensions();
+    double* dst = (double*)BeginWrite(channel, s.getTimestamp(), n * sizeof(double));
+    if(dst == nullptr)
+        return;
+    unsigned int m = std::min((unsigned int)n, sources[channel].numValues);
+    for(unsigned short i=0; i<m; ++i)
+        dst[i] = (double)s.getValue(i); //Written directly to the ring
+    EndWrite(channel);
+}
+
+void SharedMemoryBridge::PublishFrame(int channel, Camera* camera)
+{
+    uint8_t* dst = BeginWrite(channel, camera->getFrameTimeStamp(), sources[channel].slotSize);
+    if(dst == nullptr)
+        return;
+    memcpy(dst, camera->getImageDataPointer(), sources[channel].slotSize); //Single copy from the mapped readback buffer
+    EndWrite(channel);
+    Notify();
+}
+
+bool SharedMemoryBridge::Receive(int channel, double* values)
+{
+    if(!opened.load(std::memory_order_acquire) || channel < 0 || channel >= (int)sources.size() 
+       || sources[channel].kind != SharedMemoryKind::INPUT)
+        return false;
+    
+    SharedMemoryChannel& ch = channels[channel];
+    uint64_t n = ch.writeCount.load(std::memory_order_acquire);
+    if(n == sources[channel].lastRead)
+        return false;
+    
+    SharedMemorySlot* slot = (SharedMemorySlot*)(segment + ch.offset);
+    uint64_t seq = slot->seq.load(std::memory_order_acquire);
+    if(seq & 1)
+        return false; //Being written -> try at the next step
+    memcpy(values, (uint8_t*)slot + sizeof(SharedMemorySlot), ch.slotSize);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(slot->seq.load(std::memory_order_relaxed) != seq)
+        return false;
+    sources[channel].lastRead = n;
+    return true;
+}
+
+void SharedMemoryBridge::Notify()
+{
+    if(!opened.load(std::memory_order_acquire))
+        return;
+    header->notify.fetch_add(1); //Sequentially consistent with the waiters counter (no lost wake-ups)
+#ifdef __linux__
+    if(header->waiters.load() > 0)
+        syscall(SYS_futex, (uint32_t*)&header->notify, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+void SharedMemoryBridge::StepStarted()
+{
+    if(!opened.load(std::memory_order_relaxed))
+        return; //Open has to be called before the simulation is started
+    
+    double values[4];
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        if(sources[i].kind != SharedMemoryKind::INPUT || sources[i].object == nullptr || !Receive((int)i, values))
+            continue;
+        
+        Actuator* act = (Actuator*)sources[i].object;
+        if(act->getType() != ActuatorType::SERVO && std::isnan(values[0]))
+            continue;
+        switch(act->getType())
+        {
+            case ActuatorType::THRUSTER:
+                ((Thruster*)act)->setSetpoint((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::PROPELLER:
+                ((Propeller*)act)->setSetpoint((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::RUDDER:
+                ((Rudder*)act)->setSetpoint((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::MOTOR:
+                ((Motor*)act)->setIntensity((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::VBS:
+                ((VariableBuoyancy*)act)->setFlowRate((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::PUSH:
+                ((Push*)act)->setForce((Scalar)values[0]);
+                break;
+                
+            case ActuatorType::SUCTION_CUP:
+                ((SuctionCup*)act)->setPump(values[0] != 0.0);
+                break;
+                
+            case ActuatorType::SERVO:
+            {
+                Servo* srv = (Servo*)act;
+                if(!std::isnan(values[3]))
+                    srv->setControlMode((ServoControlMode)btClamped((int)values[3], 0, 2));
+                if(!std::isnan(values[2]))
+                    srv->setMaxTorque((Scalar)values[2]);
+                if(!std::isnan(values[1]))
+                    srv->setDesiredVelocity((Scalar)values[1]);
+                if(!std::isnan(values[0]))
+                    srv->setDesiredPosition((Scalar)values[0]);
+            }
+                break;
+                
+            default:
+                break;
+        }
+    }
+}
+
+void SharedMemoryBridge::StepCompleted(Scalar time)
+{
+    if(!opened.load(std::memory_order_relaxed))
+        return;
+    double t = (double)time;
+    uint64_t bits;
+    memcpy(&bits, &t, sizeof(bits));
+    header->time.store(bits, std::memory_order_relaxed);
+    header->steps.fetch_add(1, std::memory_order_release);
+    Notify(); //Once per step for all sensor samples
+}
+
+}
@@ -0,0 +1,256 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SharedMemoryClient.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/SharedMemoryClient.h"
+
+#include <climits>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#if defined(__linux__) || defined(__APPLE__)
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define SHM_SUPPORTED
+    #ifdef __linux__
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+        #include <time.h>
+    #endif
+#endif
+
+namespace sf
+{
+
+static inline size_t PadAlign(size_t size)
+{
+    return (size + SHM_BRIDGE_ALIGN - 1) & ~(size_t)(SHM_BRIDGE_ALIGN - 1);
+}
+
+SharedMemoryClient::SharedMemoryClient() : segment(nullptr), size(0), header(nullptr), channels(nullptr)
+{
+}
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+    Close();
+}
+
+bool SharedMemoryClient::Open(const std::string& name)
+{
+    Close();
+#ifdef SHM_SUPPORTED
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SharedMemoryHeader))
+    {
+        close(fd);
+        return false;
+    }
+    void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd); //Mapping stays valid
+    if(ptr == MAP_FAILED)
+        return false;
+    segment = (uint8_t*)ptr;
+    size = (size_t)st.st_size;
+    header = (SharedMemoryHeader*)segment;
+    
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(memcmp(header->magic, SHM_BRIDGE_MAGIC, 8) != 0 || header->version != SHM_BRIDGE_VERSION || header->size != size
+       || PadAlign(sizeof(SharedMemoryHeader)) + sizeof(SharedMemoryChannel) * header->numChannels > size)
+    {
+        Close();
+        return false;
+    }
+    channels = (SharedMemoryChannel*)(segment + PadAlign(sizeof(SharedMemoryHeader)));
+    for(uint32_t i=0; i<header->numChannels; ++i)
+    {
+        const SharedMemoryChannel& ch = channels[i];
+        if(ch.slotCount == 0 || ch.offset + (sizeof(SharedMemorySlot) + PadAlign(ch.slotSize)) * ch.slotCount > size)
+        {
+            Close();
+            return false;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SharedMemoryClient::Close()
+{
+#ifdef SHM_SUPPORTED
+    if(segment != nullptr)
+        munmap(segment, size);
+#endif
+    segment = nullptr;
+    size = 0;
+    header = nullptr;
+    channels = nullptr;
+}
+
+bool SharedMemoryClient::isOpen() const
+{
+    return segment != nullptr;
+}
+
+unsigned int SharedMemoryClient::getNumOfChannels() const
+{
+    return header != nullptr ? header->numChannels : 0;
+}
+
+int SharedMemoryClient::getChannelIndex(const std::string& name) const
+{
+    for(unsigned int i=0; i<getNumOfChannels(); ++i)
+        if(strncmp(channels[i].name, name.c_str(), SHM_BRIDGE_NAME_LENGTH) == 0)
+            return (int)i;
+    return -1;
+}
+
+const SharedMemoryChannel* SharedMemoryClient::getChannel(int channel) const
+{
+    if(channel < 0 || channel >= (int)getNumOfChannels())
+        return nullptr;
+    return &channels[channel];
+}
+
+SharedMemorySlot* SharedMemoryClient::getSlot(int channel, uint64_t index) const
+{
+    const SharedMemoryChannel& ch = channels[channel];
+    size_t stride = sizeof(SharedMemorySlot) + PadAlign(ch.slotSize);
+    return (SharedMemorySlot*)(segment + ch.offset + stride * (index % ch.slotCount));
+}
+
+uint64_t SharedMemoryClient::getWriteCount(int channel) const
+{
+    const SharedMemoryChannel* ch = getChannel(channel);
+    return ch != nullptr ? ch->writeCount.load(std::memory_order_acquire) : 0;
+}
+
+const uint8_t* SharedMemoryClient::BeginRead(int channel, uint64_t& seq, double* time) const
+{
+    uint64_t n = getWriteCount(channel);
+    if(n == 0)
+        return nullptr;
+    SharedMemorySlot* slot = getSlot(channel, n - 1);
+    seq = slot->seq.load(std::memory_order_acquire);
+    if(seq != 2*(n - 1) + 2)
+        return nullptr; //Overwritten already
+    if(time != nullptr)
+        *time = slot->time;
+    return (const uint8_t*)slot + sizeof(SharedMemorySlot);
+}
+
+bool SharedMemoryClient::EndRead(int channel, uint64_t seq) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    SharedMemorySlot* slot = getSlot(channel, (seq - 2)/2);
+    return slot->seq.load(std::memory_order_relaxed) == seq;
+}
+
+bool SharedMemoryClient::Read(int channel, void* dst, double* time) const
+{
+    for(int attempt=0; attempt<4; ++attempt)
+    {
+        uint64_t seq;
+        const uint8_t* src = BeginRead(channel, seq, time);
+        if(src == nullptr)
+        {
+            if(getWriteCount(channel) == 0)
+                return false;
+            continue;
+        }
+        memcpy(dst, src, channels[channel].slotSize);
+        if(EndRead(channel, seq))
+            return true;
+    }
+    return false;
+}
+
+bool SharedMemoryClient::WriteInput(int channel, const double* values)
+{
+    const SharedMemoryChannel* desc = getChannel(channel);
+    if(desc == nullptr || desc->kind != (uint8_t)SharedMemoryKind::INPUT)
+        return false;
+    SharedMemoryChannel& ch = channels[channel];
+    uint64_t n = ch.writeCount.load(std::memory_order_relaxed);
+    SharedMemorySlot* slot = getSlot(channel, 0);
+    slot->seq.store(2*n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy((uint8_t*)slot + sizeof(SharedMemorySlot), values, ch.slotSize);
+    slot->size = ch.slotSize;
+    slot->seq.store(2*n + 2, std::memory_order_release);
+    ch.writeCount.store(n + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t SharedMemoryClient::getNotifyCounter() const
+{
+    return header != nullptr ? header->notify.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedMemoryClient::Wait(uint32_t lastNotify, int timeout)
+{
+    if(header == nullptr)
+        return false;
+    if(header->notify.load(std::memory_order_acquire) != lastNotify)
+        return true;
+    
+#ifdef __linux__
+    header->waiters.fetch_add(1);
+    timespec ts;
+    ts.tv_sec = timeout/1000;
+    ts.tv_nsec = (timeout % 1000) * 1000000L;
+    //Returns immediately if the counter changed after the check above
+    syscall(SYS_futex, (uint32_t*)&header->notify, FUTEX_WAIT, lastNotify, &ts, NULL, 0);
+    header->waiters.fetch_sub(1);
+#else
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    while(header->notify.load(std::memory_order_acquire) == lastNotify && std::chrono::steady_clock::now() < end)
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+    return header->notify.load(std::memory_order_acquire) != lastNotify;
+}
+
+uint64_t SharedMemoryClient::getSteps() const
+{
+    return header != nullptr ? header->steps.load(std::memory_order_acquire) : 0;
+}
+
+double SharedMemoryClient::getSimulationTime() const
+{
+    if(header == nullptr)
+        return 0.0;
+    uint64_t bits = header->time.load(std::memory_order_acquire);
+    double t;
+    memcpy(&t, &bits, sizeof(t));
+    return t;
+}
+
+}
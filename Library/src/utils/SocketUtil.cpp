@@ -0,0 +1,269 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  SocketUtil.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/SocketUtil.h"
+
+#include <cstring>
+#if defined(__linux__) || defined(__APPLE__)
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <arpa/inet.h>
+    #define LOCAL_SOCKETS
+    #ifdef __APPLE__
+        #define SEND_FLAGS 0
+    #else
+        #define SEND_FLAGS MSG_NOSIGNAL
+    #endif
+#endif
+
+#define LISTEN_BACKLOG 8
+
+namespace sf
+{
+
+bool SocketsSupported()
+{
+#ifdef LOCAL_SOCKETS
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef LOCAL_SOCKETS
+static void ConfigureSocket(int s)
+{
+#ifdef __APPLE__
+    int noSigPipe = 1;
+    setsockopt(s, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#else
+    (void)s;
+#endif
+}
+
+static bool MakeLoopbackAddress(uint16_t port, sockaddr_in& addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return true;
+}
+
+static bool MakeUnixAddress(const std::string& path, sockaddr_un& addr)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(addr.sun_path))
+        return false;
+    strcpy(addr.sun_path, path.c_str());
+    return true;
+}
+#endif
+
+int OpenServerSocket(uint16_t port)
+{
+#ifdef LOCAL_SOCKETS
+    sockaddr_in addr;
+    MakeLoopbackAddress(port, addr);
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if(s < 0)
+        return -1;
+    int reuse = 1;
+    setsockopt(s, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if(bind(s, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, LISTEN_BACKLOG) != 0)
+    {
+        close(s);
+        return -1;
+    }
+    return s;
+#else
+    return -1;
+#endif
+}
+
+int OpenServerSocket(const std::string& path)
+{
+#ifdef LOCAL_SOCKETS
+    sockaddr_un addr;
+    if(!MakeUnixAddress(path, addr))
+        return -1;
+    unlink(path.c_str()); //Remove stale socket
+    int s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(s < 0)
+        return -1;
+    if(bind(s, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, LISTEN_BACKLOG) != 0)
+    {
+        close(s);
+        return -1;
+    }
+    return s;
+#else
+    return -1;
+#endif
+}
+
+int ConnectSocket(uint16_t port)
+{
+#ifdef LOCAL_SOCKETS
+    sockaddr_in addr;
+    MakeLoopbackAddress(port, addr);
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if(s < 0)
+        return -1;
+    if(connect(s, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        close(s);
+        return -1;
+    }
+    int noDelay = 1; //Requests are small and latency matters
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    ConfigureSocket(s);
+    return s;
+#else
+    return -1;
+#endif
+}
+
+int ConnectSocket(const std::string& path)
+{
+#ifdef LOCAL_SOCKETS
+    sockaddr_un addr;
+    if(!MakeUnixAddress(path, addr))
+        return -1;
+    int s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(s < 0)
+        return -1;
+    if(connect(s, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        close(s);
+        return -1;
+    }
+    ConfigureSocket(s);
+    return s;
+#else
+    return -1;
+#endif
+}
+
+int AcceptConnection(int serverSocket, int timeout)
+{
+#ifdef LOCAL_SOCKETS
+    if(!WaitForData(serverSocket, timeout))
+        return -1;
+    int s = accept(serverSocket, NULL, NULL);
+    if(s < 0)
+        return -1;
+    int noDelay = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)); //Fails silently for Unix sockets
+    ConfigureSocket(s);
+    return s;
+#else
+    return -1;
+#endif
+}
+
+bool WaitForData(int socket, int timeout)
+{
+#ifdef LOCAL_SOCKETS
+    pollfd pfd;
+    pfd.fd = socket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, timeout) > 0 && (pfd.revents & (POLLIN | POLLHUP | POLLERR));
+#else
+    return false;
+#endif
+}
+
+void SetSocketTimeout(int socket, int timeout)
+{
+#ifdef LOCAL_SOCKETS
+    timeval tv;
+    tv.tv_sec = timeout/1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#endif
+}
+
+bool SendAll(int socket, const void* data, size_t size)
+{
+#ifdef LOCAL_SOCKETS
+    const char* ptr = (const char*)data;
+    while(size > 0)
+    {
+        ssize_t n = send(socket, ptr, size, SEND_FLAGS);
+        if(n <= 0)
+            return false;
+        ptr += n;
+        size -= (size_t)n;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ReceiveAll(int socket, void* data, size_t size)
+{
+#ifdef LOCAL_SOCKETS
+    char* ptr = (char*)data;
+    while(size > 0)
+    {
+        ssize_t n = recv(socket, ptr, size, 0);
+        if(n <= 0)
+            return false;
+        ptr += n;
+        size -= (size_t)n;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+int64_t ReceiveSome(int socket, void* data, size_t size)
+{
+#ifdef LOCAL_SOCKETS
+    return (int64_t)recv(socket, data, size, 0);
+#else
+    return -1;
+#endif
+}
+
+void CloseSocket(int socket)
+{
+#ifdef LOCAL_SOCKETS
+    if(socket >= 0)
+        close(socket);
+#endif
+}
+
+}
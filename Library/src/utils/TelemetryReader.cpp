@@ -0,0 +1,300 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TelemetryReader.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/TelemetryReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include "utils/ScientificFileUtil.h"
+
+namespace sf
+{
+
+TelemetryReader::TelemetryReader(const std::string& path)
+{
+    data = nullptr;
+    size = 0;
+    chunksOffset = 0;
+    recovered = false;
+    
+    file = new MappedFile(path);
+    if(!file->isOpen() || file->getSize() < sizeof(TelemetryFileHeader))
+        return;
+    data = file->getData();
+    size = file->getSize();
+    if(!ParseSchema())
+    {
+        data = nullptr;
+        size = 0;
+        return;
+    }
+    LoadIndex();
+}
+
+TelemetryReader::~TelemetryReader()
+{
+    delete file;
+}
+
+bool TelemetryReader::isOpen() const
+{
+    return data != nullptr;
+}
+
+bool TelemetryReader::isRecovered() const
+{
+    return recovered;
+}
+
+size_t TelemetryReader::getNumOfChunks() const
+{
+    return index.size();
+}
+
+const std::vector<TelemetryChannel>& TelemetryReader::getChannels() const
+{
+    return channels;
+}
+
+int TelemetryReader::getChannelId(const std::string& name) const
+{
+    for(size_t i=0; i<channels.size(); ++i)
+        if(channels[i].name == name)
+            return channels[i].id;
+    return -1;
+}
+
+void TelemetryReader::getTimeRange(double& start, double& end) const
+{
+    start = end = 0.0;
+    if(index.empty())
+        return;
+    start = index.front().startTime;
+    end = index.back().endTime;
+}
+
+bool TelemetryReader::ParseSchema()
+{
+    const TelemetryFileHeader* header = (const TelemetryFileHeader*)data;
+    if(memcmp(header->magic, TELEMETRY_FILE_MAGIC, 8) != 0 || header->version != TELEMETRY_VERSION
+       || sizeof(TelemetryFileHeader) + header->schemaSize > size)
+        return false;
+    
+    const char* ptr = data + sizeof(TelemetryFileHeader);
+    const char* end = ptr + header->schemaSize;
+    auto readU16 = [&ptr, end](uint16_t& v) -> bool
+    {
+        if(ptr + 2 > end) return false;
+        memcpy(&v, ptr, 2);
+        ptr += 2;
+        return true;
+    };
+    auto readString = [&ptr, end, &readU16](std::string& s) -> bool
+    {
+        uint16_t len;
+        if(!readU16(len) || ptr + len > end) return false;
+        s = std::string(ptr, len);
+        ptr += len;
+        return true;
+    };
+    
+    for(uint32_t i=0; i<header->numChannels; ++i)
+    {
+        TelemetryChannel ch;
+        uint16_t numValues;
+        if(!readU16(ch.id) || ptr + 2 > end)
+            return false;
+        ch.kind = (TelemetryKind)(uint8_t)ptr[0];
+        ptr += 2;
+        if(!readU16(numValues) || !readString(ch.name))
+            return false;
+        ch.valueNames.resize(numValues);
+        for(uint16_t h=0; h<numValues; ++h)
+            if(!readString(ch.valueNames[h]))
+                return false;
+        channels.push_back(ch);
+    }
+    
+    chunksOffset = sizeof(TelemetryFileHeader) + header->schemaSize;
+    return true;
+}
+
+void TelemetryReader::LoadIndex()
+{
+    //Try the index written at the end of recording
+    if(size >= chunksOffset + sizeof(TelemetryFileFooter))
+    {
+        const TelemetryFileFooter* footer = (const TelemetryFileFooter*)(data + size - sizeof(TelemetryFileFooter));
+        if(memcmp(footer->magic, TELEMETRY_INDEX_MAGIC, 8) == 0
+           && footer->indexOffset + footer->numChunks * sizeof(TelemetryIndexEntry) + sizeof(TelemetryFileFooter) == size)
+        {
+            const TelemetryIndexEntry* entries = (const TelemetryIndexEntry*)(data + footer->indexOffset);
+            index.assign(entries, entries + footer->numChunks);
+            return;
+        }
+    }
+    
+    //Rebuild by scanning the chunks
+    recovered = true;
+    uint64_t offset = chunksOffset;
+    while(offset + sizeof(TelemetryChunkHeader) <= size)
+    {
+        const TelemetryChunkHeader* ch = (const TelemetryChunkHeader*)(data + offset);
+        if(memcmp(ch->magic, TELEMETRY_CHUNK_MAGIC, 4) != 0 || offset + sizeof(TelemetryChunkHeader) + ch->size > size)
+            break;
+        TelemetryIndexEntry entry;
+        entry.offset = offset;
+        entry.size = sizeof(TelemetryChunkHeader) + ch->size;
+        entry.startTime = ch->startTime;
+        entry.endTime = ch->endTime;
+        entry.channelMask = ch->channelMask;
+        entry.numRecords = ch->numRecords;
+        entry.reserved = 0;
+        index.push_back(entry);
+        offset += entry.size;
+    }
+}
+
+size_t TelemetryReader::ForEachRecord(int channel, double startTime, double endTime, std::function<bool(const TelemetryRecord&)> callback) const
+{
+    if(data == nullptr)
+        return 0;
+    
+    //Chunks are written in time order -> skip all chunks ending before the range
+    auto it = std::lower_bound(index.begin(), index.end(), startTime, 
+                               [](const TelemetryIndexEntry& e, double t){ return e.endTime < t; });
+    uint64_t mask = channel >= 0 ? TelemetryChannelBit((unsigned int)channel) : ~(uint64_t)0;
+    size_t count = 0;
+    
+    for(; it != index.end() && it->startTime <= endTime; ++it)
+    {
+        if((it->channelMask & mask) == 0)
+            continue;
+        
+        const char* ptr = data + it->offset + sizeof(TelemetryChunkHeader);
+        const char* end = data + it->offset + it->size;
+        for(uint32_t i=0; i<it->numRecords && ptr + sizeof(TelemetryRecordHeader) <= end; ++i)
+        {
+            const TelemetryRecordHeader* rh = (const TelemetryRecordHeader*)ptr;
+            const char* payload = ptr + sizeof(TelemetryRecordHeader);
+            ptr = payload + rh->size;
+            if(ptr > end)
+                break;
+            if((channel >= 0 && rh->channel != channel) || rh->time < startTime || rh->time > endTime)
+                continue;
+            
+            TelemetryRecord rec;
+            rec.channel = rh->channel;
+            rec.kind = (TelemetryKind)rh->kind;
+            rec.flags = rh->flags;
+            rec.time = rh->time;
+            rec.values = nullptr;
+            rec.numValues = 0;
+            rec.comm = nullptr;
+            rec.data = nullptr;
+            if(rec.kind == TelemetryKind::COMM)
+            {
+                rec.comm = (const TelemetryCommEvent*)payload;
+                rec.data = payload + sizeof(TelemetryCommEvent);
+            }
+            else
+            {
+                rec.values = (const double*)payload;
+                rec.numValues = rh->channel < channels.size() ? (unsigned int)channels[rh->channel].valueNames.size() : rh->size/sizeof(double);
+            }
+            
+            ++count;
+            if(!callback(rec))
+                return count;
+        }
+    }
+    return count;
+}
+
+std::vector<TelemetryRecord> TelemetryReader::getRecords(int channel, double startTime, double endTime) const
+{
+    std::vector<TelemetryRecord> records;
+    ForEachRecord(channel, startTime, endTime, [&records](const TelemetryRecord& r){ records.push_back(r); return true; });
+    return records;
+}
+
+bool TelemetryReader::FindRecord(int channel, double time, TelemetryRecord& record) const
+{
+    bool found = false;
+    ForEachRecord(channel, time, BT_LARGE_FLOAT, [&record, &found](const TelemetryRecord& r){ record = r; found = true; return false; });
+    return found;
+}
+
+bool TelemetryReader::ExportToOctaveFile(const std::string& path, const std::vector<std::string>& names) const
+{
+    if(data == nullptr)
+        return false;
+    
+    ScientificData sdata("");
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        const TelemetryChannel& ch = channels[i];
+        if(!names.empty() && std::find(names.begin(), names.end(), ch.name) == names.end())
+            continue;
+        
+        std::vector<TelemetryRecord> records = getRecords(ch.id);
+        if(records.empty())
+            continue;
+        
+        unsigned int cols = ch.kind == TelemetryKind::COMM ? 7 : 1 + (unsigned int)ch.valueNames.size();
+        ScientificDataItem* it = new ScientificDataItem();
+        it->name = ch.name;
+        it->type = DATA_MATRIX;
+        btMatrixXu* matrix = new btMatrixXu((unsigned int)records.size(), cols);
+        it->value = matrix;
+        
+        for(unsigned int r = 0; r < records.size(); ++r)
+        {
+            const TelemetryRecord& rec = records[r];
+            matrix->setElem(r, 0, rec.time);
+            if(rec.kind == TelemetryKind::COMM)
+            {
+                matrix->setElem(r, 1, (Scalar)(rec.flags & 1));
+                matrix->setElem(r, 2, (Scalar)rec.comm->seq);
+                matrix->setElem(r, 3, (Scalar)rec.comm->source);
+                matrix->setElem(r, 4, (Scalar)rec.comm->destination);
+                matrix->setElem(r, 5, rec.comm->frameTime);
+                matrix->setElem(r, 6, (Scalar)rec.comm->dataLength);
+            }
+            else
+            {
+                for(unsigned int h = 0; h < rec.numValues && h + 1 < cols; ++h)
+                    matrix->setElem(r, h + 1, rec.values[h]);
+            }
+        }
+        sdata.addItem(it);
+    }
+    
+    if(sdata.getItemsCount() == 0)
+        return false;
+    return SaveOctaveData(path, sdata);
+}
+
+}
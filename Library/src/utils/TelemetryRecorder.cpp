@@ -0,0 +1,590 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  TelemetryRecorder.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/TelemetryRecorder.h"
+
+#include "core/SimulationApp.h"
+#include "core/SimulationManager.h"
+#include "entities/MovingEntity.h"
+#include "entities/FeatherstoneEntity.h"
+#include "sensors/ScalarSensor.h"
+#include "sensors/Sample.h"
+#include "actuators/Thruster.h"
+#include "actuators/Propeller.h"
+#include "actuators/Rudder.h"
+#include "actuators/Servo.h"
+#include "comms/Comm.h"
+
+namespace sf
+{
+
+static inline size_t Pad8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+template<typename T> static void WriteValue(FILE* f, const T& value, uint64_t& offset)
+{
+    fwrite(&value, sizeof(T), 1, f);
+    offset += sizeof(T);
+}
+
+TelemetryRecorder::TelemetryRecorder(const std::string& path, size_t chunkSize, unsigned int queueCapacity, Scalar chunkDuration)
+    : path(path), chunkSize(Pad8(chunkSize < 4096 ? 4096 : chunkSize)), queueCapacity(queueCapacity < 2 ? 2 : queueCapacity), chunkDuration(chunkDuration)
+{
+    stateInterval = Scalar(0);
+    lastStateTime = Scalar(-1);
+    started = false;
+    current = nullptr;
+    allocatedChunks = 0;
+    busy = 0;
+    stop = false;
+    writer = nullptr;
+    fileOffset = 0;
+    captureMutex = SDL_CreateMutex();
+    queueMutex = SDL_CreateMutex();
+    chunkAvailable = SDL_CreateCond();
+    chunksDone = SDL_CreateCond();
+    
+    file = fopen(path.c_str(), "wb");
+    if(file == nullptr)
+    {
+        cError("Telemetry recorder could not open '%s' for writing!", path.c_str());
+        return;
+    }
+    
+    writer = SDL_CreateThread(TelemetryRecorder::RunWriter, "telemetryRecorder", this);
+    if(SimulationApp::getApp() != nullptr)
+        SimulationApp::getApp()->getSimulationManager()->setTelemetryRecorder(this);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+    if(SimulationApp::getApp() != nullptr 
+       && SimulationApp::getApp()->getSimulationManager()->getTelemetryRecorder() == this)
+        SimulationApp::getApp()->getSimulationManager()->setTelemetryRecorder(nullptr);
+    
+    if(file != nullptr)
+    {
+        //Writer drains the queue before quitting
+        SDL_LockMutex(captureMutex);
+        SubmitChunk();
+        SDL_UnlockMutex(captureMutex);
+        SDL_LockMutex(queueMutex);
+        stop = true;
+        SDL_CondSignal(chunkAvailable);
+        SDL_UnlockMutex(queueMutex);
+        SDL_WaitThread(writer, NULL);
+        
+        if(!started)
+            WriteSchema();
+        
+        TelemetryFileFooter footer;
+        footer.indexOffset = fileOffset;
+        footer.numChunks = index.size();
+        memcpy(footer.magic, TELEMETRY_INDEX_MAGIC, 8);
+        if(!index.empty())
+            fwrite(&index[0], sizeof(TelemetryIndexEntry), index.size(), file);
+        fwrite(&footer, sizeof(footer), 1, file);
+        fclose(file);
+    }
+    
+    if(current != nullptr)
+        delete current;
+    for(size_t i=0; i<freeChunks.size(); ++i)
+        delete freeChunks[i];
+    
+    SDL_DestroyCond(chunkAvailable);
+    SDL_DestroyCond(chunksDone);
+    SDL_DestroyMutex(queueMutex);
+    SDL_DestroyMutex(captureMutex);
+}
+
+void TelemetryRecorder::Detach()
+{
+    if(SimulationApp::getApp() != nullptr 
+       && SimulationApp::getApp()->getSimulationManager()->getTelemetryRecorder() == this)
+        SimulationApp::getApp()->getSimulationManager()->setTelemetryRecorder(nullptr);
+    
+    SDL_LockMutex(captureMutex);
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        if(sources[i].object == nullptr)
+            continue;
+        if(sources[i].channel.kind == TelemetryKind::SENSOR)
+            ((ScalarSensor*)sources[i].object)->InstallNewDataHandler(nullptr);
+        else if(sources[i].channel.kind == TelemetryKind::COMM)
+            ((Comm*)sources[i].object)->InstallEventHandler(nullptr);
+        sources[i].object = nullptr;
+    }
+    SDL_UnlockMutex(captureMutex);
+}
+
+bool TelemetryRecorder::isOpen() const
+{
+    return file != nullptr;
+}
+
+void TelemetryRecorder::setStateRate(Scalar hz)
+{
+    stateInterval = hz > Scalar(0) ? Scalar(1)/hz : Scalar(0);
+}
+
+std::vector<TelemetryChannel> TelemetryRecorder::getChannels() const
+{
+    std::vector<TelemetryChannel> channels;
+    for(size_t i=0; i<sources.size(); ++i)
+        channels.push_back(sources[i].channel);
+    return channels;
+}
+
+TelemetryStatistics TelemetryRecorder::getStatistics()
+{
+    SDL_LockMutex(captureMutex);
+    SDL_LockMutex(queueMutex);
+    TelemetryStatistics s = stats;
+    SDL_UnlockMutex(queueMutex);
+    SDL_UnlockMutex(captureMutex);
+    return s;
+}
+
+int TelemetryRecorder::AddChannel(TelemetryKind kind, const std::string& name, const std::vector<std::string>& valueNames, void* object)
+{
+    if(file == nullptr)
+    {
+        cError("Telemetry recorder output not available! '%s' will not be recorded.", name.c_str());
+        return -1;
+    }
+    if(started)
+    {
+        cError("Telemetry channels have to be added before recording starts! '%s' will not be recorded.", name.c_str());
+        return -1;
+    }
+    
+    Source src;
+    src.channel.id = (uint16_t)sources.size();
+    src.channel.kind = kind;
+    src.channel.name = name;
+    src.channel.valueNames = valueNames;
+    src.object = object;
+    sources.push_back(src);
+    return src.channel.id;
+}
+
+int TelemetryRecorder::AddSensor(ScalarSensor* sensor)
+{
+    if(sensor->hasNewDataHandler())
+    {
+        cError("Sensor '%s' already has a data handler and will not be recorded!", sensor->getName().c_str());
+        return -1;
+    }
+    std::vector<std::string> names;
+    for(unsigned short i=0; i<sensor->getNumOfChannels(); ++i)
+        names.push_back(sensor->getSensorChannelDescription(i).name);
+    
+    int id = AddChannel(TelemetryKind::SENSOR, sensor->getName(), names, sensor);
+    if(id >= 0)
+        sensor->InstallNewDataHandler([this, id](ScalarSensor* s, const Sample& sample){ RecordSample((uint16_t)id, sample); });
+    return id;
+}
+
+int TelemetryRecorder::AddBody(Entity* entity)
+{
+    if(entity->getType() != EntityType::SOLID && entity->getType() != EntityType::ANIMATED && entity->getType() != EntityType::FEATHERSTONE)
+    {
+        cError("Telemetry recorder supports only moving bodies! '%s' will not be recorded.", entity->getName().c_str());
+        return -1;
+    }
+    std::vector<std::string> names = {"x", "y", "z", "qx", "qy", "qz", "qw", "vx", "vy", "vz", "wx", "wy", "wz"};
+    return AddChannel(TelemetryKind::BODY, entity->getName(), names, entity);
+}
+
+int TelemetryRecorder::AddActuator(Actuator* actuator)
+{
+    std::vector<std::string> names;
+    switch(actuator->getType())
+    {
+        case ActuatorType::THRUSTER:
+        case ActuatorType::PROPELLER:
+            names = {"Setpoint", "Omega", "Thrust"};
+            break;
+            
+        case ActuatorType::RUDDER:
+            names = {"Setpoint", "Angle"};
+            break;
+            
+        case ActuatorType::SERVO:
+            names = {"Position", "Velocity", "Effort"};
+            break;
+            
+        default:
+            cError("Telemetry recorder does not support the type of actuator '%s'!", actuator->getName().c_str());
+            return -1;
+    }
+    return AddChannel(TelemetryKind::ACTUATOR, actuator->getName(), names, actuator);
+}
+
+int TelemetryRecorder::AddComm(Comm* comm)
+{
+    if(comm->hasEventHandler())
+    {
+        cError("Comm '%s' already has an event handler and will not be recorded!", comm->getName().c_str());
+        return -1;
+    }
+    int id = AddChannel(TelemetryKind::COMM, comm->getName(), std::vector<std::string>(), comm);
+    if(id >= 0)
+        comm->InstallEventHandler([this, id](Comm* c, const CommDataFrame* frame, bool received){ RecordCommEvent((uint16_t)id, frame, received); });
+    return id;
+}
+
+void TelemetryRecorder::AddAll()
+{
+    if(SimulationApp::getApp() == nullptr)
+        return;
+    SimulationManager* sm = SimulationApp::getApp()->getSimulationManager();
+    
+    Sensor* sens;
+    for(unsigned int i=0; (sens = sm->getSensor(i)) != nullptr; ++i)
+        if(sens->getType() != SensorType::VISION && !((ScalarSensor*)sens)->hasNewDataHandler())
+            AddSensor((ScalarSensor*)sens);
+    
+    Entity* ent;
+    for(unsigned int i=0; (ent = sm->getEntity(i)) != nullptr; ++i)
+        if(ent->getType() == EntityType::SOLID || ent->getType() == EntityType::ANIMATED || ent->getType() == EntityType::FEATHERSTONE)
+            AddBody(ent);
+    
+    Actuator* act;
+    for(unsigned int i=0; (act = sm->getActuator(i)) != nullptr; ++i)
+        if(act->getType() == ActuatorType::THRUSTER || act->getType() == ActuatorType::PROPELLER
+           || act->getType() == ActuatorType::RUDDER || act->getType() == ActuatorType::SERVO)
+            AddActuator(act);
+    
+    Comm* comm;
+    for(unsigned int i=0; (comm = sm->getComm(i)) != nullptr; ++i)
+        if(!comm->hasEventHandler())
+            AddComm(comm);
+}
+
+void TelemetryRecorder::WriteSchema()
+{
+    std::vector<char> schema;
+    auto append = [&schema](const void* data, size_t size)
+    {
+        schema.insert(schema.end(), (const char*)data, (const char*)data + size);
+    };
+    
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        const TelemetryChannel& ch = sources[i].channel;
+        uint8_t kind = (uint8_t)ch.kind;
+        uint8_t zero = 0;
+        uint16_t numValues = (uint16_t)ch.valueNames.size();
+        uint16_t len = (uint16_t)ch.name.size();
+        append(&ch.id, sizeof(ch.id));
+        append(&kind, 1);
+        append(&zero, 1);
+        append(&numValues, sizeof(numValues));
+        append(&len, sizeof(len));
+        append(ch.name.data(), len);
+        for(size_t h=0; h<ch.valueNames.size(); ++h)
+        {
+            len = (uint16_t)ch.valueNames[h].size();
+            append(&len, sizeof(len));
+            append(ch.valueNames[h].data(), len);
+        }
+    }
+    schema.resize(Pad8(schema.size()), 0);
+    
+    TelemetryFileHeader header;
+    memcpy(header.magic, TELEMETRY_FILE_MAGIC, 8);
+    header.version = TELEMETRY_VERSION;
+    header.numChannels = (uint32_t)sources.size();
+    header.schemaSize = schema.size();
+    header.reserved = 0;
+    WriteValue(file, header, fileOffset);
+    if(!schema.empty())
+        fwrite(&schema[0], 1, schema.size(), file);
+    fileOffset += schema.size();
+    started = true;
+}
+
+char* TelemetryRecorder::BeginRecord(uint16_t channel, TelemetryKind kind, uint8_t flags, size_t payloadSize, Scalar time)
+{
+    if(file == nullptr)
+        return nullptr;
+    if(!started)
+        WriteSchema(); //Nothing submitted yet -> writer not touching the file
+    
+    size_t recordSize = sizeof(TelemetryRecordHeader) + Pad8(payloadSize);
+    ++stats.records;
+    
+    if(current != nullptr && current->header.numRecords > 0
+       && (current->header.size + recordSize > current->data.size() || time - current->header.startTime >= chunkDuration))
+        SubmitChunk();
+    
+    if(current == nullptr) //Get a free chunk
+    {
+        SDL_LockMutex(queueMutex);
+        if(!freeChunks.empty())
+        {
+            current = freeChunks.back();
+            freeChunks.pop_back();
+        }
+        else if(allocatedChunks < queueCapacity)
+        {
+            current = new Chunk();
+            current->data.resize(chunkSize);
+            ++allocatedChunks;
+        }
+        SDL_UnlockMutex(queueMutex);
+        
+        if(current == nullptr) //All chunks waiting for writing
+        {
+            ++stats.droppedRecords;
+            return nullptr;
+        }
+        memcpy(current->header.magic, TELEMETRY_CHUNK_MAGIC, 4);
+        current->header.numRecords = 0;
+        current->header.size = 0;
+        current->header.startTime = time;
+        current->header.endTime = time;
+        current->header.channelMask = 0;
+    }
+    
+    if(recordSize > current->data.size()) //Single record larger than a chunk
+        current->data.resize(recordSize);
+    
+    char* ptr = &current->data[current->header.size];
+    if(payloadSize > 0)
+        memset(ptr + recordSize - 8, 0, 8); //Clear padding
+    TelemetryRecordHeader* rh = (TelemetryRecordHeader*)ptr;
+    rh->channel = channel;
+    rh->kind = (uint8_t)kind;
+    rh->flags = flags;
+    rh->size = (uint32_t)Pad8(payloadSize);
+    rh->time = time;
+    
+    current->header.size += recordSize;
+    ++current->header.numRecords;
+    current->header.endTime = std::max(current->header.endTime, (double)time);
+    current->header.channelMask |= TelemetryChannelBit(channel);
+    return ptr + sizeof(TelemetryRecordHeader);
+}
+
+void TelemetryRecorder::SubmitChunk()
+{
+    if(current == nullptr || current->header.numRecords == 0)
+        return;
+    
+    SDL_LockMutex(queueMutex);
+    queue.push_back(current);
+    stats.queuePeak = std::max(stats.queuePeak, (unsigned int)queue.size());
+    SDL_CondSignal(chunkAvailable);
+    SDL_UnlockMutex(queueMutex);
+    current = nullptr;
+}
+
+void TelemetryRecorder::RecordSample(uint16_t channel, const Sample& s)
+{
+    unsigned short n = s.getNumOfDimensions();
+    SDL_LockMutex(captureMutex);
+    double* values = (double*)BeginRecord(channel, TelemetryKind::SENSOR, 0, n * sizeof(double), s.getTimestamp());
+    if(values != nullptr)
+        for(unsigned short i=0; i<n; ++i)
+            values[i] = (double)s.getValue(i);
+    SDL_UnlockMutex(captureMutex);
+}
+
+void TelemetryRecorder::RecordCommEvent(uint16_t channel, const CommDataFrame* frame, bool received)
+{
+    Scalar time = SimulationApp::getApp()->getSimulationManager()->getSimulationTime();
+    SDL_LockMutex(captureMutex);
+    char* payload = BeginRecord(channel, TelemetryKind::COMM, received ? 1 : 0, sizeof(TelemetryCommEvent) + frame->data.size(), time);
+    if(payload != nullptr)
+    {
+        TelemetryCommEvent* ev = (TelemetryCommEvent*)payload;
+        ev->seq = frame->seq;
+        ev->source = frame->source;
+        ev->destination = frame->destination;
+        ev->frameTime = frame->timeStamp;
+        ev->dataLength = (uint32_t)frame->data.size();
+        ev->reserved = 0;
+        memcpy(payload + sizeof(TelemetryCommEvent), frame->data.data(), frame->data.size());
+    }
+    SDL_UnlockMutex(captureMutex);
+}
+
+void TelemetryRecorder::StepCompleted(Scalar time)
+{
+    if(stateInterval > Scalar(0) && lastStateTime >= Scalar(0) && time + Scalar(1e-9) < lastStateTime + stateInterval)
+        return;
+    lastStateTime = time;
+    
+    SDL_LockMutex(captureMutex);
+    for(size_t i=0; i<sources.size(); ++i)
+    {
+        const TelemetryChannel& ch = sources[i].channel;
+        if(sources[i].object == nullptr) //Detached
+            continue;
+        
+        if(ch.kind == TelemetryKind::BODY)
+        {
+            Entity* ent = (Entity*)sources[i].object;
+            Transform T;
+            Vector3 v, w;
+            if(ent->getType() == EntityType::FEATHERSTONE)
+            {
+                FeatherstoneEntity* fe = (FeatherstoneEntity*)ent;
+                T = fe->getLinkTransform(0);
+                v = fe->getLinkLinearVelocity(0);
+                w = fe->getLinkAngularVelocity(0);
+            }
+            else
+            {
+                MovingEntity* me = (MovingEntity*)ent;
+                T = me->getOTransform();
+                v = me->getLinearVelocity();
+                w = me->getAngularVelocity();
+            }
+            double* values = (double*)BeginRecord(ch.id, ch.kind, 0, 13 * sizeof(double), time);
+            if(values == nullptr)
+                continue;
+            Quaternion q = T.getRotation();
+            values[0] = T.getOrigin().getX();
+            values[1] = T.getOrigin().getY();
+            values[2] = T.getOrigin().getZ();
+            values[3] = q.getX();
+            values[4] = q.getY();
+            values[5] = q.getZ();
+            values[6] = q.getW();
+            values[7] = v.getX();
+            values[8] = v.getY();
+            values[9] = v.getZ();
+            values[10] = w.getX();
+            values[11] = w.getY();
+            values[12] = w.getZ();
+        }
+        else if(ch.kind == TelemetryKind::ACTUATOR)
+        {
+            Actuator* act = (Actuator*)sources[i].object;
+            double* values = (double*)BeginRecord(ch.id, ch.kind, 0, ch.valueNames.size() * sizeof(double), time);
+            if(values == nullptr)
+                continue;
+            switch(act->getType())
+            {
+                case ActuatorType::THRUSTER:
+                    values[0] = ((Thruster*)act)->getSetpoint();
+                    values[1] = ((Thruster*)act)->getOmega();
+                    values[2] = ((Thruster*)act)->getThrust();
+                    break;
+                    
+                case ActuatorType::PROPELLER:
+                    values[0] = ((Propeller*)act)->getSetpoint();
+                    values[1] = ((Propeller*)act)->getOmega();
+                    values[2] = ((Propeller*)act)->getThrust();
+                    break;
+                    
+                case ActuatorType::RUDDER:
+                    values[0] = ((Rudder*)act)->getSetpoint();
+                    values[1] = ((Rudder*)act)->getAngle();
+                    break;
+                    
+                case ActuatorType::SERVO:
+                    values[0] = ((Servo*)act)->getPosition();
+                    values[1] = ((Servo*)act)->getVelocity();
+                    values[2] = ((Servo*)act)->getEffort();
+                    break;
+                    
+                default:
+                    break;
+            }
+        }
+    }
+    SDL_UnlockMutex(captureMutex);
+}
+
+void TelemetryRecorder::Flush()
+{
+    SDL_LockMutex(captureMutex);
+    SubmitChunk();
+    SDL_UnlockMutex(captureMutex);
+    
+    SDL_LockMutex(queueMutex);
+    while(!queue.empty() || busy > 0)
+        SDL_CondWait(chunksDone, queueMutex);
+    SDL_UnlockMutex(queueMutex);
+}
+
+int TelemetryRecorder::RunWriter(void* data)
+{
+    TelemetryRecorder* rec = (TelemetryRecorder*)data;
+    
+    while(true)
+    {
+        SDL_LockMutex(rec->queueMutex);
+        while(rec->queue.empty() && !rec->stop)
+            SDL_CondWait(rec->chunkAvailable, rec->queueMutex);
+        if(rec->queue.empty()) //Stopped and drained
+        {
+            SDL_UnlockMutex(rec->queueMutex);
+            break;
+        }
+        Chunk* chunk = rec->queue.front();
+        rec->queue.pop_front();
+        ++rec->busy;
+        SDL_UnlockMutex(rec->queueMutex);
+        
+        //Only this thread touches the file and the index while recording
+        TelemetryIndexEntry entry;
+        entry.offset = rec->fileOffset;
+        entry.size = sizeof(TelemetryChunkHeader) + chunk->header.size;
+        entry.startTime = chunk->header.startTime;
+        entry.endTime = chunk->header.endTime;
+        entry.channelMask = chunk->header.channelMask;
+        entry.numRecords = chunk->header.numRecords;
+        entry.reserved = 0;
+        WriteValue(rec->file, chunk->header, rec->fileOffset);
+        fwrite(&chunk->data[0], 1, chunk->header.size, rec->file);
+        rec->fileOffset += chunk->header.size;
+        fflush(rec->file); //Complete chunks readable while recording
+        rec->index.push_back(entry);
+        
+        SDL_LockMutex(rec->queueMutex);
+        ++rec->stats.chunks;
+        rec->stats.bytesWritten += entry.size;
+        if(chunk->data.size() > rec->chunkSize) //Shrink after oversized records
+        {
+            chunk->data.resize(rec->chunkSize);
+            chunk->data.shrink_to_fit();
+        }
+        rec->freeChunks.push_back(chunk);
+        --rec->busy;
+        SDL_CondBroadcast(rec->chunksDone);
+        SDL_UnlockMutex(rec->queueMutex);
+    }
+    return 0;
+}
+
+}
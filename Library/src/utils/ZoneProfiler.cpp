@@ -0,0 +1,320 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  ZoneProfiler.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "utils/ZoneProfiler.h"
+
+#include <SDL2/SDL_mutex.h>
+#include <chrono>
+#include <map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstdio>
+#include "LinearMath/btQuickprof.h"
+
+namespace sf
+{
+
+struct ProfileFrame
+{
+    const char* name;
+    const char* detail;
+    int64_t start;
+    int64_t child;
+};
+
+struct ThreadProfile
+{
+    std::vector<ProfileEvent> events; //Ring buffer written only by the owner thread
+    uint64_t mask;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail; //First valid event after the last Clear
+    std::vector<ProfileFrame> stack;
+    uint64_t epoch;
+    unsigned int id;
+    std::string name;
+};
+
+std::atomic<bool> ZoneProfiler::enabled(false);
+static std::atomic<uint64_t> profilerEpoch(0);
+static size_t profilerCapacity = 1 << 16;
+static std::vector<ThreadProfile*> threadProfiles;
+static std::unordered_set<std::string> internedStrings;
+static btEnterProfileZoneFunc* prevBulletEnter = nullptr;
+static btLeaveProfileZoneFunc* prevBulletLeave = nullptr;
+static thread_local ThreadProfile* localProfile = nullptr;
+
+static SDL_mutex* ProfilerMutex()
+{
+    static SDL_mutex* mutex = SDL_CreateMutex();
+    return mutex;
+}
+
+static int64_t ProfilerNow()
+{
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+static ThreadProfile* LocalProfile()
+{
+    if(localProfile == nullptr)
+    {
+        ThreadProfile* tp = new ThreadProfile();
+        SDL_LockMutex(ProfilerMutex());
+        size_t cap = 1;
+        while(cap < profilerCapacity) cap <<= 1;
+        tp->events.resize(cap);
+        tp->mask = cap - 1;
+        tp->head.store(0);
+        tp->tail.store(0);
+        tp->stack.reserve(64);
+        tp->epoch = profilerEpoch.load();
+        tp->id = (unsigned int)threadProfiles.size();
+        tp->name = "Thread " + std::to_string(tp->id);
+        threadProfiles.push_back(tp); //Never deleted, threads may finish before export
+        SDL_UnlockMutex(ProfilerMutex());
+        localProfile = tp;
+    }
+    return localProfile;
+}
+
+void ZoneProfiler::setEnabled(bool en)
+{
+    SDL_LockMutex(ProfilerMutex());
+    if(en && !enabled.load())
+    {
+        profilerEpoch.fetch_add(1); //Drop zones left open when profiling was disabled
+        prevBulletEnter = btGetCurrentEnterProfileZoneFunc();
+        prevBulletLeave = btGetCurrentLeaveProfileZoneFunc();
+        btSetCustomEnterProfileZoneFunc(ZoneProfiler::BulletEnter);
+        btSetCustomLeaveProfileZoneFunc(ZoneProfiler::BulletLeave);
+    }
+    else if(!en && enabled.load())
+    {
+        btSetCustomEnterProfileZoneFunc(prevBulletEnter);
+        btSetCustomLeaveProfileZoneFunc(prevBulletLeave);
+    }
+    enabled.store(en);
+    SDL_UnlockMutex(ProfilerMutex());
+}
+
+void ZoneProfiler::setBufferCapacity(size_t n)
+{
+    SDL_LockMutex(ProfilerMutex());
+    profilerCapacity = n < 1 ? 1 : n;
+    SDL_UnlockMutex(ProfilerMutex());
+}
+
+void ZoneProfiler::setThreadName(const std::string& name)
+{
+    ThreadProfile* tp = LocalProfile();
+    SDL_LockMutex(ProfilerMutex());
+    tp->name = name;
+    SDL_UnlockMutex(ProfilerMutex());
+}
+
+void ZoneProfiler::Begin(const char* name, const char* detail)
+{
+    ThreadProfile* tp = LocalProfile();
+    uint64_t epoch = profilerEpoch.load(std::memory_order_relaxed);
+    if(tp->epoch != epoch)
+    {
+        tp->stack.clear();
+        tp->epoch = epoch;
+    }
+    
+    ProfileFrame f;
+    f.name = name;
+    f.detail = detail;
+    f.child = 0;
+    f.start = ProfilerNow();
+    tp->stack.push_back(f);
+}
+
+void ZoneProfiler::End()
+{
+    int64_t now = ProfilerNow();
+    ThreadProfile* tp = LocalProfile();
+    if(tp->stack.empty())
+        return;
+    
+    ProfileFrame f = tp->stack.back();
+    tp->stack.pop_back();
+    int64_t duration = now - f.start;
+    if(!tp->stack.empty())
+        tp->stack.back().child += duration;
+    
+    uint64_t h = tp->head.load(std::memory_order_relaxed);
+    ProfileEvent& e = tp->events[h & tp->mask];
+    e.name = f.name;
+    e.detail = f.detail;
+    e.start = f.start;
+    e.duration = duration;
+    e.self = duration - f.child;
+    e.depth = (uint32_t)tp->stack.size();
+    tp->head.store(h + 1, std::memory_order_release);
+}
+
+void ZoneProfiler::BulletEnter(const char* name)
+{
+    if(isEnabled()) Begin(name);
+}
+
+void ZoneProfiler::BulletLeave()
+{
+    if(isEnabled()) End();
+}
+
+const char* ZoneProfiler::Intern(const std::string& str)
+{
+    SDL_LockMutex(ProfilerMutex());
+    const char* ptr = internedStrings.insert(str).first->c_str();
+    SDL_UnlockMutex(ProfilerMutex());
+    return ptr;
+}
+
+void ZoneProfiler::Clear()
+{
+    SDL_LockMutex(ProfilerMutex());
+    for(size_t i=0; i<threadProfiles.size(); ++i)
+        threadProfiles[i]->tail.store(threadProfiles[i]->head.load(std::memory_order_acquire));
+    SDL_UnlockMutex(ProfilerMutex());
+}
+
+//Calls func for every valid event of a thread, oldest first
+template<typename F> static void ForEachEvent(ThreadProfile* tp, F func)
+{
+    uint64_t head = tp->head.load(std::memory_order_acquire);
+    uint64_t first = tp->tail.load();
+    if(head - first > tp->events.size())
+        first = head - tp->events.size();
+    for(uint64_t i=first; i<head; ++i)
+        func(tp->events[i & tp->mask]);
+}
+
+static void WriteJSONString(FILE* f, const char* str)
+{
+    fputc('"', f);
+    for(; *str != '\0'; ++str)
+    {
+        if(*str == '"' || *str == '\\')
+            fputc('\\', f);
+        if((unsigned char)*str >= 0x20)
+            fputc(*str, f);
+    }
+    fputc('"', f);
+}
+
+bool ZoneProfiler::ExportChromeTrace(const std::string& path)
+{
+    FILE* f = fopen(path.c_str(), "w");
+    if(f == nullptr)
+        return false;
+    
+    SDL_LockMutex(ProfilerMutex());
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Stonefish\"}}");
+    for(size_t i=0; i<threadProfiles.size(); ++i)
+    {
+        ThreadProfile* tp = threadProfiles[i];
+        fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":", tp->id);
+        WriteJSONString(f, tp->name.c_str());
+        fprintf(f, "}}");
+        
+        ForEachEvent(tp, [&](const ProfileEvent& e)
+        {
+            fprintf(f, ",\n{\"name\":");
+            WriteJSONString(f, e.name);
+            fprintf(f, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3lf,\"dur\":%.3lf", tp->id, e.start/1e3, e.duration/1e3);
+            if(e.detail != nullptr)
+            {
+                fprintf(f, ",\"args\":{\"detail\":");
+                WriteJSONString(f, e.detail);
+                fprintf(f, "}");
+            }
+            fprintf(f, "}");
+        });
+    }
+    fprintf(f, "\n]}\n");
+    SDL_UnlockMutex(ProfilerMutex());
+    
+    fclose(f);
+    return true;
+}
+
+std::vector<ProfileSummary> ZoneProfiler::getSummary()
+{
+    std::map<std::pair<std::string, std::string>, ProfileSummary> zones;
+    
+    SDL_LockMutex(ProfilerMutex());
+    for(size_t i=0; i<threadProfiles.size(); ++i)
+    {
+        ForEachEvent(threadProfiles[i], [&](const ProfileEvent& e)
+        {
+            std::pair<std::string, std::string> key(e.name, e.detail != nullptr ? e.detail : "");
+            auto it = zones.find(key);
+            if(it == zones.end())
+            {
+                ProfileSummary s;
+                s.name = key.first;
+                s.detail = key.second;
+                s.calls = 0;
+                s.total = s.self = s.max = 0.0;
+                it = zones.insert(std::make_pair(key, s)).first;
+            }
+            ++it->second.calls;
+            it->second.total += e.duration/1e6;
+            it->second.self += e.self/1e6;
+            it->second.max = std::max(it->second.max, e.duration/1e3);
+        });
+    }
+    SDL_UnlockMutex(ProfilerMutex());
+    
+    std::vector<ProfileSummary> summary;
+    for(auto it = zones.begin(); it != zones.end(); ++it)
+        summary.push_back(it->second);
+    std::sort(summary.begin(), summary.end(), [](const ProfileSummary& a, const ProfileSummary& b){ return a.total > b.total; });
+    return summary;
+}
+
+std::string ZoneProfiler::getSummaryTable()
+{
+    std::vector<ProfileSummary> summary = getSummary();
+    char line[256];
+    snprintf(line, 256, "%-48s %10s %12s %12s %10s %10s\n", "Zone", "Calls", "Total [ms]", "Self [ms]", "Mean [us]", "Max [us]");
+    std::string table(line);
+    for(size_t i=0; i<summary.size(); ++i)
+    {
+        std::string zone = summary[i].name;
+        if(!summary[i].detail.empty())
+            zone += " (" + summary[i].detail + ")";
+        snprintf(line, 256, "%-48.48s %10llu %12.3lf %12.3lf %10.2lf %10.2lf\n", zone.c_str(), (unsigned long long)summary[i].calls,
+                 summary[i].total, summary[i].self, summary[i].total * 1e3 / (double)summary[i].calls, summary[i].max);
+        table += std::string(line);
+    }
+    return table;
+}
+
+}
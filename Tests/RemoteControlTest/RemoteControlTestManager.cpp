@@ -0,0 +1,76 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  RemoteControlTestManager.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "RemoteControlTestManager.h"
+
+#include <entities/statics/Plane.h>
+#include <entities/solids/Sphere.h>
+#include <entities/solids/Box.h>
+#include <core/FeatherstoneRobot.h>
+#include <actuators/Servo.h>
+#include <sensors/scalar/Odometry.h>
+#include <utils/UnitSystem.h>
+
+RemoteControlTestManager::RemoteControlTestManager(sf::Scalar stepsPerSecond)
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE)
+{
+}
+
+void RemoteControlTestManager::BuildScenario()
+{
+    //Create materials
+    CreateMaterial("Steel", sf::UnitSystem::Density(sf::CGS, sf::MKS, 7.8), 0.5);
+    SetMaterialsInteraction("Steel", "Steel", 0.5, 0.3);
+    
+    //Build scene
+    sf::Plane* plane = new sf::Plane("Ground", 100.0, "Steel");
+    AddStaticEntity(plane, sf::I4());
+    
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    //Robot with a single servo-driven joint and odometry (actuator 0, sensor 0)
+    sf::Box* base = new sf::Box("Base", phy, sf::Vector3(0.4,0.4,0.2), sf::I4(), "Steel", "");
+    sf::Box* link = new sf::Box("Link", phy, sf::Vector3(0.5,0.05,0.05), sf::Transform(sf::IQ(), sf::Vector3(0.25,0.0,0.0)), "Steel", "");
+    std::vector<sf::SolidEntity*> links(1, link);
+    
+    sf::Robot* robot = new sf::FeatherstoneRobot("Robot", true);
+    robot->DefineLinks(base, links);
+    robot->DefineRevoluteJoint("Joint", "Base", "Link", sf::Transform(sf::IQ(), sf::Vector3(0.0,0.0,-0.2)), sf::Vector3(0.0,0.0,1.0));
+    robot->BuildKinematicStructure();
+    
+    sf::Servo* srv = new sf::Servo("Servo", 1.0, 1.0, 100.0);
+    srv->setControlMode(sf::ServoControlMode::POSITION);
+    robot->AddJointActuator(srv, "Joint");
+    
+    sf::Odometry* odom = new sf::Odometry("Odom");
+    robot->AddLinkSensor(odom, "Base", sf::I4());
+    AddRobot(robot, sf::Transform(sf::IQ(), sf::Vector3(0.0,0.0,-0.1)));
+    
+    //Free body to be tracked by the client
+    sf::Sphere* ball = new sf::Sphere("Ball", phy, 0.1, sf::I4(), "Steel", "");
+    AddSolidEntity(ball, sf::Transform(sf::IQ(), sf::Vector3(2.0,0.0,-1.0)));
+}
@@ -0,0 +1,199 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  RemoteControlTest
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include <core/ConsoleSimulationApp.h>
+#include <core/RemoteControlClient.h>
+#include <core/SimulationState.h>
+#include <core/Console.h>
+#include <utils/SocketUtil.h>
+#include <SDL2/SDL.h>
+#include <cstdio>
+#include "RemoteControlTestManager.h"
+
+#define SOCKET_PATH "/tmp/stonefish_remote_test.sock"
+
+struct RemoteTestData
+{
+    sf::SimulationApp* app;
+    unsigned int failures;
+};
+
+static void Check(RemoteTestData* data, bool condition, const char* description)
+{
+    if(condition)
+        cInfo("[PASS] %s", description);
+    else
+    {
+        cError("[FAIL] %s", description);
+        ++data->failures;
+    }
+}
+
+static bool HasStatus(const std::vector<sf::RemoteResult>& results, size_t i, sf::RemoteCommand cmd, sf::RemoteStatus status)
+{
+    return i < results.size() && results[i].command == cmd && results[i].status == status;
+}
+
+//Sends a STEP command with a truncated argument, preceded by a valid GET_TIME, bypassing the client
+static bool SendMalformedRequest(RemoteTestData* data)
+{
+    int s = sf::ConnectSocket(std::string(SOCKET_PATH));
+    if(s < 0)
+        return false;
+    
+    sf::SimulationState request;
+    request.Write((uint8_t)sf::RemoteCommand::GET_TIME);
+    request.Write((uint8_t)sf::RemoteCommand::STEP);
+    request.Write((uint16_t)10); //STEP expects uint32
+    uint32_t header[2] = {REMOTE_CONTROL_MAGIC, (uint32_t)request.getSize()};
+    bool ok = sf::SendAll(s, header, sizeof(header)) && sf::SendAll(s, request.getData(), request.getSize())
+              && sf::ReceiveAll(s, header, sizeof(header)) && header[0] == REMOTE_CONTROL_MAGIC;
+    std::vector<uint8_t> payload(ok ? header[1] : 0);
+    ok = ok && sf::ReceiveAll(s, payload.data(), payload.size());
+    sf::CloseSocket(s);
+    if(!ok)
+        return false;
+    
+    sf::SimulationState response;
+    response.WriteBytes(payload.data(), payload.size());
+    uint8_t code, status, running;
+    double time;
+    response.Read(code);
+    response.Read(status);
+    Check(data, code == (uint8_t)sf::RemoteCommand::GET_TIME && status == (uint8_t)sf::RemoteStatus::OK, "command before the malformed one executed");
+    response.Read(time);
+    response.Read(running);
+    response.Read(code);
+    response.Read(status);
+    Check(data, response.isValid() && code == (uint8_t)sf::RemoteCommand::STEP && status == (uint8_t)sf::RemoteStatus::MALFORMED, "truncated STEP reported as MALFORMED");
+    Check(data, response.getRemainingSize() == 0, "no output after a malformed command");
+    return true;
+}
+
+static int RunClient(void* ptr)
+{
+    RemoteTestData* data = (RemoteTestData*)ptr;
+    sf::RemoteControlClient client;
+    std::vector<sf::RemoteResult> results;
+    
+    //Wait for the server to start listening
+    for(unsigned int i=0; i<500 && !client.Connect(std::string(SOCKET_PATH)); ++i)
+        SDL_Delay(10);
+    Check(data, client.isConnected(), "client connected");
+    if(!client.isConnected())
+    {
+        data->app->Exit();
+        return 0;
+    }
+    
+    //Scenario description
+    client.Info();
+    Check(data, client.Execute(results) && HasStatus(results, 0, sf::RemoteCommand::INFO, sf::RemoteStatus::OK), "INFO executed");
+    int ballIndex = -1;
+    int groundIndex = -1;
+    uint16_t odomChannels = 0;
+    if(results.size() == 1)
+    {
+        const sf::RemoteResult& info = results[0];
+        Check(data, info.actuatorsInfo.size() == 1 && info.actuatorsInfo[0].name == "Servo", "INFO lists the actuator");
+        Check(data, info.sensorsInfo.size() == 1 && info.sensorsInfo[0].name == "Odom", "INFO lists the sensor");
+        if(info.sensorsInfo.size() == 1)
+            odomChannels = info.sensorsInfo[0].channels;
+        for(size_t i=0; i<info.entitiesInfo.size(); ++i)
+        {
+            if(info.entitiesInfo[i].name == "Ball")
+                ballIndex = (int)i;
+            else if(info.entitiesInfo[i].name == "Ground")
+                groundIndex = (int)i;
+        }
+        Check(data, ballIndex >= 0 && groundIndex >= 0, "INFO lists the entities");
+    }
+    
+    //Complete control cycle followed by invalid arguments, in a single request
+    client.SetActuators(std::vector<sf::RemoteSetpoint>(1, sf::RemoteSetpoint{0, 0, 0.5}));
+    client.Step(50);
+    client.GetSensors();
+    client.GetBodies();
+    client.SetActuators(std::vector<sf::RemoteSetpoint>(1, sf::RemoteSetpoint{99, 0, 1.0}));
+    client.GetSensors(std::vector<uint16_t>(1, 99));
+    client.GetBodies(std::vector<uint16_t>(1, (uint16_t)groundIndex)); //Static body
+    client.GetTime();
+    Check(data, client.Execute(results) && results.size() == 8, "control cycle batch executed");
+    Check(data, HasStatus(results, 0, sf::RemoteCommand::SET_ACTUATORS, sf::RemoteStatus::OK) && results[0].count == 1, "SET_ACTUATORS applied");
+    Check(data, HasStatus(results, 1, sf::RemoteCommand::STEP, sf::RemoteStatus::OK) && results[1].time > 0.0, "STEP advanced the simulation");
+    Check(data, HasStatus(results, 2, sf::RemoteCommand::GET_SENSORS, sf::RemoteStatus::OK) && results[2].sensors.size() == 1
+          && results[2].sensors[0].values.size() == odomChannels && odomChannels > 0, "GET_SENSORS returned the odometry");
+    bool ballFell = false;
+    if(HasStatus(results, 3, sf::RemoteCommand::GET_BODIES, sf::RemoteStatus::OK))
+        for(size_t i=0; i<results[3].bodies.size(); ++i)
+            if((int)results[3].bodies[i].index == ballIndex)
+                ballFell = results[3].bodies[i].position[2] > -1.0 && results[3].bodies[i].linearVelocity[2] > 0.0;
+    Check(data, ballFell, "GET_BODIES returned the falling body");
+    Check(data, HasStatus(results, 4, sf::RemoteCommand::SET_ACTUATORS, sf::RemoteStatus::INVALID_ARGUMENT), "SET_ACTUATORS rejected an invalid index");
+    Check(data, HasStatus(results, 5, sf::RemoteCommand::GET_SENSORS, sf::RemoteStatus::INVALID_ARGUMENT), "GET_SENSORS rejected an invalid index");
+    Check(data, HasStatus(results, 6, sf::RemoteCommand::GET_BODIES, sf::RemoteStatus::INVALID_ARGUMENT), "GET_BODIES rejected a static body");
+    Check(data, HasStatus(results, 7, sf::RemoteCommand::GET_TIME, sf::RemoteStatus::OK) && !results[7].running
+          && results[7].time == results[1].time, "invalid commands did not stop the batch");
+    
+    //Stepping is not allowed while the simulation thread is running
+    client.Resume();
+    client.Step(1);
+    client.Pause();
+    Check(data, client.Execute(results) && HasStatus(results, 1, sf::RemoteCommand::STEP, sf::RemoteStatus::WRONG_STATE)
+          && HasStatus(results, 2, sf::RemoteCommand::PAUSE, sf::RemoteStatus::OK), "STEP rejected while running");
+    
+    //Malformed request (the server serves one client at a time)
+    client.Disconnect();
+    Check(data, SendMalformedRequest(data), "malformed request answered");
+    
+    //Finish
+    client.Connect(std::string(SOCKET_PATH));
+    client.Quit();
+    if(!client.Execute(results))
+        data->app->Exit();
+    return 0;
+}
+
+int main(int argc, const char * argv[])
+{
+    RemoteControlTestManager* simulationManager = new RemoteControlTestManager(500.0);
+    sf::ConsoleSimulationApp app("RemoteControlTest", std::string(DATA_DIR_PATH), simulationManager);
+    app.EnableRemoteControl(std::string(SOCKET_PATH));
+    
+    RemoteTestData data;
+    data.app = &app;
+    data.failures = 0;
+    SDL_Thread* client = SDL_CreateThread(RunClient, "remoteControlClient", &data);
+    app.Run(false); //Lockstep, the client steps the simulation
+    SDL_WaitThread(client, NULL);
+    
+    if(data.failures > 0)
+    {
+        printf("Remote control test failed (%u checks)!\n", data.failures);
+        return 1;
+    }
+    printf("Remote control test passed.\n");
+    return 0;
+}
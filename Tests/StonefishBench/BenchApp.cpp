@@ -0,0 +1,352 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BenchApp.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "BenchApp.h"
+
+#include <omp.h>
+#include <random>
+#include <cstdlib>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <core/RayTracingScene.h>
+#include <sensors/Sensor.h>
+#include <graphics/OpenGLContent.h>
+#include <utils/GeometryFileUtil.h>
+#include <utils/SystemUtil.hpp>
+#include <utils/SharedMemoryClient.h>
+
+BenchApp::BenchApp(std::string dataDirPath, BenchManager* sim) 
+    : ConsoleSimulationApp("StonefishBench", dataDirPath, sim)
+{
+}
+
+BenchResult BenchApp::RunScenario(BenchScenario s, unsigned int scale, unsigned int steps, const std::string& meshFilename, unsigned int faces, unsigned int objects)
+{
+    BenchManager* sim = (BenchManager*)getSimulationManager();
+    BenchResult r(BenchManager::getScenarioName(s), scale, steps);
+    
+    //Startup: scenario building, initial conditions and first step
+    int64_t start = sf::GetTimeInMicroseconds();
+    sim->setScenario(s, scale, meshFilename, objects);
+    InitializeSimulation();
+    sim->setRandomSeed(1);
+    sim->StartSimulation();
+    sim->AdvanceSimulation(); //Initializes the clock
+    r.startupMs = (sf::GetTimeInMicroseconds() - start)/1000.0;
+    
+    sf::RayTracingStatistics rt0 = sim->getRayTracingScene()->getStatistics();
+    double hydroTime = 0.0;
+    
+    start = sf::GetTimeInMicroseconds();
+    for(unsigned int i=0; i<steps; ++i)
+    {
+        sim->AdvanceSimulation();
+        r.contacts += sim->getDynamicsWorld()->getDispatcher()->getNumManifolds();
+        if(s == BenchScenario::MESH)
+            hydroTime += sim->getPerformanceMonitor().getHydrodynamicsTime();
+    }
+    double runTime = (sf::GetTimeInMicroseconds() - start)/1e6;
+    
+    r.stepsPerSecond = runTime > 0.0 ? steps/runTime : 0.0;
+    r.contacts /= (double)steps;
+    if(s == BenchScenario::MESH && faces > 0)
+        r.nsPerFace = hydroTime * 1000.0 / (double)steps / (double)faces;
+    if(s == BenchScenario::RAYS)
+    {
+        sf::RayTracingStatistics rt1 = sim->getRayTracingScene()->getStatistics();
+        double traceTime = (rt1.traceTime - rt0.traceTime)/1e6;
+        r.raysPerSecond = traceTime > 0.0 ? (rt1.rays - rt0.rays)/traceTime : 0.0;
+        r.instances = (double)rt1.instances;
+        r.triangles = (double)rt1.triangles;
+    }
+    
+    sim->StopSimulation();
+    cInfo("Benchmark %s(%u): %.1lf steps/s, startup %.1lf ms.", r.scenario.c_str(), scale, r.stepsPerSecond, r.startupMs);
+    return r;
+}
+
+BenchResult BenchApp::RunMeshLoadBenchmark(const std::string& meshFilename, unsigned int faces, unsigned int loads, MeshSource source)
+{
+    BenchResult r(source == MeshSource::FILE ? "mesh_load_file" : (source == MeshSource::CACHE ? "mesh_load_cache" : "mesh_load_snapshot"), faces, loads);
+    
+    //Mesh processing as done by the scenario parser: parsing and repairing the file, 
+    //copying the processed mesh from the cache or reading it from a compiled scenario
+    std::string snapshot = meshFilename + ".bin";
+    bool caching = sf::OpenGLContent::isMeshCaching();
+    sf::OpenGLContent::setMeshCaching(source == MeshSource::CACHE);
+    if(source != MeshSource::FILE)
+    {
+        sf::Mesh* mesh = sf::OpenGLContent::LoadMesh(meshFilename, 1.f, false);
+        FILE* file = fopen(snapshot.c_str(), "wb");
+        if(file != nullptr)
+        {
+            sf::WriteMeshBinary(file, mesh);
+            fclose(file);
+        }
+        delete mesh;
+    }
+    
+    int64_t start = sf::GetTimeInMicroseconds();
+    for(unsigned int i=0; i<loads; ++i)
+    {
+        sf::Mesh* mesh = nullptr;
+        if(source == MeshSource::SNAPSHOT)
+        {
+            FILE* file = fopen(snapshot.c_str(), "rb");
+            if(file != nullptr)
+            {
+                mesh = sf::ReadMeshBinary(file);
+                fclose(file);
+            }
+        }
+        else
+            mesh = sf::OpenGLContent::LoadMesh(meshFilename, 1.f, false);
+        if(mesh != nullptr)
+            delete mesh;
+    }
+    double runTime = (sf::GetTimeInMicroseconds() - start)/1e6;
+    
+    sf::OpenGLContent::ClearMeshCache();
+    sf::OpenGLContent::setMeshCaching(caching);
+    std::remove(snapshot.c_str());
+    
+    r.stepsPerSecond = runTime > 0.0 ? loads/runTime : 0.0;
+    r.loadMs = runTime * 1000.0 / (double)loads;
+    cInfo("Benchmark %s(%u): %.3lf ms per mesh.", r.scenario.c_str(), faces, r.loadMs);
+    return r;
+}
+
+BenchResult BenchApp::RunNoiseBenchmark(unsigned int channels, unsigned int samples, bool batch)
+{
+    BenchResult r(batch ? "noise_batch" : "noise_scalar", channels, samples);
+    
+    //Noise of a multi-channel sensor sample, as generated by ScalarSensor (batch) or per channel with the standard distribution
+    sf::RandomStream stream(1);
+    std::normal_distribution<sf::Scalar> dist(sf::Scalar(0), sf::Scalar(1));
+    std::vector<sf::Scalar> noise(channels);
+    double sum = 0.0;
+    double sum2 = 0.0;
+    
+    int64_t start = sf::GetTimeInMicroseconds();
+    for(unsigned int i=0; i<samples; ++i)
+    {
+        if(batch)
+            stream.FillNormal(noise.data(), channels);
+        else
+            for(unsigned int h=0; h<channels; ++h)
+                noise[h] = dist(stream);
+        sum += noise[i % channels];
+        sum2 += noise[i % channels] * noise[i % channels];
+    }
+    double runTime = (sf::GetTimeInMicroseconds() - start)/1e6;
+    
+    r.stepsPerSecond = runTime > 0.0 ? samples/runTime : 0.0;
+    r.valuesPerSecond = r.stepsPerSecond * channels;
+    r.noiseStdDev = sqrt(sum2/samples - (sum/samples)*(sum/samples));
+    cInfo("Benchmark %s(%u): %.3lf Mvalues/s, std dev %.4lf.", r.scenario.c_str(), channels, r.valuesPerSecond/1e6, r.noiseStdDev);
+    return r;
+}
+
+static int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+BenchResult BenchApp::RunSharedMemoryBenchmark(unsigned int values, unsigned int samples, bool spin)
+{
+    BenchResult r(spin ? "shm_spin" : "shm_futex", values, samples);
+    
+    //Sample published by the simulation -> controller woken up and reading in place -> setpoint written back
+    sf::SharedMemoryBridge bridge("/stonefish_bench");
+    int output = bridge.AddOutput("sensor", values);
+    int input = bridge.AddInput("actuator", 1);
+    sf::SharedMemoryClient client;
+    if(!bridge.Open() || !client.Open(bridge.getName()))
+        return r;
+    
+    std::vector<double> latency(samples, 0.0);
+    std::thread controller([&]()
+    {
+        int in = client.getChannelIndex("sensor");
+        int out = client.getChannelIndex("actuator");
+        uint64_t read = 0;
+        uint32_t notify = client.getNotifyCounter();
+        while(read < samples)
+        {
+            if(spin)
+                while(client.getWriteCount(in) == read)
+                    std::this_thread::yield();
+            else if(!client.Wait(notify, 1000))
+                break;
+            notify = client.getNotifyCounter();
+            
+            uint64_t n = client.getWriteCount(in);
+            uint64_t seq;
+            const double* data = (const double*)client.BeginRead(in, seq);
+            if(n == read || data == nullptr)
+                continue;
+            double stamp = data[0];
+            if(!client.EndRead(in, seq))
+                continue;
+            latency[read] = (NowNs() - (int64_t)stamp)/1000.0;
+            read = n;
+            client.WriteInput(out, &stamp);
+        }
+    });
+    
+    std::vector<double> sample(values, 0.0);
+    std::vector<double> roundTrip(samples, 0.0);
+    int64_t start = sf::GetTimeInMicroseconds();
+    for(unsigned int i=0; i<samples; ++i)
+    {
+        int64_t t0 = NowNs();
+        sample[0] = (double)t0;
+        bridge.Publish(output, (sf::Scalar)i, sample.data());
+        bridge.StepCompleted((sf::Scalar)i);
+        
+        double reply = 0.0;
+        int64_t deadline = t0 + 1000000000LL;
+        while(!(bridge.Receive(input, &reply) && reply == sample[0]) && NowNs() < deadline)
+            std::this_thread::yield();
+        roundTrip[i] = (NowNs() - t0)/1000.0;
+    }
+    double runTime = (sf::GetTimeInMicroseconds() - start)/1e6;
+    controller.join();
+    
+    std::sort(latency.begin(), latency.end());
+    std::sort(roundTrip.begin(), roundTrip.end());
+    r.stepsPerSecond = runTime > 0.0 ? samples/runTime : 0.0;
+    r.latencyUs = latency[samples/2];
+    r.latencyP99Us = latency[(samples * 99)/100];
+    r.roundTripUs = roundTrip[samples/2];
+    cInfo("Benchmark %s(%u): latency %.2lf us (p99 %.2lf us), round trip %.2lf us.", 
+          r.scenario.c_str(), values, r.latencyUs, r.latencyP99Us, r.roundTripUs);
+    return r;
+}
+
+BenchResult BenchApp::RunVisionBenchmark(const std::string& executable, unsigned int sensors, unsigned int frames, unsigned int threads)
+{
+    BenchResult r("vision", sensors, frames);
+    r.threads = threads;
+    
+    //The rendering threads of llvmpipe are created with the EGL context, so every thread count needs a new process
+    std::string output = "stonefish_bench_vision.txt";
+    std::string threadsStr = std::to_string(threads);
+    std::string lpThreads = getenv("LP_NUM_THREADS") != NULL ? getenv("LP_NUM_THREADS") : "";
+    std::string ompThreads = getenv("OMP_NUM_THREADS") != NULL ? getenv("OMP_NUM_THREADS") : "";
+    setenv("LP_NUM_THREADS", threadsStr.c_str(), 1);
+    setenv("OMP_NUM_THREADS", threadsStr.c_str(), 1);
+    std::string cmd = "\"" + executable + "\" --vision-run " + std::to_string(sensors) + " " + std::to_string(frames) + " \"" + output + "\"";
+    int status = std::system(cmd.c_str());
+    lpThreads.empty() ? unsetenv("LP_NUM_THREADS") : setenv("LP_NUM_THREADS", lpThreads.c_str(), 1);
+    ompThreads.empty() ? unsetenv("OMP_NUM_THREADS") : setenv("OMP_NUM_THREADS", ompThreads.c_str(), 1);
+    
+    unsigned long rendered = 0;
+    double fps = 0.0;
+    FILE* f = status == 0 ? fopen(output.c_str(), "r") : NULL;
+    if(f == NULL)
+    {
+        cWarning("Benchmark %s(%u) with %u threads failed (headless rendering not available?).", r.scenario.c_str(), sensors, threads);
+        return r;
+    }
+    if(fscanf(f, "%lu %lf", &rendered, &fps) == 2)
+    {
+        r.steps = (unsigned int)rendered;
+        r.sensorFps = fps;
+        r.sensorFpsPerCore = fps/threads;
+    }
+    fclose(f);
+    std::remove(output.c_str());
+    
+    cInfo("Benchmark %s(%u) with %u threads: %.1lf sensor frames/s, %.1lf per core.", r.scenario.c_str(), sensors, threads, r.sensorFps, r.sensorFpsPerCore);
+    return r;
+}
+
+bool BenchApp::WriteResults(const std::string& filename, const std::vector<BenchResult>& results, bool quick)
+{
+    FILE* f = fopen(filename.c_str(), "w");
+    if(f == NULL)
+        return false;
+    
+    fprintf(f, "{\n  \"version\": \"%s\",\n  \"threads\": %d,\n  \"quick\": %s,\n  \"results\": [\n", 
+            STONEFISH_VER, omp_get_max_threads(), quick ? "true" : "false");
+    for(size_t i=0; i<results.size(); ++i)
+    {
+        const BenchResult& r = results[i];
+        fprintf(f, "    {\"scenario\": \"%s\", \"scale\": %u, \"steps\": %u, \"startup_ms\": %.3lf, \"steps_per_s\": %.3lf, \"contacts\": %.1lf",
+                r.scenario.c_str(), r.scale, r.steps, r.startupMs, r.stepsPerSecond, r.contacts);
+        if(r.nsPerFace >= 0.0)
+            fprintf(f, ", \"ns_per_face\": %.3lf", r.nsPerFace);
+        if(r.raysPerSecond >= 0.0)
+            fprintf(f, ", \"rays_per_s\": %.1lf, \"instances\": %.0lf, \"triangles\": %.0lf", r.raysPerSecond, r.instances, r.triangles);
+        if(r.valuesPerSecond >= 0.0)
+            fprintf(f, ", \"values_per_s\": %.1lf, \"noise_std_dev\": %.4lf", r.valuesPerSecond, r.noiseStdDev);
+        if(r.loadMs >= 0.0)
+            fprintf(f, ", \"load_ms\": %.4lf", r.loadMs);
+        if(r.latencyUs >= 0.0)
+            fprintf(f, ", \"latency_us\": %.3lf, \"latency_p99_us\": %.3lf, \"round_trip_us\": %.3lf", r.latencyUs, r.latencyP99Us, r.roundTripUs);
+        if(r.sensorFps >= 0.0)
+            fprintf(f, ", \"render_threads\": %u, \"sensor_fps\": %.2lf, \"sensor_fps_per_core\": %.2lf", r.threads, r.sensorFps, r.sensorFpsPerCore);
+        fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+VisionBenchApp::VisionBenchApp(std::string dataDirPath, BenchManager* sim, uint64_t frames)
+    : HeadlessSimulationApp("StonefishBench", dataDirPath, sf::RenderSettings(), sim), frames(frames)
+{
+    deadline = 0;
+}
+
+void VisionBenchApp::LoopInternal()
+{
+    if(deadline == 0)
+        deadline = sf::GetTimeInMicroseconds() + 120000000; //Give up after 2 minutes
+    
+    HeadlessSimulationApp::LoopInternal();
+    if(getSensorFrameCount() >= frames || sf::GetTimeInMicroseconds() > deadline)
+        Exit();
+}
+
+bool VisionBenchApp::RunChild(const std::string& dataDirPath, unsigned int sensors, unsigned int frames, const std::string& filename)
+{
+    BenchManager* sim = new BenchManager(500.0);
+    sim->setScenario(BenchScenario::VISION, sensors);
+    VisionBenchApp app(dataDirPath, sim, frames);
+    app.Run();
+    
+    double fps = app.getSensorFrameRate();
+    if(fps <= 0.0)
+        return false;
+    FILE* f = fopen(filename.c_str(), "w");
+    if(f == NULL)
+        return false;
+    fprintf(f, "%lu %.6lf\n", (unsigned long)app.getSensorFrameCount(), fps);
+    fclose(f);
+    return true;
+}
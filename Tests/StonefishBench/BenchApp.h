@@ -0,0 +1,92 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BenchApp.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__BenchApp__
+#define __Stonefish__BenchApp__
+
+#include <core/ConsoleSimulationApp.h>
+#include <core/HeadlessSimulationApp.h>
+#include "BenchManager.h"
+
+//! Result of a single benchmark run (negative values are not applicable).
+struct BenchResult
+{
+    BenchResult(const std::string& scenario, unsigned int scale, unsigned int steps) 
+        : scenario(scenario), scale(scale), steps(steps) {}
+    
+    std::string scenario;
+    unsigned int scale;
+    unsigned int steps;
+    double startupMs = 0.0;
+    double stepsPerSecond = 0.0;
+    double nsPerFace = -1.0;
+    double raysPerSecond = -1.0;
+    double instances = -1.0; //Number of mesh instances in the ray-traced scene
+    double triangles = -1.0; //Number of triangles in the ray-traced scene
+    double valuesPerSecond = -1.0; //Noise values generated per second
+    double noiseStdDev = -1.0; //Measured standard deviation of the noise
+    double latencyUs = -1.0; //Median latency from publishing a sample to reading it in another thread [us]
+    double latencyP99Us = -1.0; //99th percentile of the latency [us]
+    double roundTripUs = -1.0; //Median time from publishing a sample to receiving the reply [us]
+    double contacts = 0.0; //Average number of contact manifolds
+    double loadMs = -1.0; //Average time of loading a processed mesh [ms]
+    unsigned int threads = 0; //Number of rendering threads (llvmpipe and OpenMP)
+    double sensorFps = -1.0; //Sensor frames rendered per second of rendering time
+    double sensorFpsPerCore = -1.0; //Sensor frames per second divided by the number of rendering threads
+};
+
+//! Source of the processed meshes in the mesh loading benchmark.
+enum class MeshSource {FILE, CACHE, SNAPSHOT};
+
+class BenchApp : public sf::ConsoleSimulationApp
+{
+public:
+    BenchApp(std::string dataDirPath, BenchManager* sim);
+    
+    BenchResult RunScenario(BenchScenario s, unsigned int scale, unsigned int steps, const std::string& meshFilename = "", unsigned int faces = 0, unsigned int objects = 0);
+    static BenchResult RunMeshLoadBenchmark(const std::string& meshFilename, unsigned int faces, unsigned int loads, MeshSource source);
+    static BenchResult RunNoiseBenchmark(unsigned int channels, unsigned int samples, bool batch);
+    static BenchResult RunSharedMemoryBenchmark(unsigned int values, unsigned int samples, bool spin);
+    static BenchResult RunVisionBenchmark(const std::string& executable, unsigned int sensors, unsigned int frames, unsigned int threads);
+    static bool WriteResults(const std::string& filename, const std::vector<BenchResult>& results, bool quick);
+};
+
+//! Headless application rendering the vision scenario until the requested number of sensor frames (run in a child process).
+class VisionBenchApp : public sf::HeadlessSimulationApp
+{
+public:
+    VisionBenchApp(std::string dataDirPath, BenchManager* sim, uint64_t frames);
+    
+    static bool RunChild(const std::string& dataDirPath, unsigned int sensors, unsigned int frames, const std::string& filename);
+    
+protected:
+    void LoopInternal();
+    
+private:
+    uint64_t frames;
+    int64_t deadline;
+};
+
+#endif
@@ -0,0 +1,335 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BenchManager.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include "BenchManager.h"
+
+#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <entities/statics/Plane.h>
+#include <entities/solids/Sphere.h>
+#include <entities/solids/Box.h>
+#include <entities/solids/Polyhedron.h>
+#include <core/FeatherstoneRobot.h>
+#include <sensors/scalar/IMU.h>
+#include <sensors/scalar/Pressure.h>
+#include <sensors/scalar/Odometry.h>
+#include <sensors/vision/DepthCamera.h>
+#include <sensors/vision/ColorCamera.h>
+#include <sensors/vision/FLS.h>
+#include <utils/UnitSystem.h>
+
+BenchManager::BenchManager(sf::Scalar stepsPerSecond) 
+    : SimulationManager(stepsPerSecond, sf::SolverType::SOLVER_SI, sf::CollisionFilteringType::COLLISION_EXCLUSIVE)
+{
+    scenario = BenchScenario::BODIES;
+    scale = 1;
+    objects = 0;
+    clock = 1;
+}
+
+void BenchManager::setScenario(BenchScenario s, unsigned int scale, const std::string& meshFilename, unsigned int objects)
+{
+    scenario = s;
+    this->scale = scale;
+    this->meshFilename = meshFilename;
+    this->objects = objects;
+}
+
+uint64_t BenchManager::getSimulationClock() const
+{
+    return clock;
+}
+
+void BenchManager::SimulationClockSleep(uint64_t us)
+{
+    clock += us;
+}
+
+std::string BenchManager::getScenarioName(BenchScenario s)
+{
+    switch(s)
+    {
+        case BenchScenario::BODIES:
+            return "bodies";
+        case BenchScenario::CONTACTS:
+            return "contacts";
+        case BenchScenario::MESH:
+            return "mesh";
+        case BenchScenario::SENSORS:
+            return "sensors";
+        case BenchScenario::RAYS:
+            return "rays";
+        case BenchScenario::FEATHERSTONE:
+            return "featherstone";
+        case BenchScenario::VISION:
+            return "vision";
+    }
+    return "";
+}
+
+void BenchManager::BuildScenario()
+{
+    CreateMaterial("Steel", sf::UnitSystem::Density(sf::CGS, sf::MKS, 7.8), 0.3);
+    CreateMaterial("Plastic", sf::UnitSystem::Density(sf::CGS, sf::MKS, 0.9), 0.3);
+    SetMaterialsInteraction("Steel", "Steel", 0.5, 0.2);
+    SetMaterialsInteraction("Plastic", "Plastic", 0.5, 0.2);
+    SetMaterialsInteraction("Steel", "Plastic", 0.5, 0.2);
+    
+    sf::Plane* plane = new sf::Plane("Ground", 1000.0, "Steel");
+    AddStaticEntity(plane, sf::I4());
+    
+    switch(scenario)
+    {
+        case BenchScenario::BODIES:
+            BuildBodies();
+            break;
+        case BenchScenario::CONTACTS:
+            BuildContacts();
+            break;
+        case BenchScenario::MESH:
+            BuildMesh();
+            break;
+        case BenchScenario::SENSORS:
+            BuildSensors();
+            break;
+        case BenchScenario::RAYS:
+            BuildRays();
+            break;
+        case BenchScenario::FEATHERSTONE:
+            BuildFeatherstone();
+            break;
+        case BenchScenario::VISION:
+            BuildVision();
+            break;
+    }
+}
+
+//Spheres falling on the ground from a sparse grid (body count)
+void BenchManager::BuildBodies()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    unsigned int n = (unsigned int)ceil(sqrt((double)scale));
+    for(unsigned int i=0; i<scale; ++i)
+    {
+        sf::Sphere* sph = new sf::Sphere("Sphere" + std::to_string(i), phy, 0.1, sf::I4(), "Steel", "");
+        AddSolidEntity(sph, sf::Transform(sf::IQ(), sf::Vector3((i % n) * 0.5, (i / n) * 0.5, -0.5 - 0.01 * (i % 7))));
+    }
+}
+
+//Cube of touching boxes resting on the ground (contact density)
+void BenchManager::BuildContacts()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    unsigned int n = (unsigned int)ceil(cbrt((double)scale));
+    for(unsigned int i=0; i<scale; ++i)
+    {
+        unsigned int x = i % n;
+        unsigned int y = (i / n) % n;
+        unsigned int z = i / (n * n);
+        sf::Box* box = new sf::Box("Box" + std::to_string(i), phy, sf::Vector3(0.2, 0.2, 0.2), sf::I4(), "Plastic", "");
+        AddSolidEntity(box, sf::Transform(sf::IQ(), sf::Vector3(x * 0.201, y * 0.201, -0.1001 - z * 0.2001)));
+    }
+}
+
+//Single submerged mesh body (hydrodynamics cost per face)
+void BenchManager::BuildMesh()
+{
+    EnableOcean(0.0);
+    
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SUBMERGED;
+    phy.collisions = true;
+    phy.buoyancy = true;
+    sf::Polyhedron* hull = new sf::Polyhedron("Hull", phy, meshFilename, 1.0, sf::I4(), "Plastic", "");
+    AddSolidEntity(hull, sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, 5.0)));
+}
+
+//Scalar sensors attached to a single falling body (sensor count)
+void BenchManager::BuildSensors()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    sf::Sphere* sph = new sf::Sphere("Body", phy, 0.5, sf::I4(), "Steel", "");
+    AddSolidEntity(sph, sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, -2.0)));
+    
+    for(unsigned int i=0; i<scale; ++i)
+    {
+        sf::LinkSensor* sens;
+        switch(i % 3)
+        {
+            case 0:
+                sens = new sf::IMU("IMU" + std::to_string(i));
+                break;
+            case 1:
+                sens = new sf::Pressure("Pressure" + std::to_string(i));
+                break;
+            default:
+                sens = new sf::Odometry("Odometry" + std::to_string(i));
+                break;
+        }
+        sens->AttachToSolid(sph, sf::I4());
+        AddSensor(sens);
+    }
+}
+
+//Depth camera looking at a field of spheres (ray count and scene size, CPU backend in console mode)
+void BenchManager::BuildRays()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    
+    //Objects is the number of spheres, resting on a grid that fills the field of view
+    unsigned int n = (unsigned int)ceil(sqrt((double)std::max(objects, 1u)));
+    sf::Scalar spacing = sf::Scalar(8)/(sf::Scalar)n;
+    sf::Scalar radius = std::min(sf::Scalar(0.2), sf::Scalar(0.4) * spacing);
+    for(unsigned int i=0; i<objects; ++i)
+    {
+        sf::Sphere* sph = new sf::Sphere("Sphere" + std::to_string(i), phy, radius, sf::I4(), "Steel", "");
+        AddSolidEntity(sph, sf::Transform(sf::IQ(), sf::Vector3(((i % n) + 0.5) * spacing - 4.0, ((i / n) + 0.5) * spacing - 4.0, -radius)));
+    }
+    
+    //Scale is the horizontal resolution (4:3 aspect)
+    sf::DepthCamera* cam = new sf::DepthCamera("DepthCam", scale, scale * 3 / 4, 90.0, 0.1, 20.0, getStepsPerSecond());
+    cam->AttachToWorld(sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, -5.0)));
+    AddSensor(cam);
+}
+
+//Featherstone chain hanging from a fixed base (link count)
+void BenchManager::BuildFeatherstone()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = false;
+    
+    sf::Box* base = new sf::Box("Link0", phy, sf::Vector3(0.1, 0.1, 0.1), sf::I4(), "Steel", "");
+    std::vector<sf::SolidEntity*> links;
+    for(unsigned int i=1; i<=scale; ++i)
+        links.push_back(new sf::Box("Link" + std::to_string(i), phy, sf::Vector3(0.2, 0.05, 0.05), 
+                                    sf::Transform(sf::IQ(), sf::Vector3(0.1, 0.0, 0.0)), "Steel", ""));
+    
+    sf::Robot* robot = new sf::FeatherstoneRobot("Chain", true);
+    robot->DefineLinks(base, links);
+    for(unsigned int i=1; i<=scale; ++i)
+        robot->DefineRevoluteJoint("Joint" + std::to_string(i), "Link" + std::to_string(i-1), "Link" + std::to_string(i),
+                                   sf::Transform(sf::IQ(), sf::Vector3(i == 1 ? 0.05 : 0.2, 0.0, 0.0)), sf::VY(), std::make_pair(-1.0, 1.0));
+    robot->BuildKinematicStructure();
+    AddRobot(robot, sf::Transform(sf::IQ(), sf::Vector3(0.0, 0.0, -1.0 - 0.2 * scale)));
+}
+
+//Color cameras, depth cameras and forward-looking sonars above a field of spheres (sensor count, rendered headless)
+void BenchManager::BuildVision()
+{
+    sf::BodyPhysicsSettings phy;
+    phy.mode = sf::BodyPhysicsMode::SURFACE;
+    phy.collisions = true;
+    for(unsigned int i=0; i<25; ++i)
+    {
+        sf::Sphere* sph = new sf::Sphere("Sphere" + std::to_string(i), phy, 0.2, sf::I4(), "Steel", "");
+        AddSolidEntity(sph, sf::Transform(sf::IQ(), sf::Vector3((i % 5) * 0.8 - 1.6, (i / 5) * 0.8 - 1.6, -0.2)));
+    }
+    
+    //Sensors spread on a circle above the spheres, looking down
+    for(unsigned int i=0; i<scale; ++i)
+    {
+        sf::VisionSensor* sens;
+        switch(i % 3)
+        {
+            case 0:
+                sens = new sf::ColorCamera("Camera" + std::to_string(i), 320, 240, 90.0, 30.0);
+                break;
+            case 1:
+                sens = new sf::DepthCamera("DepthCamera" + std::to_string(i), 320, 240, 90.0, 0.1, 20.0, 30.0);
+                break;
+            default:
+                sens = new sf::FLS("FLS" + std::to_string(i), 256, 500, 90.0, 20.0, 0.5, 20.0, sf::ColorMap::HOT, 10.0);
+                break;
+        }
+        sf::Scalar angle = sf::Scalar(2) * M_PI * i / (sf::Scalar)scale;
+        sens->AttachToWorld(sf::Transform(sf::IQ(), sf::Vector3(0.5 * cos(angle), 0.5 * sin(angle), -5.0)));
+        AddSensor(sens);
+    }
+}
+
+//Writes an icosphere of unit radius to an OBJ file, returns the number of faces
+unsigned int BenchManager::WriteIcosphere(const std::string& filename, unsigned int subdivisions)
+{
+    const double t = (1.0 + sqrt(5.0)) / 2.0;
+    std::vector<sf::Vector3> v = {
+        {-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0}, {0, -1, t}, {0, 1, t}, 
+        {0, -1, -t}, {0, 1, -t}, {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}
+    };
+    std::vector<unsigned int> f = {
+        0,11,5, 0,5,1, 0,1,7, 0,7,10, 0,10,11, 1,5,9, 5,11,4, 11,10,2, 10,7,6, 7,1,8,
+        3,9,4, 3,4,2, 3,2,6, 3,6,8, 3,8,9, 4,9,5, 2,4,11, 6,2,10, 8,6,7, 9,8,1
+    };
+    for(size_t i=0; i<v.size(); ++i)
+        v[i].normalize();
+    
+    for(unsigned int s=0; s<subdivisions; ++s)
+    {
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> midpoints;
+        auto midpoint = [&](unsigned int a, unsigned int b)
+        {
+            std::pair<unsigned int, unsigned int> key(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if(it != midpoints.end())
+                return it->second;
+            v.push_back(((v[a] + v[b]) * 0.5).normalized());
+            midpoints[key] = (unsigned int)v.size() - 1;
+            return (unsigned int)v.size() - 1;
+        };
+        
+        std::vector<unsigned int> f2;
+        for(size_t i=0; i<f.size(); i+=3)
+        {
+            unsigned int a = midpoint(f[i], f[i+1]);
+            unsigned int b = midpoint(f[i+1], f[i+2]);
+            unsigned int c = midpoint(f[i+2], f[i]);
+            unsigned int tri[12] = {f[i], a, c, f[i+1], b, a, f[i+2], c, b, a, b, c};
+            f2.insert(f2.end(), tri, tri + 12);
+        }
+        f.swap(f2);
+    }
+    
+    FILE* file = fopen(filename.c_str(), "w");
+    if(file == NULL)
+        return 0;
+    for(size_t i=0; i<v.size(); ++i)
+        fprintf(file, "v %.6lf %.6lf %.6lf\n", (double)v[i].getX(), (double)v[i].getY(), (double)v[i].getZ());
+    for(size_t i=0; i<f.size(); i+=3)
+        fprintf(file, "f %u %u %u\n", f[i]+1, f[i+1]+1, f[i+2]+1);
+    fclose(file);
+    return (unsigned int)f.size()/3;
+}
@@ -0,0 +1,65 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  BenchManager.h
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#ifndef __Stonefish__BenchManager__
+#define __Stonefish__BenchManager__
+
+#include <core/SimulationManager.h>
+
+//! Scenarios of the benchmark suite.
+enum class BenchScenario {BODIES, CONTACTS, MESH, SENSORS, RAYS, FEATHERSTONE, VISION};
+
+class BenchManager : public sf::SimulationManager
+{
+public:
+    BenchManager(sf::Scalar stepsPerSecond);
+    
+    void setScenario(BenchScenario s, unsigned int scale, const std::string& meshFilename = "", unsigned int objects = 0);
+    void BuildScenario();
+    
+    //Deterministic stepping: the clock advances by exactly the requested sleep time
+    uint64_t getSimulationClock() const;
+    void SimulationClockSleep(uint64_t us);
+    
+    static std::string getScenarioName(BenchScenario s);
+    static unsigned int WriteIcosphere(const std::string& filename, unsigned int subdivisions);
+    
+private:
+    void BuildBodies();
+    void BuildContacts();
+    void BuildMesh();
+    void BuildSensors();
+    void BuildRays();
+    void BuildFeatherstone();
+    void BuildVision();
+    
+    BenchScenario scenario;
+    unsigned int scale;
+    std::string meshFilename;
+    unsigned int objects;
+    uint64_t clock;
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*    
+    This file is a part of Stonefish.
+
+    Stonefish is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Stonefish is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+//
+//  main.cpp
+//  Stonefish
+//
+//  Created by agent on 19/10/2026.
+//  Copyright (c) 2026 agent. All rights reserved.
+//
+
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <algorithm>
+#include "BenchApp.h"
+#include "BenchManager.h"
+
+//Usage: StonefishBench [results.json] [--quick]
+//       StonefishBench --vision-run <sensors> <frames> <output> (single headless rendering run, started by the benchmark)
+int main(int argc, const char * argv[])
+{
+    if(argc == 5 && strcmp(argv[1], "--vision-run") == 0)
+        return VisionBenchApp::RunChild(std::string(DATA_DIR_PATH), (unsigned int)atoi(argv[2]), (unsigned int)atoi(argv[3]), std::string(argv[4])) ? 0 : 1;
+    
+    std::string output = "stonefish_bench.json";
+    bool quick = false;
+    for(int i=1; i<argc; ++i)
+    {
+        if(strcmp(argv[i], "--quick") == 0)
+            quick = true;
+        else
+            output = std::string(argv[i]);
+    }
+    
+    BenchManager* simulationManager = new BenchManager(500.0);
+    BenchApp app(std::string(DATA_DIR_PATH), simulationManager);
+    
+    unsigned int steps = quick ? 200 : 1000;
+    std::vector<BenchResult> results;
+    
+    std::vector<unsigned int> bodies = quick ? std::vector<unsigned int>{10, 100} : std::vector<unsigned int>{10, 100, 1000};
+    for(size_t i=0; i<bodies.size(); ++i)
+        results.push_back(app.RunScenario(BenchScenario::BODIES, bodies[i], steps));
+    
+    std::vector<unsigned int> boxes = quick ? std::vector<unsigned int>{27, 125} : std::vector<unsigned int>{27, 125, 512};
+    for(size_t i=0; i<boxes.size(); ++i)
+        results.push_back(app.RunScenario(BenchScenario::CONTACTS, boxes[i], steps));
+    
+    unsigned int maxSubdiv = quick ? 3 : 5;
+    for(unsigned int s=1; s<=maxSubdiv; ++s)
+    {
+        std::string mesh = output + ".mesh" + std::to_string(s) + ".obj";
+        unsigned int faces = BenchManager::WriteIcosphere(mesh, s);
+        if(faces == 0)
+            continue;
+        results.push_back(app.RunScenario(BenchScenario::MESH, faces, steps, mesh, faces));
+        unsigned int loads = quick ? 20 : 100;
+        results.push_back(BenchApp::RunMeshLoadBenchmark(mesh, faces, loads, MeshSource::FILE));
+        results.push_back(BenchApp::RunMeshLoadBenchmark(mesh, faces, loads, MeshSource::CACHE));
+        results.push_back(BenchApp::RunMeshLoadBenchmark(mesh, faces, loads, MeshSource::SNAPSHOT));
+        std::remove(mesh.c_str());
+    }
+    
+    std::vector<unsigned int> sensors = quick ? std::vector<unsigned int>{10, 100} : std::vector<unsigned int>{10, 100, 1000};
+    for(size_t i=0; i<sensors.size(); ++i)
+        results.push_back(app.RunScenario(BenchScenario::SENSORS, sensors[i], steps));
+    
+    std::vector<unsigned int> resolutions = quick ? std::vector<unsigned int>{64, 160} : std::vector<unsigned int>{64, 160, 320, 640};
+    std::vector<unsigned int> objects = quick ? std::vector<unsigned int>{25, 400} : std::vector<unsigned int>{25, 100, 400, 1600};
+    for(size_t i=0; i<resolutions.size(); ++i)
+        for(size_t h=0; h<objects.size(); ++h)
+            results.push_back(app.RunScenario(BenchScenario::RAYS, resolutions[i], quick ? 50 : 200, "", 0, objects[h]));
+    
+    std::vector<unsigned int> links = quick ? std::vector<unsigned int>{4, 16} : std::vector<unsigned int>{4, 16, 64};
+    for(size_t i=0; i<links.size(); ++i)
+        results.push_back(app.RunScenario(BenchScenario::FEATHERSTONE, links[i], steps));
+    
+    std::vector<unsigned int> channels = quick ? std::vector<unsigned int>{6, 256} : std::vector<unsigned int>{6, 64, 256, 1024};
+    for(size_t i=0; i<channels.size(); ++i)
+    {
+        unsigned int samples = (quick ? 1000000 : 10000000)/channels[i];
+        results.push_back(BenchApp::RunNoiseBenchmark(channels[i], samples, false));
+        results.push_back(BenchApp::RunNoiseBenchmark(channels[i], samples, true));
+    }
+    
+    std::vector<unsigned int> values = quick ? std::vector<unsigned int>{6} : std::vector<unsigned int>{6, 1024};
+    for(size_t i=0; i<values.size(); ++i)
+    {
+        unsigned int samples = quick ? 2000 : 20000;
+        results.push_back(BenchApp::RunSharedMemoryBenchmark(values[i], samples, false));
+        results.push_back(BenchApp::RunSharedMemoryBenchmark(values[i], samples, true));
+    }
+    
+    //Headless rendering of vision sensors, sweeping the number of rendering threads
+    std::vector<unsigned int> visionSensors = quick ? std::vector<unsigned int>{3} : std::vector<unsigned int>{3, 12};
+    unsigned int cores = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<unsigned int> threads;
+    for(unsigned int t=1; t<cores; t*=2)
+        if(!quick || t == 1)
+            threads.push_back(t);
+    threads.push_back(cores);
+    for(size_t i=0; i<visionSensors.size(); ++i)
+        for(size_t h=0; h<threads.size(); ++h)
+            results.push_back(BenchApp::RunVisionBenchmark(argv[0], visionSensors[i], quick ? 200 : 1000, threads[h]));
+    
+    if(!BenchApp::WriteResults(output, results, quick))
+    {
+        printf("Could not write benchmark results to '%s'!\n", output.c_str());
+        return 1;
+    }
+    printf("Benchmark results written to '%s'.\n", output.c_str());
+    return 0;
+}